@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "landmarksloader.h"
+#include "csvfile.h"
+#include <QDebug>
+
+// Number of frames delivered at once
+#define CHUNK_SIZE 500
+
+// +-----------------------------------------------------------
+fsdk::LandmarksLoader::LandmarksLoader(const QString &sFileName)
+{
+	qRegisterMetaType<LandmarksMap>("LandmarksMap");
+	m_sFileName = sFileName;
+	setAutoDelete(false);
+}
+
+// +-----------------------------------------------------------
+void fsdk::LandmarksLoader::cancel()
+{
+	m_oCancelRequested.testAndSetOrdered(0, 1);
+}
+
+// +-----------------------------------------------------------
+bool fsdk::LandmarksLoader::isCancelled() const
+{
+	return static_cast<int>(m_oCancelRequested) == 1;
+}
+
+// +-----------------------------------------------------------
+QString fsdk::LandmarksLoader::fileName() const
+{
+	return m_sFileName;
+}
+
+// +-----------------------------------------------------------
+void fsdk::LandmarksLoader::run()
+{
+	CSVFile oFile(m_sFileName);
+	if(!oFile.beginRead())
+	{
+		qWarning().noquote() << "Could not load the landmarks CSV file: " << m_sFileName;
+		emit finished(false);
+		return;
+	}
+
+	qint64 iSize = qMax(oFile.size(), static_cast<qint64>(1));
+	int iProgress = 0;
+	emit loadProgress(iProgress);
+
+	// The files of the extractions with gating have the column of the reused
+	// frames before the landmarks (see LandmarksData::saveToCSV)
+	int iFirst = oFile.header().value(2) == "Reused" ? 3 : 2;
+
+	LandmarksMap mChunk;
+	QStringList lLine;
+	while(oFile.readNext(lLine))
+	{
+		if(isCancelled())
+		{
+			oFile.endRead();
+			emit finished(false);
+			return;
+		}
+
+		if(lLine.isEmpty())
+			continue;
+
+		qint64 iFrame = lLine[0].toLongLong();
+		QList<QPoint> lData;
+		for(int i = iFirst; i < lLine.count() - 1; i += 2)
+		{
+			QPoint oMark(lLine[i].toInt(), lLine[i + 1].toInt());
+			lData.push_back(oMark);
+		}
+		mChunk[iFrame] = lData;
+
+		if(mChunk.count() >= CHUNK_SIZE)
+		{
+			emit landmarksLoaded(mChunk);
+			mChunk.clear();
+
+			// The file position is ahead of the parsing due to the stream
+			// buffering, but that is precise enough for a progress indication
+			int iNewProgress = static_cast<int>(oFile.pos() * 100 / iSize);
+			if(iNewProgress != iProgress)
+			{
+				iProgress = iNewProgress;
+				emit loadProgress(qMin(iProgress, 99));
+			}
+		}
+	}
+	oFile.endRead();
+
+	if(!mChunk.isEmpty())
+		emit landmarksLoaded(mChunk);
+	emit loadProgress(100);
+	emit finished(true);
+}
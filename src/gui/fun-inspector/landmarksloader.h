@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LANDMARKSLOADER_H
+#define LANDMARKSLOADER_H
+
+#include <QObject>
+#include <QRunnable>
+#include <QAtomicInt>
+#include <QMap>
+#include <QList>
+#include <QPoint>
+
+namespace fsdk
+{
+	/** Landmarks positions mapped by the frame index. */
+	typedef QMap<qint64, QList<QPoint>> LandmarksMap;
+
+	/**
+	 * Background task that reads a landmarks CSV file. The landmarks are
+	 * delivered progressively, in chunks of frames, so they can be displayed
+	 * as soon as they are available (instead of freezing the interface until
+	 * the whole file is read).
+	 */
+	class LandmarksLoader : public QObject, public QRunnable
+	{
+		Q_OBJECT
+
+	public:
+		/**
+		 * Class constructor.
+		 * @param sFileName QString with the name of the landmarks CSV file.
+		 */
+		LandmarksLoader(const QString &sFileName);
+
+		/**
+		 * Runs the loading of the file (called by the thread pool).
+		 */
+		void run();
+
+		/**
+		 * Requests the cancellation of the task. The task will stop as soon
+		 * as the current line is processed.
+		 */
+		void cancel();
+
+		/**
+		 * Indicates if the cancellation of the task has been requested.
+		 * @return Boolean indicating if the task is cancelled (true) or not (false).
+		 */
+		bool isCancelled() const;
+
+		/**
+		 * Gets the name of the file loaded by this task.
+		 * @return QString with the name of the landmarks CSV file.
+		 */
+		QString fileName() const;
+
+	signals:
+
+		/**
+		 * Indicates that a new chunk of frames has been loaded.
+		 * @param mLandmarks LandmarksMap with the landmarks of the frames loaded.
+		 */
+		void landmarksLoaded(const LandmarksMap &mLandmarks);
+
+		/**
+		 * Indicates the progress of the loading.
+		 * @param iProgress Integer with the progress in range [0, 100].
+		 */
+		void loadProgress(int iProgress);
+
+		/**
+		 * Indicates that the task has finished.
+		 * @param bCompleted Boolean indicating if the whole file has been loaded
+		 * (true) or if the task failed or was cancelled (false).
+		 */
+		void finished(bool bCompleted);
+
+	private:
+
+		/** Name of the landmarks CSV file. */
+		QString m_sFileName;
+
+		/** Flag indicating that the cancellation of the task has been requested. */
+		QAtomicInt m_oCancelRequested;
+	};
+}
+
+Q_DECLARE_METATYPE(fsdk::LandmarksMap);
+
+#endif // LANDMARKSLOADER_H
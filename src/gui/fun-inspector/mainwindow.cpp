@@ -19,7 +19,7 @@
 
 #include "mainwindow.h"
 #include "application.h"
-#include "csirofacetracker.h"
+#include "facetrackerregistry.h"
 #include <QMenuBar>
 #include <QStatusBar>
 #include <QDesktopServices>
@@ -56,6 +56,8 @@ fsdk::MainWindow::MainWindow(QWidget *pParent) :
 	connect(m_pSessionData, &Session::playerFileChanged, m_pPlayerWindow, &PlayerWindow::setVideoFile);
 	connect(m_pSessionData, &Session::landmarksFileChanged, m_pPlayerWindow, &PlayerWindow::landmarksFileChanged);
 	connect(m_pSessionData, &Session::gameplayFileChanged, m_pGameplayWindow, &VideoWindow::setVideoFile);
+	connect(m_pSessionData, &Session::landmarksFileChanged, m_pPlotWindow, &PlotWindow::landmarksFileChanged);
+	connect(m_pSessionData, &Session::gaborFileChanged, m_pPlotWindow, &PlotWindow::gaborFileChanged);
 
 	// Installs activation event filters
 	m_pPlayerWindow->installEventFilter(this);
@@ -68,6 +70,11 @@ fsdk::MainWindow::MainWindow(QWidget *pParent) :
 	// Connections to allow the user seeking through the videos
 	connect(m_pPlayerWindow, &PlayerWindow::seek, m_pMediaSync, &MediaSynchronizer::seek);
 	connect(m_pGameplayWindow, &VideoWindow::seek, m_pMediaSync, &MediaSynchronizer::seek);
+	connect(m_pPlotWindow, &PlotWindow::seek, m_pMediaSync, &MediaSynchronizer::seek);
+
+	// Connections to allow the plots to follow the playback
+	connect(m_pMediaSync, &MediaSynchronizer::positionChanged, m_pPlotWindow, &PlotWindow::setPosition);
+	connect(m_pPlayerWindow, &VideoWindow::frameRateChanged, m_pPlotWindow, &PlotWindow::setFrameRate);
 }
 
 // +-----------------------------------------------------------
@@ -85,10 +92,17 @@ void fsdk::MainWindow::setupUI()
 	m_pSessionExplorer->setObjectName("sessionExplorer");
 	addDockWidget(Qt::LeftDockWidgetArea, m_pSessionExplorer, Qt::Horizontal);
 
+	//-------------------------------
+	// Plot window
+	//-------------------------------
+	m_pPlotWindow = new PlotWindow(this);
+	m_pPlotWindow->setObjectName("plotWindow");
+	addDockWidget(Qt::BottomDockWidgetArea, m_pPlotWindow, Qt::Horizontal);
+
 	//-------------------------------
 	// Video windows
 	//-------------------------------
-	m_pPlayerWindow = new PlayerWindow(CSIROFaceTracker::landmarksCount(), this);
+	m_pPlayerWindow = new PlayerWindow(FaceTrackerRegistry::backend()->landmarksCount(), this);
 	m_pPlayerWindow->setWindowIcon(QIcon(":/icons/player-window.png"));
 	m_pPlayerWindow->setObjectName("playerWindow");
 	static_cast<QMdiArea*>(centralWidget())->addSubWindow(m_pPlayerWindow);
@@ -143,6 +157,7 @@ void fsdk::MainWindow::setupUI()
 	m_pSessionFilesMenu->addMenu(m_pSessionExplorer->gameplayFileMenu());
 	m_pSessionFilesMenu->addSeparator();
 	m_pSessionFilesMenu->addMenu(m_pSessionExplorer->landmarksFileMenu());
+	m_pSessionFilesMenu->addMenu(m_pSessionExplorer->gaborFileMenu());
 
 	m_pSessionMenu->addSeparator();
 
@@ -182,6 +197,9 @@ void fsdk::MainWindow::setupUI()
 	// Action for the view of the gameplay window
 	m_pViewWindowsMenu->addMenu(m_pGameplayWindow->actionsMenu());
 
+	// Action for the view of the plot window
+	m_pViewWindowsMenu->addAction(m_pPlotWindow->toggleViewAction());
+
 	// Separator
 	m_pViewWindowsMenu->addSeparator();
 
@@ -220,6 +238,7 @@ void fsdk::MainWindow::setupUI()
 void fsdk::MainWindow::refreshUI()
 {
 	m_pSessionExplorer->refreshUI();
+	m_pPlotWindow->refreshUI();
 
 	//-------------------------------
 	// Video windows
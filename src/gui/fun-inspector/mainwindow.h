@@ -23,6 +23,7 @@
 #include "videowindow.h"
 #include "playerwindow.h"
 #include "sessionexplorer.h"
+#include "plotwindow.h"
 #include "session.h"
 #include "mediasynchronizer.h"
 #include <QMainWindow>
@@ -186,6 +187,9 @@ namespace fsdk
 		/** Window that displays the session explorer. */
 		SessionExplorer *m_pSessionExplorer;
 
+		/** Window that displays the plots of the session data. */
+		PlotWindow *m_pPlotWindow;
+
 		//-------------------------------
 		// Sub windows
 		//-------------------------------
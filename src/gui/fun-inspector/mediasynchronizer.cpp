@@ -19,6 +19,10 @@
 
 #include "mediasynchronizer.h"
 
+// Interval (in milliseconds) of the indications of position changes
+// (the default of one second is too coarse for following the playback)
+#define POSITION_NOTIFY_INTERVAL 40
+
 // +-----------------------------------------------------------
 fsdk::MediaSynchronizer::MediaSynchronizer(QObject *pParent) : QObject(pParent)
 {
@@ -66,6 +70,7 @@ void fsdk::MediaSynchronizer::add(QMediaPlayer *pMediaPlayer)
 	connect(pMediaPlayer, &QMediaPlayer::stateChanged, this, &MediaSynchronizer::onStateChanged);
 	connect(pMediaPlayer, &QMediaPlayer::currentMediaChanged, this, &MediaSynchronizer::onCurrentMediaChanged);
 	connect(pMediaPlayer, &QMediaPlayer::positionChanged, this, &MediaSynchronizer::onPositionChanged);
+	pMediaPlayer->setNotifyInterval(POSITION_NOTIFY_INTERVAL);
 	m_lMediaPlayers.push_back(pMediaPlayer);
 }
 
@@ -194,7 +199,17 @@ void fsdk::MediaSynchronizer::onCurrentMediaChanged(const QMediaContent &oMedia)
 // +-----------------------------------------------------------
 void fsdk::MediaSynchronizer::onPositionChanged(qint64 iPosition)
 {
-
+	// Report only the position of the first media player with a media
+	// loaded, to avoid duplicated indications
+	foreach(QMediaPlayer *pMediaPlayer, m_lMediaPlayers)
+	{
+		if(!pMediaPlayer->media().isNull())
+		{
+			if(pMediaPlayer == sender())
+				emit positionChanged(iPosition);
+			break;
+		}
+	}
 }
 
 // +-----------------------------------------------------------
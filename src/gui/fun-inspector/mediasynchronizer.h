@@ -75,6 +75,14 @@ namespace fsdk
 			 */
 			void stateChanged(QMediaPlayer::State eState);
 
+			/**
+			 * Signal indicating changes in the playback position (reported by
+			 * the first media player with a media loaded, since all of them are
+			 * kept in sync).
+			 * @param iPosition Long integer with the position in milliseconds.
+			 */
+			void positionChanged(qint64 iPosition);
+
 		protected slots :
 
 			/**
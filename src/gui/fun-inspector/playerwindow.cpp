@@ -19,6 +19,8 @@
 
 #include "playerwindow.h"
 #include "csvfile.h"
+#include <QThreadPool>
+#include <QStyle>
 
 // +-----------------------------------------------------------
 fsdk::PlayerWindow::PlayerWindow(int iLandmarks, QWidget *pParent) :
@@ -31,19 +33,62 @@ fsdk::PlayerWindow::PlayerWindow(int iLandmarks, QWidget *pParent) :
 		m_pVideoWidget->scene()->addItem(pLandmark);
 		pLandmark->setVisible(false);
 	}
+
+	m_pLoader = NULL;
+
+	m_pLoadProgress = new QProgressBar(this);
+	m_pLoadProgress->setRange(0, 100);
+	m_pLoadProgress->setMaximumWidth(150);
+	m_pLoadProgress->setFormat(tr("Landmarks: %p%"));
+	m_pLoadProgressAction = m_pToolbar->addWidget(m_pLoadProgress);
+
+	m_pCancelLoadAction = m_pToolbar->addAction(style()->standardIcon(QStyle::SP_DialogCancelButton), tr("Cancel loading"));
+	m_pCancelLoadAction->setStatusTip(tr("Cancels the loading of the landmarks file"));
+	connect(m_pCancelLoadAction, &QAction::triggered, this, &PlayerWindow::cancelLoading);
+
+	setLoadingVisible(false);
+}
+
+// +-----------------------------------------------------------
+fsdk::PlayerWindow::~PlayerWindow()
+{
+	stopLoader();
 }
 
 // +-----------------------------------------------------------
 void fsdk::PlayerWindow::mediaPositionChanged(qint64 iPosition)
 {
 	VideoWindow::mediaPositionChanged(iPosition);
+
+	// While scrubbing, the landmarks are the ones of the position scrubbed
+	if(!isScrubbing())
+		updateLandmarks(iPosition);
+}
+
+// +-----------------------------------------------------------
+void fsdk::PlayerWindow::scrubbed(qint64 iPosition)
+{
+	VideoWindow::scrubbed(iPosition);
+	updateLandmarks(iPosition);
+}
+
+// +-----------------------------------------------------------
+void fsdk::PlayerWindow::updateLandmarks(qint64 iPosition)
+{
 	if(!m_mData.isEmpty())
 	{
-		int iFPS = 30;
-		int iFrame = iFPS * (iPosition / 1000);
-		QList<QPoint> lPositions = m_mData[iFrame];
+		qint64 iFrame = qRound64(iPosition * frameRate() / 1000.0);
+		QList<QPoint> lPositions = m_mData.value(iFrame);
+
+		// The frame might not be loaded yet
+		if(lPositions.isEmpty())
+		{
+			if(landmarksVisible())
+				setLandmarksVisible(false);
+			return;
+		}
 		
-		for(int i = 0; i <= m_lLandmarks.count(); i++)
+		for(int i = 0; i < m_lLandmarks.count(); i++)
 		{
 			if(i >= lPositions.count())
 				break;
@@ -59,38 +104,86 @@ void fsdk::PlayerWindow::mediaPositionChanged(qint64 iPosition)
 // +-----------------------------------------------------------
 void fsdk::PlayerWindow::landmarksFileChanged(const QString sFileName)
 {
+	stopLoader();
+	m_mData.clear();
+	setLandmarksVisible(false);
+
 	if(sFileName.isEmpty())
+		return;
+
+	// Load the file in background, so the video can be played meanwhile
+	// and the landmarks are displayed as soon as their frames are read
+	m_pLoader = new LandmarksLoader(sFileName);
+	connect(m_pLoader, &LandmarksLoader::landmarksLoaded, this, &PlayerWindow::landmarksLoaded);
+	connect(m_pLoader, &LandmarksLoader::loadProgress, this, &PlayerWindow::loadProgress);
+	connect(m_pLoader, &LandmarksLoader::finished, this, &PlayerWindow::loadFinished);
+	connect(m_pLoader, &LandmarksLoader::finished, m_pLoader, &LandmarksLoader::deleteLater);
+
+	m_pLoadProgress->setValue(0);
+	setLoadingVisible(true);
+	QThreadPool::globalInstance()->start(m_pLoader);
+}
+
+// +-----------------------------------------------------------
+void fsdk::PlayerWindow::cancelLoading()
+{
+	stopLoader();
+	setLoadingVisible(false);
+}
+
+// +-----------------------------------------------------------
+void fsdk::PlayerWindow::stopLoader()
+{
+	if(m_pLoader)
 	{
-		m_mData.clear();
-		setLandmarksVisible(false);
+		// The loader deletes itself when it finishes running
+		disconnect(m_pLoader, 0, this, 0);
+		m_pLoader->cancel();
+		m_pLoader = NULL;
 	}
-	else
-	{
-		CSVFile oFile(sFileName);
-		if(!oFile.read())
-		{
-			qWarning().noquote() << "Could not load the landmarks CSV file: " << sFileName;
-			return;
-		}
+}
 
-		QList<QStringList> lLines = oFile.lines();
+// +-----------------------------------------------------------
+void fsdk::PlayerWindow::landmarksLoaded(const LandmarksMap &mLandmarks)
+{
+	// Ignore signals already queued by a cancelled loader
+	if(sender() != m_pLoader)
+		return;
 
-		QMap<qint64, QList<QPoint>> mData;
-		foreach(QStringList lLine, lLines)
-		{
-			int iFrame = lLine[0].toInt();
-			QList<QPoint> lData;
-			for(int i = 2; i < lLine.count() - 1; i += 2)
-			{
-				QPoint oMark(lLine[i].toInt(), lLine[i + 1].toInt());
-				lData.push_back(oMark);
-			}
-			mData[iFrame] = lData;
-		}
+	LandmarksMap::const_iterator it;
+	for(it = mLandmarks.constBegin(); it != mLandmarks.constEnd(); ++it)
+		m_mData.insert(it.key(), it.value());
 
-		m_mData.clear();
-		m_mData = mData;
-	}
+	updateLandmarks(mediaPlayer()->position());
+}
+
+// +-----------------------------------------------------------
+void fsdk::PlayerWindow::loadProgress(int iProgress)
+{
+	if(sender() != m_pLoader)
+		return;
+
+	m_pLoadProgress->setValue(iProgress);
+}
+
+// +-----------------------------------------------------------
+void fsdk::PlayerWindow::loadFinished(bool bCompleted)
+{
+	if(sender() != m_pLoader)
+		return;
+
+	if(!bCompleted)
+		qWarning().noquote() << "The landmarks file was not completely loaded: " << m_pLoader->fileName();
+
+	m_pLoader = NULL;
+	setLoadingVisible(false);
+}
+
+// +-----------------------------------------------------------
+void fsdk::PlayerWindow::setLoadingVisible(bool bVisible)
+{
+	m_pLoadProgressAction->setVisible(bVisible);
+	m_pCancelLoadAction->setVisible(bVisible);
 }
 
 // +-----------------------------------------------------------
@@ -22,7 +22,9 @@
 
 #include "videowindow.h"
 #include "landmarkwidget.h"
+#include "landmarksloader.h"
 #include <QList>
+#include <QProgressBar>
 
 namespace fsdk
 {
@@ -42,6 +44,11 @@ namespace fsdk
          */
 		PlayerWindow(int iLandmarks, QWidget *pParent);
 
+		/**
+		 * Class destructor.
+		 */
+		virtual ~PlayerWindow();
+
 	public slots:
 
 		/**
@@ -51,6 +58,33 @@ namespace fsdk
 		 */
 		void landmarksFileChanged(const QString sFileName);
 
+		/**
+		 * Cancels the loading of the landmarks file (the frames already
+		 * loaded are kept).
+		 */
+		void cancelLoading();
+
+	protected slots:
+
+		/**
+		 * Captures the indication that a chunk of landmarks has been loaded.
+		 * @param mLandmarks LandmarksMap with the landmarks of the frames loaded.
+		 */
+		void landmarksLoaded(const LandmarksMap &mLandmarks);
+
+		/**
+		 * Captures the indication of progress in the loading of landmarks.
+		 * @param iProgress Integer with the progress in range [0, 100].
+		 */
+		void loadProgress(int iProgress);
+
+		/**
+		 * Captures the indication that the loading of landmarks has finished.
+		 * @param bCompleted Boolean indicating if the whole file has been loaded
+		 * (true) or not (false).
+		 */
+		void loadFinished(bool bCompleted);
+
 	protected:
 
 		/**
@@ -60,17 +94,57 @@ namespace fsdk
 		 */
 		void mediaPositionChanged(qint64 iPosition);
 
+		/**
+		 * Handles the scrubbing of the video timeline, so the landmarks
+		 * are updated along with the thumbnail displayed.
+		 * @param iPosition Long integer with the scrubbed position in
+		 * milliseconds.
+		 */
+		void scrubbed(qint64 iPosition);
+
+		/**
+		 * Updates the landmarks displayed to the ones of the frame in the
+		 * given position.
+		 * @param iPosition Long integer with the position expressed
+		 * in milliseconds.
+		 */
+		void updateLandmarks(qint64 iPosition);
+
 		bool landmarksVisible() const;
 
 		void setLandmarksVisible(bool bVisible);
 
+		/**
+		 * Stops the loading of landmarks in execution (if any).
+		 */
+		void stopLoader();
+
+		/**
+		 * Shows or hides the indication of progress in the loading of landmarks.
+		 * @param bVisible Boolean indicating if the progress is visible (true)
+		 * or not (false).
+		 */
+		void setLoadingVisible(bool bVisible);
+
     private:
 
 		/** List of landmarks objects in the video widget. */
 		QList<LandmarkWidget*> m_lLandmarks;
 
 		/** Mapping of the landmarks data for each frame (read from the CSV). */
-		QMap<qint64, QList<QPoint>> m_mData;
+		LandmarksMap m_mData;
+
+		/** Task loading the landmarks file in background (or NULL if none). */
+		LandmarksLoader *m_pLoader;
+
+		/** Progress bar indicating the loading of the landmarks file. */
+		QProgressBar *m_pLoadProgress;
+
+		/** Toolbar action holding the progress bar (used to show/hide it). */
+		QAction *m_pLoadProgressAction;
+
+		/** Action to cancel the loading of the landmarks file. */
+		QAction *m_pCancelLoadAction;
     };
 }
 
@@ -0,0 +1,354 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "plotwindow.h"
+#include <QSplitter>
+#include <QVBoxLayout>
+#include <QThreadPool>
+#include <QResizeEvent>
+#include <QtMath>
+#include <QDebug>
+
+// Name of the plot layer where the cursor is drawn (it is buffered
+// separately, so following the playback does not redraw the graphs)
+#define CURSOR_LAYER "cursor"
+
+// Maximum distance (in pixels) for a press and release of the mouse
+// to be considered a click (instead of a drag)
+#define CLICK_TOLERANCE 3
+
+// +-----------------------------------------------------------
+fsdk::PlotWindow::PlotWindow(QWidget *pParent) :
+	QDockWidget("", pParent)
+{
+	m_dFrameRate = 30;
+	setupUI();
+	refreshUI();
+}
+
+// +-----------------------------------------------------------
+fsdk::PlotWindow::~PlotWindow()
+{
+	stopLoader(SeriesLoader::LandmarksSource);
+	stopLoader(SeriesLoader::GaborSource);
+}
+
+// +-----------------------------------------------------------
+void fsdk::PlotWindow::setupUI()
+{
+	QSplitter *pSplitter = new QSplitter(Qt::Horizontal, this);
+	setWidget(pSplitter);
+
+	m_pSeriesList = new QListWidget(pSplitter);
+	pSplitter->addWidget(m_pSeriesList);
+	connect(m_pSeriesList, &QListWidget::itemChanged, this, &PlotWindow::seriesToggled);
+
+	QWidget *pPlotArea = new QWidget(pSplitter);
+	QVBoxLayout *pLayout = new QVBoxLayout(pPlotArea);
+	pLayout->setContentsMargins(0, 0, 0, 0);
+	pSplitter->addWidget(pPlotArea);
+	pSplitter->setStretchFactor(1, 1);
+
+	m_pPlot = new QCustomPlot(pPlotArea);
+	pLayout->addWidget(m_pPlot, 1);
+
+	m_pSummaryLabel = new QLabel(pPlotArea);
+	m_pSummaryLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+	pLayout->addWidget(m_pSummaryLabel);
+
+	// Only the keys axis (frames) can be zoomed and dragged
+	m_pPlot->setInteractions(QCP::iRangeDrag | QCP::iRangeZoom);
+	m_pPlot->axisRect()->setRangeDrag(Qt::Horizontal);
+	m_pPlot->axisRect()->setRangeZoom(Qt::Horizontal);
+	m_pPlot->legend->setVisible(false);
+	m_pPlot->installEventFilter(this);
+
+	connect(m_pPlot->xAxis, static_cast<void (QCPAxis::*)(const QCPRange &)>(&QCPAxis::rangeChanged), this, &PlotWindow::rangeChanged);
+	connect(m_pPlot, &QCustomPlot::mousePress, this, &PlotWindow::plotMousePress);
+	connect(m_pPlot, &QCustomPlot::mouseRelease, this, &PlotWindow::plotMouseRelease);
+
+	m_pPlot->addLayer(CURSOR_LAYER, m_pPlot->layer("main"), QCustomPlot::limAbove);
+	m_pPlot->layer(CURSOR_LAYER)->setMode(QCPLayer::lmBuffered);
+
+	m_pCursor = new QCPItemStraightLine(m_pPlot);
+	m_pCursor->setLayer(CURSOR_LAYER);
+	m_pCursor->setPen(QPen(QColor(217, 100, 89), 2));
+	m_pCursor->point1->setCoords(0, 0);
+	m_pCursor->point2->setCoords(0, 1);
+}
+
+// +-----------------------------------------------------------
+void fsdk::PlotWindow::refreshUI()
+{
+	setWindowTitle(tr("Plots"));
+	m_pPlot->xAxis->setLabel(tr("Frame"));
+}
+
+// +-----------------------------------------------------------
+void fsdk::PlotWindow::landmarksFileChanged(const QString sFileName)
+{
+	loadSeries(sFileName, SeriesLoader::LandmarksSource);
+}
+
+// +-----------------------------------------------------------
+void fsdk::PlotWindow::gaborFileChanged(const QString sFileName)
+{
+	loadSeries(sFileName, SeriesLoader::GaborSource);
+}
+
+// +-----------------------------------------------------------
+void fsdk::PlotWindow::loadSeries(const QString &sFileName, SeriesLoader::SourceType eType)
+{
+	stopLoader(eType);
+	m_mSeries.remove(eType);
+	rebuildGraphs();
+
+	if(sFileName.isEmpty())
+		return;
+
+	SeriesLoader *pLoader = new SeriesLoader(sFileName, eType);
+	connect(pLoader, &SeriesLoader::seriesLoaded, this, &PlotWindow::seriesLoaded);
+	connect(pLoader, &SeriesLoader::seriesLoaded, pLoader, &SeriesLoader::deleteLater);
+	m_mLoaders[eType] = pLoader;
+	QThreadPool::globalInstance()->start(pLoader);
+}
+
+// +-----------------------------------------------------------
+void fsdk::PlotWindow::stopLoader(SeriesLoader::SourceType eType)
+{
+	SeriesLoader *pLoader = m_mLoaders.take(eType);
+	if(pLoader)
+	{
+		// The loader deletes itself when it finishes running
+		disconnect(pLoader, 0, this, 0);
+		pLoader->cancel();
+	}
+}
+
+// +-----------------------------------------------------------
+void fsdk::PlotWindow::seriesLoaded(const TimeSeriesList &lSeries)
+{
+	SeriesLoader *pLoader = static_cast<SeriesLoader*>(sender());
+	SeriesLoader::SourceType eType = pLoader->sourceType();
+
+	// Ignore signals already queued by a cancelled loader
+	if(m_mLoaders.value(eType) != pLoader)
+		return;
+	m_mLoaders.remove(eType);
+
+	m_mSeries[eType] = lSeries;
+	rebuildGraphs();
+}
+
+// +-----------------------------------------------------------
+void fsdk::PlotWindow::rebuildGraphs()
+{
+	// Keep the selection of the series already displayed
+	QMap<QString, bool> mVisible;
+	for(int i = 0; i < m_pSeriesList->count(); i++)
+		mVisible[m_pSeriesList->item(i)->text()] = m_pSeriesList->item(i)->checkState() == Qt::Checked;
+
+	m_pPlot->clearGraphs();
+	m_lGraphs.clear();
+	m_lSeries = m_mSeries.value(SeriesLoader::LandmarksSource) + m_mSeries.value(SeriesLoader::GaborSource);
+
+	m_pSeriesList->blockSignals(true);
+	m_pSeriesList->clear();
+
+	bool bKeys = false;
+	double dMinKey = 0, dMaxKey = 0;
+	for(int i = 0; i < m_lSeries.count(); i++)
+	{
+		const TimeSeries &oSeries = m_lSeries[i];
+
+		// Decimation is done here, so the plot does not need to do it again
+		QCPGraph *pGraph = m_pPlot->addGraph();
+		pGraph->setName(oSeries.name());
+		pGraph->setAdaptiveSampling(false);
+		pGraph->setPen(QPen(QColor::fromHsv((i * 47) % 360, 200, 200)));
+
+		// By default, only the first series is visible (the series have very
+		// different scales)
+		bool bVisible = mVisible.value(oSeries.name(), i == 0);
+		pGraph->setVisible(bVisible);
+		m_lGraphs.append(pGraph);
+
+		QListWidgetItem *pItem = new QListWidgetItem(oSeries.name(), m_pSeriesList);
+		pItem->setFlags(pItem->flags() | Qt::ItemIsUserCheckable);
+		pItem->setCheckState(bVisible ? Qt::Checked : Qt::Unchecked);
+		pItem->setForeground(pGraph->pen().color());
+
+		if(oSeries.count() > 0)
+		{
+			dMinKey = bKeys ? qMin(dMinKey, oSeries.keys().first()) : oSeries.keys().first();
+			dMaxKey = bKeys ? qMax(dMaxKey, oSeries.keys().last()) : oSeries.keys().last();
+			bKeys = true;
+		}
+	}
+	m_pSeriesList->blockSignals(false);
+
+	// Setting the range also updates the graphs (via rangeChanged)
+	if(dMaxKey > dMinKey)
+		m_pPlot->xAxis->setRange(dMinKey, dMaxKey);
+	else
+		updateGraphs();
+	rescaleValues();
+}
+
+// +-----------------------------------------------------------
+void fsdk::PlotWindow::updateGraphs()
+{
+	QCPRange oRange = m_pPlot->xAxis->range();
+	int iColumns = qMax(m_pPlot->axisRect()->width(), 1);
+
+	QVector<double> vKeys, vValues;
+	for(int i = 0; i < m_lGraphs.count(); i++)
+	{
+		if(!m_lGraphs[i]->visible())
+		{
+			m_lGraphs[i]->data()->clear();
+			continue;
+		}
+
+		m_lSeries[i].decimate(oRange.lower, oRange.upper, iColumns, vKeys, vValues);
+		m_lGraphs[i]->setData(vKeys, vValues, true);
+	}
+
+	m_pPlot->replot();
+	updateSummary();
+}
+
+// +-----------------------------------------------------------
+void fsdk::PlotWindow::updateSummary()
+{
+	QCPRange oRange = m_pPlot->xAxis->range();
+	QStringList lSummaries;
+	for(int i = 0; i < m_lGraphs.count(); i++)
+	{
+		if(!m_lGraphs[i]->visible())
+			continue;
+
+		SignalSummary oSummary = m_lSeries[i].summary(oRange.lower, oRange.upper);
+		if(oSummary.isEmpty())
+			continue;
+
+		lSummaries.append(tr("%1: mean %2 (min %3, max %4)").arg(m_lSeries[i].name())
+			.arg(oSummary.mean(), 0, 'g', 4).arg(oSummary.minimum(), 0, 'g', 4).arg(oSummary.maximum(), 0, 'g', 4));
+	}
+
+	if(lSummaries.isEmpty())
+		m_pSummaryLabel->clear();
+	else
+		m_pSummaryLabel->setText(tr("Frames %1 to %2 - %3").arg(qMax(qCeil(oRange.lower), 0)).arg(qFloor(oRange.upper)).arg(lSummaries.join("; ")));
+}
+
+// +-----------------------------------------------------------
+void fsdk::PlotWindow::rescaleValues()
+{
+	bool bFound = false;
+	double dMin = 0, dMax = 1;
+	for(int i = 0; i < m_lSeries.count(); i++)
+	{
+		if(!m_lGraphs[i]->visible() || m_lSeries[i].count() == 0)
+			continue;
+
+		const TimeSeries &oSeries = m_lSeries[i];
+		SignalSummary oSummary = oSeries.summary(oSeries.keys().first(), oSeries.keys().last());
+		if(oSummary.isEmpty())
+			continue;
+
+		dMin = bFound ? qMin(dMin, double(oSummary.minimum())) : oSummary.minimum();
+		dMax = bFound ? qMax(dMax, double(oSummary.maximum())) : oSummary.maximum();
+		bFound = true;
+	}
+
+	double dMargin = (dMax - dMin) * 0.05;
+	if(dMargin == 0)
+		dMargin = 0.5;
+	m_pPlot->yAxis->setRange(dMin - dMargin, dMax + dMargin);
+	m_pPlot->replot();
+}
+
+// +-----------------------------------------------------------
+void fsdk::PlotWindow::rangeChanged(const QCPRange &oRange)
+{
+	Q_UNUSED(oRange);
+	updateGraphs();
+}
+
+// +-----------------------------------------------------------
+void fsdk::PlotWindow::seriesToggled(QListWidgetItem *pItem)
+{
+	int iIndex = m_pSeriesList->row(pItem);
+	if(iIndex < 0 || iIndex >= m_lGraphs.count())
+		return;
+
+	m_lGraphs[iIndex]->setVisible(pItem->checkState() == Qt::Checked);
+	updateGraphs();
+	rescaleValues();
+}
+
+// +-----------------------------------------------------------
+void fsdk::PlotWindow::setFrameRate(double dFrameRate)
+{
+	if(dFrameRate > 0)
+		m_dFrameRate = dFrameRate;
+}
+
+// +-----------------------------------------------------------
+void fsdk::PlotWindow::setPosition(qint64 iPosition)
+{
+	double dFrame = iPosition * m_dFrameRate / 1000.0;
+	m_pCursor->point1->setCoords(dFrame, 0);
+	m_pCursor->point2->setCoords(dFrame, 1);
+
+	// If the cursor left the visible range, scroll the plot to follow it
+	// (this also replots the graphs); otherwise, only the cursor layer is
+	// replotted
+	QCPRange oRange = m_pPlot->xAxis->range();
+	if(!m_lGraphs.isEmpty() && !oRange.contains(dFrame))
+		m_pPlot->xAxis->setRange(dFrame - oRange.size() * 0.1, dFrame + oRange.size() * 0.9);
+	else
+		m_pPlot->layer(CURSOR_LAYER)->replot();
+}
+
+// +-----------------------------------------------------------
+void fsdk::PlotWindow::plotMousePress(QMouseEvent *pEvent)
+{
+	m_oPressPos = pEvent->pos();
+}
+
+// +-----------------------------------------------------------
+void fsdk::PlotWindow::plotMouseRelease(QMouseEvent *pEvent)
+{
+	if(pEvent->button() != Qt::LeftButton || (pEvent->pos() - m_oPressPos).manhattanLength() > CLICK_TOLERANCE)
+		return;
+
+	double dFrame = m_pPlot->xAxis->pixelToCoord(pEvent->pos().x());
+	emit seek(qMax(static_cast<qint64>(dFrame * 1000.0 / m_dFrameRate), static_cast<qint64>(0)));
+}
+
+// +-----------------------------------------------------------
+bool fsdk::PlotWindow::eventFilter(QObject *pObject, QEvent *pEvent)
+{
+	// The decimation depends on the width of the plot
+	if(pObject == m_pPlot && pEvent->type() == QEvent::Resize)
+		QMetaObject::invokeMethod(this, "updateGraphs", Qt::QueuedConnection);
+	return false;
+}
@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PLOTWINDOW_H
+#define PLOTWINDOW_H
+
+#include "timeseries.h"
+#include "seriesloader.h"
+#include "qcustomplot.h"
+#include <QDockWidget>
+#include <QListWidget>
+#include <QLabel>
+
+namespace fsdk
+{
+	/**
+	 * Dockable window that plots time series of the session (tracking
+	 * quality, measures derived from the facial landmarks and Gabor
+	 * energies), with a cursor that follows the playback of the videos.
+	 */
+	class PlotWindow : public QDockWidget
+	{
+		Q_OBJECT
+
+	public:
+		/**
+		 * Class constructor.
+		 * @param pParent QWidget with the window parent.
+		 */
+		PlotWindow(QWidget *pParent = 0);
+
+		/**
+		 * Class destructor.
+		 */
+		virtual ~PlotWindow();
+
+	signals:
+
+		/**
+		 * Signal indicating that the user clicked the plot to seek the
+		 * videos to the given position.
+		 * @param iValue Long integer with the seeked position in miliseconds.
+		 */
+		void seek(qint64 iValue);
+
+	public slots:
+
+		/**
+		 * Refreshes the text in UI elements (so translation changes
+		 * can be applied).
+		 */
+		void refreshUI();
+
+		/**
+		 * Captures the signal indicating updates in the landmarks file.
+		 * @param sFileName QString with the name of the landmarks file
+		 * in the session (empty if no file has been assigned to the session).
+		 */
+		void landmarksFileChanged(const QString sFileName);
+
+		/**
+		 * Captures the signal indicating updates in the Gabor energies file.
+		 * @param sFileName QString with the name of the Gabor energies file
+		 * in the session (empty if no file has been assigned to the session).
+		 */
+		void gaborFileChanged(const QString sFileName);
+
+		/**
+		 * Moves the cursor to the given playback position.
+		 * @param iPosition Long integer with the position in milliseconds.
+		 */
+		void setPosition(qint64 iPosition);
+
+		/**
+		 * Sets the frame rate of the videos, used to convert between frame
+		 * indexes and playback positions.
+		 * @param dFrameRate Double with the frame rate in frames per second.
+		 */
+		void setFrameRate(double dFrameRate);
+
+	protected slots:
+
+		/**
+		 * Captures the indication that a loader has finished.
+		 * @param lSeries TimeSeriesList with the series loaded.
+		 */
+		void seriesLoaded(const TimeSeriesList &lSeries);
+
+		/**
+		 * Captures changes in the range of the keys axis (due to zoom or
+		 * panning), so the graphs are decimated again.
+		 * @param oRange QCPRange with the new range.
+		 */
+		void rangeChanged(const QCPRange &oRange);
+
+		/**
+		 * Captures changes in the selection of the series to display.
+		 * @param pItem QListWidgetItem of the series changed.
+		 */
+		void seriesToggled(QListWidgetItem *pItem);
+
+		/**
+		 * Captures presses of the mouse in the plot.
+		 * @param pEvent QMouseEvent with the event data.
+		 */
+		void plotMousePress(QMouseEvent *pEvent);
+
+		/**
+		 * Captures releases of the mouse in the plot (clicks without dragging
+		 * seek the videos).
+		 * @param pEvent QMouseEvent with the event data.
+		 */
+		void plotMouseRelease(QMouseEvent *pEvent);
+
+		/**
+		 * Updates the data of the visible graphs with the decimation of
+		 * their series for the current range and width of the plot.
+		 */
+		void updateGraphs();
+
+	protected:
+
+		/**
+		 * Sets up the UI elements.
+		 */
+		void setupUI();
+
+		/**
+		 * Captures resizing of the plot to decimate the graphs again.
+		 * @param pObject QObject that received the event.
+		 * @param pEvent QEvent with the event data.
+		 * @return Boolean indicating if the event was handled (always false).
+		 */
+		bool eventFilter(QObject *pObject, QEvent *pEvent);
+
+		/**
+		 * Starts loading the series from the given file.
+		 * @param sFileName QString with the name of the file (if empty, the
+		 * series of that type are just removed).
+		 * @param eType Value of the SeriesLoader::SourceType enum with the type
+		 * of the file.
+		 */
+		void loadSeries(const QString &sFileName, SeriesLoader::SourceType eType);
+
+		/**
+		 * Stops the loading of series from a type of file (if running).
+		 * @param eType Value of the SeriesLoader::SourceType enum with the type
+		 * of the file.
+		 */
+		void stopLoader(SeriesLoader::SourceType eType);
+
+		/**
+		 * Recreates all graphs from the series available.
+		 */
+		void rebuildGraphs();
+
+		/**
+		 * Rescales the values axis to fit the visible series.
+		 */
+		void rescaleValues();
+
+		/**
+		 * Updates the label with the summary of the visible series in the
+		 * current range of frames.
+		 */
+		void updateSummary();
+
+	private:
+
+		/** Plot widget. */
+		QCustomPlot *m_pPlot;
+
+		/** Label with the summary of the visible series in the current range. */
+		QLabel *m_pSummaryLabel;
+
+		/** List used to select the series to display. */
+		QListWidget *m_pSeriesList;
+
+		/** Cursor indicating the playback position in the plot. */
+		QCPItemStraightLine *m_pCursor;
+
+		/** Series loaded from each type of file. */
+		QMap<SeriesLoader::SourceType, TimeSeriesList> m_mSeries;
+
+		/** All series displayed (in the same order of the graphs). */
+		TimeSeriesList m_lSeries;
+
+		/** Graphs of the series. */
+		QList<QCPGraph*> m_lGraphs;
+
+		/** Loaders in execution for each type of file. */
+		QMap<SeriesLoader::SourceType, SeriesLoader*> m_mLoaders;
+
+		/** Frame rate of the videos. */
+		double m_dFrameRate;
+
+		/** Position of the last mouse press in the plot. */
+		QPoint m_oPressPos;
+	};
+}
+
+#endif // PLOTWINDOW_H
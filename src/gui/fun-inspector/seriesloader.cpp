@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "seriesloader.h"
+#include "csvfile.h"
+#include "facetrackerregistry.h"
+#include <QVector2D>
+#include <QPoint>
+#include <QFileInfo>
+#include <QDebug>
+#include <limits>
+
+// +-----------------------------------------------------------
+fsdk::SeriesLoader::SeriesLoader(const QString &sFileName, SourceType eType, const QString &sTrackerBackend)
+{
+	qRegisterMetaType<TimeSeriesList>("TimeSeriesList");
+	m_sFileName = sFileName;
+	m_eType = eType;
+	setAutoDelete(false);
+
+	// The landmarks used to derive the measures depend on the tracker model
+	m_iRightEye = m_iLeftEye = m_iUpperLip = m_iLowerLip = -1;
+	const FaceTrackerBackend *pBackend = FaceTrackerRegistry::backend(sTrackerBackend);
+	if(pBackend)
+	{
+		m_iRightEye = pBackend->landmarkIndex(FaceTracker::RightEyeOuterCorner);
+		m_iLeftEye = pBackend->landmarkIndex(FaceTracker::LeftEyeOuterCorner);
+		m_iUpperLip = pBackend->landmarkIndex(FaceTracker::UpperLipInner);
+		m_iLowerLip = pBackend->landmarkIndex(FaceTracker::LowerLipInner);
+	}
+}
+
+// +-----------------------------------------------------------
+void fsdk::SeriesLoader::cancel()
+{
+	m_oCancelRequested.testAndSetOrdered(0, 1);
+}
+
+// +-----------------------------------------------------------
+bool fsdk::SeriesLoader::isCancelled() const
+{
+	return static_cast<int>(m_oCancelRequested) == 1;
+}
+
+// +-----------------------------------------------------------
+fsdk::SeriesLoader::SourceType fsdk::SeriesLoader::sourceType() const
+{
+	return m_eType;
+}
+
+// +-----------------------------------------------------------
+void fsdk::SeriesLoader::run()
+{
+	CSVFile oFile(m_sFileName);
+	if(!oFile.beginRead())
+	{
+		qWarning().noquote() << "Could not load the series from file: " << m_sFileName;
+		emit seriesLoaded(TimeSeriesList());
+		return;
+	}
+
+	// The files of the extractions with gating have the column of the reused
+	// frames after the quality of the landmarks or after the frame of the
+	// energies (see LandmarksData::saveToCSV and GaborData::saveToCSV)
+	int iFirst;
+	if(m_eType == LandmarksSource)
+		iFirst = oFile.header().value(2) == "Reused" ? 3 : 2;
+	else
+		iFirst = oFile.header().value(1) == "Reused" ? 2 : 1;
+
+	TimeSeriesList lSeries;
+	if(m_eType == LandmarksSource)
+	{
+		lSeries.append(TimeSeries(tr("Tracking quality")));
+		lSeries.append(TimeSeries(tr("Face size (px)")));
+		lSeries.append(TimeSeries(tr("Mouth opening (face size ratio)")));
+	}
+	else
+	{
+		foreach(QString sLabel, oFile.header().mid(iFirst))
+			lSeries.append(TimeSeries(sLabel));
+	}
+
+	// The series loaded from the file share a single summary pyramid
+	QSharedPointer<SignalPyramid> pPyramid(new SignalPyramid(lSeries.count()));
+	bool bStored = loadPyramid(*pPyramid, lSeries.count());
+	int iLastFrame = -1;
+
+	QStringList lLine;
+	QList<float> lValues;
+	while(oFile.readNext(lLine))
+	{
+		if(isCancelled())
+		{
+			oFile.endRead();
+			emit seriesLoaded(TimeSeriesList());
+			return;
+		}
+
+		if(lLine.count() < 2)
+			continue;
+
+		lValues.clear();
+		if(m_eType == LandmarksSource)
+			addLandmarksRecord(lLine, lSeries, lValues, iFirst);
+		else
+		{
+			double dFrame = lLine[0].toDouble();
+			for(int i = iFirst; i < lLine.count() && i - iFirst < lSeries.count(); i++)
+			{
+				lSeries[i - iFirst].append(dFrame, lLine[i].toDouble());
+				lValues.append(lLine[i].toFloat());
+			}
+		}
+
+		iLastFrame = lLine[0].toInt();
+		if(!bStored)
+			pPyramid->append(iLastFrame, lValues);
+	}
+	oFile.endRead();
+
+	if(bStored && pPyramid->framesCount() != iLastFrame + 1)
+	{
+		qWarning().noquote() << "The summary pyramid does not match the file: " << m_sFileName;
+		pPyramid.clear();
+	}
+
+	for(int i = 0; i < lSeries.count() && pPyramid; i++)
+		lSeries[i].setPyramid(pPyramid, i);
+
+	emit seriesLoaded(lSeries);
+}
+
+// +-----------------------------------------------------------
+void fsdk::SeriesLoader::addLandmarksRecord(const QStringList &lLine, TimeSeriesList &lSeries, QList<float> &lValues, const int iFirst) const
+{
+	const float fNaN = std::numeric_limits<float>::quiet_NaN();
+	lValues = { fNaN, fNaN, fNaN };
+
+	double dFrame = lLine[0].toDouble();
+	lSeries[0].append(dFrame, lLine[1].toDouble());
+	lValues[0] = lLine[1].toFloat();
+
+	// Frames without landmarks (tracking failed) only have the quality, and
+	// so do all frames if the tracker does not provide the landmarks needed
+	int iPoints = (lLine.count() - iFirst) / 2;
+	if(qMin(qMin(m_iRightEye, m_iLeftEye), qMin(m_iUpperLip, m_iLowerLip)) < 0)
+		return;
+	if(iPoints <= qMax(qMax(m_iRightEye, m_iLeftEye), qMax(m_iUpperLip, m_iLowerLip)))
+		return;
+
+	QPoint oRightEye(lLine[iFirst + 2 * m_iRightEye].toInt(), lLine[iFirst + 1 + 2 * m_iRightEye].toInt());
+	QPoint oLeftEye(lLine[iFirst + 2 * m_iLeftEye].toInt(), lLine[iFirst + 1 + 2 * m_iLeftEye].toInt());
+	QPoint oUpperLip(lLine[iFirst + 2 * m_iUpperLip].toInt(), lLine[iFirst + 1 + 2 * m_iUpperLip].toInt());
+	QPoint oLowerLip(lLine[iFirst + 2 * m_iLowerLip].toInt(), lLine[iFirst + 1 + 2 * m_iLowerLip].toInt());
+
+	double dFaceSize = QVector2D(oLeftEye - oRightEye).length();
+	lSeries[1].append(dFrame, dFaceSize);
+	lValues[1] = dFaceSize;
+	if(dFaceSize > 0)
+	{
+		double dMouth = QVector2D(oLowerLip - oUpperLip).length() / dFaceSize;
+		lSeries[2].append(dFrame, dMouth);
+		lValues[2] = dMouth;
+	}
+}
+
+// +-----------------------------------------------------------
+bool fsdk::SeriesLoader::loadPyramid(SignalPyramid &oPyramid, const int iSignals) const
+{
+	// The pyramids stored with the landmarks files only summarize the quality,
+	// so they are used just for files whose series are stored as-is
+	QFileInfo oFile(SignalPyramid::fileName(m_sFileName));
+	if(m_eType != GaborSource || !oFile.exists() || oFile.lastModified() < QFileInfo(m_sFileName).lastModified())
+		return false;
+
+	SignalPyramid oStored;
+	if(!oStored.load(oFile.filePath()) || oStored.signalsCount() != iSignals)
+		return false;
+
+	oPyramid = oStored;
+	return true;
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SERIESLOADER_H
+#define SERIESLOADER_H
+
+#include "timeseries.h"
+#include <QObject>
+#include <QRunnable>
+#include <QAtomicInt>
+
+namespace fsdk
+{
+	/**
+	 * Background task that reads the time series to be plotted from an
+	 * annotation file of the session.
+	 */
+	class SeriesLoader : public QObject, public QRunnable
+	{
+		Q_OBJECT
+
+	public:
+
+		/**
+		 * Types of annotation files from which series can be loaded.
+		 */
+		enum SourceType
+		{
+			/** CSV with facial landmarks: produces the tracking quality and measures derived from the landmarks. */
+			LandmarksSource,
+
+			/** CSV with Gabor energies: produces one series per kernel of the bank. */
+			GaborSource
+		};
+
+		/**
+		 * Class constructor.
+		 * @param sFileName QString with the name of the annotation file.
+		 * @param eType Value of the SourceType enum with the type of the file.
+		 * @param sTrackerBackend QString with the name of the face tracker backend
+		 * that produced the landmarks (see FaceTrackerRegistry), used to find the
+		 * landmarks from which the measures are derived. If it is empty, the
+		 * default backend is used.
+		 */
+		SeriesLoader(const QString &sFileName, SourceType eType, const QString &sTrackerBackend = QString());
+
+		/**
+		 * Runs the loading of the file (called by the thread pool).
+		 */
+		void run();
+
+		/**
+		 * Requests the cancellation of the task.
+		 */
+		void cancel();
+
+		/**
+		 * Indicates if the cancellation of the task has been requested.
+		 * @return Boolean indicating if the task is cancelled (true) or not (false).
+		 */
+		bool isCancelled() const;
+
+		/**
+		 * Gets the type of the file loaded by this task.
+		 * @return Value of the SourceType enum with the type of the file.
+		 */
+		SourceType sourceType() const;
+
+	signals:
+
+		/**
+		 * Indicates that the task has finished.
+		 * @param lSeries TimeSeriesList with the series loaded (empty if the
+		 * task failed or was cancelled).
+		 */
+		void seriesLoaded(const TimeSeriesList &lSeries);
+
+	protected:
+
+		/**
+		 * Produces the series from a record of the landmarks file.
+		 * @param lLine QStringList with the fields of the record.
+		 * @param lSeries Reference to the TimeSeriesList to append to.
+		 * @param lValues Reference to a QList to receive the values appended
+		 * to each series (NaN for the series without a value in the record).
+		 * @param iFirst Integer with the index of the column of the first landmark
+		 * (after the column of the reused frames, if the file has it).
+		 */
+		void addLandmarksRecord(const QStringList &lLine, TimeSeriesList &lSeries, QList<float> &lValues, const int iFirst) const;
+
+		/**
+		 * Loads the summary pyramid stored next to the annotation file, if it
+		 * is up to date with the file and matches the series produced.
+		 * @param oPyramid Reference to the SignalPyramid to load.
+		 * @param iSignals Integer with the number of series produced.
+		 * @return Boolean indicating if the stored pyramid was loaded (true)
+		 * or if it must be built while reading the file (false).
+		 */
+		bool loadPyramid(SignalPyramid &oPyramid, const int iSignals) const;
+
+	private:
+
+		/** Name of the annotation file. */
+		QString m_sFileName;
+
+		/** Type of the annotation file. */
+		SourceType m_eType;
+
+		/** Indexes of the landmarks used to derive the measures (-1 if not available). */
+		int m_iRightEye, m_iLeftEye, m_iUpperLip, m_iLowerLip;
+
+		/** Flag indicating that the cancellation of the task has been requested. */
+		QAtomicInt m_oCancelRequested;
+	};
+}
+
+#endif // SERIESLOADER_H
@@ -30,6 +30,7 @@ fsdk::Session::Session(QObject *pParent) :
 	m_sPlayerFileName = "";
 	m_sGameplayFileName = "";
 	m_sLandmarksFileName = "";
+	m_sGaborFileName = "";
 	m_ePlayerStatus = NotDefined;
 	m_eGameplayStatus = NotDefined;
 	m_bModified = false;
@@ -89,6 +90,24 @@ void fsdk::Session::setLandmarksFileName(const QString &sFileName)
 	emit landmarksFileChanged(sFileName);
 }
 
+// +-----------------------------------------------------------
+QString fsdk::Session::gaborFileName() const
+{
+	return m_sGaborFileName;
+}
+
+// +-----------------------------------------------------------
+void fsdk::Session::setGaborFileName(const QString &sFileName)
+{
+	if(m_sGaborFileName == sFileName)
+		return;
+
+	qDebug().noquote() << "Setting Gabor energies to: " << sFileName;
+	m_sGaborFileName = sFileName;
+	setModified(true);
+	emit gaborFileChanged(sFileName);
+}
+
 // +-----------------------------------------------------------
 void fsdk::Session::clear()
 {
@@ -97,10 +116,12 @@ void fsdk::Session::clear()
 	setPlayerFileName("");
 	setGameplayFileName("");
 	setLandmarksFileName("");
+	setGaborFileName("");
 
 	emit playerFileChanged("");
 	emit gameplayFileChanged("");
 	emit landmarksFileChanged("");
+	emit gaborFileChanged("");
 	setModified(false);
 }
 
@@ -144,6 +165,11 @@ bool fsdk::Session::save(const QString &sFileName)
 	oAnnotations.appendChild(oLandmarks);
 	oLandmarks.setAttribute("fileName", m_sLandmarksFileName);
 
+	// Gabor energies file
+	QDomElement oGabor = oDoc.createElement("Gabor");
+	oAnnotations.appendChild(oGabor);
+	oGabor.setAttribute("fileName", m_sGaborFileName);
+
 	/******************************************************
 	 * Save the file
 	 ******************************************************/
@@ -247,14 +273,20 @@ bool fsdk::Session::load(const QString &sFileName)
 	}
 	QString sLandmarksFileName = oLandmarks.attribute("fileName", "");
 
+	// Gabor energies file (optional, since it does not exist in older sessions)
+	QDomElement oGabor = oAnnotations.firstChildElement("Gabor");
+	QString sGaborFileName = oGabor.isNull() ? QString("") : oGabor.attribute("fileName", "");
+
 	m_sSessionFileName = sFileName;
 	m_sPlayerFileName = sPlayerFileName;
 	m_sGameplayFileName = sGameplayFileName;
 	m_sLandmarksFileName = sLandmarksFileName;
+	m_sGaborFileName = sGaborFileName;
 
 	emit playerFileChanged(m_sPlayerFileName);
 	emit gameplayFileChanged(m_sGameplayFileName);
 	emit landmarksFileChanged(m_sLandmarksFileName);
+	emit gaborFileChanged(m_sGaborFileName);
 	setModified(false);
 
 	return true;
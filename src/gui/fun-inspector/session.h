@@ -99,6 +99,20 @@ namespace fsdk
 		 */
 		void setLandmarksFileName(const QString &sFileName);
 
+		/**
+		 * Gets the name of the Gabor energies file.
+		 * @return QString with the name of the Gabor energies file.
+		 */
+		QString gaborFileName() const;
+
+		/**
+		 * Sets the name of the Gabor energies file.
+		 * @param sFileName QString with the name of the Gabor energies file.
+		 * If it is an empty string, the current Gabor energies file is removed
+		 * from the session.
+		 */
+		void setGaborFileName(const QString &sFileName);
+
 		/**
 		 * Clears the current session data.
 		 */
@@ -162,6 +176,13 @@ namespace fsdk
 		 */
 		void landmarksFileChanged(const QString sFileName);
 
+		/**
+		 * Signal indicating updates in the Gabor energies file.
+		 * @param sFileName QString with the new name of the Gabor energies file
+		 * in the session (empty if no file has been assigned to the session).
+		 */
+		void gaborFileChanged(const QString sFileName);
+
 	protected:
 
 		/**
@@ -187,6 +208,9 @@ namespace fsdk
 		/** Name of the CSV file with the facial landmarks. */
 		QString m_sLandmarksFileName;
 
+		/** Name of the CSV file with the Gabor energies. */
+		QString m_sGaborFileName;
+
 		/** Status of the video file with the gameplay session. */
 		VideoStatus m_eGameplayStatus;
 
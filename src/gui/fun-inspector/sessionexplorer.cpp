@@ -67,6 +67,10 @@ fsdk::SessionExplorer::SessionExplorer(Session *pData, MainWindow *pParent) :
 	m_pLandmarksFile->setIcon(0, QIcon(":/icons/landmarks-file.png"));
 	m_pAnnotationsFolder->addChild(m_pLandmarksFile);
 
+	m_pGaborFile = new QTreeWidgetItem();
+	m_pGaborFile->setIcon(0, QIcon(":/icons/landmarks-file.png"));
+	m_pAnnotationsFolder->addChild(m_pGaborFile);
+
 	m_pView->expandAll();
 
 	m_pPlayerFileMenu = new QMenu(this);
@@ -92,6 +96,14 @@ fsdk::SessionExplorer::SessionExplorer(Session *pData, MainWindow *pParent) :
 	m_pLandmarksFileRemoveAction = m_pLandmarksFileMenu->addAction("");
 	m_pLandmarksFileRemoveAction->setShortcut(QKeySequence(Qt::ALT + Qt::Key_3));
 	connect(m_pLandmarksFileRemoveAction, &QAction::triggered, this, &SessionExplorer::removeLandmarksFile);
+
+	m_pGaborFileMenu = new QMenu(this);
+	m_pGaborFileAddAction = m_pGaborFileMenu->addAction("");
+	m_pGaborFileAddAction->setShortcut(QKeySequence(Qt::CTRL + Qt::Key_4));
+	connect(m_pGaborFileAddAction, &QAction::triggered, this, &SessionExplorer::addGaborFile);
+	m_pGaborFileRemoveAction = m_pGaborFileMenu->addAction("");
+	m_pGaborFileRemoveAction->setShortcut(QKeySequence(Qt::ALT + Qt::Key_4));
+	connect(m_pGaborFileRemoveAction, &QAction::triggered, this, &SessionExplorer::removeGaborFile);
 }
 
 // +-----------------------------------------------------------
@@ -103,6 +115,7 @@ void fsdk::SessionExplorer::refreshUI()
 	m_pPlayerFile->setText(0, tr("Player"));
 	m_pGameplayFile->setText(0, tr("Gameplay"));
 	m_pLandmarksFile->setText(0, tr("Facial landmarks"));
+	m_pGaborFile->setText(0, tr("Gabor energies"));
 
 	m_pPlayerFileMenu->setTitle(tr("Player video"));
 	m_pPlayerFileAddAction->setText(tr("&Select..."));
@@ -127,6 +140,14 @@ void fsdk::SessionExplorer::refreshUI()
 	m_pLandmarksFileRemoveAction->setText(tr("&Remove"));
 	m_pLandmarksFileRemoveAction->setIcon(QIcon(":/icons/file-remove.png"));
 	m_pLandmarksFileRemoveAction->setStatusTip(tr("Remove the current landmarks file from the session"));
+
+	m_pGaborFileMenu->setTitle(tr("Gabor energies"));
+	m_pGaborFileAddAction->setText(tr("&Select..."));
+	m_pGaborFileAddAction->setIcon(QIcon(":/icons/file-add.png"));
+	m_pGaborFileAddAction->setStatusTip(tr("Select a Gabor energies file to add to the session"));
+	m_pGaborFileRemoveAction->setText(tr("&Remove"));
+	m_pGaborFileRemoveAction->setIcon(QIcon(":/icons/file-remove.png"));
+	m_pGaborFileRemoveAction->setStatusTip(tr("Remove the current Gabor energies file from the session"));
 }
 
 // +-----------------------------------------------------------
@@ -136,6 +157,7 @@ void fsdk::SessionExplorer::sessionChanged()
 	m_pPlayerFile->setText(1, m_pData->playerFileName());
 	m_pGameplayFile->setText(1, m_pData->gameplayFileName());
 	m_pLandmarksFile->setText(1, m_pData->landmarksFileName());
+	m_pGaborFile->setText(1, m_pData->gaborFileName());
 
 	m_pRoot->setText(0, tr("%1Session").arg(m_pData->isModified() ? "*" : ""));
 	m_pMainWindow->setWindowModified(m_pData->isModified());
@@ -159,6 +181,12 @@ QMenu *fsdk::SessionExplorer::landmarksFileMenu() const
 	return m_pLandmarksFileMenu;
 }
 
+// +-----------------------------------------------------------
+QMenu *fsdk::SessionExplorer::gaborFileMenu() const
+{
+	return m_pGaborFileMenu;
+}
+
 // +-----------------------------------------------------------
 void fsdk::SessionExplorer::showContextMenu(const QPoint &oClickPos)
 {
@@ -184,6 +212,13 @@ void fsdk::SessionExplorer::showContextMenu(const QPoint &oClickPos)
 		oMenu.addAction(m_pLandmarksFileRemoveAction);
 		oMenu.exec(m_pView->mapToGlobal(oClickPos));
 	}
+	else if(pItem == m_pGaborFile)
+	{
+		QMenu oMenu(this);
+		oMenu.addAction(m_pGaborFileAddAction);
+		oMenu.addAction(m_pGaborFileRemoveAction);
+		oMenu.exec(m_pView->mapToGlobal(oClickPos));
+	}
 }
 
 // +-----------------------------------------------------------
@@ -265,4 +300,31 @@ bool fsdk::SessionExplorer::removeLandmarksFile()
 	}
 	else
 		return false;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::SessionExplorer::addGaborFile()
+{
+	QString sFile = QFileDialog::getOpenFileName(this, tr("Select Gabor energies file..."), m_pMainWindow->lastPathUsed(), tr("Comma-Separated-Value files (*.csv);; All files (*.*)"));
+	if(sFile.length())
+	{
+		m_pData->setGaborFileName(sFile);
+		m_pMainWindow->setLastPathUsed(QFileInfo(sFile).absolutePath());
+		return true;
+	}
+	else
+		return false;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::SessionExplorer::removeGaborFile()
+{
+	QMessageBox::StandardButton eResp = QMessageBox::question(this, tr("Attention!"), tr("Do you confirm removing the Gabor energies CSV file from the session?"), QMessageBox::Yes | QMessageBox::No);
+	if(eResp == QMessageBox::Yes)
+	{
+		m_pData->setGaborFileName("");
+		return true;
+	}
+	else
+		return false;
 }
\ No newline at end of file
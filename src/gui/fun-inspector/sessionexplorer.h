@@ -90,6 +90,12 @@ namespace fsdk
 		 */
 		QMenu *landmarksFileMenu() const;
 
+		/**
+		 * Gets the menu of actions for the Gabor energies file.
+		 * @return Instance of a QMenu with the menu of actions.
+		 */
+		QMenu *gaborFileMenu() const;
+
 	public slots:
 
 		/**
@@ -159,6 +165,22 @@ namespace fsdk
 		 */
 		bool removeLandmarksFile();
 
+		/**
+		 * Opens a dialog for the user to select an existing CSV file
+		 * of the Gabor energies to add to the session.
+		 * @return Boolean indicating if the method executed with success
+		 * (true) or not (false).
+		 */
+		bool addGaborFile();
+
+		/**
+		 * Removes the current CSV file of the Gabor energies from the session
+		 * (with confirmation from the user).
+		 * @return Boolean indicating if the method executed with success
+		 * (true) or not (false).
+		 */
+		bool removeGaborFile();
+
     private:
 
 		/** Reference to the main window instance. */
@@ -188,6 +210,9 @@ namespace fsdk
 		/** Element that holds the landmarks annotation file. */
 		QTreeWidgetItem *m_pLandmarksFile;
 
+		/** Element that holds the Gabor energies annotation file. */
+		QTreeWidgetItem *m_pGaborFile;
+
 		/** Menu of actions for the player file. */
 		QMenu *m_pPlayerFileMenu;
 
@@ -214,6 +239,15 @@ namespace fsdk
 
 		/** Action to remove the current landmarks file. */
 		QAction *m_pLandmarksFileRemoveAction;
+
+		/** Menu of actions for the Gabor energies file. */
+		QMenu *m_pGaborFileMenu;
+
+		/** Action to add a Gabor energies file. */
+		QAction *m_pGaborFileAddAction;
+
+		/** Action to remove the current Gabor energies file. */
+		QAction *m_pGaborFileRemoveAction;
     };
 }
 
@@ -0,0 +1,307 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "thumbnailcache.h"
+#include "imageman.h"
+#include <QThreadPool>
+#include <QStandardPaths>
+#include <QCryptographicHash>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QDir>
+#include <QDebug>
+#include <opencv2/imgproc/imgproc.hpp>
+
+using namespace cv;
+
+// Width (in pixels) of the sampled thumbnails
+#define THUMBNAIL_WIDTH 160
+
+// Minimum interval (in milliseconds) between two thumbnails
+#define MIN_INTERVAL 1000
+
+// Maximum number of thumbnails sampled from a video (the interval is
+// enlarged for long videos, so the memory used is bounded)
+#define MAX_THUMBNAILS 1000
+
+// Maximum number of frames decoded sequentially to reach the next sample
+// (above that the capture is seeked, which is slower for short distances
+// because the decoder restarts from the previous keyframe)
+#define MAX_GRAB_DISTANCE 60
+
+// Maximum time (in milliseconds) before the end of the video in which the
+// decoding may fail and the thumbnails still be complete (the frame count
+// reported by the containers often includes a few frames that can not be read)
+#define END_TOLERANCE 1000
+
+// Identification and version of the cache file format
+#define CACHE_MAGIC 0x46534b54
+#define CACHE_VERSION 1
+
+// +-----------------------------------------------------------
+fsdk::ThumbnailBuilder::ThumbnailBuilder(const QString &sFileName)
+{
+	m_sFileName = sFileName;
+	setAutoDelete(false);
+}
+
+// +-----------------------------------------------------------
+void fsdk::ThumbnailBuilder::cancel()
+{
+	m_oCancelRequested.testAndSetOrdered(0, 1);
+}
+
+// +-----------------------------------------------------------
+bool fsdk::ThumbnailBuilder::isCancelled() const
+{
+	return static_cast<int>(m_oCancelRequested) == 1;
+}
+
+// +-----------------------------------------------------------
+void fsdk::ThumbnailBuilder::run()
+{
+	VideoCapture oCap;
+	if(!oCap.open(m_sFileName.toStdString()))
+	{
+		qWarning().noquote() << "Could not open the video file to build the thumbnails: " << m_sFileName;
+		emit finished(false);
+		return;
+	}
+
+	double dFPS = oCap.get(CV_CAP_PROP_FPS);
+	int iFrames = static_cast<int>(oCap.get(CV_CAP_PROP_FRAME_COUNT));
+	if(dFPS <= 0 || iFrames <= 0)
+	{
+		qWarning().noquote() << "Could not query the frame rate and length of the video file: " << m_sFileName;
+		emit finished(false);
+		return;
+	}
+
+	qint64 iDuration = static_cast<qint64>(iFrames * 1000.0 / dFPS);
+	qint64 iInterval = qMax(static_cast<qint64>(MIN_INTERVAL), iDuration / MAX_THUMBNAILS);
+
+	Mat oFrame, oSmall;
+	int iCurrent = -1;
+	bool bCompleted = true;
+	for(qint64 iPosition = 0; iPosition < iDuration; iPosition += iInterval)
+	{
+		if(isCancelled())
+		{
+			emit finished(false);
+			return;
+		}
+
+		int iFrame = qRound(iPosition * dFPS / 1000.0);
+		int iDistance = iFrame - iCurrent;
+		if(iDistance <= 0 || iDistance > MAX_GRAB_DISTANCE)
+		{
+			oCap.set(CV_CAP_PROP_POS_FRAMES, iFrame);
+			iCurrent = iFrame - 1;
+		}
+
+		bool bGrabbed = true;
+		while(bGrabbed && iCurrent < iFrame)
+		{
+			bGrabbed = oCap.grab();
+			iCurrent++;
+		}
+		// A failure before the end leaves the thumbnails incomplete (so they
+		// are not cached and are built again the next time); in the last sample
+		// or close to the end it is only the short last frame of the video
+		if(!bGrabbed || !oCap.retrieve(oFrame) || oFrame.empty())
+		{
+			bCompleted = iPosition + iInterval >= iDuration || iDuration - iPosition <= END_TOLERANCE;
+			if(!bCompleted)
+				qWarning().noquote() << "Could not decode the video file after" << iPosition << "ms to build the thumbnails: " << m_sFileName;
+			break;
+		}
+
+		double dScale = static_cast<double>(THUMBNAIL_WIDTH) / oFrame.cols;
+		resize(oFrame, oSmall, Size(), dScale, dScale, INTER_AREA);
+		cvtColor(oSmall, oSmall, CV_BGR2RGB);
+
+		// Mat2Image does not copy the data, so the copy is needed to detach
+		// the image from the buffer reused in the next iteration
+		emit thumbnailReady(iPosition, ImageMan::Mat2Image(oSmall).copy());
+	}
+
+	emit finished(bCompleted && !isCancelled());
+}
+
+// +-----------------------------------------------------------
+fsdk::ThumbnailCache::ThumbnailCache(QObject *pParent) : QObject(pParent)
+{
+	m_pBuilder = NULL;
+}
+
+// +-----------------------------------------------------------
+fsdk::ThumbnailCache::~ThumbnailCache()
+{
+	cancelBuilder();
+}
+
+// +-----------------------------------------------------------
+void fsdk::ThumbnailCache::setVideoFile(const QString &sFileName)
+{
+	cancelBuilder();
+	m_sFileName = sFileName;
+	m_mThumbnails.clear();
+	emit thumbnailsChanged();
+
+	if(sFileName.isEmpty())
+		return;
+
+	if(load(cacheFileName(sFileName)))
+	{
+		emit thumbnailsChanged();
+		return;
+	}
+
+	m_pBuilder = new ThumbnailBuilder(sFileName);
+	connect(m_pBuilder, &ThumbnailBuilder::thumbnailReady, this, &ThumbnailCache::thumbnailReady);
+	connect(m_pBuilder, &ThumbnailBuilder::finished, this, &ThumbnailCache::builderFinished);
+	connect(m_pBuilder, &ThumbnailBuilder::finished, m_pBuilder, &ThumbnailBuilder::deleteLater);
+	QThreadPool::globalInstance()->start(m_pBuilder);
+}
+
+// +-----------------------------------------------------------
+void fsdk::ThumbnailCache::cancelBuilder()
+{
+	if(m_pBuilder)
+	{
+		// The builder deletes itself when it finishes running
+		disconnect(m_pBuilder, 0, this, 0);
+		m_pBuilder->cancel();
+		m_pBuilder = NULL;
+	}
+}
+
+// +-----------------------------------------------------------
+QImage fsdk::ThumbnailCache::thumbnail(qint64 iPosition) const
+{
+	if(m_mThumbnails.isEmpty())
+		return QImage();
+
+	QMap<qint64, QImage>::const_iterator it = m_mThumbnails.lowerBound(iPosition);
+	if(it == m_mThumbnails.constEnd())
+		return (--it).value();
+	if(it == m_mThumbnails.constBegin())
+		return it.value();
+
+	QMap<qint64, QImage>::const_iterator itPrev = it - 1;
+	return (iPosition - itPrev.key() < it.key() - iPosition) ? itPrev.value() : it.value();
+}
+
+// +-----------------------------------------------------------
+bool fsdk::ThumbnailCache::isEmpty() const
+{
+	return m_mThumbnails.isEmpty();
+}
+
+// +-----------------------------------------------------------
+void fsdk::ThumbnailCache::thumbnailReady(qint64 iPosition, const QImage &oImage)
+{
+	// Ignore signals already queued by a cancelled builder
+	if(sender() != m_pBuilder)
+		return;
+
+	m_mThumbnails.insert(iPosition, oImage);
+	emit thumbnailsChanged();
+}
+
+// +-----------------------------------------------------------
+void fsdk::ThumbnailCache::builderFinished(bool bCompleted)
+{
+	if(sender() != m_pBuilder)
+		return;
+	m_pBuilder = NULL;
+
+	if(bCompleted && !m_mThumbnails.isEmpty())
+		save(cacheFileName(m_sFileName));
+}
+
+// +-----------------------------------------------------------
+QString fsdk::ThumbnailCache::cacheFileName(const QString &sFileName)
+{
+	QFileInfo oInfo(sFileName);
+
+	QCryptographicHash oHash(QCryptographicHash::Md5);
+	oHash.addData(oInfo.absoluteFilePath().toUtf8());
+	oHash.addData(QByteArray::number(oInfo.size()));
+	oHash.addData(QByteArray::number(oInfo.lastModified().toMSecsSinceEpoch()));
+
+	QString sPath = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/thumbnails";
+	return QString("%1/%2.thumbs").arg(sPath).arg(QString(oHash.result().toHex()));
+}
+
+// +-----------------------------------------------------------
+bool fsdk::ThumbnailCache::load(const QString &sCacheFile)
+{
+	QFile oFile(sCacheFile);
+	if(!oFile.open(QIODevice::ReadOnly))
+		return false;
+
+	QDataStream oStream(&oFile);
+	oStream.setVersion(QDataStream::Qt_5_0);
+
+	quint32 iMagic, iVersion;
+	oStream >> iMagic >> iVersion;
+	if(oStream.status() != QDataStream::Ok || iMagic != CACHE_MAGIC || iVersion != CACHE_VERSION)
+	{
+		qWarning().noquote() << "Ignoring invalid thumbnails cache file: " << sCacheFile;
+		return false;
+	}
+
+	QMap<qint64, QImage> mThumbnails;
+	oStream >> mThumbnails;
+	if(oStream.status() != QDataStream::Ok)
+	{
+		qWarning().noquote() << "Error reading the thumbnails cache file: " << sCacheFile;
+		return false;
+	}
+
+	m_mThumbnails = mThumbnails;
+	return true;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::ThumbnailCache::save(const QString &sCacheFile) const
+{
+	if(!QDir().mkpath(QFileInfo(sCacheFile).absolutePath()))
+	{
+		qWarning().noquote() << "Could not create the thumbnails cache directory for: " << sCacheFile;
+		return false;
+	}
+
+	QSaveFile oFile(sCacheFile);
+	if(!oFile.open(QIODevice::WriteOnly))
+	{
+		qWarning().noquote() << "Could not write the thumbnails cache file: " << sCacheFile;
+		return false;
+	}
+
+	QDataStream oStream(&oFile);
+	oStream.setVersion(QDataStream::Qt_5_0);
+	oStream << static_cast<quint32>(CACHE_MAGIC) << static_cast<quint32>(CACHE_VERSION);
+	oStream << m_mThumbnails;
+
+	return oFile.commit();
+}
@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef THUMBNAILCACHE_H
+#define THUMBNAILCACHE_H
+
+#include <QObject>
+#include <QRunnable>
+#include <QAtomicInt>
+#include <QImage>
+#include <QMap>
+
+namespace fsdk
+{
+	/**
+	 * Background task that decodes a video file and samples low resolution
+	 * thumbnails of its frames at a fixed time interval.
+	 */
+	class ThumbnailBuilder : public QObject, public QRunnable
+	{
+		Q_OBJECT
+
+	public:
+		/**
+		 * Class constructor.
+		 * @param sFileName QString with the name of the video file to sample.
+		 */
+		ThumbnailBuilder(const QString &sFileName);
+
+		/**
+		 * Runs the sampling of the thumbnails (called by the thread pool).
+		 */
+		void run();
+
+		/**
+		 * Requests the cancellation of the task. The task will stop as soon
+		 * as the current frame is processed.
+		 */
+		void cancel();
+
+		/**
+		 * Indicates if the cancellation of the task has been requested.
+		 * @return Boolean indicating if the task is cancelled (true) or not (false).
+		 */
+		bool isCancelled() const;
+
+	signals:
+
+		/**
+		 * Indicates that a new thumbnail has been sampled.
+		 * @param iPosition Long integer with the position of the thumbnail in
+		 * the video, expressed in milliseconds.
+		 * @param oImage QImage with the thumbnail.
+		 */
+		void thumbnailReady(qint64 iPosition, const QImage &oImage);
+
+		/**
+		 * Indicates that the task has finished.
+		 * @param bCompleted Boolean indicating if all thumbnails have been sampled
+		 * (true) or if the task failed or was cancelled (false).
+		 */
+		void finished(bool bCompleted);
+
+	private:
+
+		/** Name of the video file to sample. */
+		QString m_sFileName;
+
+		/** Flag indicating that the cancellation of the task has been requested. */
+		QAtomicInt m_oCancelRequested;
+	};
+
+	/**
+	 * Keeps a strip of low resolution thumbnails of a video, used to provide
+	 * immediate visual feedback while the user scrubs through the timeline
+	 * (so the media player only needs to seek when the user stops dragging).
+	 * The thumbnails are sampled in background and stored in the user cache
+	 * directory, so they are only built once for each video file.
+	 */
+	class ThumbnailCache : public QObject
+	{
+		Q_OBJECT
+
+	public:
+		/**
+		 * Class constructor.
+		 * @param pParent Instance of the parent object.
+		 */
+		ThumbnailCache(QObject *pParent = 0);
+
+		/**
+		 * Class destructor.
+		 */
+		virtual ~ThumbnailCache();
+
+		/**
+		 * Sets the video file whose thumbnails are kept by this cache. The
+		 * thumbnails are loaded from disk if available, or otherwise built
+		 * in background.
+		 * @param sFileName QString with the name of the video file (or an
+		 * empty string to clear the cache).
+		 */
+		void setVideoFile(const QString &sFileName);
+
+		/**
+		 * Gets the thumbnail closest to the given position.
+		 * @param iPosition Long integer with the position in the video,
+		 * expressed in milliseconds.
+		 * @return QImage with the nearest thumbnail available, or a null
+		 * QImage if there are no thumbnails available yet.
+		 */
+		QImage thumbnail(qint64 iPosition) const;
+
+		/**
+		 * Indicates if there are no thumbnails available.
+		 * @return Boolean indicating if the cache is empty (true) or not (false).
+		 */
+		bool isEmpty() const;
+
+		/**
+		 * Gets the name of the file used to store the thumbnails of a video
+		 * in the user cache directory. The name depends on the path, size and
+		 * modification time of the video, so changed videos are sampled again.
+		 * @param sFileName QString with the name of the video file.
+		 * @return QString with the name of the cache file.
+		 */
+		static QString cacheFileName(const QString &sFileName);
+
+	signals:
+
+		/**
+		 * Indicates that the set of thumbnails available has changed.
+		 */
+		void thumbnailsChanged();
+
+	protected slots:
+
+		/**
+		 * Captures the indication that a new thumbnail was sampled.
+		 * @param iPosition Long integer with the position of the thumbnail in
+		 * the video, expressed in milliseconds.
+		 * @param oImage QImage with the thumbnail.
+		 */
+		void thumbnailReady(qint64 iPosition, const QImage &oImage);
+
+		/**
+		 * Captures the indication that the building task has finished.
+		 * @param bCompleted Boolean indicating if all thumbnails have been sampled
+		 * (true) or not (false).
+		 */
+		void builderFinished(bool bCompleted);
+
+	protected:
+
+		/**
+		 * Cancels the building task in execution (if any).
+		 */
+		void cancelBuilder();
+
+		/**
+		 * Loads the thumbnails from the cache file.
+		 * @param sCacheFile QString with the name of the cache file.
+		 * @return Boolean indicating if the file was loaded (true) or not (false).
+		 */
+		bool load(const QString &sCacheFile);
+
+		/**
+		 * Saves the thumbnails to the cache file.
+		 * @param sCacheFile QString with the name of the cache file.
+		 * @return Boolean indicating if the file was saved (true) or not (false).
+		 */
+		bool save(const QString &sCacheFile) const;
+
+	private:
+
+		/** Name of the video file whose thumbnails are kept. */
+		QString m_sFileName;
+
+		/** Thumbnails available, mapped by their positions in milliseconds. */
+		QMap<qint64, QImage> m_mThumbnails;
+
+		/** Building task in execution (or NULL if none). */
+		ThumbnailBuilder *m_pBuilder;
+	};
+}
+
+#endif // THUMBNAILCACHE_H
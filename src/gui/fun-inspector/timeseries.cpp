@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "timeseries.h"
+#include <QtMath>
+#include <algorithm>
+
+// +-----------------------------------------------------------
+fsdk::TimeSeries::TimeSeries(const QString &sName)
+{
+	m_sName = sName;
+	m_iSignal = 0;
+}
+
+// +-----------------------------------------------------------
+QString fsdk::TimeSeries::name() const
+{
+	return m_sName;
+}
+
+// +-----------------------------------------------------------
+int fsdk::TimeSeries::count() const
+{
+	return m_vKeys.count();
+}
+
+// +-----------------------------------------------------------
+void fsdk::TimeSeries::append(const double dKey, const double dValue)
+{
+	m_vKeys.append(dKey);
+	m_vValues.append(dValue);
+}
+
+// +-----------------------------------------------------------
+const QVector<double>& fsdk::TimeSeries::keys() const
+{
+	return m_vKeys;
+}
+
+// +-----------------------------------------------------------
+const QVector<double>& fsdk::TimeSeries::values() const
+{
+	return m_vValues;
+}
+
+// +-----------------------------------------------------------
+void fsdk::TimeSeries::setPyramid(const QSharedPointer<const SignalPyramid> &pPyramid, const int iSignal)
+{
+	m_pPyramid = pPyramid;
+	m_iSignal = iSignal;
+}
+
+// +-----------------------------------------------------------
+fsdk::SignalSummary fsdk::TimeSeries::summary(const double dLower, const double dUpper) const
+{
+	if(m_pPyramid)
+		return m_pPyramid->summary(m_iSignal, qCeil(dLower), qFloor(dUpper));
+
+	SignalSummary oRet;
+	int iBegin = std::lower_bound(m_vKeys.constBegin(), m_vKeys.constEnd(), dLower) - m_vKeys.constBegin();
+	int iEnd = std::upper_bound(m_vKeys.constBegin(), m_vKeys.constEnd(), dUpper) - m_vKeys.constBegin();
+	for(int i = iBegin; i < iEnd; i++)
+		oRet.merge(SignalSummary(m_vValues[i]));
+	return oRet;
+}
+
+// +-----------------------------------------------------------
+void fsdk::TimeSeries::decimate(const double dLower, const double dUpper, const int iColumns, QVector<double> &vKeys, QVector<double> &vValues) const
+{
+	vKeys.clear();
+	vValues.clear();
+	if(m_vKeys.isEmpty() || iColumns <= 0 || dUpper <= dLower)
+		return;
+
+	// Indexes of the values in range, including one value out of each border
+	int iBegin = std::lower_bound(m_vKeys.constBegin(), m_vKeys.constEnd(), dLower) - m_vKeys.constBegin();
+	int iEnd = std::upper_bound(m_vKeys.constBegin(), m_vKeys.constEnd(), dUpper) - m_vKeys.constBegin();
+	iBegin = qMax(iBegin - 1, 0);
+	iEnd = qMin(iEnd + 1, m_vKeys.count());
+
+	// Few values: no need to decimate
+	if(iEnd - iBegin <= 2 * iColumns)
+	{
+		vKeys = m_vKeys.mid(iBegin, iEnd - iBegin);
+		vValues = m_vValues.mid(iBegin, iEnd - iBegin);
+		return;
+	}
+
+	vKeys.reserve(2 * iColumns + 2);
+	vValues.reserve(2 * iColumns + 2);
+
+	if(m_pPyramid)
+	{
+		// Each column is drawn as a vertical segment between its minimum
+		// and maximum, summarized by the pyramid
+		int iFirstFrame = qCeil(dLower);
+		int iLastFrame = qFloor(dUpper);
+		QList<SignalSummary> lColumns = m_pPyramid->summaries(m_iSignal, iFirstFrame, iLastFrame, iColumns);
+		double dFrames = iLastFrame - iFirstFrame + 1;
+
+		if(m_vKeys[iBegin] < iFirstFrame)
+		{
+			vKeys.append(m_vKeys[iBegin]);
+			vValues.append(m_vValues[iBegin]);
+		}
+		for(int i = 0; i < lColumns.count(); i++)
+		{
+			if(lColumns[i].isEmpty())
+				continue;
+
+			double dKey = iFirstFrame + qCeil(i * dFrames / lColumns.count());
+			vKeys.append(dKey);
+			vValues.append(lColumns[i].minimum());
+			vKeys.append(dKey);
+			vValues.append(lColumns[i].maximum());
+		}
+		if(m_vKeys[iEnd - 1] > iLastFrame)
+		{
+			vKeys.append(m_vKeys[iEnd - 1]);
+			vValues.append(m_vValues[iEnd - 1]);
+		}
+		return;
+	}
+
+	double dWidth = (dUpper - dLower) / iColumns;
+	int i = iBegin;
+	while(i < iEnd)
+	{
+		// Find the minimum and maximum values in the column of the current value
+		int iColumn = qFloor((m_vKeys[i] - dLower) / dWidth);
+		int iMin = i, iMax = i;
+		for(i++; i < iEnd && qFloor((m_vKeys[i] - dLower) / dWidth) == iColumn; i++)
+		{
+			if(m_vValues[i] < m_vValues[iMin])
+				iMin = i;
+			if(m_vValues[i] > m_vValues[iMax])
+				iMax = i;
+		}
+
+		// Add them in their original order
+		int iFirst = qMin(iMin, iMax);
+		int iLast = qMax(iMin, iMax);
+		vKeys.append(m_vKeys[iFirst]);
+		vValues.append(m_vValues[iFirst]);
+		if(iLast != iFirst)
+		{
+			vKeys.append(m_vKeys[iLast]);
+			vValues.append(m_vValues[iLast]);
+		}
+	}
+}
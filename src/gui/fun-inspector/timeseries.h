@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TIMESERIES_H
+#define TIMESERIES_H
+
+#include "signalpyramid.h"
+#include <QString>
+#include <QVector>
+#include <QList>
+#include <QSharedPointer>
+#include <QMetaType>
+
+namespace fsdk
+{
+	/**
+	 * Sequence of values indexed by video frame, plotted in the PlotWindow.
+	 * The keys (frame indexes) must be appended in ascending order.
+	 */
+	class TimeSeries
+	{
+	public:
+		/**
+		 * Class constructor.
+		 * @param sName QString with the name of the series.
+		 */
+		TimeSeries(const QString &sName = "");
+
+		/**
+		 * Gets the name of the series.
+		 * @return QString with the name of the series.
+		 */
+		QString name() const;
+
+		/**
+		 * Gets the number of values in the series.
+		 * @return Integer with the number of values.
+		 */
+		int count() const;
+
+		/**
+		 * Appends a value to the series.
+		 * @param dKey Double with the key (frame index) of the value. It must
+		 * be greater than the key of the last value appended.
+		 * @param dValue Double with the value.
+		 */
+		void append(const double dKey, const double dValue);
+
+		/**
+		 * Gets the keys of the series.
+		 * @return Const reference to the QVector with the keys.
+		 */
+		const QVector<double>& keys() const;
+
+		/**
+		 * Gets the values of the series.
+		 * @return Const reference to the QVector with the values.
+		 */
+		const QVector<double>& values() const;
+
+		/**
+		 * Sets the multi-resolution summary of the series, used to speed up
+		 * the decimation and the summaries of long ranges of keys.
+		 * @param pPyramid Shared pointer to the SignalPyramid with the summary
+		 * (it might be shared by the series loaded from the same file).
+		 * @param iSignal Integer with the index of this series in the pyramid.
+		 */
+		void setPyramid(const QSharedPointer<const SignalPyramid> &pPyramid, const int iSignal);
+
+		/**
+		 * Gets the summary (minimum, maximum and mean) of the values in the
+		 * given range of keys. It takes O(log n) if the series has a pyramid,
+		 * and O(n) otherwise.
+		 * @param dLower Double with the lower key of the range.
+		 * @param dUpper Double with the upper key of the range.
+		 * @return SignalSummary with the summary of the values in the range.
+		 */
+		SignalSummary summary(const double dLower, const double dUpper) const;
+
+		/**
+		 * Reduces the values in the given range of keys to at most two values
+		 * (the minimum and the maximum, in their original order) per column of
+		 * pixels, so the series can be plotted at interactive frame rates
+		 * regardless of its length while still displaying all its peaks. One value
+		 * before and one after the range are also included, so the lines reach
+		 * the borders of the plot. If the series has a pyramid, the minimum and the
+		 * maximum of each column are obtained from it in O(log n), so zoomed-out
+		 * views do not need to walk all the values in range.
+		 * @param dLower Double with the lower key of the range.
+		 * @param dUpper Double with the upper key of the range.
+		 * @param iColumns Integer with the number of columns of pixels.
+		 * @param vKeys Reference to a QVector to receive the decimated keys.
+		 * @param vValues Reference to a QVector to receive the decimated values.
+		 */
+		void decimate(const double dLower, const double dUpper, const int iColumns, QVector<double> &vKeys, QVector<double> &vValues) const;
+
+	private:
+
+		/** Name of the series. */
+		QString m_sName;
+
+		/** Keys (frame indexes) of the series, in ascending order. */
+		QVector<double> m_vKeys;
+
+		/** Values of the series. */
+		QVector<double> m_vValues;
+
+		/** Multi-resolution summary of the series (optional). */
+		QSharedPointer<const SignalPyramid> m_pPyramid;
+
+		/** Index of the series in the pyramid. */
+		int m_iSignal;
+	};
+
+	/** List of time series. */
+	typedef QList<TimeSeries> TimeSeriesList;
+}
+
+Q_DECLARE_METATYPE(fsdk::TimeSeriesList);
+
+#endif // TIMESERIES_H
@@ -45,6 +45,13 @@ fsdk::VideoWidget::VideoWidget(QWidget *pParent) : QGraphicsView(pParent)
 	// Add the video item
 	m_pVideoItem = new QGraphicsVideoItem();
 	m_pScene->addItem(m_pVideoItem);
+
+	// Add the thumbnail item (on top of the video, but below any other
+	// items added afterwards)
+	m_pThumbnailItem = new QGraphicsPixmapItem();
+	m_pThumbnailItem->setTransformationMode(Qt::SmoothTransformation);
+	m_pThumbnailItem->setVisible(false);
+	m_pScene->addItem(m_pThumbnailItem);
 }
 
 // +-----------------------------------------------------------
@@ -139,4 +146,30 @@ void fsdk::VideoWidget::mediaStatusChanged(QMediaPlayer::MediaStatus eStatus)
 {
 	Q_UNUSED(eStatus);
 	m_pVideoItem->setSize(m_pVideoItem->nativeSize());
+}
+// +-----------------------------------------------------------
+void fsdk::VideoWidget::showThumbnail(const QImage &oImage)
+{
+	if(oImage.isNull())
+		return;
+
+	m_pThumbnailItem->setPixmap(QPixmap::fromImage(oImage));
+
+	QSizeF oSize = m_pVideoItem->size();
+	if(oSize.isEmpty())
+		oSize = oImage.size();
+	m_pThumbnailItem->setTransform(QTransform::fromScale(oSize.width() / oImage.width(), oSize.height() / oImage.height()));
+	m_pThumbnailItem->setVisible(true);
+}
+
+// +-----------------------------------------------------------
+void fsdk::VideoWidget::hideThumbnail()
+{
+	m_pThumbnailItem->setVisible(false);
+}
+
+// +-----------------------------------------------------------
+bool fsdk::VideoWidget::thumbnailVisible() const
+{
+	return m_pThumbnailItem->isVisible();
 }
\ No newline at end of file
@@ -22,6 +22,7 @@
 
 #include <QGraphicsView>
 #include <QGraphicsVideoItem>
+#include <QGraphicsPixmapItem>
 #include <QWheelEvent>
 #include <QMediaPlayer>
 
@@ -78,6 +79,25 @@ namespace fsdk
 		 */
 		QSize sizeHint() const;
 
+		/**
+		 * Displays a thumbnail over the video (used to give visual feedback
+		 * while the user scrubs through the video timeline). The thumbnail
+		 * is scaled to the size of the video.
+		 * @param oImage QImage with the thumbnail to display.
+		 */
+		void showThumbnail(const QImage &oImage);
+
+		/**
+		 * Hides the thumbnail displayed over the video (if any).
+		 */
+		void hideThumbnail();
+
+		/**
+		 * Indicates if a thumbnail is being displayed over the video.
+		 * @return Boolean indicating if a thumbnail is visible (true) or not (false).
+		 */
+		bool thumbnailVisible() const;
+
 	signals:
 
 		/**
@@ -119,6 +139,9 @@ namespace fsdk
 		/** Video item used to display the background video. */
 		QGraphicsVideoItem *m_pVideoItem;
 
+		/** Pixmap item used to display thumbnails over the video while scrubbing. */
+		QGraphicsPixmapItem *m_pThumbnailItem;
+
 		/** Current zoom level. */
 		double m_dZoomLevel;
 	};
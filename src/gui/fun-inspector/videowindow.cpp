@@ -28,6 +28,7 @@
 #include <QDebug>
 #include <QTime>
 #include <QToolbar>
+#include <QMediaMetaData>
 
 #define SLIDER_STYLE_SHEET "\
 	QSlider::groove:horizontal\
@@ -66,6 +67,14 @@
 	}\
 	"
 
+// Time (in milliseconds) the user must hold the dragged progress slider
+// still before the media player is actually seeked
+#define SCRUB_SEEK_DELAY 300
+
+// Maximum distance (in milliseconds) of a position reported by the media player
+// to the one of a seek done while scrubbing for it to be taken as the seeked frame
+#define SCRUB_SEEK_TOLERANCE 100
+
 // +-----------------------------------------------------------
 fsdk::VideoWindow::VideoWindow(QWidget *pParent) :
 	QMdiSubWindow(pParent)
@@ -74,6 +83,13 @@ fsdk::VideoWindow::VideoWindow(QWidget *pParent) :
 	setWindowFlags(windowFlags() & ~Qt::WindowMinimizeButtonHint);
 
 	m_pMediaPlayer = new QMediaPlayer(this);
+	m_pThumbnailCache = new ThumbnailCache(this);
+
+	m_pScrubTimer = new QTimer(this);
+	m_pScrubTimer->setSingleShot(true);
+	m_pScrubTimer->setInterval(SCRUB_SEEK_DELAY);
+	connect(m_pScrubTimer, &QTimer::timeout, this, &VideoWindow::scrubTimeout);
+	m_iScrubSeek = -1;
 
 	setupUI();
 	refreshUI();
@@ -84,6 +100,7 @@ fsdk::VideoWindow::VideoWindow(QWidget *pParent) :
 	connect(m_pMediaPlayer, &QMediaPlayer::stateChanged, this, &VideoWindow::mediaStateChanged);
 	connect(m_pMediaPlayer, &QMediaPlayer::positionChanged, this, &VideoWindow::mediaPositionChanged);
 	connect(m_pMediaPlayer, &QMediaPlayer::durationChanged, this, &VideoWindow::mediaDurationChanged);
+	connect(m_pMediaPlayer, static_cast<void (QMediaPlayer::*)()>(&QMediaPlayer::metaDataChanged), this, &VideoWindow::mediaMetaDataChanged);
 }
 
 // +-----------------------------------------------------------
@@ -107,6 +124,8 @@ void fsdk::VideoWindow::setupUI()
 	m_pProgressSlider->setStyleSheet(SLIDER_STYLE_SHEET);
 	pBottom->layout()->addWidget(m_pProgressSlider);
 	connect(m_pProgressSlider, &CustomSlider::valueChanged, this, &VideoWindow::sliderValueChanged);
+	connect(m_pProgressSlider, &CustomSlider::sliderPressed, this, &VideoWindow::sliderPressed);
+	connect(m_pProgressSlider, &CustomSlider::sliderReleased, this, &VideoWindow::sliderReleased);
 
 	m_pRemainingTime = new QLabel("00:00", this);
 	pBottom->layout()->addWidget(m_pRemainingTime);
@@ -374,6 +393,12 @@ void fsdk::VideoWindow::mediaStatusChanged(QMediaPlayer::MediaStatus eStatus)
 	updateProgressTime();
 }
 
+// +-----------------------------------------------------------
+void fsdk::VideoWindow::mediaMetaDataChanged()
+{
+	emit frameRateChanged(frameRate());
+}
+
 // +-----------------------------------------------------------
 void fsdk::VideoWindow::mediaStateChanged(QMediaPlayer::State eState)
 {
@@ -385,10 +410,30 @@ void fsdk::VideoWindow::mediaStateChanged(QMediaPlayer::State eState)
 // +-----------------------------------------------------------
 void fsdk::VideoWindow::mediaPositionChanged(qint64 iPosition)
 {
-	Q_UNUSED(iPosition);
+	// While scrubbing, the thumbnail of the position scrubbed is kept (the
+	// player still reports the positions it is playing), unless the position
+	// is the one of the seek done when the slider was held still
+	if(isScrubbing())
+	{
+		if(m_iScrubSeek >= 0 && qAbs(iPosition - m_iScrubSeek) <= SCRUB_SEEK_TOLERANCE)
+		{
+			m_iScrubSeek = -1;
+			m_pVideoWidget->hideThumbnail();
+		}
+		return;
+	}
+
+	// The real frame is available, so the scrubbing thumbnail is no longer needed
+	m_pVideoWidget->hideThumbnail();
 	updateProgressTime();
 }
 
+// +-----------------------------------------------------------
+bool fsdk::VideoWindow::isScrubbing() const
+{
+	return m_pProgressSlider->isSliderDown();
+}
+
 // +-----------------------------------------------------------
 void fsdk::VideoWindow::mediaDurationChanged(qint64 iDuration)
 {
@@ -406,6 +451,9 @@ void fsdk::VideoWindow::setVideoFile(const QString &sFileName)
 	}
 	else
 		m_pMediaPlayer->setMedia(QMediaContent());
+
+	m_pVideoWidget->hideThumbnail();
+	m_pThumbnailCache->setVideoFile(sFileName);
 }
 
 // +-----------------------------------------------------------
@@ -414,14 +462,32 @@ QMediaPlayer *fsdk::VideoWindow::mediaPlayer()
 	return m_pMediaPlayer;
 }
 
+// +-----------------------------------------------------------
+double fsdk::VideoWindow::frameRate() const
+{
+	double dFPS = m_pMediaPlayer->metaData(QMediaMetaData::VideoFrameRate).toDouble();
+	return dFPS > 0 ? dFPS : 30;
+}
+
 // +-----------------------------------------------------------
 void fsdk::VideoWindow::updateProgressTime()
 {
+	// Do not move the slider under the user while it is being dragged
+	if(m_pProgressSlider->isSliderDown())
+		return;
+
 	uint iPos = m_pMediaPlayer->position() / 1000;
 	m_pProgressSlider->blockSignals(true);
 	m_pProgressSlider->setValue(iPos);
 	m_pProgressSlider->blockSignals(false);
 
+	updateProgressTime(m_pMediaPlayer->position());
+}
+
+// +-----------------------------------------------------------
+void fsdk::VideoWindow::updateProgressTime(qint64 iPosition)
+{
+	uint iPos = iPosition / 1000;
 	QTime oElapsed = QTime(0, 0, 0).addSecs(iPos);
 	QTime oRemaining = QTime(0, 0, 0).addSecs((m_pMediaPlayer->duration() / 1000) - (iPos));
 
@@ -432,5 +498,48 @@ void fsdk::VideoWindow::updateProgressTime()
 // +-----------------------------------------------------------
 void fsdk::VideoWindow::sliderValueChanged(int iValue)
 {
-	emit seek(iValue * 1000);
+	// While the slider is dragged, only the cached thumbnails are displayed
+	// (seeking the media player at each move is too slow for long videos)
+	if(m_pProgressSlider->isSliderDown())
+	{
+		scrubbed(iValue * 1000);
+		m_pScrubTimer->start();
+	}
+	else
+		emit seek(iValue * 1000);
+}
+
+// +-----------------------------------------------------------
+void fsdk::VideoWindow::sliderPressed()
+{
+	scrubbed(m_pProgressSlider->value() * 1000);
+}
+
+// +-----------------------------------------------------------
+void fsdk::VideoWindow::sliderReleased()
+{
+	m_pScrubTimer->stop();
+	m_iScrubSeek = -1;
+	emit seek(m_pProgressSlider->value() * 1000);
+}
+
+// +-----------------------------------------------------------
+void fsdk::VideoWindow::scrubTimeout()
+{
+	if(m_pProgressSlider->isSliderDown())
+	{
+		m_iScrubSeek = m_pProgressSlider->value() * 1000;
+		emit seek(m_iScrubSeek);
+	}
+}
+
+// +-----------------------------------------------------------
+void fsdk::VideoWindow::scrubbed(qint64 iPosition)
+{
+	// A new position was scrubbed, so the frame of any previous seek is outdated
+	m_iScrubSeek = -1;
+	QImage oThumbnail = m_pThumbnailCache->thumbnail(iPosition);
+	if(!oThumbnail.isNull())
+		m_pVideoWidget->showThumbnail(oThumbnail);
+	updateProgressTime(iPosition);
 }
\ No newline at end of file
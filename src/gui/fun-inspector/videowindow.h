@@ -22,12 +22,14 @@
 
 #include "videowidget.h"
 #include "volumebutton.h"
+#include "thumbnailcache.h"
 #include <QMdiSubWindow>
 #include <QAction>
 #include <QToolBar>
 #include <QMenu>
 #include <QMediaPlayer>
 #include <QSlider>
+#include <QTimer>
 
 namespace fsdk
 {
@@ -108,6 +110,13 @@ namespace fsdk
 		 */
 		QMediaPlayer *mediaPlayer();
 
+		/**
+		 * Gets the frame rate of the video being played (or 30 if it is
+		 * not known yet).
+		 * @return Double with the frame rate in frames per second.
+		 */
+		double frameRate() const;
+
 	signals:
 
 		/**
@@ -122,6 +131,12 @@ namespace fsdk
 		 */
 		void seek(qint64 iValue);
 
+		/**
+		 * Signal indicating that the frame rate of the video is known.
+		 * @param dFrameRate Double with the frame rate in frames per second.
+		 */
+		void frameRateChanged(double dFrameRate);
+
 	public slots:
 
 		/**
@@ -184,6 +199,12 @@ namespace fsdk
 		 */
 		void mediaDurationChanged(qint64 iDuration);
 
+		/**
+		 * Captures indications of changes in the media meta data (used
+		 * to report the frame rate of the video).
+		 */
+		void mediaMetaDataChanged();
+
 		/**
 		 * Captures indications on changes made by the user in the position
 		 * of the progress slider.
@@ -191,6 +212,25 @@ namespace fsdk
 		 */
 		void sliderValueChanged(int iValue);
 
+		/**
+		 * Captures the indication that the user pressed the progress slider
+		 * (so the scrubbing of the video timeline begins).
+		 */
+		void sliderPressed();
+
+		/**
+		 * Captures the indication that the user released the progress slider
+		 * (so the scrubbing ends and the media player is seeked).
+		 */
+		void sliderReleased();
+
+		/**
+		 * Captures the indication that the user stopped dragging the progress
+		 * slider for a while, so the media player is seeked to the current
+		 * slider position even though the slider is still pressed.
+		 */
+		void scrubTimeout();
+
 	protected:
 
 		/**
@@ -209,9 +249,38 @@ namespace fsdk
 		 */
 		void updateProgressTime();
 
+		/**
+		 * Queries if the user is scrubbing the video (i.e. holding the progress
+		 * slider), case in which the frame displayed is the one scrubbed and
+		 * not the one of the player.
+		 * @return Boolean indicating if the video is being scrubbed (true) or
+		 * not (false).
+		 */
+		bool isScrubbing() const;
+
+		/**
+		 * Updates the labels with the progress time.
+		 * @param iPosition Long integer with the position to display, in
+		 * milliseconds.
+		 */
+		void updateProgressTime(qint64 iPosition);
+
+		/**
+		 * Handles the scrubbing of the video timeline to the given position
+		 * (i.e. while the user drags the progress slider, before the media
+		 * player is actually seeked). The default implementation displays
+		 * the nearest cached thumbnail.
+		 * @param iPosition Long integer with the scrubbed position in
+		 * milliseconds.
+		 */
+		virtual void scrubbed(qint64 iPosition);
+
 		/** Video displayed at this window. */
 		VideoWidget *m_pVideoWidget;
 
+		/** Window toolbar. */
+		QToolBar *m_pToolbar;
+
     private:
 
 		/** The default parent of this window (kept safe for use in detachment/attachment). */
@@ -220,9 +289,6 @@ namespace fsdk
 		/** Video progress slider. */
 		CustomSlider *m_pProgressSlider;
 
-		/** Window toolbar. */
-		QToolBar *m_pToolbar;
-
 		/** Toggle view action for this window. */
 		QAction *m_pToggleViewAction;
 
@@ -243,6 +309,15 @@ namespace fsdk
 		QLabel *m_pElapsedTime;
 
 		QLabel *m_pRemainingTime;
+
+		/** Cache with the thumbnails of the video, used while scrubbing. */
+		ThumbnailCache *m_pThumbnailCache;
+
+		/** Timer used to seek the media player when the user stops dragging the slider. */
+		QTimer *m_pScrubTimer;
+
+		/** Position of the seek done while scrubbing whose frame is still to be reported (or -1). */
+		qint64 m_iScrubSeek;
     };
 }
 
@@ -19,6 +19,7 @@
 
 #include "csvfile.h"
 #include <QDebug>
+#include <QSaveFile>
 #include <QRegularExpression>
 
 // +-----------------------------------------------------------
@@ -215,16 +216,56 @@ bool fsdk::CSVFile::read(const QString &sFilename, const bool bHeader)
 	return read(bHeader);
 }
 
+// +-----------------------------------------------------------
+bool fsdk::CSVFile::beginRead(const bool bHeader)
+{
+	if(!open(QIODevice::ReadOnly | QIODevice::Text))
+	{
+		qDebug().noquote() << QString("Error opening file %1 for reading").arg(fileName());
+		return false;
+	}
+
+	m_oReader.setDevice(this);
+	m_oReader.setCodec(m_pCodec);
+
+	m_lHeader.clear();
+	m_lLines.clear();
+	if(bHeader && !m_oReader.atEnd())
+		m_lHeader = readLine(m_oReader);
+
+	return true;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::CSVFile::readNext(QStringList &lLine)
+{
+	if(m_oReader.device() == NULL || m_oReader.atEnd())
+		return false;
+
+	lLine = readLine(m_oReader);
+	return true;
+}
+
+// +-----------------------------------------------------------
+void fsdk::CSVFile::endRead()
+{
+	m_oReader.setDevice(NULL);
+	close();
+}
+
 // +-----------------------------------------------------------
 bool fsdk::CSVFile::write()
 {
-	if(!open(QIODevice::WriteOnly | QIODevice::Text))
+	// The contents are written to a temporary file that only replaces the file
+	// when complete, so an interruption never leaves a partial CSV behind
+	QSaveFile oFile(fileName());
+	if(!oFile.open(QIODevice::WriteOnly | QIODevice::Text))
 	{
 		qDebug().noquote() << QString("Error opening file %1 for writing").arg(fileName());
 		return false;
 	}
 
-	QTextStream oWriter(this);
+	QTextStream oWriter(&oFile);
 
 	for(int i = 0; i < m_lHeader.count(); i++)
 	{
@@ -262,8 +303,13 @@ bool fsdk::CSVFile::write()
 				oWriter << endl;
 		}
 	}
-	
-	close();
+
+	oWriter.flush();
+	if(!oFile.commit())
+	{
+		qDebug().noquote() << QString("Error writing file %1").arg(fileName());
+		return false;
+	}
 	return true;
 }
 
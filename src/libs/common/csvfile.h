@@ -65,8 +65,35 @@ namespace fsdk
 		 */
 		bool read(const QString &sFilename, const bool bHeader = true);
 
+		/**
+		 * Opens the CSV file specified in fileName() for reading its records
+		 * one at a time with readNext() (instead of loading all of them into
+		 * memory with read()). If the CSV has a header, it is read and made
+		 * available in header() by this call.
+		 * @param bHeader Boolean indicating if the CSV has a header (true)
+		 * or not (false).
+		 * @return Boolean indicating if the file was opened (true) or not (false).
+		 */
+		bool beginRead(const bool bHeader = true);
+
+		/**
+		 * Reads the next record from a file opened with beginRead(). The record
+		 * is not added to lines().
+		 * @param lLine Reference to the QStringList to receive the record fields.
+		 * @return Boolean indicating if a record was read (true) or if the end
+		 * of the file has been reached (false).
+		 */
+		bool readNext(QStringList &lLine);
+
+		/**
+		 * Closes a file opened with beginRead().
+		 */
+		void endRead();
+
 		/**
 		 * Writes the contents of the CSV to the file specified in fileName().
+		 * The file is replaced atomically (see QSaveFile), so it keeps its
+		 * previous contents if the writting fails or is interrupted.
 		 * @return Boolean indicating if the writting was successful (true)
 		 * or not (false).
 		 */
@@ -146,6 +173,9 @@ namespace fsdk
 
 		/** Codec used to read/write the contents of the CSV. */
 		QTextCodec *m_pCodec;
+
+		/** Text stream used to read records one at a time (see beginRead()). */
+		QTextStream m_oReader;
 	};
 }
 
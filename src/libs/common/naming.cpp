@@ -18,10 +18,24 @@
  */
 
 #include "naming.h"
+#include "csvfile.h"
 #include <QRegularExpression>
 #include <QDir>
+#include <QDirIterator>
 #include <QFileInfo>
 
+// Directory that matches a directory and all of its subdirectories
+#define RECURSIVE_DIR "/**/"
+
+// Prefix of the arguments that refer to a manifest file
+#define MANIFEST_PREFIX "@"
+
+// Prefixes of the live inputs (see LiveSource), kept as they are in a manifest
+#define LIVE_PREFIXES { "camera:", "pipe:" }
+
+// Prefix of the image sequences (see ImageSequence), whose path is resolved in a manifest
+#define SEQUENCE_PREFIX "images:"
+
 // +-----------------------------------------------------------
 fsdk::Naming::Naming()
 {
@@ -35,6 +49,10 @@ fsdk::Naming::WildcardListingReturn fsdk::Naming::wildcardListing(const QString
 	// the first and the last wildcard characters)
 	QRegularExpression oWildcardRE("[\\?\\*\\[\\]].*[\\?\\*\\[\\]]|[\\?\\*\\[\\]]");
 
+	// The recursive wildcards are listed walking the subdirectories
+	if(isRecursiveWildcard(sSourceWildcard))
+		return recursiveListing(sSourceWildcard, sTargetWildcard, mMatchedListing);
+
 	// Check if the source wildcard has a wildcard in the proper place
 	QFileInfo oSource(sSourceWildcard);
 	QDir oSourceDir = oSource.dir();
@@ -69,36 +87,200 @@ fsdk::Naming::WildcardListingReturn fsdk::Naming::wildcardListing(const QString
 		return ListingOk;
 	}
 
-	// Otherwise, filter all source files with the given source wildcard
+	// Otherwise, filter all source files with the given source wildcard (listing
+	// the directory only once, and unsorted since the mapping sorts the names)
 	oSourceDir.setNameFilters(QStringList(sSourceFilePart));
-	if(oSourceDir.entryInfoList().count() == 0)
+	QStringList lFiles = oSourceDir.entryList(QDir::Files, QDir::NoSort);
+	if(lFiles.count() == 0)
 		return EmptySourceListing;
 
 	// Process the mapping to the target names according to the parts under
 	// the wildcard in the source names
-	QString sSourcePrefix = sSourceFilePart.mid(0, oSourceMatch.capturedStart(0));
-	QString sSourcePostfix = sSourceFilePart.mid(oSourceMatch.capturedEnd(0));
+	int iSourcePrefix = oSourceMatch.capturedStart(0);
+	int iSourcePostfix = sSourceFilePart.length() - oSourceMatch.capturedEnd(0);
 	QString sTargetPrefix = sTargetFilePart.mid(0, oTargetMatch.capturedStart(0));
 	QString sTargetPostfix = sTargetFilePart.mid(oTargetMatch.capturedEnd(0));
 
 	mMatchedListing.clear();
-	QString sMiddle, sSourceFilename, sTargetFilename;
-	int iPos, iLen;
-	foreach(QFileInfo oFile, oSourceDir.entryInfoList())
+	QString sSourcePath = oSourceDir.absolutePath();
+	QString sTargetPath = oTargetDir.absolutePath();
+	foreach(QString sFile, lFiles)
 	{
-		// Get the "real" text in the place of the wildcard in the source file name 
-		iPos = oFile.fileName().indexOf(sSourcePrefix) + sSourcePrefix.length();
-		iLen = oFile.fileName().indexOf(sSourcePostfix) - sSourcePrefix.length();
-		sMiddle = oFile.fileName().mid(iPos, iLen);
+		QString sTargetFile = matchedFileName(sFile, iSourcePrefix, iSourcePostfix, sTargetPrefix, sTargetPostfix);
+		mMatchedListing[QString("%1/%2").arg(sSourcePath, sFile)] = QString("%1/%2").arg(sTargetPath, sTargetFile);
+	}
+
+	return ListingOk;
+}
+
+// +-----------------------------------------------------------
+fsdk::Naming::WildcardListingReturn fsdk::Naming::recursiveListing(const QString &sSourceWildcard, const QString &sTargetWildcard, QMap<QString, QString> &mMatchedListing)
+{
+	// Same regular expression of wildcardListing()
+	QRegularExpression oWildcardRE("[\\?\\*\\[\\]].*[\\?\\*\\[\\]]|[\\?\\*\\[\\]]");
+
+	// Split the wildcards in the base directory and the file name (which
+	// can not have any other directory). A wildcard that starts with the
+	// recursive directory is relative to the current directory, and one that
+	// starts with the separator is relative to the root directory.
+	QString sSource = QDir::fromNativeSeparators(sSourceWildcard);
+	if(!sSource.contains(RECURSIVE_DIR))
+		sSource.prepend(".");
+	int iSourceRec = sSource.indexOf(RECURSIVE_DIR);
+	QString sSourceBase = sSource.left(iSourceRec);
+	QString sSourceFilePart = sSource.mid(iSourceRec + QString(RECURSIVE_DIR).length());
+	if(sSourceBase.isEmpty())
+		sSourceBase = "/";
+
+	if(sSourceBase.contains(oWildcardRE) || sSourceFilePart.contains('/'))
+		return InvalidSourceWildcard;
 
-		// Create a target name with that middle text in place of the target wildcard
-		sSourceFilename = QString("%1/%2").arg(oSourceDir.absolutePath(), oFile.fileName());
-		sTargetFilename = QString("%1/%2%3%4").arg(oTargetDir.absolutePath(), sTargetPrefix, sMiddle, sTargetPostfix);
+	if(!isRecursiveWildcard(sTargetWildcard))
+		return InvalidTargetWildcard;
+
+	QString sTarget = QDir::fromNativeSeparators(sTargetWildcard);
+	if(!sTarget.contains(RECURSIVE_DIR))
+		sTarget.prepend(".");
+	int iTargetRec = sTarget.indexOf(RECURSIVE_DIR);
+	QString sTargetBase = sTarget.left(iTargetRec);
+	QString sTargetFilePart = sTarget.mid(iTargetRec + QString(RECURSIVE_DIR).length());
+	if(sTargetBase.isEmpty())
+		sTargetBase = "/";
+
+	if(sTargetBase.contains(oWildcardRE) || sTargetFilePart.contains('/'))
+		return InvalidTargetWildcard;
+
+	// Check if the wildcards are the same in both arguments
+	QRegularExpressionMatch oSourceMatch = oWildcardRE.match(sSourceFilePart);
+	QRegularExpressionMatch oTargetMatch = oWildcardRE.match(sTargetFilePart);
 
-		// Add to the mapping
-		mMatchedListing[sSourceFilename] = sTargetFilename;
+	if(oSourceMatch.captured(0) != oTargetMatch.captured(0))
+		return DifferentWildcards;
+
+	QDir oSourceDir(sSourceBase);
+	if(!oSourceDir.exists())
+		return FileNotExist;
+	QDir oTargetDir(sTargetBase);
+
+	int iSourcePrefix = oSourceMatch.hasMatch() ? oSourceMatch.capturedStart(0) : sSourceFilePart.length();
+	int iSourcePostfix = oSourceMatch.hasMatch() ? sSourceFilePart.length() - oSourceMatch.capturedEnd(0) : 0;
+	QString sTargetPrefix = oTargetMatch.hasMatch() ? sTargetFilePart.mid(0, oTargetMatch.capturedStart(0)) : sTargetFilePart;
+	QString sTargetPostfix = oTargetMatch.hasMatch() ? sTargetFilePart.mid(oTargetMatch.capturedEnd(0)) : QString();
+
+	// Walk the tree one file at a time, mirroring the subdirectories of the
+	// source files in the target names
+	mMatchedListing.clear();
+	QDirIterator oIterator(oSourceDir.absolutePath(), QStringList(sSourceFilePart), QDir::Files, QDirIterator::Subdirectories);
+	while(oIterator.hasNext())
+	{
+		QString sSourceFilename = oIterator.next();
+		QString sSubdir = oSourceDir.relativeFilePath(oIterator.fileInfo().absolutePath());
+		QString sTargetFile = matchedFileName(oIterator.fileName(), iSourcePrefix, iSourcePostfix, sTargetPrefix, sTargetPostfix);
+		mMatchedListing[sSourceFilename] = QDir::cleanPath(QString("%1/%2/%3").arg(oTargetDir.absolutePath(), sSubdir, sTargetFile));
 	}
 
+	if(mMatchedListing.count() == 0)
+		return EmptySourceListing;
+
 	return ListingOk;
 }
 
+// +-----------------------------------------------------------
+QString fsdk::Naming::matchedFileName(const QString &sFileName, const int iSourcePrefix, const int iSourcePostfix, const QString &sTargetPrefix, const QString &sTargetPostfix)
+{
+	// Get the "real" text in the place of the wildcard in the source file name
+	// and create a target name with that middle text in place of the target wildcard
+	QString sMiddle = sFileName.mid(iSourcePrefix, sFileName.length() - iSourcePrefix - iSourcePostfix);
+	return QString("%1%2%3").arg(sTargetPrefix, sMiddle, sTargetPostfix);
+}
+
+// +-----------------------------------------------------------
+bool fsdk::Naming::isRecursiveWildcard(const QString &sWildcard)
+{
+	QString sPath = QDir::fromNativeSeparators(sWildcard);
+	return sPath.contains(RECURSIVE_DIR) || sPath.startsWith(QString(RECURSIVE_DIR).mid(1));
+}
+
+// +-----------------------------------------------------------
+bool fsdk::Naming::isManifest(const QString &sArgument)
+{
+	return sArgument.startsWith(MANIFEST_PREFIX) && sArgument.length() > 1;
+}
+
+// +-----------------------------------------------------------
+fsdk::Naming::ManifestListingReturn fsdk::Naming::manifestListing(const QString &sManifest, const int iTargets, QMap<QString, QStringList> &mMatchedListing, int &iLine)
+{
+	QString sFilename = sManifest.startsWith(MANIFEST_PREFIX) ? sManifest.mid(1) : sManifest;
+	QDir oBaseDir = QFileInfo(sFilename).absoluteDir();
+
+	QStringList lLivePrefixes = LIVE_PREFIXES;
+	QString sSequencePrefix = SEQUENCE_PREFIX;
+
+	iLine = 0;
+	CSVFile oManifest(sFilename);
+	if(!oManifest.beginRead(false))
+		return ManifestNotReadable;
+
+	mMatchedListing.clear();
+	QStringList lLine;
+	while(oManifest.readNext(lLine))
+	{
+		iLine++;
+
+		// Ignore the empty lines and the comments
+		if(lLine.count() == 0 || (lLine.count() == 1 && lLine[0].trimmed().isEmpty()) || lLine[0].startsWith('#'))
+			continue;
+
+		if(lLine.count() != iTargets + 1)
+		{
+			oManifest.endRead();
+			return InvalidManifestLine;
+		}
+
+		for(int i = 0; i < lLine.count(); i++)
+		{
+			QString sField = lLine[i].trimmed();
+			if(sField == "-")
+			{
+				lLine[i] = sField;
+				continue;
+			}
+
+			bool bLive = false;
+			foreach(QString sPrefix, lLivePrefixes)
+				bLive = bLive || sField.startsWith(sPrefix);
+			if(bLive)
+			{
+				lLine[i] = sField;
+				continue;
+			}
+
+			// Only the path of an image sequence is resolved (it may be absolute)
+			QString sPrefix;
+			if(sField.startsWith(sSequencePrefix))
+			{
+				sPrefix = sSequencePrefix;
+				sField = sField.mid(sSequencePrefix.length());
+			}
+
+			if(QDir::isRelativePath(sField))
+				sField = QDir::cleanPath(oBaseDir.absoluteFilePath(sField));
+			lLine[i] = sPrefix + sField;
+		}
+
+		QString sInput = lLine.takeFirst();
+		if(mMatchedListing.contains(sInput))
+		{
+			oManifest.endRead();
+			return DuplicateManifestInput;
+		}
+		mMatchedListing[sInput] = lLine;
+	}
+	oManifest.endRead();
+
+	if(mMatchedListing.count() == 0)
+		return EmptyManifest;
+
+	return ManifestOk;
+}
+
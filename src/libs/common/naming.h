@@ -22,6 +22,7 @@
 
 #include "libexport.h"
 #include <QMap>
+#include <QStringList>
 
 namespace fsdk
 {
@@ -62,6 +63,27 @@ namespace fsdk
 			ListingOk
 		};
 
+		/**
+		 * Possible returns of the manifestListing() method.
+		 */
+		enum ManifestListingReturn
+		{
+			/** The manifest file could not be read. */
+			ManifestNotReadable,
+
+			/** A line of the manifest does not have the number of files expected. */
+			InvalidManifestLine,
+
+			/** A line of the manifest lists an input already listed in a previous line. */
+			DuplicateManifestInput,
+
+			/** The manifest has no files. */
+			EmptyManifest,
+
+			/** The method concluded ok and the listing was produced. */
+			ManifestOk
+		};
+
 		/**
 		 * List existing files according to a given source wildcard
 		 * and produce new names according to the given target wildcard.
@@ -78,8 +100,17 @@ namespace fsdk
 		 *       similar to full regexps. Within the character class, like
 		 *       outside, backslash has no special meaning.
 		 *
+		 * The directory part may also contain a "**" directory (recursive wildcard)
+		 * that matches the directory before it and all of its subdirectories (for
+		 * instance, the directory "videos/**" with the file name "*.mp4" lists the
+		 * MP4 files in the whole tree of the directory "videos"). In that case the target wildcard must also
+		 * have a "**" directory, which is replaced by the subdirectory of each
+		 * source file (so the target files mirror the tree of the source files).
+		 * The subdirectories are walked file by file (see QDirIterator), so even
+		 * large trees are listed without loading each directory at once.
+		 *
 		 * @param sSourceWildcard Path and name of the source file, with wildcards
-		 * only in the filename part. This mask will be used to list the existing
+		 * only in the filename part (except for the recursive wildcard). This mask will be used to list the existing
 		 * files in disk and collected their names.
 		 * @param sTargetWildcard Path and name of the target file, with wildcards
 		 * only in the filename part. This mask will be used to create the new names
@@ -93,6 +124,76 @@ namespace fsdk
 		 * of success.
 		 */
 		static WildcardListingReturn wildcardListing(const QString &sSourceWildcard, const QString &sTargetWildcard, QMap<QString, QString> &mMatchedListing);
+
+		/**
+		 * Queries if the given wildcard has a recursive wildcard (a "**"
+		 * directory) in its directory part.
+		 * @param sWildcard QString with the path and name of the file.
+		 * @return Boolean indicating if the wildcard is recursive (true) or not (false).
+		 */
+		static bool isRecursiveWildcard(const QString &sWildcard);
+
+		/**
+		 * Queries if the given argument refers to a manifest file (i.e. the name
+		 * of the file prefixed by '@', as in "@batch.csv").
+		 * @param sArgument QString with the argument to check.
+		 * @return Boolean indicating if it is a manifest (true) or not (false).
+		 */
+		static bool isManifest(const QString &sArgument);
+
+		/**
+		 * List the files in a manifest file: a CSV file (without header) with a
+		 * source file and its target files in each line. The relative paths are
+		 * relative to the directory of the manifest; the lines that are empty or
+		 * start with '#' are ignored; the fields with a '-' or with the prefix of a
+		 * live input (such as "camera:0") are kept as they are; and only the path
+		 * after the prefix "images:" of an image sequence is resolved. Each input
+		 * can be listed only once. The manifest is read one
+		 * line at a time, so it can list large batches.
+		 * @param sManifest QString with the name of the manifest file (with or
+		 * without the '@' prefix).
+		 * @param iTargets Integer with the number of target files in each line.
+		 * @param mMatchedListing QMap<QString, QStringList> that maps the names of
+		 * the source files to the names of their target files.
+		 * @param iLine Reference to an integer to receive the number of the line
+		 * of the manifest read last (so an invalid line can be reported).
+		 * @return Value of the ManifestListingReturn with the return error or
+		 * indication of success.
+		 */
+		static ManifestListingReturn manifestListing(const QString &sManifest, const int iTargets, QMap<QString, QStringList> &mMatchedListing, int &iLine);
+
+	protected:
+
+		/**
+		 * List the files of a recursive source wildcard and produce the new names
+		 * according to the recursive target wildcard (see wildcardListing()).
+		 * @param sSourceWildcard Path and name of the source file, with a "**"
+		 * directory.
+		 * @param sTargetWildcard Path and name of the target file, with a "**"
+		 * directory.
+		 * @param mMatchedListing QMap<QString, QString> that maps the names of the
+		 * source files listed to the names of the target files.
+		 * @return Value of the WildcardListingReturn with the return error or indication
+		 * of success.
+		 */
+		static WildcardListingReturn recursiveListing(const QString &sSourceWildcard, const QString &sTargetWildcard, QMap<QString, QString> &mMatchedListing);
+
+		/**
+		 * Produces the name of a target file, by replacing the wildcard in the
+		 * target file name with the text matched by the wildcard in the source
+		 * file name.
+		 * @param sFileName QString with the name of the source file (without path).
+		 * @param iSourcePrefix Integer with the length of the text before the
+		 * wildcard in the source file name.
+		 * @param iSourcePostfix Integer with the length of the text after the
+		 * wildcard in the source file name.
+		 * @param sTargetPrefix QString with the text before the wildcard in the
+		 * target file name.
+		 * @param sTargetPostfix QString with the text after the wildcard in the
+		 * target file name.
+		 * @return QString with the name of the target file (without path).
+		 */
+		static QString matchedFileName(const QString &sFileName, const int iSourcePrefix, const int iSourcePostfix, const QString &sTargetPrefix, const QString &sTargetPostfix);
 	};
 }
 
@@ -0,0 +1,360 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "resultcache.h"
+#include "csvfile.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QCryptographicHash>
+#include <QApplication>
+#include <QDebug>
+#include <algorithm>
+
+// Name of the manifest file in the cache directory
+#define MANIFEST_FILE "manifest.csv"
+
+// Base name of the files of a result in its directory in the cache
+#define ENTRY_BASE_NAME "result"
+
+// Files up to this size (in bytes) are hashed entirely
+#define FULL_HASH_SIZE 1048576
+
+// Number and size (in bytes) of the blocks hashed in the larger files
+#define HASH_BLOCKS 16
+#define HASH_BLOCK_SIZE 65536
+
+// +-----------------------------------------------------------
+fsdk::ResultCache::ResultCache()
+{
+	m_iMaxSize = 0;
+	m_iSize = 0;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::ResultCache::open(const QString &sDirectory, const qint64 iMaxSize)
+{
+	if(!QDir().mkpath(sDirectory))
+	{
+		qWarning().noquote() << QApplication::translate("ResultCache", "could not create the cache directory %1").arg(sDirectory);
+		return false;
+	}
+
+	m_sDirectory = QDir(sDirectory).absolutePath();
+	m_iMaxSize = iMaxSize;
+	if(!readManifest())
+	{
+		m_sDirectory.clear();
+		return false;
+	}
+
+	if(m_iSize > m_iMaxSize)
+	{
+		evict(m_iMaxSize);
+		writeManifest();
+	}
+	return true;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::ResultCache::isOpen() const
+{
+	return !m_sDirectory.isEmpty();
+}
+
+// +-----------------------------------------------------------
+QString fsdk::ResultCache::hashFile(const QString &sFilename)
+{
+	QFile oFile(sFilename);
+	if(!oFile.open(QIODevice::ReadOnly))
+		return QString();
+
+	QCryptographicHash oHash(QCryptographicHash::Sha1);
+	qint64 iSize = oFile.size();
+	oHash.addData(QByteArray::number(iSize));
+
+	if(iSize <= FULL_HASH_SIZE)
+		oHash.addData(oFile.readAll());
+	else
+	{
+		// Hash blocks evenly spread from the begining to the end of the file
+		qint64 iStep = (iSize - HASH_BLOCK_SIZE) / (HASH_BLOCKS - 1);
+		for(int i = 0; i < HASH_BLOCKS; i++)
+		{
+			if(!oFile.seek(i * iStep))
+				return QString();
+			oHash.addData(oFile.read(HASH_BLOCK_SIZE));
+		}
+	}
+
+	return QString(oHash.result().toHex());
+}
+
+// +-----------------------------------------------------------
+QString fsdk::ResultCache::key(const QStringList &lFiles, const QStringList &lParameters)
+{
+	QCryptographicHash oHash(QCryptographicHash::Sha1);
+	foreach(QString sFile, lFiles)
+	{
+		QString sFileHash = hashFile(sFile);
+		if(sFileHash.isEmpty())
+			return QString();
+		oHash.addData(sFileHash.toUtf8());
+		oHash.addData("\n");
+	}
+
+	foreach(QString sParameter, lParameters)
+	{
+		oHash.addData(sParameter.toUtf8());
+		oHash.addData("\n");
+	}
+
+	return QString(oHash.result().toHex());
+}
+
+// +-----------------------------------------------------------
+bool fsdk::ResultCache::fetch(const QString &sKey, const QString &sFilename)
+{
+	if(!isOpen() || !m_mSizes.contains(sKey))
+		return false;
+
+	QDir oEntry(entryDirectory(sKey));
+	foreach(QString sFile, m_mFiles[sKey])
+	{
+		if(!QFile::exists(oEntry.filePath(ENTRY_BASE_NAME + sFile)))
+		{
+			remove(sKey);
+			writeManifest();
+			return false;
+		}
+	}
+
+	// The main file is the first, so the files derived from it (such as the
+	// summary pyramids, that are only valid if not older) are copied after it
+	QString sBase = baseName(sFilename);
+	foreach(QString sFile, m_mFiles[sKey])
+	{
+		// QFile::copy does not overwrite existing files
+		QString sTarget = sBase + sFile;
+		if(QFile::exists(sTarget) && !QFile::remove(sTarget))
+			return false;
+		if(!QFile::copy(oEntry.filePath(ENTRY_BASE_NAME + sFile), sTarget))
+			return false;
+	}
+
+	m_mLastUsed[sKey] = QDateTime::currentDateTimeUtc();
+	writeManifest();
+	return true;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::ResultCache::store(const QString &sKey, const QStringList &lFiles, const QString &sSource)
+{
+	if(!isOpen() || sKey.isEmpty() || lFiles.isEmpty())
+		return false;
+
+	// Name the files relative to the base name of the main file
+	QString sBase = baseName(lFiles.first());
+	QStringList lNames;
+	qint64 iSize = 0;
+	foreach(QString sFile, lFiles)
+	{
+		QString sPath = QFileInfo(sFile).absoluteFilePath();
+		QString sName = sPath.mid(sBase.length());
+		if(!sPath.startsWith(sBase) || sName.contains('/'))
+		{
+			qWarning().noquote() << QApplication::translate("ResultCache", "the file %1 does not belong to the result %2").arg(sFile, lFiles.first());
+			return false;
+		}
+
+		lNames.append(sName);
+		iSize += QFileInfo(sFile).size();
+	}
+
+	// A result bigger than the whole cache is not stored
+	if(iSize > m_iMaxSize)
+		return false;
+
+	// Copy to a temporary directory first, so a failure never leaves a partial result
+	QString sEntry = entryDirectory(sKey);
+	QString sTemp = sEntry + ".tmp";
+	QDir(sTemp).removeRecursively();
+	if(!QDir().mkpath(sTemp))
+		return false;
+
+	for(int i = 0; i < lFiles.count(); i++)
+	{
+		if(!QFile::copy(lFiles[i], QDir(sTemp).filePath(ENTRY_BASE_NAME + lNames[i])))
+		{
+			qWarning().noquote() << QApplication::translate("ResultCache", "could not copy the file %1 to the cache").arg(lFiles[i]);
+			QDir(sTemp).removeRecursively();
+			return false;
+		}
+	}
+
+	remove(sKey);
+	if(!QDir().rename(sTemp, sEntry))
+	{
+		QDir(sTemp).removeRecursively();
+		writeManifest();
+		return false;
+	}
+
+	evict(m_iMaxSize - iSize);
+	m_mSizes[sKey] = iSize;
+	m_mLastUsed[sKey] = QDateTime::currentDateTimeUtc();
+	m_mSources[sKey] = sSource;
+	m_mFiles[sKey] = lNames;
+	m_iSize += iSize;
+
+	return writeManifest();
+}
+
+// +-----------------------------------------------------------
+int fsdk::ResultCache::count() const
+{
+	return m_mSizes.count();
+}
+
+// +-----------------------------------------------------------
+qint64 fsdk::ResultCache::size() const
+{
+	return m_iSize;
+}
+
+// +-----------------------------------------------------------
+qint64 fsdk::ResultCache::maxSize() const
+{
+	return m_iMaxSize;
+}
+
+// +-----------------------------------------------------------
+QString fsdk::ResultCache::entryDirectory(const QString &sKey) const
+{
+	return QDir(m_sDirectory).filePath(sKey);
+}
+
+// +-----------------------------------------------------------
+QString fsdk::ResultCache::baseName(const QString &sFilename)
+{
+	QFileInfo oFile(sFilename);
+	return oFile.absoluteDir().filePath(oFile.completeBaseName());
+}
+
+// +-----------------------------------------------------------
+bool fsdk::ResultCache::readManifest()
+{
+	m_mSizes.clear();
+	m_mLastUsed.clear();
+	m_mSources.clear();
+	m_mFiles.clear();
+	m_iSize = 0;
+
+	// A new cache has no manifest yet
+	QString sManifest = QDir(m_sDirectory).filePath(MANIFEST_FILE);
+	if(!QFile::exists(sManifest))
+		return true;
+
+	CSVFile oManifest;
+	if(!oManifest.read(sManifest))
+	{
+		qWarning().noquote() << QApplication::translate("ResultCache", "could not read the manifest of the cache %1").arg(m_sDirectory);
+		return false;
+	}
+
+	foreach(QStringList lLine, oManifest.lines())
+	{
+		if(lLine.count() < 5)
+			continue;
+
+		// The names of the files are separated by '/' (not valid in a name)
+		QString sKey = lLine[0];
+		QStringList lNames = lLine[4].split('/');
+		QDir oEntry(entryDirectory(sKey));
+		qint64 iSize = 0;
+		bool bComplete = true;
+		foreach(QString sName, lNames)
+		{
+			QFileInfo oFile(oEntry.filePath(ENTRY_BASE_NAME + sName));
+			bComplete = bComplete && oFile.exists();
+			iSize += oFile.size();
+		}
+		if(!bComplete)
+			continue;
+
+		m_mSizes[sKey] = iSize;
+		m_mLastUsed[sKey] = QDateTime::fromString(lLine[2], Qt::ISODate);
+		m_mSources[sKey] = lLine[3];
+		m_mFiles[sKey] = lNames;
+		m_iSize += iSize;
+	}
+
+	return true;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::ResultCache::writeManifest() const
+{
+	CSVFile oManifest;
+	oManifest.header().append({ "Key", "Size", "LastUsed", "Source", "Files" });
+
+	QMap<QString, qint64>::const_iterator it;
+	for(it = m_mSizes.cbegin(); it != m_mSizes.cend(); ++it)
+		oManifest.addLine({ it.key(), QString::number(it.value()), m_mLastUsed[it.key()].toString(Qt::ISODate), m_mSources[it.key()], m_mFiles[it.key()].join('/') });
+
+	if(!oManifest.write(QDir(m_sDirectory).filePath(MANIFEST_FILE)))
+	{
+		qWarning().noquote() << QApplication::translate("ResultCache", "could not write the manifest of the cache %1").arg(m_sDirectory);
+		return false;
+	}
+	return true;
+}
+
+// +-----------------------------------------------------------
+void fsdk::ResultCache::evict(const qint64 iMaxSize)
+{
+	if(m_iSize <= iMaxSize)
+		return;
+
+	// Sort the keys by the time of their last use (the oldest first)
+	QList<QPair<QDateTime, QString>> lUses;
+	QMap<QString, QDateTime>::const_iterator it;
+	for(it = m_mLastUsed.cbegin(); it != m_mLastUsed.cend(); ++it)
+		lUses.append(qMakePair(it.value(), it.key()));
+	std::sort(lUses.begin(), lUses.end());
+
+	for(int i = 0; i < lUses.count() && m_iSize > iMaxSize; i++)
+	{
+		qDebug().noquote() << QApplication::translate("ResultCache", "evicting the result of %1 from the cache").arg(m_mSources[lUses[i].second]);
+		remove(lUses[i].second);
+	}
+}
+
+// +-----------------------------------------------------------
+void fsdk::ResultCache::remove(const QString &sKey)
+{
+	if(!m_mSizes.contains(sKey))
+		return;
+
+	QDir(entryDirectory(sKey)).removeRecursively();
+	m_iSize -= m_mSizes.take(sKey);
+	m_mLastUsed.remove(sKey);
+	m_mSources.remove(sKey);
+	m_mFiles.remove(sKey);
+}
\ No newline at end of file
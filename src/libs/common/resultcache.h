@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RESULTCACHE_H
+#define RESULTCACHE_H
+
+#include "libexport.h"
+#include <QString>
+#include <QStringList>
+#include <QMap>
+#include <QDateTime>
+
+namespace fsdk
+{
+	/**
+	 * Local cache of the result files of the extraction tools, addressed by
+	 * their contents: each result (a main file and the files saved along with
+	 * it, such as the files of the faces and the summary pyramids) is kept under
+	 * a key produced from a fast hash of the input files and from the parameters
+	 * of the extraction, so running
+	 * a tool again on unchanged files with the same parameters can take the
+	 * results from the cache instead of processing the files. The cache keeps a
+	 * manifest (a CSV file in its directory) with the size and the last use of
+	 * each result, and when its size exceeds the maximum the results used less
+	 * recently are evicted. It is not meant to be shared by executions running
+	 * at the same time.
+	 */
+	class SHARED_LIB_EXPORT ResultCache
+	{
+	public:
+		/**
+		 * Class constructor. The cache must be opened with open() before use.
+		 */
+		ResultCache();
+
+		/**
+		 * Opens the cache in the given directory (created if it does not exist)
+		 * and reads its manifest. The results above the maximum size are evicted.
+		 * @param sDirectory QString with the path of the cache directory.
+		 * @param iMaxSize Long integer with the maximum size of the results kept,
+		 * in bytes.
+		 * @return Boolean indicating if the cache was opened (true) or not (false).
+		 */
+		bool open(const QString &sDirectory, const qint64 iMaxSize);
+
+		/**
+		 * Queries if the cache is open.
+		 * @return Boolean indicating if the cache is open (true) or not (false).
+		 */
+		bool isOpen() const;
+
+		/**
+		 * Produces a fast hash of the contents of a file. The small files are
+		 * hashed entirely; for the large ones (such as the videos), only the size
+		 * and a fixed number of blocks evenly spread over the file are hashed, so
+		 * the cost does not depend on the size of the file.
+		 * @param sFilename QString with the name of the file.
+		 * @return QString with the hash in hexadecimal, or an empty QString if the
+		 * file could not be read.
+		 */
+		static QString hashFile(const QString &sFilename);
+
+		/**
+		 * Produces the key of a result, from the contents of the input files and
+		 * the parameters used to produce it.
+		 * @param lFiles QStringList with the names of the input files.
+		 * @param lParameters QStringList with the parameters of the extraction,
+		 * including the version of the tool (for instance, "quality=0.2").
+		 * @return QString with the key in hexadecimal, or an empty QString if any
+		 * of the files could not be read (i.e. the result can not be cached).
+		 */
+		static QString key(const QStringList &lFiles, const QStringList &lParameters);
+
+		/**
+		 * Copies all the files of the result with the given key from the cache.
+		 * The main file is copied to the given file, and the other files are
+		 * copied next to it, with its base name in place of the base name of
+		 * the main file they were stored with (i.e. "video-face1.csv" stored
+		 * with "video.csv" is copied to "clip-face1.csv" when fetching to
+		 * "clip.csv"). The main file is copied first, so the others are never
+		 * older than it.
+		 * @param sKey QString with the key of the result.
+		 * @param sFilename QString with the name of the main file to create (the
+		 * files are overwritten if they exist).
+		 * @return Boolean indicating if the result was in the cache and copied
+		 * (true) or not (false).
+		 */
+		bool fetch(const QString &sKey, const QString &sFilename);
+
+		/**
+		 * Copies the files of a result into the cache under the given key,
+		 * evicting the results used less recently if the cache gets too big.
+		 * @param sKey QString with the key of the result.
+		 * @param lFiles QStringList with the names of the files of the result.
+		 * The first one is the main file, and the others must be in the same
+		 * directory and have names starting with its base name (as the name of
+		 * the main file without the extension).
+		 * @param sSource QString with the name of the input of the result (only
+		 * recorded in the manifest, for reference).
+		 * @return Boolean indicating if the result was stored (true) or not (false).
+		 */
+		bool store(const QString &sKey, const QStringList &lFiles, const QString &sSource);
+
+		/**
+		 * Gets the number of results in the cache.
+		 * @return Integer with the number of results.
+		 */
+		int count() const;
+
+		/**
+		 * Gets the size of the results in the cache.
+		 * @return Long integer with the size in bytes.
+		 */
+		qint64 size() const;
+
+		/**
+		 * Gets the maximum size of the results in the cache.
+		 * @return Long integer with the maximum size in bytes.
+		 */
+		qint64 maxSize() const;
+
+	protected:
+
+		/**
+		 * Gets the name of the directory with the files of a result in the
+		 * cache directory.
+		 * @param sKey QString with the key of the result.
+		 * @return QString with the path of the directory.
+		 */
+		QString entryDirectory(const QString &sKey) const;
+
+		/**
+		 * Gets the path and base name of a file (its name without the extension),
+		 * from which the names of the files of a result are derived.
+		 * @param sFilename QString with the name of the file.
+		 * @return QString with the absolute path and base name of the file.
+		 */
+		static QString baseName(const QString &sFilename);
+
+		/**
+		 * Reads the manifest of the cache, discarding the entries whose files
+		 * no longer exist.
+		 * @return Boolean indicating if the manifest was read (true) or not (false).
+		 */
+		bool readManifest();
+
+		/**
+		 * Writes the manifest of the cache.
+		 * @return Boolean indicating if the manifest was written (true) or not (false).
+		 */
+		bool writeManifest() const;
+
+		/**
+		 * Removes the results used less recently until the size of the cache
+		 * is not above the given size.
+		 * @param iMaxSize Long integer with the size to achieve, in bytes.
+		 */
+		void evict(const qint64 iMaxSize);
+
+		/**
+		 * Removes a result from the cache (its files and its entry in the manifest).
+		 * @param sKey QString with the key of the result.
+		 */
+		void remove(const QString &sKey);
+
+	private:
+
+		/** Path of the cache directory (empty if the cache is not open). */
+		QString m_sDirectory;
+
+		/** Maximum size of the results in the cache, in bytes. */
+		qint64 m_iMaxSize;
+
+		/** Size of the results in the cache, in bytes. */
+		qint64 m_iSize;
+
+		/** Size of each result, by key. */
+		QMap<QString, qint64> m_mSizes;
+
+		/** Time of the last use of each result, by key. */
+		QMap<QString, QDateTime> m_mLastUsed;
+
+		/** Input of each result (for reference), by key. */
+		QMap<QString, QString> m_mSources;
+
+		/**
+		 * Names of the files of each result, by key. The names are relative
+		 * to the base name of the main file (the first one), so ".csv" is
+		 * the main file "video.csv" and "-face1.csv" is the file "video-face1.csv".
+		 */
+		QMap<QString, QStringList> m_mFiles;
+	};
+}
+
+#endif // RESULTCACHE_H
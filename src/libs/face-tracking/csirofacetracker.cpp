@@ -22,6 +22,9 @@
 #include <QCoreApplication>
 #include <exception>
 
+// Number of landmarks of the CSIRO tracker (Multi-PIE markup without the inner mouth corners)
+#define CSIRO_LANDMARKS_COUNT 66
+
 // +-----------------------------------------------------------
 fsdk::CSIROFaceTracker::CSIROFaceTracker()
 {
@@ -88,4 +91,86 @@ void fsdk::CSIROFaceTracker::reset()
 	m_pTracker->Reset();
 	m_lLandmarks.clear();
 	m_fQuality = 0.0f;
+}
+
+// +-----------------------------------------------------------
+int fsdk::CSIROFaceTracker::landmarksCount() const
+{
+	return CSIRO_LANDMARKS_COUNT;
+}
+
+// +-----------------------------------------------------------
+int fsdk::CSIROFaceTracker::landmarkIndex(const Landmark eLandmark) const
+{
+	return csiroLandmarkIndex(eLandmark);
+}
+
+// +-----------------------------------------------------------
+int fsdk::CSIROFaceTracker::csiroLandmarkIndex(const Landmark eLandmark)
+{
+	switch(eLandmark)
+	{
+		case LeftEyeInnerCorner:
+			return 39;
+
+		case LeftEyeOuterCorner:
+			return 36;
+
+		case RightEyeInnerCorner:
+			return 42;
+
+		case RightEyeOuterCorner:
+			return 45;
+
+		case NoseTip:
+			return 30;
+
+		case MouthLeftCorner:
+			return 48;
+
+		case MouthRightCorner:
+			return 54;
+
+		case ChinTip:
+			return 8;
+
+		case UpperLipInner:
+			return 61;
+
+		case LowerLipInner:
+			return 64;
+
+		default:
+			return -1;
+	}
+}
+
+// +-----------------------------------------------------------
+QString fsdk::CSIROFaceTrackerBackend::name() const
+{
+	return "csiro";
+}
+
+// +-----------------------------------------------------------
+QString fsdk::CSIROFaceTrackerBackend::description() const
+{
+	return QCoreApplication::translate("CSIROFaceTracker", "CSIRO Face Analysis SDK tracker (66 landmarks)");
+}
+
+// +-----------------------------------------------------------
+int fsdk::CSIROFaceTrackerBackend::landmarksCount() const
+{
+	return CSIRO_LANDMARKS_COUNT;
+}
+
+// +-----------------------------------------------------------
+int fsdk::CSIROFaceTrackerBackend::landmarkIndex(const FaceTracker::Landmark eLandmark) const
+{
+	return CSIROFaceTracker::csiroLandmarkIndex(eLandmark);
+}
+
+// +-----------------------------------------------------------
+fsdk::FaceTracker* fsdk::CSIROFaceTrackerBackend::create() const
+{
+	return new CSIROFaceTracker();
 }
\ No newline at end of file
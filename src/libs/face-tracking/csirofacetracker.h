@@ -21,6 +21,7 @@
 #define CSIROFACETRACKER_H
 
 #include "facetracker.h"
+#include "facetrackerregistry.h"
 
 // Predefinition of the CSIRO face tracker classes
 namespace FACETRACKER
@@ -36,7 +37,7 @@ namespace fsdk
 	 * Specific implementations must inherit this class
 	 * and implement its pure virtual methods.
 	 */
-	class SHARED_LIB_EXPORT CSIROFaceTracker: FaceTracker
+	class SHARED_LIB_EXPORT CSIROFaceTracker: public FaceTracker
 	{
 	public:
 		/**
@@ -81,11 +82,27 @@ namespace fsdk
 
 		/**
 		 * Queries the total number of facial landmarks supported by the
-		 * implemented tracker. This method should be overwritten by the
-		 * children classes. The CSIRO Face Tracking SDK uses 66 landmarks.
-		 * @return Unsigned integer with the number of landmarks supported.
+		 * implemented tracker. The CSIRO Face Tracking SDK uses 66 landmarks.
+		 * @return Integer with the number of landmarks supported.
 		 */
-		static uint landmarksCount() { return 66; };
+		int landmarksCount() const;
+
+		/**
+		 * Queries the index of a semantic landmark in the landmarks of the
+		 * tracker (the CSIRO Face Tracking SDK uses the Multi-PIE markup
+		 * without the inner corners of the mouth).
+		 * @param eLandmark Value of the Landmark enumeration with the landmark.
+		 * @return Integer with the index of the landmark.
+		 */
+		int landmarkIndex(const Landmark eLandmark) const;
+
+		/**
+		 * Gets the index of a semantic landmark without requiring an instance
+		 * of the tracker (whose construction loads the CSIRO models).
+		 * @param eLandmark Value of the Landmark enumeration with the landmark.
+		 * @return Integer with the index of the landmark.
+		 */
+		static int csiroLandmarkIndex(const Landmark eLandmark);
 
 		/**
 		 * Resets the tracking by attempting to find the face again in the next
@@ -107,6 +124,45 @@ namespace fsdk
 		/** Cached list of the landmarks obtained from the previous tracking. */
 		QList<QPoint> m_lLandmarks;
 	};
+
+	/**
+	 * Backend of the CSIRO Face Tracker, registered in the FaceTrackerRegistry
+	 * with the name "csiro".
+	 */
+	class SHARED_LIB_EXPORT CSIROFaceTrackerBackend: public FaceTrackerBackend
+	{
+	public:
+		/**
+		 * Gets the name of the backend.
+		 * @return QString with the name "csiro".
+		 */
+		QString name() const;
+
+		/**
+		 * Gets the description of the backend.
+		 * @return QString with the description of the backend.
+		 */
+		QString description() const;
+
+		/**
+		 * Gets the number of landmarks of the tracker.
+		 * @return Integer with the number of landmarks (66).
+		 */
+		int landmarksCount() const;
+
+		/**
+		 * Gets the index of a semantic landmark in the landmarks of the tracker.
+		 * @param eLandmark Value of the FaceTracker::Landmark enumeration with the landmark.
+		 * @return Integer with the index of the landmark.
+		 */
+		int landmarkIndex(const FaceTracker::Landmark eLandmark) const;
+
+		/**
+		 * Creates a new instance of the CSIROFaceTracker.
+		 * @return Instance of the CSIROFaceTracker (it must be deleted by the caller).
+		 */
+		FaceTracker *create() const;
+	};
 }
 
 #endif // CSIROFACETRACKER_H
\ No newline at end of file
@@ -24,6 +24,7 @@
 #include <opencv2\core\core.hpp>
 #include <QList>
 #include <QPoint>
+#include <QString>
 
 using namespace cv;
 
@@ -37,6 +38,49 @@ namespace fsdk
 	class SHARED_LIB_EXPORT FaceTracker
 	{
 	public:
+		/**
+		 * Class destructor.
+		 */
+		virtual ~FaceTracker() {};
+
+		/**
+		 * Facial landmarks with a semantic meaning, whose indexes may vary
+		 * among the different trackers (see landmarkIndex()). Left and right
+		 * refer to the sides of the image.
+		 */
+		enum Landmark
+		{
+			/** Inner corner of the left eye. */
+			LeftEyeInnerCorner,
+
+			/** Outer corner of the left eye. */
+			LeftEyeOuterCorner,
+
+			/** Inner corner of the right eye. */
+			RightEyeInnerCorner,
+
+			/** Outer corner of the right eye. */
+			RightEyeOuterCorner,
+
+			/** Tip of the nose. */
+			NoseTip,
+
+			/** Left corner of the mouth. */
+			MouthLeftCorner,
+
+			/** Right corner of the mouth. */
+			MouthRightCorner,
+
+			/** Tip of the chin. */
+			ChinTip,
+
+			/** Middle of the inner contour of the upper lip. */
+			UpperLipInner,
+
+			/** Middle of the inner contour of the lower lip. */
+			LowerLipInner
+		};
+
 		/**
 		 * Tracks a face in the given frame. If the frame is the first one
 		 * (after the class has been instantiated or a call to reset() has 
@@ -67,13 +111,58 @@ namespace fsdk
 		 */
 		virtual QList<QPoint> getLandmarks() const = 0;
 
+		/**
+		 * Tracks a face in a sequence of consecutive frames. Trackers that can
+		 * process several frames at once (for instance, in a GPU) should
+		 * overwrite this method. The default implementation simply tracks the
+		 * frames one by one.
+		 * @param lFrames Reference to a QList of OpenCV's Mat with the frames.
+		 * @param lLandmarks Reference to a QList to receive the landmarks tracked
+		 * in each frame (see getLandmarks()).
+		 * @param lQualities Reference to a QList to receive the quality of the
+		 * tracking in each frame (see getQuality()).
+		 */
+		virtual void track(QList<Mat> &lFrames, QList<QList<QPoint>> &lLandmarks, QList<float> &lQualities)
+		{
+			lLandmarks.clear();
+			lQualities.clear();
+			for(int i = 0; i < lFrames.count(); i++)
+			{
+				track(lFrames[i]);
+				lLandmarks.append(getLandmarks());
+				lQualities.append(getQuality());
+			}
+		};
+
+		/**
+		 * Gives the tracker a prediction of the landmarks in the next frame
+		 * to be tracked (for instance, from a temporal filter of the previous
+		 * landmarks), that it might use as an initial guess. The prediction
+		 * is valid only for the next call to track(). The default
+		 * implementation ignores it.
+		 * @param lLandmarks QList of QPoint with the predicted landmarks, or
+		 * an empty QList if there is no prediction.
+		 */
+		virtual void setPrediction(const QList<QPoint> &lLandmarks)
+		{
+			Q_UNUSED(lLandmarks);
+		};
+
 		/**
 		 * Queries the total number of facial landmarks supported by the
-		 * implemented tracker. This method should be overwritten by the
-		 * children classes. The default implementation returns 0.
-		 * @return Unsigned integer with the number of landmarks supported.
+		 * implemented tracker.
+		 * @return Integer with the number of landmarks supported.
+		 */
+		virtual int landmarksCount() const = 0;
+
+		/**
+		 * Queries the index of a semantic landmark in the landmarks of the
+		 * tracker (see getLandmarks()).
+		 * @param eLandmark Value of the Landmark enumeration with the landmark.
+		 * @return Integer with the index of the landmark, or -1 if the tracker
+		 * does not provide it.
 		 */
-		static uint landmarksCount() { return 0; };
+		virtual int landmarkIndex(const Landmark eLandmark) const = 0;
 
 		/**
 		 * Resets the tracking by attempting to redetect the face in the next
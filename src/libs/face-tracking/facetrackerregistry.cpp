@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "facetrackerregistry.h"
+#include "csirofacetracker.h"
+#include <QMutexLocker>
+
+QMap<QString, fsdk::FaceTrackerBackend*> fsdk::FaceTrackerRegistry::m_mBackends;
+QString fsdk::FaceTrackerRegistry::m_sDefault;
+QMutex fsdk::FaceTrackerRegistry::m_oMutex;
+
+// +-----------------------------------------------------------
+void fsdk::FaceTrackerRegistry::registerBuiltInBackends()
+{
+	if(!m_mBackends.isEmpty())
+		return;
+
+	FaceTrackerBackend *pBackend = new CSIROFaceTrackerBackend();
+	m_mBackends[pBackend->name()] = pBackend;
+	m_sDefault = pBackend->name();
+}
+
+// +-----------------------------------------------------------
+void fsdk::FaceTrackerRegistry::registerBackend(FaceTrackerBackend *pBackend)
+{
+	QMutexLocker oLocker(&m_oMutex);
+	registerBuiltInBackends();
+
+	// The previous instances are not deleted, since they may still be in use
+	m_mBackends[pBackend->name()] = pBackend;
+}
+
+// +-----------------------------------------------------------
+QStringList fsdk::FaceTrackerRegistry::backends()
+{
+	QMutexLocker oLocker(&m_oMutex);
+	registerBuiltInBackends();
+	return m_mBackends.keys();
+}
+
+// +-----------------------------------------------------------
+const fsdk::FaceTrackerBackend* fsdk::FaceTrackerRegistry::backend(const QString &sName)
+{
+	QMutexLocker oLocker(&m_oMutex);
+	registerBuiltInBackends();
+	return m_mBackends.value(sName.isEmpty() ? m_sDefault : sName, NULL);
+}
+
+// +-----------------------------------------------------------
+QString fsdk::FaceTrackerRegistry::defaultBackend()
+{
+	QMutexLocker oLocker(&m_oMutex);
+	registerBuiltInBackends();
+	return m_sDefault;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::FaceTrackerRegistry::setDefaultBackend(const QString &sName)
+{
+	QMutexLocker oLocker(&m_oMutex);
+	registerBuiltInBackends();
+	if(!m_mBackends.contains(sName))
+		return false;
+
+	m_sDefault = sName;
+	return true;
+}
+
+// +-----------------------------------------------------------
+fsdk::FaceTracker* fsdk::FaceTrackerRegistry::create(const QString &sName)
+{
+	const FaceTrackerBackend *pBackend = backend(sName);
+	return pBackend ? pBackend->create() : NULL;
+}
\ No newline at end of file
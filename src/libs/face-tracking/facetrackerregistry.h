@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef FACETRACKERREGISTRY_H
+#define FACETRACKERREGISTRY_H
+
+#include "facetracker.h"
+#include <QString>
+#include <QStringList>
+#include <QMap>
+#include <QMutex>
+
+namespace fsdk
+{
+	/**
+	 * Describes a face tracker implementation (backend) and creates its
+	 * instances. New trackers are plugged in by inheriting this class and
+	 * registering an instance with FaceTrackerRegistry::registerBackend().
+	 */
+	class SHARED_LIB_EXPORT FaceTrackerBackend
+	{
+	public:
+		/**
+		 * Class destructor.
+		 */
+		virtual ~FaceTrackerBackend() {};
+
+		/**
+		 * Gets the name of the backend (used to select it, for instance in
+		 * command line options).
+		 * @return QString with the name of the backend.
+		 */
+		virtual QString name() const = 0;
+
+		/**
+		 * Gets the description of the backend, to be displayed.
+		 * @return QString with the description of the backend.
+		 */
+		virtual QString description() const = 0;
+
+		/**
+		 * Gets the number of landmarks of the trackers created by the backend
+		 * (without requiring an instance of the tracker).
+		 * @return Integer with the number of landmarks.
+		 */
+		virtual int landmarksCount() const = 0;
+
+		/**
+		 * Gets the index of a semantic landmark in the landmarks of the trackers
+		 * created by the backend (without requiring an instance of the tracker).
+		 * @param eLandmark Value of the FaceTracker::Landmark enumeration with the landmark.
+		 * @return Integer with the index of the landmark, or -1 if it is not provided.
+		 */
+		virtual int landmarkIndex(const FaceTracker::Landmark eLandmark) const = 0;
+
+		/**
+		 * Creates a new instance of the tracker.
+		 * @return Instance of the FaceTracker (it must be deleted by the caller).
+		 */
+		virtual FaceTracker *create() const = 0;
+	};
+
+	/**
+	 * Registry of the face tracker backends available. The CSIRO tracker is
+	 * always registered (with the name "csiro") and is the default backend.
+	 * All methods are thread-safe.
+	 */
+	class SHARED_LIB_EXPORT FaceTrackerRegistry
+	{
+	public:
+		/**
+		 * Registers a new backend. If a backend with the same name is already
+		 * registered, it is replaced.
+		 * @param pBackend Instance of the FaceTrackerBackend. The registry takes
+		 * the ownership of the instance.
+		 */
+		static void registerBackend(FaceTrackerBackend *pBackend);
+
+		/**
+		 * Gets the names of the backends registered.
+		 * @return QStringList with the names of the backends.
+		 */
+		static QStringList backends();
+
+		/**
+		 * Gets a backend by its name.
+		 * @param sName QString with the name of the backend. If it is empty,
+		 * the default backend is returned.
+		 * @return Instance of the FaceTrackerBackend, or NULL if there is no
+		 * backend registered with the given name.
+		 */
+		static const FaceTrackerBackend *backend(const QString &sName = QString());
+
+		/**
+		 * Gets the name of the default backend.
+		 * @return QString with the name of the default backend.
+		 */
+		static QString defaultBackend();
+
+		/**
+		 * Sets the default backend.
+		 * @param sName QString with the name of the backend.
+		 * @return Boolean indicating if the backend is registered and was set
+		 * as default (true) or not (false).
+		 */
+		static bool setDefaultBackend(const QString &sName);
+
+		/**
+		 * Creates a new tracker with the given backend.
+		 * @param sName QString with the name of the backend. If it is empty,
+		 * the default backend is used.
+		 * @return Instance of the FaceTracker (it must be deleted by the caller),
+		 * or NULL if there is no backend registered with the given name.
+		 */
+		static FaceTracker *create(const QString &sName = QString());
+
+	protected:
+
+		/**
+		 * Registers the built-in backends, if not done yet. It must be called
+		 * with the mutex locked.
+		 */
+		static void registerBuiltInBackends();
+
+	private:
+
+		/** Backends registered (name x instance). */
+		static QMap<QString, FaceTrackerBackend*> m_mBackends;
+
+		/** Name of the default backend. */
+		static QString m_sDefault;
+
+		/** Mutex to protect the access to the registry. */
+		static QMutex m_oMutex;
+	};
+}
+
+#endif // FACETRACKERREGISTRY_H
@@ -0,0 +1,365 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "multifacetracker.h"
+#include <opencv2/imgproc/imgproc.hpp>
+#include <QCoreApplication>
+#include <QFile>
+#include <QDir>
+#include <QDebug>
+#include <stdexcept>
+#include <algorithm>
+
+// Name of the default Haar cascade file (searched in the directory of the application)
+#define DEFAULT_DETECTOR "haarcascade_frontalface_alt2.xml"
+
+// Maximum width of the frames for the detection (larger frames are downscaled)
+#define DETECTION_WIDTH 640
+
+// Minimum size of the faces detected (in the downscaled frame)
+#define MIN_FACE_SIZE 40
+
+// Minimum overlap for a detection to be taken as a face already tracked (or lost)
+#define DETECTION_OVERLAP 0.3
+
+// Minimum overlap for two trackers to be taken as tracking the same face
+#define DUPLICATE_OVERLAP 0.5
+
+// Number of frames during which the ID of a lost face can be reused
+#define LOST_TIMEOUT 90
+
+// +-----------------------------------------------------------
+fsdk::MultiFaceTracker::MultiFaceTracker(const QString &sBackend, const int iMaxFaces, const double dScale, const float fResetQuality)
+{
+	m_sBackend = sBackend;
+	m_iMaxFaces = qMax(iMaxFaces, 1);
+	m_dScale = qMin(qMax(dScale, 0.05), 1.0);
+	m_fResetQuality = qMax(qMin(fResetQuality, 1.0f), 0.0f);
+	m_iDetectionInterval = 15;
+	m_iFramesToDetection = 0;
+	m_iFrame = 0;
+	m_iNextId = 0;
+
+	QString sDetector = QDir(QCoreApplication::applicationDirPath()).filePath(DEFAULT_DETECTOR);
+	if(QFile::exists(sDetector))
+		setDetector(sDetector);
+}
+
+// +-----------------------------------------------------------
+fsdk::MultiFaceTracker::~MultiFaceTracker()
+{
+	reset();
+	qDeleteAll(m_lIdle);
+}
+
+// +-----------------------------------------------------------
+bool fsdk::MultiFaceTracker::setDetector(const QString &sFile)
+{
+	if(!m_oDetector.load(sFile.toStdString()))
+	{
+		qWarning().noquote() << QCoreApplication::translate("MultiFaceTracker", "could not load the face detector %1").arg(sFile);
+		return false;
+	}
+	return true;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::MultiFaceTracker::hasDetector() const
+{
+	return !m_oDetector.empty();
+}
+
+// +-----------------------------------------------------------
+void fsdk::MultiFaceTracker::setDetectionInterval(const int iFrames)
+{
+	m_iDetectionInterval = qMax(iFrames, 1);
+}
+
+// +-----------------------------------------------------------
+fsdk::ScaledFaceTracker* fsdk::MultiFaceTracker::createTracker(const bool bUseROI)
+{
+	for(int i = 0; i < m_lIdle.count(); i++)
+	{
+		if(m_lIdle[i]->usesROI() == bUseROI)
+			return m_lIdle.takeAt(i);
+	}
+
+	// The CSIRO tracker throws a pointer to the exception if it fails to load its models
+	FaceTracker *pTracker = NULL;
+	try
+	{
+		pTracker = FaceTrackerRegistry::create(m_sBackend);
+	}
+	catch(std::runtime_error *pException)
+	{
+		delete pException;
+		pTracker = NULL;
+	}
+
+	return pTracker ? new ScaledFaceTracker(pTracker, m_dScale, bUseROI) : NULL;
+}
+
+// +-----------------------------------------------------------
+void fsdk::MultiFaceTracker::releaseTracker(ScaledFaceTracker *pTracker)
+{
+	pTracker->reset();
+	m_lIdle.append(pTracker);
+}
+
+// +-----------------------------------------------------------
+void fsdk::MultiFaceTracker::track(Mat &oFrame)
+{
+	m_iFrame++;
+
+	// Without a detector, track a single face in the whole frame (reset
+	// after the previous frame if its quality got too low)
+	if(!hasDetector())
+	{
+		if(m_mTrackers.isEmpty())
+		{
+			ScaledFaceTracker *pTracker = createTracker(false);
+			if(!pTracker)
+				return;
+			m_mTrackers[m_iNextId++] = pTracker;
+		}
+		else if(m_mTrackers.first()->getQuality() < m_fResetQuality)
+			m_mTrackers.first()->reset();
+	}
+
+	// Otherwise, detect new faces periodically (or while there are none)
+	else if(m_mTrackers.isEmpty() || --m_iFramesToDetection <= 0)
+	{
+		detect(oFrame);
+		m_iFramesToDetection = m_iDetectionInterval;
+	}
+
+	// Track all faces in parallel in the same frame
+	m_oFrame = oFrame;
+	m_lActive = m_mTrackers.values();
+	cv::parallel_for_(cv::Range(0, m_lActive.count()), *this);
+	m_lActive.clear();
+	m_oFrame = Mat();
+
+	if(!hasDetector())
+		return;
+
+	// Update the regions of the faces and discard the faces lost
+	QMap<int, ScaledFaceTracker*>::iterator it = m_mTrackers.begin();
+	while(it != m_mTrackers.end())
+	{
+		QList<QPoint> lLandmarks = it.value()->getLandmarks();
+		if(!lLandmarks.isEmpty() && it.value()->getQuality() >= m_fResetQuality)
+		{
+			m_mRegions[it.key()] = boundingRect(lLandmarks);
+			++it;
+		}
+		else
+		{
+			m_mLostRegions[it.key()] = m_mRegions.value(it.key());
+			m_mLostFrames[it.key()] = m_iFrame;
+			m_mRegions.remove(it.key());
+			releaseTracker(it.value());
+			it = m_mTrackers.erase(it);
+		}
+	}
+
+	// Discard the trackers that converged to the same face of another tracker
+	// (keeping the one with the best quality)
+	QList<int> lFaces = m_mTrackers.keys();
+	for(int i = 0; i < lFaces.count(); i++)
+	{
+		for(int j = i + 1; j < lFaces.count(); j++)
+		{
+			if(!m_mTrackers.contains(lFaces[i]) || !m_mTrackers.contains(lFaces[j]))
+				continue;
+			if(overlap(m_mRegions[lFaces[i]], m_mRegions[lFaces[j]]) < DUPLICATE_OVERLAP)
+				continue;
+
+			int iDiscard = m_mTrackers[lFaces[j]]->getQuality() > m_mTrackers[lFaces[i]]->getQuality() ? lFaces[i] : lFaces[j];
+			releaseTracker(m_mTrackers.take(iDiscard));
+			m_mRegions.remove(iDiscard);
+		}
+	}
+
+	// Forget the faces lost long ago
+	QMap<int, int>::iterator itLost = m_mLostFrames.begin();
+	while(itLost != m_mLostFrames.end())
+	{
+		if(m_iFrame - itLost.value() > LOST_TIMEOUT)
+		{
+			m_mLostRegions.remove(itLost.key());
+			itLost = m_mLostFrames.erase(itLost);
+		}
+		else
+			++itLost;
+	}
+}
+
+// +-----------------------------------------------------------
+void fsdk::MultiFaceTracker::operator()(const cv::Range &oRange) const
+{
+	for(int i = oRange.start; i < oRange.end; i++)
+	{
+		Mat oFrame = m_oFrame;
+		m_lActive[i]->track(oFrame);
+	}
+}
+
+// +-----------------------------------------------------------
+bool fsdk::MultiFaceTracker::isLarger(const Rect &oFirst, const Rect &oSecond)
+{
+	return oFirst.area() > oSecond.area();
+}
+
+// +-----------------------------------------------------------
+void fsdk::MultiFaceTracker::detect(const Mat &oFrame)
+{
+	if(m_mTrackers.count() >= m_iMaxFaces)
+		return;
+
+	// Detect on a downscaled, equalized gray copy of the frame
+	Mat oGray;
+	if(oFrame.channels() == 3)
+		cvtColor(oFrame, oGray, CV_BGR2GRAY);
+	else
+		oGray = oFrame.clone();
+
+	double dFactor = oGray.cols > DETECTION_WIDTH ? double(DETECTION_WIDTH) / oGray.cols : 1.0;
+	if(dFactor < 1.0)
+		resize(oGray, oGray, Size(), dFactor, dFactor, INTER_AREA);
+	equalizeHist(oGray, oGray);
+
+	std::vector<Rect> vFaces;
+	m_oDetector.detectMultiScale(oGray, vFaces, 1.1, 3, 0, Size(MIN_FACE_SIZE, MIN_FACE_SIZE));
+
+	// Start tracking the new faces (the largest ones first)
+	std::sort(vFaces.begin(), vFaces.end(), isLarger);
+	for(unsigned int i = 0; i < vFaces.size() && m_mTrackers.count() < m_iMaxFaces; i++)
+	{
+		Rect oFace(qRound(vFaces[i].x / dFactor), qRound(vFaces[i].y / dFactor), qRound(vFaces[i].width / dFactor), qRound(vFaces[i].height / dFactor));
+
+		// Ignore the faces already tracked
+		bool bTracked = false;
+		foreach(Rect oRegion, m_mRegions)
+		{
+			if(overlap(oFace, oRegion) >= DETECTION_OVERLAP)
+			{
+				bTracked = true;
+				break;
+			}
+		}
+		if(bTracked)
+			continue;
+
+		// Reuse the ID of a face lost close to it (or give it a new one)
+		int iId = -1;
+		QMap<int, Rect>::const_iterator it;
+		for(it = m_mLostRegions.cbegin(); it != m_mLostRegions.cend(); ++it)
+		{
+			if(overlap(oFace, it.value()) >= DETECTION_OVERLAP)
+			{
+				iId = it.key();
+				break;
+			}
+		}
+		if(iId >= 0)
+		{
+			m_mLostRegions.remove(iId);
+			m_mLostFrames.remove(iId);
+		}
+		else
+			iId = m_iNextId++;
+
+		ScaledFaceTracker *pTracker = createTracker(true);
+		if(!pTracker)
+			return;
+		pTracker->setFaceRegion(oFace, oFrame.size());
+
+		m_mTrackers[iId] = pTracker;
+		m_mRegions[iId] = oFace;
+	}
+}
+
+// +-----------------------------------------------------------
+void fsdk::MultiFaceTracker::setPrediction(const int iFace, const QList<QPoint> &lLandmarks)
+{
+	ScaledFaceTracker *pTracker = m_mTrackers.value(iFace);
+	if(pTracker)
+		pTracker->setPrediction(lLandmarks);
+}
+
+// +-----------------------------------------------------------
+QList<int> fsdk::MultiFaceTracker::faces() const
+{
+	return m_mTrackers.keys();
+}
+
+// +-----------------------------------------------------------
+float fsdk::MultiFaceTracker::getQuality(const int iFace) const
+{
+	ScaledFaceTracker *pTracker = m_mTrackers.value(iFace);
+	return pTracker ? pTracker->getQuality() : 0.0f;
+}
+
+// +-----------------------------------------------------------
+QList<QPoint> fsdk::MultiFaceTracker::getLandmarks(const int iFace) const
+{
+	ScaledFaceTracker *pTracker = m_mTrackers.value(iFace);
+	return pTracker ? pTracker->getLandmarks() : QList<QPoint>();
+}
+
+// +-----------------------------------------------------------
+void fsdk::MultiFaceTracker::reset()
+{
+	foreach(ScaledFaceTracker *pTracker, m_mTrackers)
+		releaseTracker(pTracker);
+	m_mTrackers.clear();
+	m_mRegions.clear();
+	m_mLostRegions.clear();
+	m_mLostFrames.clear();
+	m_iFramesToDetection = 0;
+	m_iFrame = 0;
+	m_iNextId = 0;
+}
+
+// +-----------------------------------------------------------
+cv::Rect fsdk::MultiFaceTracker::boundingRect(const QList<QPoint> &lLandmarks)
+{
+	if(lLandmarks.isEmpty())
+		return Rect();
+
+	int iMinX = lLandmarks[0].x(), iMaxX = iMinX;
+	int iMinY = lLandmarks[0].y(), iMaxY = iMinY;
+	foreach(QPoint oPoint, lLandmarks)
+	{
+		iMinX = qMin(iMinX, oPoint.x());
+		iMaxX = qMax(iMaxX, oPoint.x());
+		iMinY = qMin(iMinY, oPoint.y());
+		iMaxY = qMax(iMaxY, oPoint.y());
+	}
+	return Rect(iMinX, iMinY, iMaxX - iMinX + 1, iMaxY - iMinY + 1);
+}
+
+// +-----------------------------------------------------------
+double fsdk::MultiFaceTracker::overlap(const Rect &oFirst, const Rect &oSecond)
+{
+	int iSmaller = qMin(oFirst.area(), oSecond.area());
+	if(iSmaller <= 0)
+		return 0.0;
+	return double((oFirst & oSecond).area()) / iSmaller;
+}
\ No newline at end of file
@@ -0,0 +1,244 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MULTIFACETRACKER_H
+#define MULTIFACETRACKER_H
+
+#include "facetrackerregistry.h"
+#include "scaledfacetracker.h"
+#include <opencv2/objdetect/objdetect.hpp>
+#include <QMap>
+#include <QList>
+#include <QPoint>
+
+namespace fsdk
+{
+	/**
+	 * Tracks several faces in the frames of a video (for instance, of two players
+	 * sharing the camera). The faces are found by a Haar cascade detector, run
+	 * periodically on a downscaled copy of the frame, and each face is tracked by
+	 * its own tracker (of the given backend) restricted to a region around it
+	 * (see ScaledFaceTracker). The trackers of the different faces run in parallel
+	 * on the same decoded frame. Each face receives a stable ID, kept while it is
+	 * tracked and reused if the face is lost and found again close to where it was
+	 * lost shortly after.
+	 * If the detector can not be loaded, a single face is tracked in the whole
+	 * frame (i.e. the behaviour is the same of the single face tracking).
+	 */
+	class SHARED_LIB_EXPORT MultiFaceTracker: protected cv::ParallelLoopBody
+	{
+	public:
+		/**
+		 * Class constructor.
+		 * @param sBackend QString with the name of the face tracker backend used
+		 * for each face (if empty, the default backend is used).
+		 * @param iMaxFaces Integer with the maximum number of faces tracked. The
+		 * default is 4.
+		 * @param dScale Double with the scale factor applied to the face regions
+		 * before tracking, in range (0, 1]. The default is 1 (full resolution).
+		 * @param fResetQuality Float with the minimum quality of the tracking of a
+		 * face, in range [0, 1]. A face tracked with lower quality is considered
+		 * lost. The default is 0.2 (20%).
+		 */
+		MultiFaceTracker(const QString &sBackend = QString(), const int iMaxFaces = 4, const double dScale = 1.0, const float fResetQuality = 0.2f);
+
+		/**
+		 * Class destructor.
+		 */
+		virtual ~MultiFaceTracker();
+
+		/**
+		 * Loads the Haar cascade used to detect the faces. The constructor loads
+		 * the default cascade (haarcascade_frontalface_alt2.xml, from the
+		 * directory of the application), if it exists.
+		 * @param sFile QString with the name of the cascade file.
+		 * @return Boolean indicating if the cascade was loaded (true) or not (false).
+		 */
+		bool setDetector(const QString &sFile);
+
+		/**
+		 * Queries if a detector is loaded (i.e. if several faces can be tracked).
+		 * @return Boolean indicating if the detector is loaded (true) or not (false).
+		 */
+		bool hasDetector() const;
+
+		/**
+		 * Sets the interval between the detections of new faces.
+		 * @param iFrames Integer with the number of frames between the detections.
+		 * The default is 15. The detection is also done on every frame while no
+		 * face is tracked.
+		 */
+		void setDetectionInterval(const int iFrames);
+
+		/**
+		 * Detects new faces (if it is time to) and tracks all faces in the given
+		 * frame. The faces lost in the frame are not reported by faces() anymore.
+		 * @param oFrame Reference to an OpenCV's Mat with the frame.
+		 */
+		void track(Mat &oFrame);
+
+		/**
+		 * Gives the tracker of a face a prediction of its landmarks in the next
+		 * frame (see FaceTracker::setPrediction()).
+		 * @param iFace Integer with the ID of the face.
+		 * @param lLandmarks QList of QPoint with the predicted landmarks.
+		 */
+		void setPrediction(const int iFace, const QList<QPoint> &lLandmarks);
+
+		/**
+		 * Gets the IDs of the faces tracked in the last frame.
+		 * @return QList of integers with the IDs of the faces, in ascending order.
+		 */
+		QList<int> faces() const;
+
+		/**
+		 * Queries the quality of the tracking of a face in the last frame.
+		 * @param iFace Integer with the ID of the face.
+		 * @return Float with the quality in range [0, 1] (0 if the face is not
+		 * tracked).
+		 */
+		float getQuality(const int iFace) const;
+
+		/**
+		 * Queries the landmarks of a face in the last frame.
+		 * @param iFace Integer with the ID of the face.
+		 * @return QList of QPoint with the landmarks of the face, or an empty
+		 * QList if the face is not tracked.
+		 */
+		QList<QPoint> getLandmarks(const int iFace) const;
+
+		/**
+		 * Resets the tracking, discarding all faces (the IDs start over from 0).
+		 * The trackers are kept for the faces found afterwards, so resetting
+		 * (for instance, in each image of a sequence) does not load the models
+		 * of the backend again.
+		 */
+		void reset();
+
+	protected:
+
+		/**
+		 * Tracks the faces in a range of the active trackers (executed in
+		 * parallel by track()).
+		 * @param oRange OpenCV's Range with the indexes of the trackers.
+		 */
+		void operator()(const cv::Range &oRange) const;
+
+		/**
+		 * Detects the faces in the given frame and starts tracking those that
+		 * are not tracked yet (up to the maximum number of faces).
+		 * @param oFrame OpenCV's Mat with the frame.
+		 */
+		void detect(const Mat &oFrame);
+
+		/**
+		 * Gets a tracker for a new face: an idle tracker released before (see
+		 * releaseTracker()), or a new one created with the configured backend
+		 * and scale if there is none.
+		 * @param bUseROI Boolean indicating if the tracker works only in the
+		 * region around the face.
+		 * @return Instance of the ScaledFaceTracker, or NULL if the tracker of
+		 * the backend could not be created.
+		 */
+		ScaledFaceTracker *createTracker(const bool bUseROI);
+
+		/**
+		 * Resets a tracker that no longer tracks a face and keeps it idle, so it
+		 * is reused by createTracker() instead of creating a new one.
+		 * @param pTracker Instance of the ScaledFaceTracker to release.
+		 */
+		void releaseTracker(ScaledFaceTracker *pTracker);
+
+		/**
+		 * Compares the areas of two regions (used to sort the faces detected).
+		 * @param oFirst OpenCV's Rect with the first region.
+		 * @param oSecond OpenCV's Rect with the second region.
+		 * @return Boolean indicating if the first region is larger (true) or
+		 * not (false).
+		 */
+		static bool isLarger(const Rect &oFirst, const Rect &oSecond);
+
+		/**
+		 * Gets the bounding box of the given landmarks.
+		 * @param lLandmarks QList of QPoint with the landmarks.
+		 * @return OpenCV's Rect with the bounding box (empty if there are no landmarks).
+		 */
+		static Rect boundingRect(const QList<QPoint> &lLandmarks);
+
+		/**
+		 * Calculates how much two regions overlap.
+		 * @param oFirst OpenCV's Rect with the first region.
+		 * @param oSecond OpenCV's Rect with the second region.
+		 * @return Double with the area of the intersection relative to the area
+		 * of the smaller region, in range [0, 1].
+		 */
+		static double overlap(const Rect &oFirst, const Rect &oSecond);
+
+	private:
+
+		/** Name of the face tracker backend. */
+		QString m_sBackend;
+
+		/** Maximum number of faces tracked. */
+		int m_iMaxFaces;
+
+		/** Scale factor applied to the face regions before tracking. */
+		double m_dScale;
+
+		/** Minimum quality of the tracking of a face. */
+		float m_fResetQuality;
+
+		/** Haar cascade used to detect the faces. */
+		cv::CascadeClassifier m_oDetector;
+
+		/** Number of frames between the detections. */
+		int m_iDetectionInterval;
+
+		/** Number of frames remaining until the next detection. */
+		int m_iFramesToDetection;
+
+		/** Index of the current frame (counted since the last reset). */
+		int m_iFrame;
+
+		/** ID to be given to the next new face. */
+		int m_iNextId;
+
+		/** Trackers of the faces, by their IDs. */
+		QMap<int, ScaledFaceTracker*> m_mTrackers;
+
+		/** Trackers not in use, kept to be reused for new faces. */
+		QList<ScaledFaceTracker*> m_lIdle;
+
+		/** Bounding boxes of the faces in the last frame, by their IDs. */
+		QMap<int, Rect> m_mRegions;
+
+		/** Regions of the faces lost recently (to reuse their IDs), by their IDs. */
+		QMap<int, Rect> m_mLostRegions;
+
+		/** Index of the frame where each face was lost, by their IDs. */
+		QMap<int, int> m_mLostFrames;
+
+		/** Trackers executed in parallel in the current frame. */
+		QList<ScaledFaceTracker*> m_lActive;
+
+		/** Frame where the faces are being tracked. */
+		Mat m_oFrame;
+	};
+}
+
+#endif // MULTIFACETRACKER_H
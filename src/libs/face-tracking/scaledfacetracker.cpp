@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "scaledfacetracker.h"
+#include <QtMath>
+
+// Size of the ROI relative to the bounding box of the landmarks
+#define ROI_FACTOR 2.0
+
+// Minimum distance (relative to the size of the face) between the face and the ROI
+// borders; if the face gets closer than that to the borders, the ROI is recomputed
+#define ROI_MARGIN 0.2
+
+// +-----------------------------------------------------------
+fsdk::ScaledFaceTracker::ScaledFaceTracker(FaceTracker *pTracker, const double dScale, const bool bUseROI)
+{
+	m_pTracker = pTracker;
+	m_dScale = qMin(qMax(dScale, 0.05), 1.0);
+	m_bUseROI = bUseROI;
+}
+
+// +-----------------------------------------------------------
+fsdk::ScaledFaceTracker::~ScaledFaceTracker()
+{
+	if(m_pTracker)
+		delete m_pTracker;
+}
+
+// +-----------------------------------------------------------
+void fsdk::ScaledFaceTracker::track(Mat &oFrame)
+{
+	m_lLandmarks.clear();
+
+	// Move the ROI in advance if the face is predicted to leave it
+	if(m_bUseROI && !m_lPrediction.isEmpty())
+		updateROI(m_lPrediction, oFrame.size());
+
+	// Crop the region of interest (if any). The ROI may be invalid for this
+	// frame if the frame size changed, in which case the whole frame is used
+	Mat oInput = oFrame;
+	Point oOffset(0, 0);
+	if(!m_oROI.empty())
+	{
+		if((m_oROI & Rect(0, 0, oFrame.cols, oFrame.rows)) == m_oROI)
+		{
+			oInput = oFrame(m_oROI);
+			oOffset = m_oROI.tl();
+		}
+		else
+		{
+			m_oROI = Rect();
+			m_pTracker->reset();
+		}
+	}
+
+	// Downscale it (the area interpolation avoids aliasing)
+	if(m_dScale < 1.0)
+		resize(oInput, m_oScaled, Size(), m_dScale, m_dScale, INTER_AREA);
+	else
+		m_oScaled = oInput;
+
+	// Pass the prediction on in the coordinates of the wrapped tracker
+	if(!m_lPrediction.isEmpty())
+	{
+		QList<QPoint> lPrediction;
+		foreach(QPoint oPoint, m_lPrediction)
+			lPrediction.append(QPoint(qRound((oPoint.x() - oOffset.x) * m_dScale), qRound((oPoint.y() - oOffset.y) * m_dScale)));
+		m_pTracker->setPrediction(lPrediction);
+		m_lPrediction.clear();
+	}
+
+	m_pTracker->track(m_oScaled);
+
+	// Map the landmarks back to the full resolution frame
+	foreach(QPoint oPoint, m_pTracker->getLandmarks())
+		m_lLandmarks.append(QPoint(qRound(oPoint.x() / m_dScale) + oOffset.x, qRound(oPoint.y() / m_dScale) + oOffset.y));
+
+	if(m_bUseROI)
+		updateROI(m_lLandmarks, oFrame.size());
+}
+
+// +-----------------------------------------------------------
+void fsdk::ScaledFaceTracker::setPrediction(const QList<QPoint> &lLandmarks)
+{
+	m_lPrediction = lLandmarks;
+}
+
+// +-----------------------------------------------------------
+void fsdk::ScaledFaceTracker::updateROI(const QList<QPoint> &lLandmarks, const Size &oFrameSize)
+{
+	// If the face was lost, go back to the whole frame
+	if(lLandmarks.isEmpty())
+	{
+		if(!m_oROI.empty())
+		{
+			m_oROI = Rect();
+			m_pTracker->reset();
+		}
+		return;
+	}
+
+	// Bounding box of the face
+	int iMinX = lLandmarks[0].x(), iMaxX = iMinX;
+	int iMinY = lLandmarks[0].y(), iMaxY = iMinY;
+	foreach(QPoint oPoint, lLandmarks)
+	{
+		iMinX = qMin(iMinX, oPoint.x());
+		iMaxX = qMax(iMaxX, oPoint.x());
+		iMinY = qMin(iMinY, oPoint.y());
+		iMaxY = qMax(iMaxY, oPoint.y());
+	}
+	Rect oFace(iMinX, iMinY, iMaxX - iMinX + 1, iMaxY - iMinY + 1);
+
+	// Keep the current ROI while the face is well inside it
+	int iMarginX = qCeil(oFace.width * ROI_MARGIN);
+	int iMarginY = qCeil(oFace.height * ROI_MARGIN);
+	Rect oSafe(oFace.x - iMarginX, oFace.y - iMarginY, oFace.width + 2 * iMarginX, oFace.height + 2 * iMarginY);
+	Rect oFrameRect(0, 0, oFrameSize.width, oFrameSize.height);
+	if(!m_oROI.empty() && (oSafe & oFrameRect & m_oROI) == (oSafe & oFrameRect))
+		return;
+
+	// Otherwise, define a new ROI centered on the face and restart the tracking
+	// in it (the tracker state refers to the coordinates of the previous ROI)
+	setFaceRegion(oFace, oFrameSize);
+}
+
+// +-----------------------------------------------------------
+void fsdk::ScaledFaceTracker::setFaceRegion(const Rect &oFace, const Size &oFrameSize)
+{
+	int iWidth = qCeil(oFace.width * ROI_FACTOR);
+	int iHeight = qCeil(oFace.height * ROI_FACTOR);
+	Rect oROI(oFace.x + oFace.width / 2 - iWidth / 2, oFace.y + oFace.height / 2 - iHeight / 2, iWidth, iHeight);
+	oROI &= Rect(0, 0, oFrameSize.width, oFrameSize.height);
+	if(oROI.area() > 0 && oROI != m_oROI)
+	{
+		m_oROI = oROI;
+		m_pTracker->reset();
+	}
+}
+
+// +-----------------------------------------------------------
+float fsdk::ScaledFaceTracker::getQuality() const
+{
+	return m_pTracker->getQuality();
+}
+
+// +-----------------------------------------------------------
+QList<QPoint> fsdk::ScaledFaceTracker::getLandmarks() const
+{
+	return m_lLandmarks;
+}
+
+// +-----------------------------------------------------------
+void fsdk::ScaledFaceTracker::reset()
+{
+	m_pTracker->reset();
+	m_oROI = Rect();
+	m_lPrediction.clear();
+	m_lLandmarks.clear();
+}
+
+// +-----------------------------------------------------------
+int fsdk::ScaledFaceTracker::landmarksCount() const
+{
+	return m_pTracker->landmarksCount();
+}
+
+// +-----------------------------------------------------------
+int fsdk::ScaledFaceTracker::landmarkIndex(const Landmark eLandmark) const
+{
+	return m_pTracker->landmarkIndex(eLandmark);
+}
+
+// +-----------------------------------------------------------
+double fsdk::ScaledFaceTracker::scale() const
+{
+	return m_dScale;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::ScaledFaceTracker::usesROI() const
+{
+	return m_bUseROI;
+}
+
+// +-----------------------------------------------------------
+cv::Rect fsdk::ScaledFaceTracker::roi() const
+{
+	return m_oROI;
+}
\ No newline at end of file
@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SCALEDFACETRACKER_H
+#define SCALEDFACETRACKER_H
+
+#include "facetracker.h"
+#include <opencv2/imgproc/imgproc.hpp>
+
+namespace fsdk
+{
+	/**
+	 * Face tracker that reduces the cost of another tracker on high resolution
+	 * frames, by tracking on a downscaled copy of the frame and/or only on a
+	 * region of interest (ROI) around the face found in the previous frames.
+	 * The landmarks are mapped back to the coordinates of the full resolution
+	 * frame. Since the wrapped tracker keeps its state in the coordinates of
+	 * the images it receives, the ROI is kept fixed while the face remains well
+	 * inside it; when the face gets close to the ROI borders (or is lost), the
+	 * ROI is recomputed and the wrapped tracker is reset.
+	 */
+	class SHARED_LIB_EXPORT ScaledFaceTracker: public FaceTracker
+	{
+	public:
+		/**
+		 * Class constructor.
+		 * @param pTracker Instance of the FaceTracker to use in the tracking. This
+		 * class takes the ownership of the instance (i.e. it is deleted with it).
+		 * @param dScale Double with the scale factor applied to the frames before
+		 * tracking, in range (0, 1]. The default is 0.5 (i.e. half resolution).
+		 * @param bUseROI Boolean indicating if the tracking should be done only on
+		 * a region around the face (true) or on the whole frame (false, the default).
+		 */
+		ScaledFaceTracker(FaceTracker *pTracker, const double dScale = 0.5, const bool bUseROI = false);
+
+		/**
+		 * Class destructor.
+		 */
+		virtual ~ScaledFaceTracker();
+
+		/**
+		 * Tracks a face in the given frame (see FaceTracker::track()). The frame
+		 * is cropped to the ROI (if used) and downscaled before being passed to
+		 * the wrapped tracker.
+		 * @param oFrame Reference to an OpenCV's Mat with the
+		 * data of the image where the face is to be found.
+		 */
+		void track(Mat &oFrame);
+
+		/**
+		 * Gives the tracker a prediction of the landmarks in the next frame. If
+		 * the ROI is used, it is moved in advance when the predicted face is not
+		 * well inside it (or placed around the predicted face if the face was
+		 * lost). The prediction is also passed on to the wrapped tracker, in the
+		 * coordinates of the images it receives.
+		 * @param lLandmarks QList of QPoint with the predicted landmarks, in the
+		 * coordinates of the full resolution frame.
+		 */
+		void setPrediction(const QList<QPoint> &lLandmarks);
+
+		/**
+		 * Queries the quality of the current tracking.
+		 * @return Float between 0 and 1 indicating the quality of the
+		 * current tracking (as reported by the wrapped tracker).
+		 */
+		float getQuality() const;
+
+		/**
+		 * Queries the positions of the currently tracked facial landmarks, in
+		 * the coordinates of the full resolution frame.
+		 * @return Q QList of QPoint values for all facial landmarks tracked,
+		 * or an empty QList() in case the quality of the tracker is 0.
+		 */
+		QList<QPoint> getLandmarks() const;
+
+		/**
+		 * Resets the tracking by attempting to find the face again in the next
+		 * frame (in the whole frame, since the ROI is also discarded).
+		 */
+		void reset();
+
+		/**
+		 * Queries the total number of facial landmarks of the wrapped tracker.
+		 * @return Integer with the number of landmarks supported.
+		 */
+		int landmarksCount() const;
+
+		/**
+		 * Queries the index of a semantic landmark in the landmarks of the
+		 * wrapped tracker.
+		 * @param eLandmark Value of the Landmark enumeration with the landmark.
+		 * @return Integer with the index of the landmark, or -1 if the tracker
+		 * does not provide it.
+		 */
+		int landmarkIndex(const Landmark eLandmark) const;
+
+		/**
+		 * Gets the scale factor applied to the frames before tracking.
+		 * @return Double with the scale factor in range (0, 1].
+		 */
+		double scale() const;
+
+		/**
+		 * Queries if the tracking is done only on a region around the face.
+		 * @return Boolean indicating if the ROI is used (true) or not (false).
+		 */
+		bool usesROI() const;
+
+		/**
+		 * Defines the ROI around the given face region (for instance, a face
+		 * found by a detector), so the wrapped tracker searches the face only
+		 * in it in the next frame. The wrapped tracker is reset if the ROI
+		 * changes. It is meant to be used along with the tracking on the ROI
+		 * (see usesROI()), so the ROI follows the face afterwards.
+		 * @param oFace OpenCV's Rect with the face region, in the coordinates
+		 * of the full resolution frame.
+		 * @param oFrameSize OpenCV's Size with the size of the full resolution frame.
+		 */
+		void setFaceRegion(const Rect &oFace, const Size &oFrameSize);
+
+		/**
+		 * Gets the region of interest currently used for the tracking.
+		 * @return OpenCV's Rect with the ROI in the coordinates of the full
+		 * resolution frame, or an empty Rect if the whole frame is used.
+		 */
+		Rect roi() const;
+
+	protected:
+
+		/**
+		 * Updates the ROI according to the landmarks of the face (tracked in the
+		 * current frame or predicted for the next one). If the face is not well
+		 * inside the current ROI, a new ROI is defined around it and the wrapped
+		 * tracker is reset (so it redetects the face in the new region in the
+		 * next frame).
+		 * @param lLandmarks QList of QPoint with the landmarks of the face, in the
+		 * coordinates of the full resolution frame (if empty, the face was lost and
+		 * the whole frame is used again).
+		 * @param oFrameSize OpenCV's Size with the size of the full resolution frame.
+		 */
+		void updateROI(const QList<QPoint> &lLandmarks, const Size &oFrameSize);
+
+	private:
+
+		/** Instance of the wrapped tracker. */
+		FaceTracker *m_pTracker;
+
+		/** Scale factor applied to the frames before tracking. */
+		double m_dScale;
+
+		/** Indicates if the tracking is done only on a region around the face. */
+		bool m_bUseROI;
+
+		/** Current region of interest (empty if the whole frame is used). */
+		Rect m_oROI;
+
+		/** Buffer with the downscaled frame (reused between the frames). */
+		Mat m_oScaled;
+
+		/** Landmarks predicted for the next frame (empty if there is no prediction). */
+		QList<QPoint> m_lPrediction;
+
+		/** Landmarks tracked, in the coordinates of the full resolution frame. */
+		QList<QPoint> m_lLandmarks;
+	};
+}
+
+#endif // SCALEDFACETRACKER_H
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "trackingvalidation.h"
+#include <QCoreApplication>
+#include <QVector2D>
+#include <QRect>
+#include <QtMath>
+
+// +-----------------------------------------------------------
+fsdk::TrackingValidation::TrackingValidation(const int iLeftEye, const int iRightEye)
+{
+	m_iLeftEye = iLeftEye;
+	m_iRightEye = iRightEye;
+	m_iFrames = 0;
+	m_iReferenceFound = 0;
+	m_iBothFound = 0;
+	m_dErrorSum = 0;
+	m_dErrorMax = 0;
+	m_dQualitySum = 0;
+}
+
+// +-----------------------------------------------------------
+void fsdk::TrackingValidation::add(const QList<QPoint> &lReference, const float fReferenceQuality, const QList<QPoint> &lLandmarks, const float fQuality)
+{
+	m_iFrames++;
+	m_dQualitySum += fQuality - fReferenceQuality;
+
+	if(lReference.isEmpty())
+		return;
+	m_iReferenceFound++;
+
+	if(lLandmarks.count() != lReference.count())
+		return;
+	m_iBothFound++;
+
+	// Distance used to normalize the errors
+	double dNorm;
+	if(m_iLeftEye >= 0 && m_iRightEye >= 0 && lReference.count() > qMax(m_iLeftEye, m_iRightEye))
+		dNorm = QVector2D(lReference[m_iRightEye] - lReference[m_iLeftEye]).length();
+	else
+	{
+		QRect oFace(lReference[0], QSize(1, 1));
+		foreach(QPoint oPoint, lReference)
+			oFace |= QRect(oPoint, QSize(1, 1));
+		dNorm = qSqrt(oFace.width() * oFace.width() + oFace.height() * oFace.height());
+	}
+	dNorm = qMax(dNorm, 1.0);
+
+	double dError = 0;
+	for(int i = 0; i < lReference.count(); i++)
+		dError += QVector2D(lLandmarks[i] - lReference[i]).length();
+	dError /= lReference.count() * dNorm;
+
+	m_dErrorSum += dError;
+	m_dErrorMax = qMax(m_dErrorMax, dError);
+}
+
+// +-----------------------------------------------------------
+int fsdk::TrackingValidation::frames() const
+{
+	return m_iFrames;
+}
+
+// +-----------------------------------------------------------
+double fsdk::TrackingValidation::agreement() const
+{
+	return m_iReferenceFound > 0 ? double(m_iBothFound) / m_iReferenceFound : 1.0;
+}
+
+// +-----------------------------------------------------------
+double fsdk::TrackingValidation::meanError() const
+{
+	return m_iBothFound > 0 ? m_dErrorSum / m_iBothFound : 0.0;
+}
+
+// +-----------------------------------------------------------
+double fsdk::TrackingValidation::maxError() const
+{
+	return m_dErrorMax;
+}
+
+// +-----------------------------------------------------------
+double fsdk::TrackingValidation::meanQualityDifference() const
+{
+	return m_iFrames > 0 ? m_dQualitySum / m_iFrames : 0.0;
+}
+
+// +-----------------------------------------------------------
+QString fsdk::TrackingValidation::toString() const
+{
+	return QCoreApplication::translate("TrackingValidation", "%1 frames compared; face found in %2% of the frames found at full resolution; "
+		"landmarks error of %3% (max %4%) of the eyes distance; quality difference of %5")
+		.arg(m_iFrames).arg(agreement() * 100, 0, 'f', 1).arg(meanError() * 100, 0, 'f', 1)
+		.arg(maxError() * 100, 0, 'f', 1).arg(meanQualityDifference(), 0, 'f', 3);
+}
\ No newline at end of file
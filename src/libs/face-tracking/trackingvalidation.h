@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef TRACKINGVALIDATION_H
+#define TRACKINGVALIDATION_H
+
+#include "libexport.h"
+#include <QList>
+#include <QPoint>
+#include <QString>
+
+namespace fsdk
+{
+	/**
+	 * Accumulates the differences between the results of a face tracker and
+	 * the results of a reference tracker on the same frames (for instance, of
+	 * a reduced resolution tracking against the full resolution tracking).
+	 * The landmarks errors are normalized by the distance between the inner
+	 * corners of the eyes in the reference (or by the diagonal of the face,
+	 * if the indexes of the eyes are not known), so they are independent of
+	 * the face size.
+	 */
+	class SHARED_LIB_EXPORT TrackingValidation
+	{
+	public:
+		/**
+		 * Class constructor.
+		 * @param iLeftEye Integer with the index of the inner corner of the left
+		 * eye in the landmarks (or -1 if it is not known).
+		 * @param iRightEye Integer with the index of the inner corner of the right
+		 * eye in the landmarks (or -1 if it is not known).
+		 */
+		TrackingValidation(const int iLeftEye = -1, const int iRightEye = -1);
+
+		/**
+		 * Adds the results of the trackers on a frame.
+		 * @param lReference QList of QPoint with the landmarks of the reference tracker.
+		 * @param fReferenceQuality Float with the quality of the reference tracker.
+		 * @param lLandmarks QList of QPoint with the landmarks of the tracker validated.
+		 * @param fQuality Float with the quality of the tracker validated.
+		 */
+		void add(const QList<QPoint> &lReference, const float fReferenceQuality, const QList<QPoint> &lLandmarks, const float fQuality);
+
+		/**
+		 * Gets the number of frames compared.
+		 * @return Integer with the number of frames.
+		 */
+		int frames() const;
+
+		/**
+		 * Gets the ratio of the frames where the face was found by the reference
+		 * tracker that also had the face found by the tracker validated.
+		 * @return Double in range [0, 1] with the ratio.
+		 */
+		double agreement() const;
+
+		/**
+		 * Gets the mean error of the landmarks in the frames where the face was
+		 * found by both trackers.
+		 * @return Double with the mean normalized error.
+		 */
+		double meanError() const;
+
+		/**
+		 * Gets the maximum error of the landmarks (the mean error in the worst frame).
+		 * @return Double with the maximum normalized error.
+		 */
+		double maxError() const;
+
+		/**
+		 * Gets the mean difference of the quality (tracker validated minus the
+		 * reference) in all frames compared.
+		 * @return Double with the mean quality difference.
+		 */
+		double meanQualityDifference() const;
+
+		/**
+		 * Gets a summary of the validation, to be displayed.
+		 * @return QString with the summary.
+		 */
+		QString toString() const;
+
+	private:
+
+		/** Index of the inner corner of the left eye. */
+		int m_iLeftEye;
+
+		/** Index of the inner corner of the right eye. */
+		int m_iRightEye;
+
+		/** Number of frames compared. */
+		int m_iFrames;
+
+		/** Number of frames where the face was found by the reference tracker. */
+		int m_iReferenceFound;
+
+		/** Number of frames where the face was found by both trackers. */
+		int m_iBothFound;
+
+		/** Sum of the normalized errors in the frames where both found the face. */
+		double m_dErrorSum;
+
+		/** Maximum normalized error. */
+		double m_dErrorMax;
+
+		/** Sum of the quality differences. */
+		double m_dQualitySum;
+	};
+}
+
+#endif // TRACKINGVALIDATION_H
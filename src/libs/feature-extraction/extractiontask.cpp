@@ -18,36 +18,151 @@
  */
 
 #include "extractiontask.h"
+#include "signalpyramid.h"
+#include "facetracksdata.h"
+#include <QApplication>
 #include <QDebug>
+#include <QFile>
+#include <QSaveFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+/** Minimum interval between the progress reports, in milliseconds. */
+#define PROGRESS_INTERVAL 500
+
+/** Weight of the newest measure in the smoothed processing rate. */
+#define RATE_SMOOTHING 0.3
+
+/** Maximum number of frames to skip by grabbing instead of seeking the video. */
+#define SEEK_THRESHOLD 30
+
+/** Time to wait for a live frame before checking the cancellation, in milliseconds. */
+#define LIVE_READ_TIMEOUT 100
 
 // +-----------------------------------------------------------
 fsdk::ExtractionTask::ExtractionTask(QString sInputFile)
 {
 	qRegisterMetaType<ExtractionTask::ExtractionError>("ExtractionTask::ExtractionError");
 	m_sInputFile = sInputFile;
+	m_eDecodeMode = ColorDecode;
+	m_iCheckpointInterval = 60000;
+	m_dVideoFrameRate = 30;
+	m_iCapturePosition = 0;
+	m_bSeekable = true;
+	m_pLive = NULL;
+	m_pSequence = NULL;
+	m_iLiveQueueSize = 2;
+	m_iLiveMaxLatency = 200;
+	m_iLiveDuration = 0;
+	m_bStreaming = false;
+	m_iPublishCapacity = 256;
+	m_pRing = NULL;
+	m_eInputFileType = ImageFile;
+}
+
+// +-----------------------------------------------------------
+fsdk::ExtractionTask::~ExtractionTask()
+{
+	releaseLive();
+	releaseSequence();
+	closePublishing();
 }
 
 // +-----------------------------------------------------------
 bool fsdk::ExtractionTask::start()
 {
-	// Try to open the file as an image
-	m_oImage = cv::imread(m_sInputFile.toStdString(), CV_LOAD_IMAGE_COLOR);
-	if(m_oImage.empty())
+	// Open the image sequences (decoded straight to gray, if requested)
+	if(ImageSequence::isImageSequence(m_sInputFile))
 	{
-		// If failed, then try to open the file as a video
-		if(!m_oCap.open(m_sInputFile.toStdString()))
+		m_pSequence = new ImageSequence(m_sInputFile);
+		if(!m_pSequence->open())
+		{
+			releaseSequence();
+			emit taskError(m_sInputFile, InvalidInputFile);
+			return false;
+		}
+		m_pSequence->setReadFlags(m_eDecodeMode == LumaDecode ? CV_LOAD_IMAGE_GRAYSCALE : CV_LOAD_IMAGE_COLOR);
+		m_eInputFileType = ImageSequenceInput;
+	}
+
+	// Open the live inputs (camera or named pipe) in their capture thread
+	else if(LiveSource::isLiveInput(m_sInputFile))
+	{
+		m_pLive = new LiveSource(m_sInputFile, m_iLiveQueueSize, LiveSource::DropOldest, m_iLiveMaxLatency);
+		if(!m_pLive->open())
 		{
+			releaseLive();
 			emit taskError(m_sInputFile, InvalidInputFile);
 			return false;
 		}
+		m_pLive->start();
+		m_eInputFileType = LiveInput;
+	}
+	else
+	{
+		// Try to open the file as an image (decoded straight to gray, if requested)
+		m_oImage = cv::imread(m_sInputFile.toStdString(), m_eDecodeMode == LumaDecode ? CV_LOAD_IMAGE_GRAYSCALE : CV_LOAD_IMAGE_COLOR);
+		if(m_oImage.empty())
+		{
+			// If failed, then try to open the file as a video
+			if(!m_oCap.open(m_sInputFile.toStdString()))
+			{
+				emit taskError(m_sInputFile, InvalidInputFile);
+				return false;
+			}
+			else
+				m_eInputFileType = VideoFile;
+		}
 		else
-			m_eInputFileType = VideoFile;
+			m_eInputFileType = ImageFile;
+	}
+
+	// Query the number of frames only once (it is a costly call in some backends)
+	if(m_eInputFileType == LiveInput)
+	{
+		// The live inputs have no known length and are processed as they come
+		m_iFrameCount = 0;
+		m_dVideoFrameRate = m_pLive->frameRate();
+		if(!m_oSelection.isAll())
+			qWarning().noquote() << QApplication::translate("ExtractionTask", "the frame selection is ignored for the live input %1").arg(m_sInputFile);
+	}
+	else if(m_eInputFileType == VideoFile)
+	{
+		m_iFrameCount = qMax(static_cast<int>(m_oCap.get(CV_CAP_PROP_FRAME_COUNT)), 0);
+		m_dVideoFrameRate = m_oCap.get(CV_CAP_PROP_FPS);
+		if(m_dVideoFrameRate <= 0)
+		{
+			m_dVideoFrameRate = 30;
+			if(!m_oSelection.isAll())
+				qWarning().noquote() << QApplication::translate("ExtractionTask", "the frame rate of video %1 is unknown; assuming 30 fps to select the frames").arg(m_sInputFile);
+		}
+
+		// If only some frames are selected, the progress refers to them
+		if(m_iFrameCount > 0 && !m_oSelection.isAll())
+			m_iFrameCount = m_oSelection.count(m_iFrameCount, m_dVideoFrameRate);
+	}
+	else if(m_eInputFileType == ImageSequenceInput)
+	{
+		// The images are the frames (the time ranges assume 30 fps)
+		m_iFrameCount = m_oSelection.count(m_pSequence->count(), m_dVideoFrameRate);
+		startSequence(0);
 	}
 	else
-		m_eInputFileType = ImageFile;
-		
+		m_iFrameCount = 1;
+
+	m_iCapturePosition = 0;
+	m_bSeekable = true;
+
 	m_iCurrentFrame = -1;
+	m_iFramesRead = 0;
 	m_iProgress = 0;
+	m_iLastProgressTime = 0;
+	m_iLastProgressFrames = 0;
+	m_dFrameRate = 0;
+	m_oProgressTimer.start();
+	m_oCheckpointTimer.start();
+	if(m_oProfile.isEnabled())
+		m_oElapsed.start();
 	return true;
 }
 
@@ -55,14 +170,24 @@ bool fsdk::ExtractionTask::start()
 void fsdk::ExtractionTask::end(const ExtractionTask::ExtractionError &eError)
 {
 	m_oCap.release();
+	releaseLive();
+	releaseSequence();
+	closePublishing();
+	endProfile();
 	emit taskError(m_sInputFile, eError);
 }
 
 // +-----------------------------------------------------------
 void fsdk::ExtractionTask::end(const QVariant &vData)
 {
-	setProgress(100);
+	// Report the final progress with the actual number of frames read
+	// (the number reported by the video is just an estimate in some formats)
+	emitProgress(m_iFramesRead, m_iFramesRead);
 	m_oCap.release();
+	releaseLive();
+	releaseSequence();
+	closePublishing();
+	endProfile();
 	emit taskFinished(m_sInputFile, vData);
 }
 
@@ -91,22 +216,43 @@ int fsdk::ExtractionTask::progress() const
 }
 
 // +-----------------------------------------------------------
-void fsdk::ExtractionTask::setProgress(int iProgress)
+void fsdk::ExtractionTask::updateProgress()
 {
-	if(iProgress != m_iProgress)
-	{
-		m_iProgress = qMin(qMax(iProgress, 0), 100);
-		emit taskProgress(m_sInputFile, iProgress);
-	}
+	qint64 iNow = m_oProgressTimer.elapsed();
+	qint64 iInterval = iNow - m_iLastProgressTime;
+	if(iInterval < PROGRESS_INTERVAL)
+		return;
+
+	// Smooth the rate measured in the interval with the previous ones
+	double dRate = (m_iFramesRead - m_iLastProgressFrames) * 1000.0 / iInterval;
+	if(m_iLastProgressTime == 0)
+		m_dFrameRate = dRate;
+	else
+		m_dFrameRate = RATE_SMOOTHING * dRate + (1.0 - RATE_SMOOTHING) * m_dFrameRate;
+
+	m_iLastProgressTime = iNow;
+	m_iLastProgressFrames = m_iFramesRead;
+	emitProgress(m_iFramesRead, m_iFrameCount);
+}
+
+// +-----------------------------------------------------------
+void fsdk::ExtractionTask::emitProgress(const int iFrames, const int iFrameCount)
+{
+	TaskProgress oProgress(iFrames, iFrameCount, m_dFrameRate, m_oProgressTimer.elapsed());
+	m_iProgress = iFrameCount > 0 ? oProgress.percent() : 100;
+	emit taskProgress(m_sInputFile, oProgress);
 }
 
 // +-----------------------------------------------------------
 int fsdk::ExtractionTask::frameCount() const
 {
-	if(m_eInputFileType == VideoFile)
-		return static_cast<const VideoCapture>(m_oCap).get(CV_CAP_PROP_FRAME_COUNT);
-	else
-		return 1;
+	return m_iFrameCount;
+}
+
+// +-----------------------------------------------------------
+double fsdk::ExtractionTask::videoFrameRate() const
+{
+	return m_dVideoFrameRate;
 }
 
 // +-----------------------------------------------------------
@@ -121,14 +267,93 @@ Mat& fsdk::ExtractionTask::frame()
 	return m_oCurrentFrame;
 }
 
+// +-----------------------------------------------------------
+Mat& fsdk::ExtractionTask::colorFrame()
+{
+	if(m_eDecodeMode == ColorDecode)
+		return m_oCurrentFrame;
+
+	// Produce the BGR frame only once per frame (the video/live frames are
+	// still decoded in BGR, but the image files are decoded again in colour)
+	if(m_oColorFrame.empty() && !m_oCurrentFrame.empty())
+	{
+		if(m_eInputFileType == ImageFile)
+			m_oColorFrame = cv::imread(m_sInputFile.toStdString(), CV_LOAD_IMAGE_COLOR);
+		else if(m_eInputFileType == ImageSequenceInput)
+			m_oColorFrame = cv::imread(m_pSequence->fileName(m_iCurrentFrame).toStdString(), CV_LOAD_IMAGE_COLOR);
+		else if(m_oDecoded.channels() == 3)
+			m_oColorFrame = m_oDecoded;
+		else
+			cvtColor(m_oCurrentFrame, m_oColorFrame, CV_GRAY2BGR);
+	}
+	return m_oColorFrame;
+}
+
 // +-----------------------------------------------------------
 Mat& fsdk::ExtractionTask::nextFrame()
 {
-	if(m_eInputFileType == VideoFile)
+	ScopedStageTimer oTimer(m_oProfile, TaskProfile::DecodeStage);
+
+	// In the luma decoding, the video/live frames are decoded to a separate
+	// buffer, from which only the luma is taken as the current frame
+	bool bLuma = m_eDecodeMode == LumaDecode && (m_eInputFileType == VideoFile || m_eInputFileType == LiveInput);
+	Mat &oDecoded = bLuma ? m_oDecoded : m_oCurrentFrame;
+	m_oColorFrame.release();
+
+	if(m_eInputFileType == LiveInput)
+	{
+		// Wait for the next frame captured (checking periodically if the task
+		// was cancelled or its duration expired)
+		int iFrame = -1;
+		oDecoded = Mat();
+		while(!isCancelled() && !(m_iLiveDuration > 0 && m_oProgressTimer.hasExpired(m_iLiveDuration)))
+		{
+			if(m_pLive->read(oDecoded, iFrame, LIVE_READ_TIMEOUT) || m_pLive->atEnd())
+				break;
+		}
+		if(bLuma)
+			extractLuma();
+
+		if(!m_oCurrentFrame.empty())
+		{
+			m_iCurrentFrame = iFrame;
+			m_iFramesRead++;
+		}
+		else
+			m_iCurrentFrame = -1;
+	}
+	else if(m_eInputFileType == VideoFile)
 	{
-		m_oCap >> m_oCurrentFrame;
+		// Skip the frames not selected (if any)
+		int iNext = m_oSelection.next(m_iCapturePosition, m_dVideoFrameRate);
+		if(iNext < 0 || !positionCapture(iNext))
+			oDecoded = Mat();
+		else
+		{
+			m_oCap >> oDecoded;
+			m_iCapturePosition++;
+		}
+		if(bLuma)
+			extractLuma();
+
 		if(!m_oCurrentFrame.empty())
-			m_iCurrentFrame++;
+		{
+			m_iCurrentFrame = iNext;
+			m_iFramesRead++;
+		}
+		else
+			m_iCurrentFrame = -1;
+	}
+	else if(m_eInputFileType == ImageSequenceInput)
+	{
+		// Read the next image selected (already decoded by the workers, if
+		// the processing is slower than the decoding)
+		int iIndex;
+		if(m_pSequence->read(m_oCurrentFrame, iIndex))
+		{
+			m_iCurrentFrame = iIndex;
+			m_iFramesRead++;
+		}
 		else
 			m_iCurrentFrame = -1;
 	}
@@ -141,6 +366,7 @@ Mat& fsdk::ExtractionTask::nextFrame()
 		{
 			m_oCurrentFrame = m_oImage;
 			m_iCurrentFrame = 0;
+			m_iFramesRead++;
 		}
 		else
 		{
@@ -149,5 +375,336 @@ Mat& fsdk::ExtractionTask::nextFrame()
 		}
 	}
 
+	if(!m_oCurrentFrame.empty())
+		m_oProfile.addFrames();
+
 	return m_oCurrentFrame;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::ExtractionTask::positionCapture(const int iFrame)
+{
+	if(iFrame == m_iCapturePosition)
+		return true;
+
+	// Try to seek directly, if it is a long way or backwards. Since the seeking
+	// is not frame-accurate with some codecs, check the resulting position
+	int iDistance = iFrame - m_iCapturePosition;
+	if(m_bSeekable && (iDistance < 0 || iDistance > SEEK_THRESHOLD))
+	{
+		if(m_oCap.set(CV_CAP_PROP_POS_FRAMES, iFrame) && static_cast<int>(m_oCap.get(CV_CAP_PROP_POS_FRAMES)) == iFrame)
+		{
+			m_iCapturePosition = iFrame;
+			return true;
+		}
+
+		// The position is now unknown, so restart from the begining
+		// (and do not try seeking this video again)
+		m_bSeekable = false;
+		if(!m_oCap.open(m_sInputFile.toStdString()))
+			return false;
+		m_iCapturePosition = 0;
+	}
+	else if(iDistance < 0)
+	{
+		if(!m_oCap.open(m_sInputFile.toStdString()))
+			return false;
+		m_iCapturePosition = 0;
+	}
+
+	// Grab the frames up to the one desired (without decoding them)
+	while(m_iCapturePosition < iFrame)
+	{
+		if(!m_oCap.grab())
+			return false;
+		m_iCapturePosition++;
+	}
+	return true;
+}
+
+// +-----------------------------------------------------------
+void fsdk::ExtractionTask::extractLuma()
+{
+	if(m_oDecoded.empty())
+		m_oCurrentFrame = Mat();
+	else if(m_oDecoded.channels() == 1)
+		m_oCurrentFrame = m_oDecoded;
+	else
+		cvtColor(m_oDecoded, m_oCurrentFrame, CV_BGR2GRAY);
+}
+
+// +-----------------------------------------------------------
+void fsdk::ExtractionTask::startSequence(const int iFrame)
+{
+	QList<int> lIndexes;
+	for(int i = m_oSelection.next(iFrame, m_dVideoFrameRate); i >= 0 && i < m_pSequence->count(); i = m_oSelection.next(i + 1, m_dVideoFrameRate))
+		lIndexes.append(i);
+	m_pSequence->start(lIndexes);
+}
+
+// +-----------------------------------------------------------
+void fsdk::ExtractionTask::releaseLive()
+{
+	if(!m_pLive)
+		return;
+
+	m_pLive->stop();
+	if(m_pLive->droppedFrames() > 0)
+		qInfo().noquote() << QApplication::translate("ExtractionTask", "%1 of %2 frames captured from the live input %3 were dropped to keep up with it").arg(m_pLive->droppedFrames()).arg(m_pLive->capturedFrames()).arg(m_sInputFile);
+
+	delete m_pLive;
+	m_pLive = NULL;
+}
+
+// +-----------------------------------------------------------
+void fsdk::ExtractionTask::setLiveOptions(const int iQueueSize, const int iMaxLatency, const int iDuration)
+{
+	m_iLiveQueueSize = qMax(iQueueSize, 1);
+	m_iLiveMaxLatency = qMax(iMaxLatency, 0);
+	m_iLiveDuration = qMax(iDuration, 0) * qint64(1000);
+}
+
+// +-----------------------------------------------------------
+void fsdk::ExtractionTask::setStreaming(const bool bEnabled)
+{
+	m_bStreaming = bEnabled;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::ExtractionTask::isStreaming() const
+{
+	return m_bStreaming;
+}
+
+// +-----------------------------------------------------------
+void fsdk::ExtractionTask::streamResult(const QVariant &vData, const int iFrame)
+{
+	if(m_bStreaming)
+		emit taskResult(m_sInputFile, iFrame < 0 ? m_iCurrentFrame : iFrame, vData);
+}
+
+// +-----------------------------------------------------------
+void fsdk::ExtractionTask::setPublishing(const QString &sKey, const int iCapacity)
+{
+	m_sPublishKey = sKey;
+	m_iPublishCapacity = qMax(iCapacity, 1);
+}
+
+// +-----------------------------------------------------------
+bool fsdk::ExtractionTask::openPublishing(const int iValuesCount)
+{
+	if(m_sPublishKey.isEmpty())
+		return true;
+
+	closePublishing();
+	m_pRing = new FeatureRing(m_sPublishKey);
+	if(!m_pRing->create(iValuesCount, m_iPublishCapacity))
+	{
+		closePublishing();
+		return false;
+	}
+	return true;
+}
+
+// +-----------------------------------------------------------
+void fsdk::ExtractionTask::releaseSequence()
+{
+	if(!m_pSequence)
+		return;
+
+	delete m_pSequence;
+	m_pSequence = NULL;
+}
+
+// +-----------------------------------------------------------
+void fsdk::ExtractionTask::closePublishing()
+{
+	delete m_pRing;
+	m_pRing = NULL;
+}
+
+// +-----------------------------------------------------------
+void fsdk::ExtractionTask::publish(const int iFace, const float fQuality, const QList<float> &lValues, const int iFrame)
+{
+	if(m_pRing)
+		m_pRing->publish(iFrame < 0 ? m_iCurrentFrame : iFrame, iFace, fQuality, lValues);
+}
+
+// +-----------------------------------------------------------
+void fsdk::ExtractionTask::publish(const int iFace, const float fQuality, const QList<QPoint> &lLandmarks)
+{
+	if(!m_pRing)
+		return;
+
+	QList<float> lValues;
+	lValues.reserve(lLandmarks.count() * 2);
+	foreach(QPoint oPoint, lLandmarks)
+	{
+		lValues.append(oPoint.x());
+		lValues.append(oPoint.y());
+	}
+	m_pRing->publish(m_iCurrentFrame, iFace, fQuality, lValues);
+}
+
+// +-----------------------------------------------------------
+void fsdk::ExtractionTask::setFrameSelection(const FrameSelection &oSelection)
+{
+	m_oSelection = oSelection;
+}
+
+// +-----------------------------------------------------------
+void fsdk::ExtractionTask::setDecodeMode(const DecodeMode eMode)
+{
+	m_eDecodeMode = eMode;
+}
+
+// +-----------------------------------------------------------
+fsdk::ExtractionTask::DecodeMode fsdk::ExtractionTask::decodeMode() const
+{
+	return m_eDecodeMode;
+}
+
+// +-----------------------------------------------------------
+void fsdk::ExtractionTask::setProfilingEnabled(const bool bEnabled)
+{
+	m_oProfile.setEnabled(bEnabled);
+}
+
+// +-----------------------------------------------------------
+fsdk::TaskProfile& fsdk::ExtractionTask::profile()
+{
+	return m_oProfile;
+}
+
+// +-----------------------------------------------------------
+void fsdk::ExtractionTask::endProfile()
+{
+	if(!m_oProfile.isEnabled())
+		return;
+
+	if(m_oElapsed.isValid())
+	{
+		m_oProfile.addElapsed(m_oElapsed.nsecsElapsed());
+		m_oElapsed.invalidate();
+	}
+	emit taskProfiled(m_sInputFile, m_oProfile);
+}
+
+// +-----------------------------------------------------------
+void fsdk::ExtractionTask::setCheckpoint(const QString &sFile, const int iInterval)
+{
+	m_sCheckpointFile = sFile;
+	m_iCheckpointInterval = qMax(iInterval, 1) * qint64(1000);
+}
+
+// +-----------------------------------------------------------
+QString fsdk::ExtractionTask::checkpointFile() const
+{
+	return m_sCheckpointFile;
+}
+
+// +-----------------------------------------------------------
+QString fsdk::ExtractionTask::checkpointFileName(const QString &sOutputFile)
+{
+	return sOutputFile + ".ckpt";
+}
+
+// +-----------------------------------------------------------
+QString fsdk::ExtractionTask::checkpointDataFile(const QString &sFile)
+{
+	return sFile + ".csv";
+}
+
+// +-----------------------------------------------------------
+void fsdk::ExtractionTask::removeCheckpoint(const QString &sFile)
+{
+	QString sDataFile = checkpointDataFile(sFile);
+	FaceTracksData::removeFaceFiles(sDataFile);
+	QFile::remove(sFile);
+	QFile::remove(sDataFile);
+	QFile::remove(SignalPyramid::fileName(sDataFile));
+}
+
+// +-----------------------------------------------------------
+int fsdk::ExtractionTask::readCheckpoint(int &iRecords) const
+{
+	iRecords = -1;
+	if(!isCheckpointEnabled())
+		return -1;
+
+	QFile oFile(m_sCheckpointFile);
+	if(!oFile.open(QIODevice::ReadOnly))
+		return -1;
+
+	QJsonObject oCheckpoint = QJsonDocument::fromJson(oFile.readAll()).object();
+	if(oCheckpoint.value("input").toString() != m_sInputFile)
+	{
+		qWarning().noquote() << QApplication::translate("ExtractionTask", "checkpoint file %1 is not from input file %2; it will be ignored").arg(m_sCheckpointFile, m_sInputFile);
+		return -1;
+	}
+
+	iRecords = oCheckpoint.value("records").toInt(-1);
+	return oCheckpoint.value("frame").toInt(-1);
+}
+
+// +-----------------------------------------------------------
+bool fsdk::ExtractionTask::writeCheckpoint(const int iRecords)
+{
+	m_oCheckpointTimer.restart();
+
+	QJsonObject oCheckpoint;
+	oCheckpoint["input"] = m_sInputFile;
+	oCheckpoint["frame"] = m_iCurrentFrame;
+	oCheckpoint["records"] = iRecords;
+
+	// Save the file atomically, so an interruption never leaves it corrupted
+	QSaveFile oFile(m_sCheckpointFile);
+	if(!oFile.open(QIODevice::WriteOnly))
+		return false;
+	oFile.write(QJsonDocument(oCheckpoint).toJson(QJsonDocument::Compact));
+	return oFile.commit();
+}
+
+// +-----------------------------------------------------------
+bool fsdk::ExtractionTask::isCheckpointEnabled() const
+{
+	return !m_sCheckpointFile.isEmpty() && (m_eInputFileType == VideoFile || m_eInputFileType == ImageSequenceInput);
+}
+
+// +-----------------------------------------------------------
+bool fsdk::ExtractionTask::isCheckpointDue() const
+{
+	if(!isCheckpointEnabled())
+		return false;
+
+	return m_oCheckpointTimer.hasExpired(m_iCheckpointInterval);
+}
+
+// +-----------------------------------------------------------
+bool fsdk::ExtractionTask::seek(const int iFrame)
+{
+	if(m_eInputFileType != VideoFile && m_eInputFileType != ImageSequenceInput)
+		return iFrame == 0;
+
+	if(iFrame <= 0)
+		return true;
+
+	// The images of a sequence are simply decoded from the given one on. Even
+	// when the seeking of a video is not frame-accurate, grabbing the frames is
+	// still much faster than processing them again
+	if(m_eInputFileType == ImageSequenceInput)
+		startSequence(iFrame);
+	else if(!positionCapture(iFrame))
+		return false;
+
+	m_iCurrentFrame = iFrame - 1;
+	m_iFramesRead = m_oSelection.count(iFrame, m_dVideoFrameRate);
+	m_iLastProgressFrames = m_iFramesRead;
+	return true;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::ExtractionTask::isImageSequence() const
+{
+	return m_eInputFileType == ImageSequenceInput;
 }
\ No newline at end of file
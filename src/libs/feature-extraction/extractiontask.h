@@ -21,8 +21,18 @@
 #define EXTRACTIONTASK_H
 
 #include "libexport.h"
+#include "taskprofile.h"
+#include "taskprogress.h"
+#include "frameselection.h"
+#include "livesource.h"
+#include "imagesequence.h"
+#include "featurering.h"
 #include <QObject>
 #include <QRunnable>
+#include <QElapsedTimer>
+#include <QPoint>
+#include <QApplication>
+#include <QDebug>
 #include <opencv2/opencv.hpp>
 
 using namespace cv;
@@ -45,6 +55,13 @@ namespace fsdk
 		 */
 		ExtractionTask(QString sInputFile);
 
+		/**
+		 * Class destructor. Releases the live input, the image sequence and the
+		 * ring buffer of the features published, if the task did not conclude
+		 * (for instance, if it was never started or it was interrupted).
+		 */
+		virtual ~ExtractionTask();
+
 		/**
 		 * Enumeration values indicating the different extraction errors
 		 * that may happen.
@@ -66,9 +83,29 @@ namespace fsdk
 		Q_ENUM(ExtractionError)
 
 		/**
-		 * Gets the number of frames in the input file being processed.
+		 * Enumeration values indicating how the frames are decoded.
+		 */
+		enum DecodeMode
+		{
+			/** The frames are decoded to BGR (the default). */
+			ColorDecode,
+
+			/**
+			 * Only the luma (the gray levels) of the frames is kept, as an 8-bit
+			 * single channel image; the BGR frame is only produced on demand.
+			 */
+			LumaDecode
+		};
+		Q_ENUM(DecodeMode)
+
+		/**
+		 * Gets the number of frames in the input file being processed (or only
+		 * the number of frames selected, if there is a frame selection).
 		 * This function always return 1 for image files (since they have
-		 * only one "frame").
+		 * only one "frame"). The number is queried from the video only once,
+		 * when the task starts.
+		 * @return Integer with the number of frames, or 0 if the video does
+		 * not report it.
 		 */
 		int frameCount() const;
 
@@ -83,7 +120,8 @@ namespace fsdk
 		int frameIndex() const;
 
 		/**
-		 * Gets the data of the current frame in processing.
+		 * Gets the data of the current frame in processing (in BGR, or only its
+		 * luma if the luma decoding is used; see setDecodeMode()).
 		 * @return OpenCV's Mat with the frame data. It can be an empty
 		 * Mat if there is no frame available (see the documentation for 
 		 * the method frameIndex()). To check if it is an empty Mat, use
@@ -92,7 +130,18 @@ namespace fsdk
 		Mat& frame();
 
 		/**
-		 * Grabs the next frame from the input file to process.
+		 * Gets the data of the current frame in processing in BGR. In the
+		 * luma decoding (see setDecodeMode()) the BGR frame is only produced
+		 * by this call, once per frame; otherwise it is the same as frame().
+		 * @return OpenCV's Mat with the BGR frame data. It can be an empty Mat
+		 * if there is no frame available.
+		 */
+		Mat& colorFrame();
+
+		/**
+		 * Grabs the next frame from the input file to process. If a frame selection
+		 * is set, the frames not selected are skipped without being decoded (by
+		 * seeking the video or just grabbing them, whichever is cheaper).
 		 * @return OpenCV's Mat with the frame data. It can be an empty
 		 * Mat if there is no frame available (see the documentation for
 		 * the method frameIndex()). To check if it is an empty Mat, use
@@ -100,6 +149,124 @@ namespace fsdk
 		 */
 		Mat& nextFrame();
 
+		/**
+		 * Enables or disables the timing of the stages of the extraction. When
+		 * enabled, the profile is reported with the signal taskProfiled() at the
+		 * end of the task. It must be called before the task is started.
+		 * @param bEnabled Boolean indicating if the profiling is enabled (true)
+		 * or not (false). The default is disabled.
+		 */
+		void setProfilingEnabled(const bool bEnabled);
+
+		/**
+		 * Sets the selection of the frames to process in video files (the default
+		 * is to process all frames). It must be called before the task is started.
+		 * @param oSelection FrameSelection with the frames to process.
+		 */
+		void setFrameSelection(const FrameSelection &oSelection);
+
+		/**
+		 * Sets how the frames are decoded. In the luma decoding, the frames given
+		 * by frame() and nextFrame() are 8-bit gray images: the image files are
+		 * decoded straight to gray (the JPEG decoder, for instance, only decodes
+		 * the luma component) and the luma of the video/live frames is taken once
+		 * as they are read, so the consumers that work on the gray levels (the
+		 * face trackers and the Gabor filtering) need no conversion of their own,
+		 * and all copies of the frames (or of regions of them) are a third of the
+		 * size. It must be called before the task is started.
+		 * @param eMode Value of the DecodeMode enumeration with the decoding mode.
+		 * The default is ColorDecode.
+		 */
+		void setDecodeMode(const DecodeMode eMode);
+
+		/**
+		 * Gets how the frames are decoded.
+		 * @return Value of the DecodeMode enumeration with the decoding mode.
+		 */
+		DecodeMode decodeMode() const;
+
+		/**
+		 * Enables the periodic checkpointing of the extraction, so an interrupted
+		 * task can be resumed later from the last checkpoint instead of from the
+		 * begining of the video. The checkpoint is made of a small file with the
+		 * index of the last frame processed (the given file) and a CSV file with
+		 * the partial results (see checkpointDataFile()). It must be called
+		 * before the task is started.
+		 * @param sFile QString with the name of the checkpoint file. If it is
+		 * empty (the default), the checkpointing is disabled.
+		 * @param iInterval Integer with the interval between the checkpoints,
+		 * in seconds. The default is 60 seconds.
+		 */
+		void setCheckpoint(const QString &sFile, const int iInterval = 60);
+
+		/**
+		 * Sets up the reading of live inputs (a camera or a named pipe, see
+		 * LiveSource). The frames are captured in another thread and, when the
+		 * extraction falls behind, the oldest frames are dropped so the latency
+		 * stays bounded (the indexes of the frames processed then have gaps).
+		 * It must be called before the task is started.
+		 * @param iQueueSize Integer with the maximum number of frames waiting
+		 * to be processed. The default is 2.
+		 * @param iMaxLatency Integer with the maximum time, in milliseconds, that
+		 * a frame may wait to be processed. The default is 200.
+		 * @param iDuration Integer with the time, in seconds, after which the
+		 * extraction ends. The default is 0 (i.e. it runs until the input ends
+		 * or the task is cancelled).
+		 */
+		void setLiveOptions(const int iQueueSize = 2, const int iMaxLatency = 200, const int iDuration = 0);
+
+		/**
+		 * Enables or disables the streaming of the results, frame by frame, with
+		 * the signal taskResult() (in addition to the whole results reported by
+		 * taskFinished() at the end). It must be called before the task is started.
+		 * @param bEnabled Boolean indicating if the streaming is enabled (true)
+		 * or not (false, the default).
+		 */
+		void setStreaming(const bool bEnabled);
+
+		/**
+		 * Enables the publishing of the features of each frame, as soon as they
+		 * are extracted, to a ring buffer in shared memory (see FeatureRing), so
+		 * other processes can consume them with low latency. The ring is created
+		 * when the task starts and destroyed when it ends (or when its last reader
+		 * detaches from it). It must be called before the task is started.
+		 * @param sKey QString with the key of the shared memory. If it is empty
+		 * (the default), the publishing is disabled.
+		 * @param iCapacity Integer with the number of records kept in the ring.
+		 * The default is 256.
+		 */
+		void setPublishing(const QString &sKey, const int iCapacity = 256);
+
+		/**
+		 * Gets the name of the checkpoint file used by the task.
+		 * @return QString with the name of the checkpoint file, or an empty
+		 * string if the checkpointing is disabled.
+		 */
+		QString checkpointFile() const;
+
+		/**
+		 * Gets the name of the checkpoint file to be used for the given output
+		 * (CSV) file.
+		 * @param sOutputFile QString with the name of the output file.
+		 * @return QString with the name of the checkpoint file.
+		 */
+		static QString checkpointFileName(const QString &sOutputFile);
+
+		/**
+		 * Gets the name of the CSV file with the partial results of the given
+		 * checkpoint file.
+		 * @param sFile QString with the name of the checkpoint file.
+		 * @return QString with the name of the CSV file with the partial results.
+		 */
+		static QString checkpointDataFile(const QString &sFile);
+
+		/**
+		 * Removes the given checkpoint file and its partial results (including
+		 * the files of the faces, if the results have more than one face).
+		 * @param sFile QString with the name of the checkpoint file.
+		 */
+		static void removeCheckpoint(const QString &sFile);
+
 	public slots:
 
 		/**
@@ -127,12 +294,14 @@ namespace fsdk
 		void taskError(const QString &sInputFile, const ExtractionTask::ExtractionError eError);
 
 		/**
-		 * Indicates the progress of the feature extraction.
+		 * Indicates the progress of the feature extraction. It is emitted at most
+		 * once every PROGRESS_INTERVAL milliseconds (and once more at the end),
+		 * so the cost of the queued signal does not depend on the video length.
 		 * @param sInputFile QString with the name of the image/video file that is being processed.
-		 * @param iPercent Integer value in range [0, 100] indicating
-		 * how much of the extraction has been concluded.
+		 * @param oProgress TaskProgress with the frames processed, the smoothed
+		 * processing rate and the estimated time remaining.
 		 */
-		void taskProgress(const QString &sInputFile, const int iProgress);
+		void taskProgress(const QString &sInputFile, const fsdk::TaskProgress &oProgress);
 
 		/**
 		 * Indicates that the feature extraction has been concluded.
@@ -144,6 +313,26 @@ namespace fsdk
 		 */
 		void taskFinished(const QString &sInputFile, const QVariant &vData);
 
+		/**
+		 * Indicates the results of a single frame, as soon as it is processed
+		 * (only if the streaming is enabled, see setStreaming()).
+		 * @param sInputFile QString with the name of the input being processed.
+		 * @param iFrame Integer with the index of the frame.
+		 * @param vData QVariant object with the data of the features extracted
+		 * from the frame (of the same type reported by taskFinished()).
+		 */
+		void taskResult(const QString &sInputFile, const int iFrame, const QVariant &vData);
+
+		/**
+		 * Indicates the timing of the stages of the extraction. It is emitted
+		 * (only if the profiling is enabled) right before taskFinished() or
+		 * taskError().
+		 * @param sInputFile QString with the name of the image/video file
+		 * that was processed.
+		 * @param oProfile TaskProfile with the timing of the stages.
+		 */
+		void taskProfiled(const QString &sInputFile, const fsdk::TaskProfile &oProfile);
+
 	protected:
 
 		/**
@@ -196,6 +385,13 @@ namespace fsdk
 		 */
 		QString inputFile() const;
 
+		/**
+		 * Gets the frame rate of the input video (available after start()).
+		 * @return Double with the frame rate in frames per second (or 30 if
+		 * it is not known).
+		 */
+		double videoFrameRate() const;
+
 		/**
 		 * Gets the progress of the task.
 		 * @return Integer with the current progress in range [0, 100].
@@ -203,13 +399,199 @@ namespace fsdk
 		int progress() const;
 
 		/**
-		 * Sets the progress of the task.
-		 * @param iProgress Integer with the current progress in range [0, 100].
+		 * Updates the progress of the task after the current frame has been
+		 * processed. This method SHOULD be called at the end of each iteration
+		 * of the loop in the implementation of run(). It measures the processing
+		 * rate and emits the signal taskProgress() when the reporting interval
+		 * has elapsed.
+		 */
+		void updateProgress();
+
+		/**
+		 * Gets the profile used to time the stages of the extraction (to be
+		 * used with ScopedStageTimer in the implementation of run()).
+		 * @return Reference to the TaskProfile of the task.
+		 */
+		TaskProfile& profile();
+
+		/**
+		 * Reads the checkpoint of the task (if the checkpointing is enabled and
+		 * the file exists and was produced for the same input file).
+		 * @param iRecords Reference to an integer to receive the number of records
+		 * in the partial results of the checkpoint, so the implementations can
+		 * check that the results read back are the ones of the checkpoint.
+		 * @return Integer with the index of the last frame processed before the
+		 * checkpoint, or -1 if there is no valid checkpoint to resume from.
+		 */
+		int readCheckpoint(int &iRecords) const;
+
+		/**
+		 * Records a checkpoint with the index of the current frame. The partial
+		 * results MUST have been saved to checkpointDataFile() before calling
+		 * this method.
+		 * @param iRecords Integer with the number of records in the partial
+		 * results saved (see readCheckpoint()).
+		 * @return Boolean indicating if the checkpoint was recorded (true) or
+		 * not (false).
+		 */
+		bool writeCheckpoint(const int iRecords);
+
+		/**
+		 * Resumes the task from its last checkpoint, if there is one: reads the
+		 * partial results and seeks the video to the frame following the last
+		 * one processed. If the checkpoint can not be read, or if the partial
+		 * results read back do not match it, the task simply starts over from
+		 * the begining.
+		 * @param oData Reference to the data to receive the partial results (any
+		 * of the data classes with readFromCSV(), count() and clear(), such as
+		 * LandmarksData, FaceTracksData or GaborData).
+		 * @return Boolean indicating if the task can proceed (true) or if the
+		 * video could not be seeked (false).
+		 */
+		template<typename T> bool resumeCheckpoint(T &oData);
+
+		/**
+		 * Records a checkpoint with the partial results of the task.
+		 * @param oData Reference to the data with the partial results (any of
+		 * the data classes with saveToCSV() and count()).
+		 * @return Boolean indicating if the checkpoint was recorded (true)
+		 * or not (false).
+		 */
+		template<typename T> bool saveCheckpoint(const T &oData);
+
+		/**
+		 * Checks if the checkpointing is enabled for the task (it is never
+		 * enabled for image files nor live inputs, only for videos and image
+		 * sequences).
+		 * @return Boolean indicating if the checkpointing is enabled (true)
+		 * or not (false).
+		 */
+		bool isCheckpointEnabled() const;
+
+		/**
+		 * Checks if it is time to record a new checkpoint (i.e. if the checkpointing
+		 * is enabled, the input is a video and the interval has elapsed).
+		 * @return Boolean indicating if a checkpoint is due (true) or not (false).
+		 */
+		bool isCheckpointDue() const;
+
+		/**
+		 * Checks if the results are streamed frame by frame.
+		 * @return Boolean indicating if the streaming is enabled (true) or
+		 * not (false).
 		 */
-		void setProgress(int iProgress);
+		bool isStreaming() const;
+
+		/**
+		 * Emits the signal taskResult() with the results of a frame.
+		 * @param vData QVariant object with the data of the features extracted
+		 * from the frame.
+		 * @param iFrame Integer with the index of the frame. The default is -1,
+		 * meaning the current frame (the results of the frames processed in
+		 * batches are streamed after the frames were read).
+		 */
+		void streamResult(const QVariant &vData, const int iFrame = -1);
+
+		/**
+		 * Creates the ring buffer to publish the features of the frames, if the
+		 * publishing is enabled. It must be called after start().
+		 * @param iValuesCount Integer with the maximum number of values published
+		 * for each frame.
+		 * @return Boolean indicating if the task can proceed (true) or if the ring
+		 * could not be created (false).
+		 */
+		bool openPublishing(const int iValuesCount);
+
+		/**
+		 * Publishes the features of a frame (if the publishing is enabled).
+		 * @param iFace Integer with the ID of the face (0 if only one face is tracked).
+		 * @param fQuality Float with the quality of the tracking of the face.
+		 * @param lValues QList of floats with the features.
+		 * @param iFrame Integer with the index of the frame. The default is -1,
+		 * meaning the current frame.
+		 */
+		void publish(const int iFace, const float fQuality, const QList<float> &lValues, const int iFrame = -1);
+
+		/**
+		 * Publishes the landmarks of the current frame (if the publishing is
+		 * enabled), as the sequence of their coordinates (x0, y0, x1, y1, ...).
+		 * @param iFace Integer with the ID of the face (0 if only one face is tracked).
+		 * @param fQuality Float with the quality of the tracking of the face.
+		 * @param lLandmarks QList of QPoint with the landmarks.
+		 */
+		void publish(const int iFace, const float fQuality, const QList<QPoint> &lLandmarks);
+
+		/**
+		 * Seeks the input video (or image sequence) so the next call to
+		 * nextFrame() grabs the given frame. It is intended to resume the task from a checkpoint, after start()
+		 * has been called.
+		 * @param iFrame Integer with the index of the frame to seek to.
+		 * @return Boolean indicating if the seek was succesful (true) or not (false).
+		 */
+		bool seek(const int iFrame);
+
+		/**
+		 * Queries if the input is a sequence of images (see ImageSequence), whose
+		 * frames are unrelated still images (so, for instance, the face should be
+		 * detected again in each one of them).
+		 * @return Boolean indicating if the input is an image sequence (true)
+		 * or not (false).
+		 */
+		bool isImageSequence() const;
 
 	private:
 
+		/**
+		 * Concludes the timing of the task and reports it with the signal
+		 * taskProfiled(), if the profiling is enabled.
+		 */
+		void endProfile();
+
+		/**
+		 * Emits the signal taskProgress() with the current progress.
+		 * @param iFrames Integer with the number of frames processed.
+		 * @param iFrameCount Integer with the total number of frames.
+		 */
+		void emitProgress(const int iFrames, const int iFrameCount);
+
+		/**
+		 * Positions the video capture so the next frame read is the given one.
+		 * Short distances ahead are skipped by grabbing the frames (which does
+		 * not decode them); longer ones by seeking the container, as long as it
+		 * proves to be frame-accurate.
+		 * @param iFrame Integer with the index of the frame to position at.
+		 * @return Boolean indicating if the positioning was succesful (true) or
+		 * not (false).
+		 */
+		bool positionCapture(const int iFrame);
+
+		/**
+		 * Takes the luma of the frame decoded as the current frame (used in the
+		 * luma decoding of the video/live frames).
+		 */
+		void extractLuma();
+
+		/**
+		 * Starts decoding the images of the sequence selected, from the given one.
+		 * @param iFrame Integer with the index of the first image to decode.
+		 */
+		void startSequence(const int iFrame);
+
+		/**
+		 * Stops the capture of the live input (if any) and releases it.
+		 */
+		void releaseLive();
+
+		/**
+		 * Stops decoding the image sequence (if any) and releases it.
+		 */
+		void releaseSequence();
+
+		/**
+		 * Destroys the ring buffer used to publish the features (if any).
+		 */
+		void closePublishing();
+
 		/** Define the possible types of the input file. */
 		enum InputFileType
 		{
@@ -217,7 +599,13 @@ namespace fsdk
 			ImageFile,
 
 			/** The input file is a video file. */
-			VideoFile
+			VideoFile,
+
+			/** The input is a live camera or named pipe. */
+			LiveInput,
+
+			/** The input is a sequence of image files. */
+			ImageSequenceInput
 		};
 
 		/** Type of the input file. */
@@ -241,9 +629,129 @@ namespace fsdk
 		/** Data of the current frame being processed in the input file. */
 		Mat m_oCurrentFrame;
 
+		/** How the frames are decoded. */
+		DecodeMode m_eDecodeMode;
+
+		/** Frame decoded from the video/live input, in the luma decoding (reused between the frames). */
+		Mat m_oDecoded;
+
+		/** BGR frame produced on demand, in the luma decoding (empty until requested). */
+		Mat m_oColorFrame;
+
 		/** Index of the current frame being processed in the input file. */
 		int m_iCurrentFrame;
+
+		/** Number of frames to process (queried once, when the task starts). */
+		int m_iFrameCount;
+
+		/** Number of frames read from the input file. */
+		int m_iFramesRead;
+
+		/** Selection of the frames to process. */
+		FrameSelection m_oSelection;
+
+		/** Frame rate of the input video (used to select frames by time). */
+		double m_dVideoFrameRate;
+
+		/** Index of the next frame that the video capture will read. */
+		int m_iCapturePosition;
+
+		/** Indicates if seeking the video capture is frame-accurate. */
+		bool m_bSeekable;
+
+		/** Timer of the progress (used to measure the processing rate). */
+		QElapsedTimer m_oProgressTimer;
+
+		/** Time of the last progress reported, in milliseconds. */
+		qint64 m_iLastProgressTime;
+
+		/** Number of frames read at the time of the last progress reported. */
+		int m_iLastProgressFrames;
+
+		/** Smoothed (exponential moving average) processing rate in frames per second. */
+		double m_dFrameRate;
+
+		/** Timing of the stages of the extraction. */
+		TaskProfile m_oProfile;
+
+		/** Timer of the whole task (used when profiling). */
+		QElapsedTimer m_oElapsed;
+
+		/** Name of the checkpoint file (empty if the checkpointing is disabled). */
+		QString m_sCheckpointFile;
+
+		/** Interval between the checkpoints, in milliseconds. */
+		qint64 m_iCheckpointInterval;
+
+		/** Timer of the last checkpoint recorded. */
+		QElapsedTimer m_oCheckpointTimer;
+
+		/** Live source read (if the input is a live input). */
+		LiveSource *m_pLive;
+
+		/** Image sequence read (if the input is an image sequence). */
+		ImageSequence *m_pSequence;
+
+		/** Maximum number of live frames waiting to be processed. */
+		int m_iLiveQueueSize;
+
+		/** Maximum time that a live frame may wait to be processed, in milliseconds. */
+		int m_iLiveMaxLatency;
+
+		/** Time after which the extraction of a live input ends, in milliseconds (0 for no limit). */
+		qint64 m_iLiveDuration;
+
+		/** Indicates if the results are streamed frame by frame. */
+		bool m_bStreaming;
+
+		/** Key of the shared memory where the features are published (empty if disabled). */
+		QString m_sPublishKey;
+
+		/** Number of records kept in the ring buffer of the features published. */
+		int m_iPublishCapacity;
+
+		/** Ring buffer where the features are published (while the task runs). */
+		FeatureRing *m_pRing;
 	};
 }
 
+// +-----------------------------------------------------------
+template<typename T> bool fsdk::ExtractionTask::resumeCheckpoint(T &oData)
+{
+	int iRecords;
+	int iLastFrame = readCheckpoint(iRecords);
+	if(iLastFrame < 0)
+		return true;
+
+	if(!oData.readFromCSV(checkpointDataFile(checkpointFile())))
+	{
+		qWarning().noquote() << QApplication::translate("ExtractionTask", "could not read the partial results of checkpoint %1; the extraction will start over").arg(checkpointFile());
+		oData.clear();
+		return true;
+	}
+
+	// The results saved after the checkpoint was last recorded (or left
+	// incomplete by an interruption) can not be resumed from its frame
+	if(oData.count() != iRecords)
+	{
+		qWarning().noquote() << QApplication::translate("ExtractionTask", "the partial results of checkpoint %1 do not match it; the extraction will start over").arg(checkpointFile());
+		oData.clear();
+		return true;
+	}
+
+	return seek(iLastFrame + 1);
+}
+
+// +-----------------------------------------------------------
+template<typename T> bool fsdk::ExtractionTask::saveCheckpoint(const T &oData)
+{
+	ScopedStageTimer oTimer(profile(), TaskProfile::SerializationStage);
+	if(!oData.saveToCSV(checkpointDataFile(checkpointFile())) || !writeCheckpoint(oData.count()))
+	{
+		qWarning().noquote() << QApplication::translate("ExtractionTask", "error writing the checkpoint file %1").arg(checkpointFile());
+		return false;
+	}
+	return true;
+}
+
 #endif // EXTRACTIONTASK_H
\ No newline at end of file
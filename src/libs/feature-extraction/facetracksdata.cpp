@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "facetracksdata.h"
+#include "csvfile.h"
+#include <QApplication>
+#include <QFileInfo>
+#include <QDir>
+#include <QRegularExpression>
+
+// +-----------------------------------------------------------
+fsdk::FaceTracksData::FaceTracksData()
+{
+	qRegisterMetaType<fsdk::FaceTracksData>("fsdk::FaceTracksData");
+}
+
+// +-----------------------------------------------------------
+bool fsdk::FaceTracksData::isEmpty() const
+{
+	return m_mFaces.isEmpty();
+}
+
+// +-----------------------------------------------------------
+int fsdk::FaceTracksData::count() const
+{
+	int iCount = 0;
+	QMap<int, LandmarksData>::const_iterator it;
+	for(it = m_mFaces.cbegin(); it != m_mFaces.cend(); ++it)
+		iCount += it.value().count();
+	return iCount;
+}
+
+// +-----------------------------------------------------------
+QList<int> fsdk::FaceTracksData::faces() const
+{
+	return m_mFaces.keys();
+}
+
+// +-----------------------------------------------------------
+const fsdk::LandmarksData fsdk::FaceTracksData::face(const int iFace) const
+{
+	return m_mFaces.value(iFace);
+}
+
+// +-----------------------------------------------------------
+void fsdk::FaceTracksData::add(const int iFrame, const int iFace, const QList<QPoint> &lPoints, const float fQuality)
+{
+	m_mFaces[iFace].add(iFrame, lPoints, fQuality);
+}
+
+// +-----------------------------------------------------------
+void fsdk::FaceTracksData::clear()
+{
+	m_mFaces.clear();
+}
+
+// +-----------------------------------------------------------
+QString fsdk::FaceTracksData::faceFileName(const QString &sFilename, const int iFace)
+{
+	QFileInfo oFile(sFilename);
+	return oFile.dir().filePath(QString("%1-face%2.%3").arg(oFile.completeBaseName()).arg(iFace).arg(oFile.suffix()));
+}
+
+// +-----------------------------------------------------------
+QStringList fsdk::FaceTracksData::faceFiles(const QString &sFilename)
+{
+	CSVFile oIndex;
+	if(!QFile::exists(sFilename) || !oIndex.read(sFilename))
+		return QStringList();
+
+	QFileInfo oFile(sFilename);
+	QDir oDir = oFile.dir();
+	QRegularExpression oRE(QString("^%1-face[0-9]+\\.%2$").arg(QRegularExpression::escape(oFile.completeBaseName()),
+		QRegularExpression::escape(oFile.suffix())));
+
+	QStringList lFiles;
+	foreach(QStringList lLine, oIndex.lines())
+	{
+		if(lLine.count() >= 5 && oRE.match(lLine[4]).hasMatch())
+			lFiles.append(oDir.filePath(lLine[4]));
+	}
+	return lFiles;
+}
+
+// +-----------------------------------------------------------
+void fsdk::FaceTracksData::removeFaceFiles(const QString &sFilename)
+{
+	// Only the files listed in the previous index are removed, since a glob over
+	// the directory would also match the outputs of other inputs (i.e. the file
+	// "video-face2.csv" of the input "video-face2.avi" when saving "video.csv")
+	foreach(QString sPath, faceFiles(sFilename))
+	{
+		QFile::remove(sPath);
+		QFile::remove(SignalPyramid::fileName(sPath));
+	}
+}
+
+// +-----------------------------------------------------------
+bool fsdk::FaceTracksData::saveToCSV(const QString &sFilename) const
+{
+	// Remove the files of faces from previous savings (that may not exist anymore)
+	removeFaceFiles(sFilename);
+
+	CSVFile oIndex;
+	oIndex.header().append({ "Face", "First Frame", "Last Frame", "Frames", "File" });
+
+	QMap<int, LandmarksData>::const_iterator it;
+	for(it = m_mFaces.cbegin(); it != m_mFaces.cend(); ++it)
+	{
+		QString sFaceFile = faceFileName(sFilename, it.key());
+		if(!it.value().saveToCSV(sFaceFile))
+			return false;
+
+		QList<int> lFrames = it.value().frames();
+		oIndex.addLine({ QString::number(it.key()), QString::number(lFrames.first()), QString::number(lFrames.last()),
+			QString::number(lFrames.count()), QFileInfo(sFaceFile).fileName() });
+	}
+
+	return oIndex.write(sFilename);
+}
+
+// +-----------------------------------------------------------
+bool fsdk::FaceTracksData::readFromCSV(const QString &sFilename)
+{
+	CSVFile oIndex;
+	if(!oIndex.read(sFilename))
+	{
+		qDebug().noquote() << QApplication::translate("FaceTracksData", "error reading face tracks CSV file");
+		return false;
+	}
+
+	QMap<int, LandmarksData> mFaces;
+	QDir oDir = QFileInfo(sFilename).dir();
+	foreach(QStringList lLine, oIndex.lines())
+	{
+		if(lLine.count() < 5)
+		{
+			qDebug().noquote() << QApplication::translate("FaceTracksData", "format error in face tracks CSV file");
+			return false;
+		}
+
+		LandmarksData oData;
+		if(!oData.readFromCSV(oDir.filePath(lLine[4])))
+			return false;
+		mFaces[lLine[0].toInt()] = oData;
+	}
+
+	m_mFaces = mFaces;
+	return true;
+}
\ No newline at end of file
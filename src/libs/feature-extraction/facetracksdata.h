@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef FACETRACKSDATA_H
+#define FACETRACKSDATA_H
+
+#include "libexport.h"
+#include "landmarksdata.h"
+#include <QMap>
+#include <QList>
+#include <QStringList>
+#include <QPoint>
+#include <QMetaType>
+
+namespace fsdk
+{
+	/**
+	 * Represents the landmarks extracted from videos with more than one face
+	 * (for instance, of two players sharing the camera). The data of each face
+	 * is kept in its own LandmarksData, identified by the stable ID given by
+	 * the tracking, and has only the frames where that face was tracked.
+	 * The data is saved to one CSV file per face (in the same format of the
+	 * single face extraction, so they can be used to extract the Gabor
+	 * features), plus an index CSV file with the list of faces.
+	 */
+	class SHARED_LIB_EXPORT FaceTracksData
+	{
+	public:
+
+		/**
+		 * Class constructor.
+		 */
+		FaceTracksData();
+
+		/**
+		 * Queries if the data is empty.
+		 * @return Boolean indicating if the data is empty (true) or not (false).
+		 */
+		bool isEmpty() const;
+
+		/**
+		 * Gets the number of records in the data (the frames of all faces).
+		 * @return Integer with the number of records.
+		 */
+		int count() const;
+
+		/**
+		 * Gets the IDs of the faces in the data.
+		 * @return QList of integers with the IDs of the faces, in ascending order.
+		 */
+		QList<int> faces() const;
+
+		/**
+		 * Gets the landmarks data of a face.
+		 * @param iFace Integer with the ID of the face.
+		 * @return LandmarksData with the frames where the face was tracked (empty
+		 * if there is no face with the given ID).
+		 */
+		const LandmarksData face(const int iFace) const;
+
+		/**
+		 * Adds data of a face in the given frame.
+		 * @param iFrame Integer with the number of the video frame.
+		 * @param iFace Integer with the ID of the face.
+		 * @param lPoints QList of QPoint objects with the coordinates of
+		 * the facial landmarks of the face in that frame.
+		 * @param fQuality Float value with the tracking quality of the face
+		 * in that frame, in range [0, 1].
+		 */
+		void add(const int iFrame, const int iFace, const QList<QPoint> &lPoints, const float fQuality);
+
+		/**
+		 * Removes all existing data.
+		 */
+		void clear();
+
+		/**
+		 * Saves the data to the given index CSV file and to the CSV files of
+		 * the faces (see faceFileName()).
+		 * @param sFilename QString with the name of the index file.
+		 * @return Boolean indicating if the saving was succesful (true) or
+		 * not (false).
+		 */
+		bool saveToCSV(const QString &sFilename) const;
+
+		/**
+		 * Reads the data from the given index CSV file and from the CSV files
+		 * of the faces listed in it.
+		 * @param sFilename QString with the name of the index file.
+		 * @return Boolean indicating if the reading was succesful (true) or
+		 * not (false).
+		 */
+		bool readFromCSV(const QString &sFilename);
+
+		/**
+		 * Gets the name of the CSV file with the data of a face.
+		 * @param sFilename QString with the name of the index file.
+		 * @param iFace Integer with the ID of the face.
+		 * @return QString with the name of the file of the face (the name of
+		 * the index file with the suffix "-face<ID>", in the same directory).
+		 */
+		static QString faceFileName(const QString &sFilename, const int iFace);
+
+		/**
+		 * Gets the CSV files of the faces listed in the given index file. Only
+		 * the files named as by faceFileName() are listed.
+		 * @param sFilename QString with the name of the index file.
+		 * @return QStringList with the paths and names of the files of the faces,
+		 * or an empty list if the index file does not exist or can not be read.
+		 */
+		static QStringList faceFiles(const QString &sFilename);
+
+		/**
+		 * Removes the CSV files of the faces (and their summary pyramids) listed
+		 * in the given index file. The index file itself is not removed, and
+		 * nothing is done if it does not exist.
+		 * @param sFilename QString with the name of the index file.
+		 */
+		static void removeFaceFiles(const QString &sFilename);
+
+	private:
+
+		/** Mapping between the face IDs and their landmarks data. */
+		QMap<int, LandmarksData> m_mFaces;
+	};
+}
+
+// Declare the class as a Qt metatype
+Q_DECLARE_METATYPE(fsdk::FaceTracksData);
+
+#endif // FACETRACKSDATA_H
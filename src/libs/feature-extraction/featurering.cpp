@@ -0,0 +1,261 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "featurering.h"
+#include <QAtomicInteger>
+#include <QApplication>
+#include <QDebug>
+#include <chrono>
+#include <atomic>
+#include <cstring>
+
+/** Magic number of the ring header ("FSDK" in little-endian). */
+#define RING_MAGIC 0x4B445346
+
+/** Version of the layout of the ring. */
+#define RING_VERSION 1
+
+/** Size of the ring header, in bytes. */
+#define HEADER_SIZE 64
+
+/** Offset of the number of records written in the header. */
+#define WRITTEN_OFFSET 24
+
+/** Size of the fixed fields of a record, in bytes. */
+#define RECORD_FIELDS_SIZE 32
+
+// +-----------------------------------------------------------
+fsdk::FeatureRing::FeatureRing(const QString &sKey):
+	m_oMemory(sKey)
+{
+	m_iCapacity = 0;
+	m_iValuesCount = 0;
+	m_iRecordSize = 0;
+	m_iNext = 0;
+	m_iLost = 0;
+}
+
+// +-----------------------------------------------------------
+fsdk::FeatureRing::~FeatureRing()
+{
+	detach();
+}
+
+// +-----------------------------------------------------------
+bool fsdk::FeatureRing::create(const int iValuesCount, const int iCapacity)
+{
+	detach();
+
+	m_iValuesCount = qMax(iValuesCount, 0);
+	m_iCapacity = qMax(iCapacity, 1);
+
+	// Keep the records aligned to 8 bytes (for the 64-bit fields)
+	m_iRecordSize = (RECORD_FIELDS_SIZE + m_iValuesCount * sizeof(float) + 7) & ~7;
+	if(!m_oMemory.create(HEADER_SIZE + m_iCapacity * m_iRecordSize))
+	{
+		qWarning().noquote() << QApplication::translate("FeatureRing", "could not create the shared memory %1: %2").arg(key(), m_oMemory.errorString());
+		m_iCapacity = 0;
+		m_iValuesCount = 0;
+		return false;
+	}
+
+	char *pData = static_cast<char*>(m_oMemory.data());
+	memset(pData, 0, m_oMemory.size());
+	quint32 *pHeader = reinterpret_cast<quint32*>(pData);
+	pHeader[0] = RING_MAGIC;
+	pHeader[1] = RING_VERSION;
+	pHeader[2] = m_iCapacity;
+	pHeader[3] = m_iValuesCount;
+	pHeader[4] = m_iRecordSize;
+
+	m_iNext = 0;
+	m_iLost = 0;
+	return true;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::FeatureRing::attach()
+{
+	detach();
+
+	if(!m_oMemory.attach(QSharedMemory::ReadOnly))
+		return false;
+
+	const quint32 *pHeader = static_cast<const quint32*>(m_oMemory.constData());
+	if(m_oMemory.size() < HEADER_SIZE || pHeader[0] != RING_MAGIC || pHeader[1] != RING_VERSION)
+	{
+		qWarning().noquote() << QApplication::translate("FeatureRing", "the shared memory %1 does not have a ring of features").arg(key());
+		m_oMemory.detach();
+		return false;
+	}
+
+	m_iCapacity = pHeader[2];
+	m_iValuesCount = pHeader[3];
+	m_iRecordSize = pHeader[4];
+
+	// Start with the oldest record still available
+	quint64 iWritten = reinterpret_cast<const QBasicAtomicInteger<quint64>*>(static_cast<const char*>(m_oMemory.constData()) + WRITTEN_OFFSET)->loadAcquire();
+	m_iNext = iWritten > quint64(m_iCapacity) ? iWritten - m_iCapacity : 0;
+	m_iLost = 0;
+	return true;
+}
+
+// +-----------------------------------------------------------
+void fsdk::FeatureRing::detach()
+{
+	if(m_oMemory.isAttached())
+		m_oMemory.detach();
+	m_iCapacity = 0;
+	m_iValuesCount = 0;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::FeatureRing::isAttached() const
+{
+	return m_oMemory.isAttached();
+}
+
+// +-----------------------------------------------------------
+QString fsdk::FeatureRing::key() const
+{
+	return m_oMemory.key();
+}
+
+// +-----------------------------------------------------------
+int fsdk::FeatureRing::capacity() const
+{
+	return m_iCapacity;
+}
+
+// +-----------------------------------------------------------
+int fsdk::FeatureRing::valuesCount() const
+{
+	return m_iValuesCount;
+}
+
+// +-----------------------------------------------------------
+qint64 fsdk::FeatureRing::lostRecords() const
+{
+	return m_iLost;
+}
+
+// +-----------------------------------------------------------
+qint64 fsdk::FeatureRing::now()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// +-----------------------------------------------------------
+char* fsdk::FeatureRing::record(const quint64 iSequence) const
+{
+	return static_cast<char*>(const_cast<void*>(m_oMemory.constData())) + HEADER_SIZE + (iSequence % m_iCapacity) * m_iRecordSize;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::FeatureRing::publish(const int iFrame, const int iFace, const float fQuality, const QList<float> &lValues)
+{
+	if(!isAttached() || m_iCapacity == 0)
+		return false;
+
+	char *pRecord = record(m_iNext);
+	QBasicAtomicInteger<quint64> *pSequence = reinterpret_cast<QBasicAtomicInteger<quint64>*>(pRecord);
+	QBasicAtomicInteger<quint64> *pWritten = reinterpret_cast<QBasicAtomicInteger<quint64>*>(static_cast<char*>(m_oMemory.data()) + WRITTEN_OFFSET);
+
+	// Mark the record as being written, so the readers ignore it meanwhile
+	// (the fence keeps the writes of the fields from happening before it)
+	pSequence->storeRelease(2 * m_iNext + 1);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	qint64 iTimestamp = now();
+	quint32 iCount = qMin(lValues.count(), m_iValuesCount);
+	memcpy(pRecord + 8, &iTimestamp, sizeof(qint64));
+	memcpy(pRecord + 16, &iFrame, sizeof(qint32));
+	memcpy(pRecord + 20, &iFace, sizeof(qint32));
+	memcpy(pRecord + 24, &fQuality, sizeof(float));
+	memcpy(pRecord + 28, &iCount, sizeof(quint32));
+	float *pValues = reinterpret_cast<float*>(pRecord + RECORD_FIELDS_SIZE);
+	for(quint32 i = 0; i < iCount; i++)
+		pValues[i] = lValues[i];
+
+	// Conclude the record and make it available
+	pSequence->storeRelease(2 * m_iNext + 2);
+	m_iNext++;
+	pWritten->storeRelease(m_iNext);
+	return true;
+}
+
+// +-----------------------------------------------------------
+fsdk::FeatureRing::ReadResult fsdk::FeatureRing::read(int &iFrame, int &iFace, float &fQuality, QList<float> &lValues, qint64 &iTimestamp)
+{
+	if(!isAttached() || m_iCapacity == 0)
+		return NoRecord;
+
+	const QBasicAtomicInteger<quint64> *pWritten = reinterpret_cast<const QBasicAtomicInteger<quint64>*>(static_cast<const char*>(m_oMemory.constData()) + WRITTEN_OFFSET);
+	bool bLost = false;
+	while(true)
+	{
+		quint64 iWritten = pWritten->loadAcquire();
+		if(m_iNext >= iWritten)
+			return NoRecord;
+
+		// Skip the records already overwritten by the writer
+		if(iWritten - m_iNext > quint64(m_iCapacity))
+		{
+			m_iLost += iWritten - m_iCapacity - m_iNext;
+			m_iNext = iWritten - m_iCapacity;
+			bLost = true;
+		}
+
+		// Copy the record, and check that it was not overwritten meanwhile
+		const char *pRecord = record(m_iNext);
+		const QBasicAtomicInteger<quint64> *pSequence = reinterpret_cast<const QBasicAtomicInteger<quint64>*>(pRecord);
+		if(pSequence->loadAcquire() != 2 * m_iNext + 2)
+		{
+			m_iLost++;
+			m_iNext++;
+			bLost = true;
+			continue;
+		}
+
+		quint32 iCount;
+		memcpy(&iTimestamp, pRecord + 8, sizeof(qint64));
+		memcpy(&iFrame, pRecord + 16, sizeof(qint32));
+		memcpy(&iFace, pRecord + 20, sizeof(qint32));
+		memcpy(&fQuality, pRecord + 24, sizeof(float));
+		memcpy(&iCount, pRecord + 28, sizeof(quint32));
+		iCount = qMin(iCount, quint32(m_iValuesCount));
+
+		lValues.clear();
+		const float *pValues = reinterpret_cast<const float*>(pRecord + RECORD_FIELDS_SIZE);
+		for(quint32 i = 0; i < iCount; i++)
+			lValues.append(pValues[i]);
+
+		// (the fence keeps the reads of the fields from happening after it)
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if(pSequence->loadAcquire() != 2 * m_iNext + 2)
+		{
+			m_iLost++;
+			m_iNext++;
+			bLost = true;
+			continue;
+		}
+
+		m_iNext++;
+		return bLost ? RecordsLost : RecordRead;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef FEATURERING_H
+#define FEATURERING_H
+
+#include "libexport.h"
+#include <QString>
+#include <QList>
+#include <QSharedMemory>
+
+namespace fsdk
+{
+	/**
+	 * Ring buffer of per-frame features in shared memory, used to hand off the
+	 * results of an extraction to other processes as soon as each frame is
+	 * processed (without any file I/O). There is a single writer (the process
+	 * that creates the ring) and any number of readers (the processes that
+	 * attach to it), and no locks are used: the writer never waits for the
+	 * readers, so a reader that falls more than capacity() records behind
+	 * loses the oldest ones.
+	 *
+	 * The layout of the shared memory is fixed (all values little-endian, as
+	 * in the machine), so readers may be written in any language:
+	 * - header (64 bytes): magic 0x4B445346 ("FSDK") as uint32 at offset 0,
+	 *   version (1) as uint32 at 4, capacity (number of records) as uint32 at
+	 *   8, maximum number of values per record as uint32 at 12, record size in
+	 *   bytes as uint32 at 16, and the number of records written as uint64 at
+	 *   24 (updated after each record is complete);
+	 * - records (starting at offset 64, each record i at 64 + (i % capacity) *
+	 *   record size): sequence as uint64 at 0, publishing time in microseconds
+	 *   since the epoch as int64 at 8, frame as int32 at 16, face as int32 at
+	 *   20, quality as float at 24, number of values as uint32 at 28 and the
+	 *   values as floats from 32.
+	 *
+	 * The sequence of a record is 2n + 1 while the n-th record (counting from
+	 * 0) is being written, and 2n + 2 when it is complete. Readers must check
+	 * it before and after copying a record, to detect when it was overwritten
+	 * in the meantime.
+	 */
+	class SHARED_LIB_EXPORT FeatureRing
+	{
+	public:
+
+		/**
+		 * Results of reading a record from the ring.
+		 */
+		enum ReadResult
+		{
+			/** A record was read. */
+			RecordRead,
+
+			/** There is no new record to read. */
+			NoRecord,
+
+			/** A record was read, but some records before it were lost (see lostRecords()). */
+			RecordsLost
+		};
+
+		/**
+		 * Class constructor.
+		 * @param sKey QString with the key that identifies the shared memory.
+		 */
+		FeatureRing(const QString &sKey);
+
+		/**
+		 * Class destructor.
+		 */
+		virtual ~FeatureRing();
+
+		/**
+		 * Creates the ring in the shared memory, to write to it.
+		 * @param iValuesCount Integer with the maximum number of values in each record.
+		 * @param iCapacity Integer with the number of records kept in the ring. The
+		 * default is 256.
+		 * @return Boolean indicating if the ring was created (true) or not (false,
+		 * for instance, if another process already created a ring with the same key).
+		 */
+		bool create(const int iValuesCount, const int iCapacity = 256);
+
+		/**
+		 * Attaches to a ring created by another process, to read from it. The
+		 * reading starts with the oldest record still available in the ring.
+		 * @return Boolean indicating if the ring was attached (true) or not (false).
+		 */
+		bool attach();
+
+		/**
+		 * Detaches from the shared memory (which is destroyed when the last process
+		 * detaches from it).
+		 */
+		void detach();
+
+		/**
+		 * Queries if the ring is attached to the shared memory (i.e. if it was
+		 * created or attached).
+		 * @return Boolean indicating if the ring is attached (true) or not (false).
+		 */
+		bool isAttached() const;
+
+		/**
+		 * Gets the key that identifies the shared memory.
+		 * @return QString with the key.
+		 */
+		QString key() const;
+
+		/**
+		 * Gets the number of records kept in the ring.
+		 * @return Integer with the capacity, or 0 if the ring is not attached.
+		 */
+		int capacity() const;
+
+		/**
+		 * Gets the maximum number of values in each record.
+		 * @return Integer with the number of values, or 0 if the ring is not attached.
+		 */
+		int valuesCount() const;
+
+		/**
+		 * Writes a record to the ring (it must have been created by this instance).
+		 * @param iFrame Integer with the index of the frame.
+		 * @param iFace Integer with the ID of the face (or 0 if only one face is tracked).
+		 * @param fQuality Float with the quality of the tracking of the face.
+		 * @param lValues QList of floats with the features of the frame (the values
+		 * beyond valuesCount() are ignored).
+		 * @return Boolean indicating if the record was written (true) or not (false).
+		 */
+		bool publish(const int iFrame, const int iFace, const float fQuality, const QList<float> &lValues);
+
+		/**
+		 * Reads the next record from the ring (it must have been attached by this
+		 * instance).
+		 * @param iFrame Reference to an integer to receive the index of the frame.
+		 * @param iFace Reference to an integer to receive the ID of the face.
+		 * @param fQuality Reference to a float to receive the quality of the tracking.
+		 * @param lValues Reference to a QList of floats to receive the features.
+		 * @param iTimestamp Reference to a 64-bit integer to receive the time when
+		 * the record was published, in microseconds since the epoch.
+		 * @return Value of the ReadResult enumeration indicating if a record was read.
+		 */
+		ReadResult read(int &iFrame, int &iFace, float &fQuality, QList<float> &lValues, qint64 &iTimestamp);
+
+		/**
+		 * Gets the number of records lost by the reader so far (because they were
+		 * overwritten before being read).
+		 * @return 64-bit integer with the number of records lost.
+		 */
+		qint64 lostRecords() const;
+
+		/**
+		 * Gets the current time in the clock used to time the records.
+		 * @return 64-bit integer with the time in microseconds since the epoch.
+		 */
+		static qint64 now();
+
+	protected:
+
+		/**
+		 * Gets the address of the given record in the shared memory.
+		 * @param iSequence 64-bit integer with the number of the record (counting from 0).
+		 * @return Pointer to the begining of the record.
+		 */
+		char* record(const quint64 iSequence) const;
+
+	private:
+
+		/** Shared memory with the ring. */
+		QSharedMemory m_oMemory;
+
+		/** Number of records kept in the ring. */
+		int m_iCapacity;
+
+		/** Maximum number of values in each record. */
+		int m_iValuesCount;
+
+		/** Size of each record in bytes. */
+		int m_iRecordSize;
+
+		/** Number of the next record to write or read. */
+		quint64 m_iNext;
+
+		/** Number of records lost by the reader. */
+		qint64 m_iLost;
+	};
+}
+
+#endif // FEATURERING_H
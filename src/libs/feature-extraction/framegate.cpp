@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "framegate.h"
+#include <opencv2/imgproc/imgproc.hpp>
+#include <QVector2D>
+#include <QApplication>
+
+using namespace cv;
+
+// Width and height of the signatures of the frames
+#define SIGNATURE_SIZE 32
+
+// +-----------------------------------------------------------
+fsdk::FrameGate::FrameGate(const double dThreshold, const int iMaxReused)
+{
+	m_dThreshold = qMax(dThreshold, 0.0);
+	m_iMaxReused = qMax(iMaxReused, 0);
+	m_iConsecutive = 0;
+	m_iReused = 0;
+	m_iProcessed = 0;
+	m_dLastChange = -1;
+	m_iErrors = 0;
+	m_dErrorSum = 0;
+	m_dErrorMax = 0;
+}
+
+// +-----------------------------------------------------------
+void fsdk::FrameGate::setThreshold(const double dThreshold)
+{
+	m_dThreshold = qMax(dThreshold, 0.0);
+}
+
+// +-----------------------------------------------------------
+double fsdk::FrameGate::threshold() const
+{
+	return m_dThreshold;
+}
+
+// +-----------------------------------------------------------
+void fsdk::FrameGate::setMaxReused(const int iMaxReused)
+{
+	m_iMaxReused = qMax(iMaxReused, 0);
+}
+
+// +-----------------------------------------------------------
+int fsdk::FrameGate::maxReused() const
+{
+	return m_iMaxReused;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::FrameGate::isRedundant(const Mat &oFrame)
+{
+	// Signature: the gray levels averaged over blocks of the frame
+	Mat oGray;
+	if(oFrame.channels() == 3)
+		cvtColor(oFrame, oGray, CV_BGR2GRAY);
+	else
+		oGray = oFrame;
+	resize(oGray, m_oSignature, Size(SIGNATURE_SIZE, SIGNATURE_SIZE), 0, 0, INTER_AREA);
+
+	double dChange = -1;
+	if(!m_oReference.empty())
+		dChange = norm(m_oSignature, m_oReference, NORM_L1) / m_oSignature.total();
+
+	if(decide(dChange))
+		return true;
+
+	m_oSignature.copyTo(m_oReference);
+	return false;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::FrameGate::isRedundant(const QList<QPoint> &lLandmarks)
+{
+	double dChange = -1;
+	if(!lLandmarks.isEmpty() && lLandmarks.count() == m_lReference.count())
+	{
+		dChange = 0;
+		for(int i = 0; i < lLandmarks.count(); i++)
+			dChange += QVector2D(lLandmarks[i] - m_lReference[i]).length();
+		dChange /= lLandmarks.count();
+	}
+
+	if(decide(dChange))
+		return true;
+
+	m_lReference = lLandmarks;
+	return false;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::FrameGate::decide(const double dChange)
+{
+	m_dLastChange = dChange;
+	if(dChange >= 0 && dChange < m_dThreshold && m_iConsecutive < m_iMaxReused)
+	{
+		m_iConsecutive++;
+		m_iReused++;
+		return true;
+	}
+
+	m_iConsecutive = 0;
+	m_iProcessed++;
+	return false;
+}
+
+// +-----------------------------------------------------------
+void fsdk::FrameGate::reset()
+{
+	m_oReference.release();
+	m_lReference.clear();
+	m_iConsecutive = 0;
+}
+
+// +-----------------------------------------------------------
+double fsdk::FrameGate::lastChange() const
+{
+	return m_dLastChange;
+}
+
+// +-----------------------------------------------------------
+int fsdk::FrameGate::reusedFrames() const
+{
+	return m_iReused;
+}
+
+// +-----------------------------------------------------------
+int fsdk::FrameGate::processedFrames() const
+{
+	return m_iProcessed;
+}
+
+// +-----------------------------------------------------------
+void fsdk::FrameGate::addError(const double dError)
+{
+	m_iErrors++;
+	m_dErrorSum += dError;
+	m_dErrorMax = qMax(m_dErrorMax, dError);
+}
+
+// +-----------------------------------------------------------
+double fsdk::FrameGate::meanError() const
+{
+	return m_iErrors > 0 ? m_dErrorSum / m_iErrors : 0;
+}
+
+// +-----------------------------------------------------------
+double fsdk::FrameGate::maxError() const
+{
+	return m_dErrorMax;
+}
+
+// +-----------------------------------------------------------
+QString fsdk::FrameGate::toString() const
+{
+	int iFrames = m_iReused + m_iProcessed;
+	QString sRet = QApplication::translate("FrameGate", "%1 of %2 frames reused (%3%)")
+		.arg(m_iReused).arg(iFrames).arg(iFrames > 0 ? m_iReused * 100.0 / iFrames : 0, 0, 'f', 1);
+	if(m_iErrors > 0)
+		sRet += QApplication::translate("FrameGate", "; error of the reused frames of %1 (max %2)")
+			.arg(meanError(), 0, 'g', 4).arg(maxError(), 0, 'g', 4);
+	return sRet;
+}
\ No newline at end of file
@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FRAMEGATE_H
+#define FRAMEGATE_H
+
+#include "libexport.h"
+#include <opencv2/core/core.hpp>
+#include <QList>
+#include <QPoint>
+#include <QString>
+
+namespace fsdk
+{
+	/**
+	 * Change-detection gate that tells which frames are redundant, i.e. barely
+	 * changed since the last frame fully processed, so the results of that frame
+	 * can be reused instead of being computed again (long stretches of webcam
+	 * recordings where the face barely moves). The change is measured either on a
+	 * cheap signature of the frame (the gray levels downsampled to 32x32 pixels,
+	 * compared by their mean absolute difference, in gray levels) or on the facial
+	 * landmarks (compared by their mean displacement, in pixels). The reference is
+	 * only updated with the frames fully processed, so slow drifts accumulate until
+	 * they exceed the threshold. A maximum number of consecutive reused frames
+	 * forces a refresh, bounding the age of the results reused.
+	 * The gate also accumulates the errors of the results reused (if the caller
+	 * validates them against the full processing) to report its accuracy.
+	 */
+	class SHARED_LIB_EXPORT FrameGate
+	{
+	public:
+
+		/**
+		 * Class constructor.
+		 * @param dThreshold Double with the change below which a frame is redundant
+		 * (in gray levels for the signatures or in pixels for the landmarks). The
+		 * default is 2.
+		 * @param iMaxReused Integer with the maximum number of consecutive frames
+		 * reused. The default is 30.
+		 */
+		FrameGate(const double dThreshold = 2.0, const int iMaxReused = 30);
+
+		/**
+		 * Sets the change below which a frame is redundant.
+		 * @param dThreshold Double with the threshold (in gray levels for the
+		 * signatures or in pixels for the landmarks).
+		 */
+		void setThreshold(const double dThreshold);
+
+		/**
+		 * Gets the change below which a frame is redundant.
+		 * @return Double with the threshold.
+		 */
+		double threshold() const;
+
+		/**
+		 * Sets the maximum number of consecutive frames reused.
+		 * @param iMaxReused Integer with the maximum number of frames.
+		 */
+		void setMaxReused(const int iMaxReused);
+
+		/**
+		 * Gets the maximum number of consecutive frames reused.
+		 * @return Integer with the maximum number of frames.
+		 */
+		int maxReused() const;
+
+		/**
+		 * Checks if a frame is redundant by its signature. If it is not, the frame
+		 * becomes the reference (i.e. it is assumed to be fully processed).
+		 * @param oFrame OpenCV's Mat with the frame (gray or BGR).
+		 * @return Boolean indicating if the frame is redundant (true) or if it must
+		 * be fully processed (false).
+		 */
+		bool isRedundant(const cv::Mat &oFrame);
+
+		/**
+		 * Checks if a frame is redundant by its landmarks. If it is not, the
+		 * landmarks become the reference (i.e. the frame is assumed to be fully
+		 * processed). Frames without landmarks are never redundant.
+		 * @param lLandmarks QList of QPoint with the landmarks of the frame.
+		 * @return Boolean indicating if the frame is redundant (true) or if it must
+		 * be fully processed (false).
+		 */
+		bool isRedundant(const QList<QPoint> &lLandmarks);
+
+		/**
+		 * Discards the reference, so the next frame is fully processed.
+		 */
+		void reset();
+
+		/**
+		 * Gets the change measured in the last frame checked.
+		 * @return Double with the change (in gray levels for the signatures or in
+		 * pixels for the landmarks), or -1 if there was no reference to compare.
+		 */
+		double lastChange() const;
+
+		/**
+		 * Gets the number of frames checked that were redundant.
+		 * @return Integer with the number of frames reused.
+		 */
+		int reusedFrames() const;
+
+		/**
+		 * Gets the number of frames checked that had to be fully processed.
+		 * @return Integer with the number of frames processed.
+		 */
+		int processedFrames() const;
+
+		/**
+		 * Adds the error of the results reused in a frame, against the results of
+		 * its full processing (the measure of the error is defined by the caller).
+		 * @param dError Double with the error.
+		 */
+		void addError(const double dError);
+
+		/**
+		 * Gets the mean of the errors added.
+		 * @return Double with the mean error (0 if no error was added).
+		 */
+		double meanError() const;
+
+		/**
+		 * Gets the maximum of the errors added.
+		 * @return Double with the maximum error (0 if no error was added).
+		 */
+		double maxError() const;
+
+		/**
+		 * Gets a summary of the gating (and of the errors, if any), to be displayed.
+		 * @return QString with the summary.
+		 */
+		QString toString() const;
+
+	protected:
+
+		/**
+		 * Decides if a frame is redundant from its change, updating the counters.
+		 * @param dChange Double with the change of the frame (or -1 if there was
+		 * no reference to compare).
+		 * @return Boolean indicating if the frame is redundant (true) or not (false).
+		 */
+		bool decide(const double dChange);
+
+	private:
+
+		/** Change below which a frame is redundant. */
+		double m_dThreshold;
+
+		/** Maximum number of consecutive frames reused. */
+		int m_iMaxReused;
+
+		/** Number of consecutive frames reused since the reference. */
+		int m_iConsecutive;
+
+		/** Number of frames reused. */
+		int m_iReused;
+
+		/** Number of frames fully processed. */
+		int m_iProcessed;
+
+		/** Change measured in the last frame checked. */
+		double m_dLastChange;
+
+		/** Signature of the reference frame (empty if there is none). */
+		cv::Mat m_oReference;
+
+		/** Buffer with the signature of the frame checked (reused between the frames). */
+		cv::Mat m_oSignature;
+
+		/** Landmarks of the reference frame (empty if there are none). */
+		QList<QPoint> m_lReference;
+
+		/** Number of errors added. */
+		int m_iErrors;
+
+		/** Sum of the errors added. */
+		double m_dErrorSum;
+
+		/** Maximum error added. */
+		double m_dErrorMax;
+	};
+}
+
+#endif // FRAMEGATE_H
@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "frameselection.h"
+#include <QStringList>
+#include <QtMath>
+#include <algorithm>
+
+// +-----------------------------------------------------------
+fsdk::FrameSelection::FrameSelection()
+{
+	m_iStride = 1;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::FrameSelection::isAll() const
+{
+	return m_iStride == 1 && m_lRanges.isEmpty() && m_lTimeRanges.isEmpty() && m_lFrames.isEmpty();
+}
+
+// +-----------------------------------------------------------
+int fsdk::FrameSelection::stride() const
+{
+	return m_iStride;
+}
+
+// +-----------------------------------------------------------
+void fsdk::FrameSelection::setStride(const int iStride)
+{
+	m_iStride = qMax(iStride, 1);
+}
+
+// +-----------------------------------------------------------
+void fsdk::FrameSelection::addRange(const int iFirst, const int iLast)
+{
+	m_lRanges.append(QPair<int, int>(qMax(qMin(iFirst, iLast), 0), qMax(iFirst, iLast)));
+}
+
+// +-----------------------------------------------------------
+void fsdk::FrameSelection::addTimeRange(const qint64 iStart, const qint64 iEnd)
+{
+	m_lTimeRanges.append(QPair<qint64, qint64>(qMax(qMin(iStart, iEnd), qint64(0)), qMax(iStart, iEnd)));
+}
+
+// +-----------------------------------------------------------
+void fsdk::FrameSelection::addFrame(const int iFrame)
+{
+	if(iFrame < 0)
+		return;
+
+	QList<int>::iterator it = std::lower_bound(m_lFrames.begin(), m_lFrames.end(), iFrame);
+	if(it == m_lFrames.end() || *it != iFrame)
+		m_lFrames.insert(it, iFrame);
+}
+
+// +-----------------------------------------------------------
+void fsdk::FrameSelection::clear()
+{
+	m_iStride = 1;
+	m_lRanges.clear();
+	m_lTimeRanges.clear();
+	m_lFrames.clear();
+}
+
+// +-----------------------------------------------------------
+bool fsdk::FrameSelection::parseFrames(const QString &sSpec)
+{
+	FrameSelection oParsed(*this);
+	foreach(QString sItem, sSpec.split(',', QString::SkipEmptyParts))
+	{
+		QStringList lValues = sItem.trimmed().split('-');
+		bool bFirst, bLast = true;
+		int iFirst = lValues[0].trimmed().toInt(&bFirst);
+		int iLast = lValues.count() == 2 ? lValues[1].trimmed().toInt(&bLast) : iFirst;
+
+		if(!bFirst || !bLast || lValues.count() > 2 || iFirst < 0 || iLast < iFirst)
+			return false;
+
+		if(lValues.count() == 1)
+			oParsed.addFrame(iFirst);
+		else
+			oParsed.addRange(iFirst, iLast);
+	}
+
+	*this = oParsed;
+	return true;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::FrameSelection::parseTimes(const QString &sSpec)
+{
+	FrameSelection oParsed(*this);
+	foreach(QString sItem, sSpec.split(',', QString::SkipEmptyParts))
+	{
+		QStringList lValues = sItem.trimmed().split('-');
+		qint64 iStart, iEnd;
+		if(lValues.count() != 2 || !parseTime(lValues[0], iStart) || !parseTime(lValues[1], iEnd) || iEnd < iStart)
+			return false;
+
+		oParsed.addTimeRange(iStart, iEnd);
+	}
+
+	*this = oParsed;
+	return true;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::FrameSelection::parseTime(const QString &sTime, qint64 &iTime)
+{
+	QStringList lParts = sTime.trimmed().split(':');
+	if(lParts.count() > 3)
+		return false;
+
+	double dSeconds = 0;
+	for(int i = 0; i < lParts.count(); i++)
+	{
+		bool bOk;
+		double dValue = lParts[i].toDouble(&bOk);
+		if(!bOk || dValue < 0 || (i < lParts.count() - 1 && dValue != qFloor(dValue)))
+			return false;
+		dSeconds = dSeconds * 60 + dValue;
+	}
+
+	iTime = qRound64(dSeconds * 1000);
+	return true;
+}
+
+// +-----------------------------------------------------------
+QList<QPair<int, int>> fsdk::FrameSelection::frameRanges(const double dFrameRate) const
+{
+	QList<QPair<int, int>> lRanges = m_lRanges;
+
+	QList<QPair<qint64, qint64>>::const_iterator it;
+	for(it = m_lTimeRanges.cbegin(); it != m_lTimeRanges.cend(); ++it)
+	{
+		int iFirst = qCeil(it->first * dFrameRate / 1000.0);
+		int iLast = qFloor(it->second * dFrameRate / 1000.0);
+		if(iLast >= iFirst)
+			lRanges.append(QPair<int, int>(iFirst, iLast));
+	}
+
+	return lRanges;
+}
+
+// +-----------------------------------------------------------
+int fsdk::FrameSelection::next(const int iFrame, const double dFrameRate) const
+{
+	int iStart = qMax(iFrame, 0);
+
+	// Without ranges nor explicit frames, the stride applies to the whole video
+	if(m_lRanges.isEmpty() && m_lTimeRanges.isEmpty() && m_lFrames.isEmpty())
+		return (iStart + m_iStride - 1) / m_iStride * m_iStride;
+
+	int iNext = -1;
+
+	// Next frame (aligned to the stride) in each range
+	QList<QPair<int, int>> lRanges = frameRanges(dFrameRate);
+	QList<QPair<int, int>>::const_iterator it;
+	for(it = lRanges.cbegin(); it != lRanges.cend(); ++it)
+	{
+		if(it->second < iStart)
+			continue;
+
+		int iCandidate = qMax(iStart, it->first);
+		iCandidate = it->first + (iCandidate - it->first + m_iStride - 1) / m_iStride * m_iStride;
+		if(iCandidate <= it->second && (iNext == -1 || iCandidate < iNext))
+			iNext = iCandidate;
+	}
+
+	// Next frame in the explicit list
+	QList<int>::const_iterator itFrame = std::lower_bound(m_lFrames.cbegin(), m_lFrames.cend(), iStart);
+	if(itFrame != m_lFrames.cend() && (iNext == -1 || *itFrame < iNext))
+		iNext = *itFrame;
+
+	return iNext;
+}
+
+// +-----------------------------------------------------------
+int fsdk::FrameSelection::count(const int iFrame, const double dFrameRate) const
+{
+	if(iFrame <= 0)
+		return 0;
+
+	if(m_lRanges.isEmpty() && m_lTimeRanges.isEmpty() && m_lFrames.isEmpty())
+		return (iFrame + m_iStride - 1) / m_iStride;
+
+	// The ranges may overlap, so simply walk the selected frames
+	int iCount = 0;
+	for(int i = next(0, dFrameRate); i >= 0 && i < iFrame; i = next(i + 1, dFrameRate))
+		iCount++;
+	return iCount;
+}
\ No newline at end of file
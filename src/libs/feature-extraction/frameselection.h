@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef FRAMESELECTION_H
+#define FRAMESELECTION_H
+
+#include "libexport.h"
+#include <QString>
+#include <QList>
+#include <QPair>
+
+namespace fsdk
+{
+	/**
+	 * Selection of the frames of a video to be processed by an extraction task.
+	 * The selection is made of frame ranges, time ranges and/or an explicit list
+	 * of frames (or all frames, if none of them is given), sub-sampled by a stride.
+	 * The stride is applied from the begining of each range (or of the video) and
+	 * not to the frames in the explicit list.
+	 */
+	class SHARED_LIB_EXPORT FrameSelection
+	{
+	public:
+
+		/**
+		 * Class constructor. The selection initially includes all frames.
+		 */
+		FrameSelection();
+
+		/**
+		 * Queries if the selection includes all frames (i.e. if it has no ranges
+		 * or frame list and the stride is 1).
+		 * @return Boolean indicating if all frames are selected (true) or not (false).
+		 */
+		bool isAll() const;
+
+		/**
+		 * Gets the stride of the selection.
+		 * @return Integer with the stride (1 means every frame is selected).
+		 */
+		int stride() const;
+
+		/**
+		 * Sets the stride of the selection (i.e. only every Nth frame is selected).
+		 * @param iStride Integer with the stride. Values lower than 1 are taken as 1.
+		 */
+		void setStride(const int iStride);
+
+		/**
+		 * Adds a range of frames to the selection.
+		 * @param iFirst Integer with the index of the first frame in the range.
+		 * @param iLast Integer with the index of the last frame in the range (inclusive).
+		 */
+		void addRange(const int iFirst, const int iLast);
+
+		/**
+		 * Adds a time range to the selection. It is converted to frames using the
+		 * frame rate of the video when the selection is queried.
+		 * @param iStart Long integer with the start time of the range, in milliseconds.
+		 * @param iEnd Long integer with the end time of the range (inclusive), in milliseconds.
+		 */
+		void addTimeRange(const qint64 iStart, const qint64 iEnd);
+
+		/**
+		 * Adds an explicit frame to the selection.
+		 * @param iFrame Integer with the index of the frame.
+		 */
+		void addFrame(const int iFrame);
+
+		/**
+		 * Removes all ranges and frames and resets the stride (so all frames are
+		 * selected again).
+		 */
+		void clear();
+
+		/**
+		 * Parses a list of frames and frame ranges, in the format "10-200,350,400-420",
+		 * and adds them to the selection.
+		 * @param sSpec QString with the list of frames and ranges.
+		 * @return Boolean indicating if the list is valid (true) or not (false). In case
+		 * of an invalid list, the selection is not changed.
+		 */
+		bool parseFrames(const QString &sSpec);
+
+		/**
+		 * Parses a list of time ranges, in the format "65.5-90,00:02:00-00:02:30" (the
+		 * times can be given in seconds or as [[hh:]mm:]ss[.zzz]), and adds them to the
+		 * selection.
+		 * @param sSpec QString with the list of time ranges.
+		 * @return Boolean indicating if the list is valid (true) or not (false). In case
+		 * of an invalid list, the selection is not changed.
+		 */
+		bool parseTimes(const QString &sSpec);
+
+		/**
+		 * Gets the first frame selected at or after the given frame.
+		 * @param iFrame Integer with the index of the frame to start searching from.
+		 * @param dFrameRate Double with the frame rate of the video (used to convert
+		 * the time ranges).
+		 * @return Integer with the index of the next frame selected, or -1 if there
+		 * is none.
+		 */
+		int next(const int iFrame, const double dFrameRate) const;
+
+		/**
+		 * Counts the frames selected before the given frame.
+		 * @param iFrame Integer with the index of the frame (exclusive limit).
+		 * @param dFrameRate Double with the frame rate of the video (used to convert
+		 * the time ranges).
+		 * @return Integer with the number of frames selected in range [0, iFrame).
+		 */
+		int count(const int iFrame, const double dFrameRate) const;
+
+	protected:
+
+		/**
+		 * Gets all the ranges of frames in the selection (including the time ranges
+		 * converted to frames).
+		 * @param dFrameRate Double with the frame rate of the video.
+		 * @return QList with the pairs of first and last frames of each range.
+		 */
+		QList<QPair<int, int>> frameRanges(const double dFrameRate) const;
+
+		/**
+		 * Parses a time given in seconds or as [[hh:]mm:]ss[.zzz].
+		 * @param sTime QString with the time to parse.
+		 * @param iTime Reference to a long integer to receive the time in milliseconds.
+		 * @return Boolean indicating if the time is valid (true) or not (false).
+		 */
+		static bool parseTime(const QString &sTime, qint64 &iTime);
+
+	private:
+
+		/** Stride of the selection. */
+		int m_iStride;
+
+		/** Ranges of frames (first and last frames, inclusive). */
+		QList<QPair<int, int>> m_lRanges;
+
+		/** Time ranges (start and end times in milliseconds, inclusive). */
+		QList<QPair<qint64, qint64>> m_lTimeRanges;
+
+		/** Explicit list of frames (kept sorted and without duplicates). */
+		QList<int> m_lFrames;
+	};
+}
+
+#endif // FRAMESELECTION_H
@@ -19,6 +19,7 @@
 
 #include "gaborbank.h"
 #include "imageman.h"
+#include <cmath>
 #include <QApplication>
 #include <QDebug>
 
@@ -27,11 +28,17 @@ using namespace cv;
 // +-----------------------------------------------------------
 fsdk::GaborBank::GaborBank()
 {
+	m_bPyramid = false;
+	m_bUpsample = true;
+	m_ePrecision = GaborKernel::FloatPrecision;
 }
 
 // +-----------------------------------------------------------
 fsdk::GaborBank::GaborBank(const QList<double> &lWavelengths, const QList<double> &lOrientations)
 {
+	m_bPyramid = false;
+	m_bUpsample = true;
+	m_ePrecision = GaborKernel::FloatPrecision;
 	m_lOrientations = lOrientations;
 	m_lWavelengths = lWavelengths;
 
@@ -43,6 +50,7 @@ fsdk::GaborBank::GaborBank(const QList<double> &lWavelengths, const QList<double
 			m_mKernels[KernelParameters(dLambda, dTheta)] = oKernel;
 		}
 	}
+	updateIds();
 }
 
 // +-----------------------------------------------------------
@@ -51,6 +59,13 @@ fsdk::GaborBank::GaborBank(const GaborBank &oOther)
 	m_lWavelengths = oOther.m_lWavelengths;
 	m_lOrientations = oOther.m_lOrientations;
 	m_mKernels = oOther.m_mKernels;
+	m_vKernels = oOther.m_vKernels;
+	m_bPyramid = oOther.m_bPyramid;
+	m_bUpsample = oOther.m_bUpsample;
+	m_vLevels = oOther.m_vLevels;
+	m_vScaled = oOther.m_vScaled;
+	m_vFactors = oOther.m_vFactors;
+	m_ePrecision = oOther.m_ePrecision;
 }
 
 // +-----------------------------------------------------------
@@ -79,6 +94,13 @@ fsdk::GaborBank& fsdk::GaborBank::operator=(const GaborBank &oOther)
 	m_lWavelengths = oOther.m_lWavelengths;
 	m_lOrientations = oOther.m_lOrientations;
 	m_mKernels = oOther.m_mKernels;
+	m_vKernels = oOther.m_vKernels;
+	m_bPyramid = oOther.m_bPyramid;
+	m_bUpsample = oOther.m_bUpsample;
+	m_vLevels = oOther.m_vLevels;
+	m_vScaled = oOther.m_vScaled;
+	m_vFactors = oOther.m_vFactors;
+	m_ePrecision = oOther.m_ePrecision;
 	return *this;
 }
 
@@ -95,6 +117,39 @@ QList<double> fsdk::GaborBank::orientations() const
 	return m_lOrientations;
 }
 
+// +-----------------------------------------------------------
+void fsdk::GaborBank::setPyramid(const bool bEnabled, const bool bUpsample)
+{
+	m_bPyramid = bEnabled;
+	m_bUpsample = bUpsample;
+	updateIds();
+}
+
+// +-----------------------------------------------------------
+bool fsdk::GaborBank::isPyramid() const
+{
+	return m_bPyramid;
+}
+
+// +-----------------------------------------------------------
+int fsdk::GaborBank::pyramidLevel(const int iId) const
+{
+	return m_bPyramid ? m_vLevels.at(iId) : 0;
+}
+
+// +-----------------------------------------------------------
+void fsdk::GaborBank::setPrecision(const GaborKernel::Precision ePrecision)
+{
+	m_ePrecision = ePrecision;
+	updateIds();
+}
+
+// +-----------------------------------------------------------
+fsdk::GaborKernel::Precision fsdk::GaborBank::precision() const
+{
+	return m_ePrecision;
+}
+
 // +-----------------------------------------------------------
 Mat fsdk::GaborBank::getThumbnails(const GaborKernel::KernelComponent eComp, const Size oSize, const bool bResize) const
 {
@@ -128,27 +183,97 @@ Mat fsdk::GaborBank::getThumbnails(const GaborKernel::KernelComponent eComp, con
 // +-----------------------------------------------------------
 void fsdk::GaborBank::filter(const cv::Mat &oImage, QList<cv::Mat> &lResponses) const
 {
-	// Convert the image to gray scale
-	Mat oGrImage;
-	if(oImage.type() != CV_8UC1)
-		cvtColor(oImage, oGrImage, CV_BGR2GRAY);
-	else
-		oGrImage = oImage;
+	// Convert the image to gray scale (and downsample it, if needed)
+	std::vector<Mat> vLevels;
+	buildLevels(oImage, vLevels);
 
 	// Filter with all kernels
 	lResponses.clear();
-	QMap<KernelParameters, GaborKernel>::const_iterator it;
-	for(it = m_mKernels.cbegin(); it != m_mKernels.cend(); ++it)
+	Mat oReal, oImaginary;
+	for(int i = 0; i < m_vKernels.count(); i++)
 	{
-		GaborKernel oKernel = it.value();
-
 		Mat oResponses;
-		oKernel.filter(oGrImage, oResponses);
+		filterKernel(i, vLevels, oResponses, oReal, oImaginary, m_bUpsample);
 
 		lResponses.append(oResponses);
 	}
 }
 
+// +-----------------------------------------------------------
+bool fsdk::GaborBank::filter(const cv::Mat &oImage, cv::Mat &oTensor, const TensorLayout eLayout) const
+{
+	// A batch of a single image (the header of the tensor is kept in the
+	// list, so its memory is reused)
+	QList<Mat> lImages, lTensors;
+	lImages.append(oImage);
+	lTensors.append(oTensor);
+	if(!filter(lImages, lTensors, eLayout))
+		return false;
+
+	oTensor = lTensors[0];
+	return true;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::GaborBank::filter(const QList<cv::Mat> &lImages, QList<cv::Mat> &lTensors, const TensorLayout eLayout) const
+{
+	int iKernels = m_vKernels.count();
+	if(iKernels == 0 || (eLayout == InterleavedLayout && iKernels > CV_CN_MAX))
+		return false;
+
+	while(lTensors.count() < lImages.count())
+		lTensors.append(Mat());
+	while(lTensors.count() > lImages.count())
+		lTensors.removeLast();
+
+	// Convert the images to gray scale (and downsample them, if needed) and
+	// allocate their tensors (Mat::create does nothing if a tensor already has
+	// the same size and type)
+	std::vector<std::vector<Mat> > vLevels(lImages.count());
+	for(int j = 0; j < lImages.count(); j++)
+	{
+		buildLevels(lImages[j], vLevels[j]);
+		Mat oGrImage = vLevels[j][0];
+
+		if(eLayout == PlanarLayout)
+		{
+			int aSizes[] = { iKernels, oGrImage.rows, oGrImage.cols };
+			lTensors[j].create(3, aSizes, CV_32F);
+		}
+		else
+			lTensors[j].create(oGrImage.rows, oGrImage.cols, CV_32FC(iKernels));
+	}
+
+	// Apply each kernel to all images before moving on to the next one (reusing
+	// the buffers of the components among them)
+	Mat oReal, oImaginary, oResponses;
+	for(int i = 0; i < iKernels; i++)
+	{
+		for(int j = 0; j < lImages.count(); j++)
+		{
+			if(eLayout == PlanarLayout)
+			{
+				// Write the response straight to its plane in the tensor
+				oResponses = plane(lTensors[j], i);
+				filterKernel(i, vLevels[j], oResponses, oReal, oImaginary, true);
+			}
+			else
+			{
+				filterKernel(i, vLevels[j], oResponses, oReal, oImaginary, true);
+				int aFromTo[] = { 0, i };
+				mixChannels(&oResponses, 1, &lTensors[j], 1, aFromTo, 1);
+			}
+		}
+	}
+	return true;
+}
+
+// +-----------------------------------------------------------
+Mat fsdk::GaborBank::plane(const cv::Mat &oTensor, const int iKernel)
+{
+	return Mat(oTensor.size[1], oTensor.size[2], CV_32F, const_cast<uchar*>(oTensor.ptr(iKernel)));
+}
+
 // +-----------------------------------------------------------
 void fsdk::GaborBank::filter(const cv::Mat &oImage, QMap<KernelParameters, cv::Mat> &mResponses) const
 {
@@ -189,6 +314,7 @@ void fsdk::GaborBank::clear()
 	m_lOrientations.clear();
 	m_lWavelengths.clear();
 	m_mKernels.clear();
+	m_vKernels.clear();
 }
 
 // +-----------------------------------------------------------
@@ -199,16 +325,148 @@ void fsdk::GaborBank::addKernel(const GaborKernel &oKernel)
 	if(!m_lWavelengths.contains(oKernel.lambda()))
 	m_lWavelengths.append(oKernel.lambda());
 	m_mKernels[KernelParameters(oKernel.lambda(), oKernel.theta())] = oKernel;
+	updateIds();
+}
+
+// +-----------------------------------------------------------
+void fsdk::GaborBank::updateIds()
+{
+	m_vKernels.clear();
+	m_vKernels.reserve(m_mKernels.count());
+	QMap<KernelParameters, GaborKernel>::iterator it;
+	for(it = m_mKernels.begin(); it != m_mKernels.end(); ++it)
+	{
+		if(it.value().precision() != m_ePrecision)
+			it.value().setPrecision(m_ePrecision);
+		m_vKernels.append(it.value());
+	}
+
+	// Scale the kernels to their levels of the pyramid (if used)
+	m_vLevels.fill(0, m_vKernels.count());
+	m_vScaled.clear();
+	m_vFactors.clear();
+	if(!m_bPyramid || m_vKernels.isEmpty())
+		return;
+
+	double dMinLambda = m_vKernels[0].lambda();
+	foreach(GaborKernel oKernel, m_vKernels)
+		dMinLambda = qMin(dMinLambda, oKernel.lambda());
+
+	m_vScaled.reserve(m_vKernels.count());
+	m_vFactors.reserve(m_vKernels.count());
+	for(int i = 0; i < m_vKernels.count(); i++)
+	{
+		GaborKernel oKernel = m_vKernels[i];
+
+		// Use the coarsest level where the wavelength is not smaller than the
+		// smallest wavelength in the bank
+		int iLevel = 0;
+		while(oKernel.lambda() / (1 << (iLevel + 1)) >= dMinLambda)
+			iLevel++;
+		m_vLevels[i] = iLevel;
+
+		if(iLevel == 0)
+		{
+			m_vScaled.append(oKernel);
+			m_vFactors.append(1.0);
+			continue;
+		}
+
+		int iScale = 1 << iLevel;
+		GaborKernel oScaled(oKernel.windowSize() / iScale, oKernel.theta(), oKernel.lambda() / iScale, oKernel.sigma() / iScale, oKernel.psi());
+		oScaled.setPrecision(m_ePrecision);
+		m_vScaled.append(oScaled);
+
+		// Gain of the smoothing of all levels up to the one of the kernel, at
+		// the center frequency of the kernel (in cycles per pixel of each level)
+		double dFreqX = std::cos(oKernel.theta()) / oKernel.lambda();
+		double dFreqY = std::sin(oKernel.theta()) / oKernel.lambda();
+		double dGain = 1.0;
+		for(int j = 0; j < iLevel; j++)
+			dGain *= pyramidGain(dFreqX * (1 << j)) * pyramidGain(dFreqY * (1 << j));
+
+		// The envelope of the scaled kernel covers 1/4^level of the pixels
+		m_vFactors.append(iScale * iScale / dGain);
+	}
+}
+
+// +-----------------------------------------------------------
+void fsdk::GaborBank::buildLevels(const cv::Mat &oImage, std::vector<cv::Mat> &vLevels) const
+{
+	// Convert the image to gray scale
+	Mat oGrImage;
+	if(oImage.type() != CV_8UC1)
+		cvtColor(oImage, oGrImage, CV_BGR2GRAY);
+	else
+		oGrImage = oImage;
+
+	int iMaxLevel = 0;
+	if(m_bPyramid)
+		foreach(int iLevel, m_vLevels)
+			iMaxLevel = qMax(iMaxLevel, iLevel);
+
+	vLevels.clear();
+	if(iMaxLevel > 0)
+		buildPyramid(oGrImage, vLevels, iMaxLevel);
+	else
+		vLevels.push_back(oGrImage);
+}
+
+// +-----------------------------------------------------------
+void fsdk::GaborBank::filterKernel(const int iId, const std::vector<cv::Mat> &vLevels, cv::Mat &oResponses, cv::Mat &oReal, cv::Mat &oImaginary, const bool bUpsample) const
+{
+	int iLevel = pyramidLevel(iId);
+	if(iLevel == 0)
+	{
+		m_vKernels[iId].filter(vLevels[0], oResponses, oReal, oImaginary);
+		return;
+	}
+
+	// Filter the downsampled level with the scaled kernel and compensate the
+	// responses (see the description of the class)
+	Mat oLevelResponses;
+	m_vScaled[iId].filter(vLevels[iLevel], oLevelResponses, oReal, oImaginary);
+	oLevelResponses *= m_vFactors[iId];
+
+	if(bUpsample)
+		resize(oLevelResponses, oResponses, vLevels[0].size(), 0, 0, INTER_LINEAR);
+	else
+		oResponses = oLevelResponses;
+}
+
+// +-----------------------------------------------------------
+double fsdk::GaborBank::pyramidGain(const double dFrequency)
+{
+	// Frequency response of the kernel [1 4 6 4 1] / 16
+	return (6 + 8 * std::cos(2 * CV_PI * dFrequency) + 2 * std::cos(4 * CV_PI * dFrequency)) / 16;
+}
+
+// +-----------------------------------------------------------
+int fsdk::GaborBank::kernelsCount() const
+{
+	return m_vKernels.count();
+}
+
+// +-----------------------------------------------------------
+int fsdk::GaborBank::kernelId(const double dLambda, const double dTheta) const
+{
+	// The offset of 1 makes the comparison of the zero orientation work
+	for(int i = 0; i < m_vKernels.count(); i++)
+		if(qFuzzyCompare(1 + m_vKernels[i].lambda(), 1 + dLambda) && qFuzzyCompare(1 + m_vKernels[i].theta(), 1 + dTheta))
+			return i;
+	return -1;
+}
+
+// +-----------------------------------------------------------
+fsdk::GaborKernel fsdk::GaborBank::kernel(const int iId) const
+{
+	return m_vKernels.at(iId);
 }
 
 // +-----------------------------------------------------------
 QList<fsdk::GaborKernel> fsdk::GaborBank::kernels() const
 {
-	QList<GaborKernel> oRet;
-	QMap<KernelParameters, GaborKernel>::const_iterator it;
-	for(it = m_mKernels.cbegin(); it != m_mKernels.cend(); ++it)
-		oRet.append(it.value());
-	return oRet;
+	return m_vKernels.toList();
 }
 
 // +-----------------------------------------------------------
@@ -24,6 +24,8 @@
 #include "gaborkernel.h"
 #include <QMap>
 #include <QPair>
+#include <QVector>
+#include <vector>
 
 namespace fsdk
 {
@@ -36,11 +38,56 @@ namespace fsdk
 
 	/**
 	 * Implements a bank of Gabor filters used to represent facial expressions.
+	 *
+	 * The bank can optionally filter in a multi-scale (pyramid) mode (see
+	 * setPyramid()): since the window of a kernel grows with its wavelength,
+	 * the kernels with the larger wavelengths dominate the cost of the direct
+	 * filtering. In the pyramid mode, a kernel of wavelength λ is evaluated on
+	 * the level L of a Gaussian pyramid of the image (downsampled by 2^L) with a
+	 * kernel of wavelength λ/2^L, with L as large as possible while λ/2^L is not
+	 * smaller than the smallest wavelength in the bank. With the default bank
+	 * (λ = 3, 6, 9 and 12) the kernels of λ = 6 and 9 are evaluated at half
+	 * resolution and the ones of λ = 12 at quarter resolution, all with windows
+	 * of the size of the λ = 3 or λ = 4.5 kernels, so the total cost gets close
+	 * to the cost of the smallest scale alone.
+	 *
+	 * The responses of the pyramid mode approximate the direct ones: they are
+	 * scaled by 4^L to compensate the smaller area of the envelope of the scaled
+	 * kernel, and by the inverse of the gain of the pyramid smoothing at the
+	 * center frequency of the kernel. The energies (mean magnitudes) agree best,
+	 * since the residual errors come mostly from the frequencies away from the
+	 * center of the band (where the smoothing gain differs from the one
+	 * compensated), while the maps of the responses also lose the spatial detail
+	 * finer than the level they were computed at (and are shifted by up to half
+	 * a pixel of the level when upsampled). The errors against the direct path
+	 * are measured for each kernel by fsdk-bench (metrics of the pyramid runs of
+	 * GaborBank::filter).
 	 */
 	class SHARED_LIB_EXPORT GaborBank
 	{
 	public:
 
+		/**
+		 * Memory layouts of the tensor with the responses of all kernels (see
+		 * filter(const cv::Mat&, cv::Mat&, const TensorLayout)).
+		 */
+		enum TensorLayout
+		{
+			/**
+			 * One plane per kernel (kernels x height x width): a 3-dimensional
+			 * single channel Mat, with the response of the kernel with ID k in
+			 * the plane k.
+			 */
+			PlanarLayout,
+
+			/**
+			 * All kernels per pixel (height x width x kernels): a 2-dimensional
+			 * Mat with one channel per kernel, with the response of the kernel
+			 * with ID k in the channel k (so at most CV_CN_MAX kernels).
+			 */
+			InterleavedLayout
+		};
+
 		/**
 		 * Default class constructor.
 		 * Creates an empty bank.
@@ -82,6 +129,51 @@ namespace fsdk
 		 */
 		QList<double> orientations() const;
 
+		/**
+		 * Enables or disables the multi-scale (pyramid) filtering (see the
+		 * description of the class). It applies to the filtering into a QList
+		 * of responses or into a tensor; the other filtering methods always
+		 * filter directly at full resolution.
+		 * @param bEnabled Boolean indicating if the pyramid filtering is enabled
+		 * (true) or not (false, the default).
+		 * @param bUpsample Boolean indicating if the responses computed on the
+		 * downsampled levels are upsampled back to the size of the image (true,
+		 * the default) or kept in the size of their levels (false). The responses
+		 * written to a tensor are always upsampled.
+		 */
+		void setPyramid(const bool bEnabled, const bool bUpsample = true);
+
+		/**
+		 * Queries if the multi-scale (pyramid) filtering is enabled.
+		 * @return Boolean indicating if the pyramid filtering is enabled (true)
+		 * or not (false).
+		 */
+		bool isPyramid() const;
+
+		/**
+		 * Gets the level of the pyramid where the kernel with the given ID is
+		 * evaluated (the image is downsampled by 2^level).
+		 * @param iId Integer with the ID of the kernel, in range [0, kernelsCount()).
+		 * @return Integer with the level of the pyramid (always 0 if the pyramid
+		 * filtering is disabled).
+		 */
+		int pyramidLevel(const int iId) const;
+
+		/**
+		 * Sets the numeric precision of the filtering with all kernels in the
+		 * bank (see GaborKernel::setPrecision()), including the kernels added
+		 * afterwards.
+		 * @param ePrecision Value of the GaborKernel::Precision enumeration with
+		 * the precision. The default is GaborKernel::FloatPrecision.
+		 */
+		void setPrecision(const GaborKernel::Precision ePrecision);
+
+		/**
+		 * Gets the numeric precision of the filtering.
+		 * @return Value of the GaborKernel::Precision enumeration with the precision.
+		 */
+		GaborKernel::Precision precision() const;
+
 		/**
 		 * Builds a thumbnail collation of the Gabor bank, with each kernel in the given
 		 * size. The thumbnail is normalized to gray scale, so it can be used for visual
@@ -107,6 +199,49 @@ namespace fsdk
 		 */
 		void filter(const cv::Mat &oImage, QList<cv::Mat> &lResponses) const;
 
+		/**
+		 * Filters the given image with the kernels in the bank and writes all their
+		 * responses to a single contiguous tensor of floats (CV_32F), indexed by the
+		 * IDs of the kernels (see kernelId()). If the tensor given already has the
+		 * size and type required, its memory is reused (so the same tensor can be
+		 * given for every frame with the same size, without any allocation).
+		 * @param oImage OpenCV's Mat with the image in which to apply the filters.
+		 * @param oTensor Reference to an OpenCV's Mat that will receive the responses.
+		 * @param eLayout Value of the TensorLayout enumeration with the memory layout
+		 * of the tensor. The default is PlanarLayout.
+		 * @return Boolean indicating if the image was filtered (true) or not (false,
+		 * if the layout can not hold the number of kernels in the bank).
+		 */
+		bool filter(const cv::Mat &oImage, cv::Mat &oTensor, const TensorLayout eLayout = PlanarLayout) const;
+
+		/**
+		 * Filters a batch of images (for instance, the face crops of several frames)
+		 * with the kernels in the bank, writing the responses of each image to its
+		 * own tensor (see filter(const cv::Mat&, cv::Mat&, const TensorLayout)). Each
+		 * kernel is applied to all the images before moving on to the next kernel,
+		 * so its taps stay in the cache instead of being reloaded for every image
+		 * (which matters with the larger windows). The images may have different
+		 * sizes.
+		 * @param lImages QList of OpenCV's Mat with the images to filter.
+		 * @param lTensors Reference to a QList of OpenCV's Mat that will receive the
+		 * tensors of the images, in the same order. The memory of the tensors already
+		 * in the list is reused whenever they have the size and type required.
+		 * @param eLayout Value of the TensorLayout enumeration with the memory layout
+		 * of the tensors. The default is PlanarLayout.
+		 * @return Boolean indicating if the images were filtered (true) or not (false,
+		 * if the layout can not hold the number of kernels in the bank).
+		 */
+		bool filter(const QList<cv::Mat> &lImages, QList<cv::Mat> &lTensors, const TensorLayout eLayout = PlanarLayout) const;
+
+		/**
+		 * Gets the response of a kernel from a tensor produced by the filtering
+		 * with the PlanarLayout (without copying its data).
+		 * @param oTensor Constant reference to the OpenCV's Mat with the tensor.
+		 * @param iKernel Integer with the ID of the kernel.
+		 * @return OpenCV's Mat with the header of the plane of the kernel.
+		 */
+		static cv::Mat plane(const cv::Mat &oTensor, const int iKernel);
+
 		/**
 		 * Filters the given image with the kernels in the bank and get their responses
 		 * and the parameters used for the kernels.
@@ -163,6 +298,75 @@ namespace fsdk
 		 */
 		QList<GaborKernel> kernels() const;
 
+		/**
+		 * Gets the number of kernels in the bank.
+		 * @return Integer with the number of kernels.
+		 */
+		int kernelsCount() const;
+
+		/**
+		 * Gets the dense integer ID of the kernel with the given parameters. The IDs
+		 * are in range [0, kernelsCount()), in the same order of kernels() and of the
+		 * responses of the filtering. The parameters are compared with a tolerance, so
+		 * the values do not need to be bitwise equal to the ones used in the bank.
+		 * @param dLambda Double with the wavelength of the kernel.
+		 * @param dTheta Double with the orientation of the kernel.
+		 * @return Integer with the ID of the kernel, or -1 if it is not in the bank.
+		 */
+		int kernelId(const double dLambda, const double dTheta) const;
+
+		/**
+		 * Gets the kernel with the given ID.
+		 * @param iId Integer with the ID of the kernel, in range [0, kernelsCount()).
+		 * @return GaborKernel with the kernel.
+		 */
+		GaborKernel kernel(const int iId) const;
+
+	protected:
+
+		/**
+		 * Rebuilds the list of kernels indexed by their IDs (and sets their
+		 * precision), after the kernels in the bank changed.
+		 */
+		void updateIds();
+
+		/**
+		 * Prepares the image for the filtering: converts it to gray scale and,
+		 * if the pyramid filtering is enabled, builds the levels of the pyramid
+		 * needed by the kernels in the bank.
+		 * @param oImage OpenCV's Mat with the image to be filtered.
+		 * @param vLevels Reference to a std::vector of OpenCV's Mat to receive
+		 * the gray scale image (first level) and its downsampled levels.
+		 */
+		void buildLevels(const cv::Mat &oImage, std::vector<cv::Mat> &vLevels) const;
+
+		/**
+		 * Filters an image with a kernel of the bank, on the pyramid level of
+		 * the kernel (see pyramidLevel()).
+		 * @param iId Integer with the ID of the kernel.
+		 * @param vLevels Constant reference to the std::vector with the levels
+		 * of the image (see buildLevels()).
+		 * @param oResponses Reference to an OpenCV's Mat that will receive the
+		 * responses. If it already has the size and type of the responses, its
+		 * memory is reused.
+		 * @param oReal Reference to an OpenCV's Mat used as buffer for the real
+		 * component of the responses.
+		 * @param oImaginary Reference to an OpenCV's Mat used as buffer for the
+		 * imaginary component of the responses.
+		 * @param bUpsample Boolean indicating if the responses computed on a
+		 * downsampled level are upsampled to the size of the image (true) or
+		 * not (false).
+		 */
+		void filterKernel(const int iId, const std::vector<cv::Mat> &vLevels, cv::Mat &oResponses, cv::Mat &oReal, cv::Mat &oImaginary, const bool bUpsample) const;
+
+		/**
+		 * Computes the gain of one level of the Gaussian pyramid smoothing
+		 * (the separable 5-tap filter of cv::pyrDown) at a frequency.
+		 * @param dFrequency Double with the frequency, in cycles per pixel.
+		 * @return Double with the gain, in range [0, 1].
+		 */
+		static double pyramidGain(const double dFrequency);
+
 	private:
 
 		/** Wavelenghts used to create the Gabor kernels in this bank. */
@@ -177,6 +381,26 @@ namespace fsdk
 		 */
 		QMap<KernelParameters, GaborKernel> m_mKernels;
 
+		/** Kernels in this bank indexed by their IDs (in the order of the mapping). */
+		QVector<GaborKernel> m_vKernels;
+
+		/** Indicates if the multi-scale (pyramid) filtering is enabled. */
+		bool m_bPyramid;
+
+		/** Indicates if the responses of the pyramid filtering are upsampled. */
+		bool m_bUpsample;
+
+		/** Pyramid levels of the kernels, indexed by their IDs. */
+		QVector<int> m_vLevels;
+
+		/** Kernels scaled to their pyramid levels, indexed by their IDs. */
+		QVector<GaborKernel> m_vScaled;
+
+		/** Factors that compensate the responses of the scaled kernels, indexed by their IDs. */
+		QVector<double> m_vFactors;
+
+		/** Numeric precision of the filtering. */
+		GaborKernel::Precision m_ePrecision;
 	};
 }
 
@@ -19,19 +19,26 @@
 
 #include "gabordata.h"
 #include "csvfile.h"
+#include <QApplication>
+#include <QFileInfo>
 
 // +-----------------------------------------------------------
 fsdk::GaborData::GaborData()
 {
 	qRegisterMetaType<fsdk::GaborData>("fsdk::GaborData");
-	m_iLandmarksCount = 0;
+	m_iEnergiesCount = 0;
+	m_bPyramidValid = true;
 }
 
 // +-----------------------------------------------------------
 fsdk::GaborData::GaborData(const GaborData& oOther)
 {
-	m_mLandmarks = oOther.m_mLandmarks;
-	m_iLandmarksCount = oOther.m_iLandmarksCount;
+	m_mEnergies = oOther.m_mEnergies;
+	m_lLabels = oOther.m_lLabels;
+	m_iEnergiesCount = oOther.m_iEnergiesCount;
+	m_sReused = oOther.m_sReused;
+	m_oPyramid = oOther.m_oPyramid;
+	m_bPyramidValid = oOther.m_bPyramidValid;
 }
 
 // +-----------------------------------------------------------
@@ -42,44 +49,89 @@ fsdk::GaborData::~GaborData()
 // +-----------------------------------------------------------
 bool fsdk::GaborData::isEmpty() const
 {
-	return m_mLandmarks.isEmpty();
+	return m_mEnergies.isEmpty();
 }
 
 // +-----------------------------------------------------------
 int fsdk::GaborData::count() const
 {
-	return m_mLandmarks.count();
+	return m_mEnergies.count();
 }
 
 // +-----------------------------------------------------------
-const QList<QPoint> fsdk::GaborData::landmarks(int iFrame) const
+const QList<float> fsdk::GaborData::energies(int iFrame) const
 {
-	return m_mLandmarks[iFrame];
+	return m_mEnergies[iFrame];
 }
 
 // +-----------------------------------------------------------
-void fsdk::GaborData::add(const int iFrame, const QList<QPoint> &lPoints, const float fQuality)
+QStringList fsdk::GaborData::labels() const
 {
-	m_mLandmarks[iFrame] = lPoints;
-	m_iLandmarksCount = qMax(m_iLandmarksCount, lPoints.count());
+	return m_lLabels;
+}
+
+// +-----------------------------------------------------------
+void fsdk::GaborData::setLabels(const QStringList &lLabels)
+{
+	m_lLabels = lLabels;
+	m_oPyramid.setLabels(lLabels);
+}
+
+// +-----------------------------------------------------------
+bool fsdk::GaborData::isReused(const int iFrame) const
+{
+	return m_sReused.contains(iFrame);
+}
+
+// +-----------------------------------------------------------
+void fsdk::GaborData::setReused(const int iFrame, const bool bReused)
+{
+	if(bReused)
+		m_sReused.insert(iFrame);
+	else
+		m_sReused.remove(iFrame);
+}
+
+// +-----------------------------------------------------------
+void fsdk::GaborData::add(const int iFrame, const QList<float> &lEnergies)
+{
+	m_mEnergies[iFrame] = lEnergies;
+	m_iEnergiesCount = qMax(m_iEnergiesCount, lEnergies.count());
+
+	// Frames added in ascending order (as during the extraction) simply
+	// extend the pyramid; any other change requires rebuilding it
+	if(m_bPyramidValid)
+	{
+		if(m_oPyramid.framesCount() == 0 && m_oPyramid.signalsCount() != m_iEnergiesCount)
+		{
+			m_oPyramid.reset(m_iEnergiesCount);
+			m_oPyramid.setLabels(m_lLabels);
+		}
+		m_bPyramidValid = m_oPyramid.signalsCount() == m_iEnergiesCount && m_oPyramid.append(iFrame, lEnergies);
+	}
 }
 
 // +-----------------------------------------------------------
 void fsdk::GaborData::remove(const int iFrame)
 {
-	m_mLandmarks.remove(iFrame);
+	m_mEnergies.remove(iFrame);
+	m_sReused.remove(iFrame);
+	m_bPyramidValid = false;
 
-	m_iLandmarksCount = 0;
-	QMap<int, QList<QPoint>>::const_iterator it;
-	for(it = m_mLandmarks.cbegin(); it != m_mLandmarks.cend(); ++it)
-		m_iLandmarksCount = qMax(m_iLandmarksCount, it.value().count());
+	m_iEnergiesCount = 0;
+	QMap<int, QList<float>>::const_iterator it;
+	for(it = m_mEnergies.cbegin(); it != m_mEnergies.cend(); ++it)
+		m_iEnergiesCount = qMax(m_iEnergiesCount, it.value().count());
 }
 
 // +-----------------------------------------------------------
 void fsdk::GaborData::clear()
 {
-	m_mLandmarks.clear();
-	m_iLandmarksCount = 0;
+	m_mEnergies.clear();
+	m_sReused.clear();
+	m_iEnergiesCount = 0;
+	m_oPyramid.reset(0);
+	m_bPyramidValid = true;
 }
 
 // +-----------------------------------------------------------
@@ -88,40 +140,125 @@ bool fsdk::GaborData::saveToCSV(const QString &sFilename) const
 	CSVFile oData;
 	QStringList lLine;
 
-	// Add a header
-	oData.header().append({ "Frame", "Quality" });
-
-	QString sNum;
-	for(int i = 0; i < m_iLandmarksCount; i++)
+	// Add a header (with default labels for the energies without one, and
+	// the column of the reused frames only if there are any)
+	bool bReused = !m_sReused.isEmpty();
+	oData.header().append("Frame");
+	if(bReused)
+		oData.header().append("Reused");
+	for(int i = 0; i < m_iEnergiesCount; i++)
 	{
-		sNum = QString::number(i);
-		oData.header().append({ QString("x%1").arg(sNum), QString("y%1").arg(sNum) });
+		if(i < m_lLabels.count())
+			oData.header().append(m_lLabels[i]);
+		else
+			oData.header().append(QString("e%1").arg(i));
 	}
 
 	// Add the data records
-	QMap<int, QList<QPoint>>::const_iterator it;
-	for(it = m_mLandmarks.cbegin(); it != m_mLandmarks.cend(); ++it)
+	QMap<int, QList<float>>::const_iterator it;
+	for(it = m_mEnergies.cbegin(); it != m_mEnergies.cend(); ++it)
 	{
 		lLine.clear();
-		//lLine.append({ QString::number(it.key()), QString::number(m_mQualities[it.key()]) });
-		foreach(QPoint oPoint, it.value())
-			lLine.append({ QString::number(oPoint.x()), QString::number(oPoint.y()) });
+		lLine.append(QString::number(it.key()));
+		if(bReused)
+			lLine.append(m_sReused.contains(it.key()) ? "1" : "0");
+		foreach(float fEnergy, it.value())
+			lLine.append(QString::number(fEnergy));
 		oData.addLine(lLine);
 	}
 		
-	return oData.write(sFilename);
+	if(!oData.write(sFilename))
+		return false;
+
+	// Store the summary pyramid next to the data file
+	return pyramid().save(SignalPyramid::fileName(sFilename));
 }
 
 // +-----------------------------------------------------------
 bool fsdk::GaborData::readFromCSV(const QString &sFilename)
 {
-	return false;
+	CSVFile oData;
+	if(!oData.read(sFilename))
+	{
+		qDebug().noquote() << QApplication::translate("GaborData", "error reading Gabor CSV file");
+		return false;
+	}
+
+	QMap<int, QList<float>> mEnergies;
+	QSet<int> sReused;
+	int iEnergiesCount = 0;
+
+	// Files with reused frames have an additional column after the frame
+	int iFirst = oData.header().value(1) == "Reused" ? 2 : 1;
+
+	QList<QStringList> lData = oData.lines();
+	foreach(QStringList lLine, lData)
+	{
+		if(lLine.count() < iFirst)
+		{
+			qDebug().noquote() << QApplication::translate("GaborData", "format error in Gabor CSV file");
+			return false;
+		}
+
+		int iFrame = lLine[0].toInt();
+		if(iFirst == 2 && lLine[1].toInt() != 0)
+			sReused.insert(iFrame);
+
+		QList<float> lEnergies;
+		for(int i = iFirst; i < lLine.count(); i++)
+			lEnergies.append(lLine[i].toFloat());
+
+		mEnergies[iFrame] = lEnergies;
+		iEnergiesCount = qMax(iEnergiesCount, lEnergies.count());
+	}
+
+	m_mEnergies = mEnergies;
+	m_sReused = sReused;
+	m_lLabels = oData.header().mid(iFirst);
+	m_iEnergiesCount = iEnergiesCount;
+
+	// Use the stored summary pyramid if it is up to date with the data file
+	QFileInfo oPyramidFile(SignalPyramid::fileName(sFilename));
+	int iFrames = m_mEnergies.isEmpty() ? 0 : m_mEnergies.lastKey() + 1;
+	m_bPyramidValid = oPyramidFile.exists() &&
+		oPyramidFile.lastModified() >= QFileInfo(sFilename).lastModified() &&
+		m_oPyramid.load(oPyramidFile.filePath()) &&
+		m_oPyramid.signalsCount() == m_iEnergiesCount && m_oPyramid.framesCount() == iFrames;
+
+	return true;
+}
+
+// +-----------------------------------------------------------
+int fsdk::GaborData::energiesCount() const
+{
+	return m_iEnergiesCount;
+}
+
+// +-----------------------------------------------------------
+const fsdk::SignalPyramid &fsdk::GaborData::pyramid() const
+{
+	if(!m_bPyramidValid)
+		rebuildPyramid();
+	return m_oPyramid;
 }
 
 // +-----------------------------------------------------------
-int fsdk::GaborData::landmarksCount() const
+fsdk::SignalSummary fsdk::GaborData::energySummary(const int iEnergy, const int iFirstFrame, const int iLastFrame) const
 {
-	return m_iLandmarksCount;
+	return pyramid().summary(iEnergy, iFirstFrame, iLastFrame);
+}
+
+// +-----------------------------------------------------------
+void fsdk::GaborData::rebuildPyramid() const
+{
+	m_oPyramid.reset(m_iEnergiesCount);
+	m_oPyramid.setLabels(m_lLabels);
+
+	QMap<int, QList<float>>::const_iterator it;
+	for(it = m_mEnergies.cbegin(); it != m_mEnergies.cend(); ++it)
+		m_oPyramid.append(it.key(), it.value());
+
+	m_bPyramidValid = true;
 }
 
 // +-----------------------------------------------------------
@@ -132,12 +269,10 @@ QDebug operator<<(QDebug oDbg, const fsdk::GaborData &oData)
 	else
 	{
 		oDbg.nospace() <<
-		QString("GaborData({frame:0, quality:%1, landmarks:{(%2, %3), (more %4 ...)}}, {more %5 ...})")
+		QString("GaborData({frame:0, energies:{%1, (more %2 ...)}}, {more %3 ...})")
 		.arg(
-			/*QString::number(oData.quality(0)),*/
-			QString::number(oData.landmarks(0)[0].x()),
-			QString::number(oData.landmarks(0)[0].y()),
-			QString::number(oData.landmarks(0).count() - 1),
+			oData.energies(0).isEmpty() ? QString("") : QString::number(oData.energies(0)[0]),
+			QString::number(oData.energies(0).count() - 1),
 			QString::number(oData.count() - 1)
 		);
 	}
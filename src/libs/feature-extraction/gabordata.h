@@ -21,16 +21,20 @@
 #define GABORDATA_H
 
 #include "libexport.h"
+#include "signalpyramid.h"
 #include <QMap>
+#include <QSet>
 #include <QList>
-#include <QPoint>
+#include <QStringList>
 #include <QMetaType>
 #include <QDebug>
 
 namespace fsdk
 {
 	/**
-	 * Represents Gabor responses extracted from facial landmarks.
+	 * Represents Gabor responses extracted from facial landmarks. The data
+	 * of each frame is a list of energies (the mean magnitude of the responses
+	 * in the face region), one for each kernel in the bank of Gabor filters.
 	 */
 	class SHARED_LIB_EXPORT GaborData
 	{
@@ -54,7 +58,7 @@ namespace fsdk
 		~GaborData();
 
 		/**
-		 * Queries if the landmarks data is empty.
+		 * Queries if the Gabor data is empty.
 		 * @return Boolean indicating if the data is empty (true) or not (false).
 		 */
 		bool isEmpty() const;
@@ -66,24 +70,53 @@ namespace fsdk
 		int count() const;
 
 		/**
-		 * Queries the landmarks of a given frame. Same as operator[].
+		 * Queries the energies of a given frame.
 		 * @param iFrame Integer with the index of the frame to get the
-		 * landmarks for.
-		 * @return QList of QPoint objects with the coordinates of the
-		 * facial landmarks in the given frame, or an empty QList() if
+		 * energies for.
+		 * @return QList of float values with the energies of the responses
+		 * of each kernel in the given frame, or an empty QList() if
 		 * the frame is invalid or if the data is empty.
 		 */
-		const QList<QPoint> landmarks(int iFrame) const;
+		const QList<float> energies(int iFrame) const;
+
+		/**
+		 * Gets the labels of the energies (i.e. the identification of the
+		 * kernel that produced each one of them).
+		 * @return QStringList with the labels of the energies.
+		 */
+		QStringList labels() const;
+
+		/**
+		 * Sets the labels of the energies.
+		 * @param lLabels QStringList with the labels of the energies.
+		 */
+		void setLabels(const QStringList &lLabels);
+
+		/**
+		 * Queries if the energies of the given frame were reused from a previous
+		 * frame (i.e. the frame was skipped by a FrameGate, instead of filtered).
+		 * @param iFrame Integer with the index of the frame.
+		 * @return Boolean indicating if the energies were reused (true) or
+		 * computed (false).
+		 */
+		bool isReused(const int iFrame) const;
+
+		/**
+		 * Marks the energies of the given frame as reused from a previous frame
+		 * (or as computed).
+		 * @param iFrame Integer with the index of the frame.
+		 * @param bReused Boolean indicating if the energies were reused (true)
+		 * or computed (false).
+		 */
+		void setReused(const int iFrame, const bool bReused);
 
 		/**
 		 * Adds data of the given frame.
 		 * @param iFrame Integer with the number of the video frame.
-		 * @param lPoints QList of QPoint objects with the coordinates of 
-		 * the facial landmarks in that frame.
-		 * @param fQuality Float value with the tracking quality in that frame
-		 * in range [0, 1].
+		 * @param lEnergies QList of float values with the energies of the
+		 * responses of each kernel in that frame.
 		 */
-		void add(const int iFrame, const QList<QPoint> &lPoints, const float fQuality);
+		void add(const int iFrame, const QList<float> &lEnergies);
 
 		/**
 		 * Removes the data from the given frame.
@@ -97,7 +130,8 @@ namespace fsdk
 		void clear();
 
 		/**
-		 * Saves the landmarks data to the given CSV file.
+		 * Saves the Gabor data to the given CSV file. If the energies of any
+		 * frame were reused, a column "Reused" is added after the frame.
 		 * @param sFilename QString with the name of the file
 		 * to save the data to.
 		 * @return Boolean indicating if the saving was succesful
@@ -106,7 +140,7 @@ namespace fsdk
 		bool saveToCSV(const QString &sFilename) const;
 
 		/**
-		 * Reads the landmarks data from the given CSV file.
+		 * Reads the Gabor data from the given CSV file.
 		 * @param sFilename QString with the name of the file
 		 * to read the data from.
 		 * @return Boolean indicating if the reading was succesful
@@ -115,19 +149,58 @@ namespace fsdk
 		bool readFromCSV(const QString &sFilename);
 
 		/**
-		 * Gets the maximum number of landmarks stored in this
+		 * Gets the maximum number of energies per frame stored in this
 		 * object.
-		 * @return Integer with the maximum number of landmarks.
+		 * @return Integer with the maximum number of energies.
+		 */
+		int energiesCount() const;
+
+		/**
+		 * Gets the multi-resolution summary of the energies (one signal per
+		 * kernel). The pyramid is built incrementally as frames are added in
+		 * ascending order, and rebuilt on demand after other changes.
+		 * @return Const reference to the SignalPyramid with the summary of
+		 * the energies.
 		 */
-		int landmarksCount() const;
+		const SignalPyramid &pyramid() const;
+
+		/**
+		 * Gets the summary (minimum, maximum and mean) of an energy in a range
+		 * of frames, in O(log n).
+		 * @param iEnergy Integer with the index of the energy.
+		 * @param iFirstFrame Integer with the first frame of the range.
+		 * @param iLastFrame Integer with the last frame of the range (inclusive).
+		 * @return SignalSummary with the summary of the energy in the range.
+		 */
+		SignalSummary energySummary(const int iEnergy, const int iFirstFrame, const int iLastFrame) const;
+
+	protected:
+
+		/**
+		 * Rebuilds the pyramid with the summary of the energies from the
+		 * existing frame data.
+		 */
+		void rebuildPyramid() const;
 
 	private:
 
-		/** Mapping between frame number and list of 2D points of landmarks. */
-		QMap<int, QList<QPoint>> m_mLandmarks;
+		/** Mapping between frame number and list of energies. */
+		QMap<int, QList<float>> m_mEnergies;
+
+		/** Labels of the energies. */
+		QStringList m_lLabels;
 		
-		/** Number of landmarks used by the tracker. */
-		int m_iLandmarksCount;
+		/** Maximum number of energies per frame. */
+		int m_iEnergiesCount;
+
+		/** Frames whose energies were reused from a previous frame. */
+		QSet<int> m_sReused;
+
+		/** Multi-resolution summary of the energies. */
+		mutable SignalPyramid m_oPyramid;
+
+		/** Indicates if the pyramid is in sync with the frame data. */
+		mutable bool m_bPyramidValid;
 
 	};
 }
@@ -19,16 +19,20 @@
 
 #include "gaborextractiontask.h"
 #include "landmarksdata.h"
+#include "landmarksfilter.h"
+#include "framegate.h"
 #include <cmath>
 #include <QRect>
 #include <QVector2D>
-#include "csirofacetracker.h"
+#include <QScopedPointer>
+#include "facetrackerregistry.h"
+#include <QApplication>
+#include <QDebug>
 
 using namespace cv;
 
-// Indexes of the landmarks at the eye corners
-#define LEFT_EYE_INNER_CORNER 39
-#define RIGHT_EYE_INNER_CORNER 42
+// Minimum tracking quality before the tracker is reset (when the face is tracked by the task)
+#define RESET_QUALITY 0.2f
 
 // +-----------------------------------------------------------
 fsdk::GaborExtractionTask::GaborExtractionTask(const QString &sVideoFile, const QString &sLandmarksFile):
@@ -36,6 +40,86 @@ fsdk::GaborExtractionTask::GaborExtractionTask(const QString &sVideoFile, const
 {
 	m_sLandmarksFile = sLandmarksFile;
 	m_oBank = GaborBank::defaultBank();
+	m_iLeftEye = -1;
+	m_iRightEye = -1;
+	m_bSmoothing = false;
+	m_iMaxGap = 5;
+	m_iBatchSize = 1;
+	m_bGating = false;
+	m_dGateThreshold = 2.0;
+	m_iGateMaxReused = 30;
+	m_bGateValidate = false;
+	setTrackerBackend(QString());
+}
+
+// +-----------------------------------------------------------
+bool fsdk::GaborExtractionTask::setTrackerBackend(const QString &sName)
+{
+	const FaceTrackerBackend *pBackend = FaceTrackerRegistry::backend(sName);
+	if(!pBackend)
+		return false;
+
+	int iLeftEye = pBackend->landmarkIndex(FaceTracker::LeftEyeInnerCorner);
+	int iRightEye = pBackend->landmarkIndex(FaceTracker::RightEyeInnerCorner);
+	if(iLeftEye < 0 || iRightEye < 0)
+		return false;
+
+	m_iLeftEye = iLeftEye;
+	m_iRightEye = iRightEye;
+	m_sTrackerBackend = sName;
+	return true;
+}
+
+// +-----------------------------------------------------------
+void fsdk::GaborExtractionTask::setSmoothing(const bool bEnabled, const int iMaxGap)
+{
+	m_bSmoothing = bEnabled;
+	m_iMaxGap = qMax(iMaxGap, 0);
+}
+
+// +-----------------------------------------------------------
+void fsdk::GaborExtractionTask::setPooling(const RegionPooling &oPooling)
+{
+	m_oPooling = oPooling;
+}
+
+// +-----------------------------------------------------------
+void fsdk::GaborExtractionTask::setBank(const GaborBank &oBank)
+{
+	m_oBank = oBank;
+}
+
+// +-----------------------------------------------------------
+fsdk::GaborBank fsdk::GaborExtractionTask::bank() const
+{
+	return m_oBank;
+}
+
+// +-----------------------------------------------------------
+void fsdk::GaborExtractionTask::setPyramid(const bool bEnabled)
+{
+	m_oBank.setPyramid(bEnabled);
+}
+
+// +-----------------------------------------------------------
+void fsdk::GaborExtractionTask::setPrecision(const GaborKernel::Precision ePrecision)
+{
+	m_oBank.setPrecision(ePrecision);
+}
+
+// +-----------------------------------------------------------
+void fsdk::GaborExtractionTask::setBatchSize(const int iSize)
+{
+	m_iBatchSize = qMax(iSize, 1);
+}
+
+// +-----------------------------------------------------------
+void fsdk::GaborExtractionTask::setGating(const bool bEnabled, const double dThreshold, const int iMaxReused, const bool bValidate)
+{
+	m_bGating = bEnabled;
+	m_dGateThreshold = qMax(dThreshold, 0.0);
+	m_iGateMaxReused = qMax(iMaxReused, 0);
+	m_bGateValidate = bValidate;
 }
 
 // +-----------------------------------------------------------
@@ -45,62 +129,215 @@ void fsdk::GaborExtractionTask::run()
 	GaborData oData;
 	QList<QPoint> lLandmarks;
 
-	// Try to read the CSV with the landmarks
+	// Try to read the CSV with the landmarks (or create the tracker, if the
+	// face is to be tracked while the frames are processed)
 	LandmarksData oLandmarks;
-	if(!oLandmarks.readFromCSV(m_sLandmarksFile))
+	QScopedPointer<FaceTracker> pTracker;
+	if(m_sLandmarksFile.isEmpty())
+		pTracker.reset(FaceTrackerRegistry::backend(m_sTrackerBackend)->create());
+	else
+	{
+		bool bRead;
+		{
+			ScopedStageTimer oTimer(profile(), TaskProfile::LoadingStage);
+			bRead = oLandmarks.readFromCSV(m_sLandmarksFile);
+		}
+		if(!bRead)
+		{
+			end(InvalidInputParameters);
+			return;
+		}
+	}
+
+	// Label the energies after the kernel that produces each one of them
+	// (in the same order used by GaborBank::filter) and the region/statistic
+	// they are pooled with
+	QStringList lLabels;
+	foreach(GaborKernel oKernel, m_oBank.kernels())
+		lLabels.append(QString("w%1_o%2").arg(oKernel.lambda()).arg(qRound(oKernel.theta() * 180 / CV_PI)));
+	lLabels = m_oPooling.labels(lLabels);
+	oData.setLabels(lLabels);
+
+	// Start the task (if start fails, it will emit taskError())
+	if(!start())
+		return;
+
+	// The images of a sequence are unrelated, so the face is detected again in
+	// each one of them and the temporal smoothing and gating do not apply
+	if(isImageSequence() && (m_bSmoothing || m_bGating))
+	{
+		qWarning().noquote() << QApplication::translate("GaborExtractionTask", "the smoothing and the gating are ignored for the image sequence %1").arg(inputFile());
+		m_bSmoothing = false;
+		m_bGating = false;
+	}
+
+	// Resume from the last checkpoint, if there is one
+	if(!resumeCheckpoint(oData))
+	{
+		end(InvalidInputFile);
+		return;
+	}
+
+	// Publish the energies (if requested)
+	if(!openPublishing(lLabels.count()))
 	{
 		end(InvalidInputParameters);
 		return;
 	}
 
-	// Start the task
-	start();
-	
+	// Temporal filter of the landmarks (if requested)
+	LandmarksFilter oFilter(videoFrameRate(), m_iMaxGap);
+
+	// Gate of the redundant frames (if requested), with the index of the last
+	// frame filtered (whose energies are reused)
+	FrameGate oGate(m_dGateThreshold, m_iGateMaxReused);
+	int iLastFrame = -1;
+
 	// Process while not cancelled and there are frames
 	while(!isCancelled() && !nextFrame().empty())
 	{
 		// Get current frame and its landmarks
 		oFrame = frame();
-		lLandmarks = oLandmarks.landmarks(frameIndex());
+		float fQuality;
+		if(pTracker)
+		{
+			ScopedStageTimer oTimer(profile(), TaskProfile::TrackingStage);
+			if(m_bSmoothing)
+				pTracker->setPrediction(oFilter.predict(frameIndex()));
+			if(isImageSequence())
+				pTracker->reset();
+			pTracker->track(oFrame);
+			lLandmarks = pTracker->getLandmarks();
+			fQuality = pTracker->getQuality();
+			if(fQuality < RESET_QUALITY)
+				pTracker->reset();
+		}
+		else
+		{
+			lLandmarks = oLandmarks.landmarks(frameIndex());
+			fQuality = oLandmarks.quality(frameIndex());
+		}
+		if(m_bSmoothing)
+		{
+			ScopedStageTimer oTimer(profile(), TaskProfile::SmoothingStage);
+			lLandmarks = oFilter.filter(frameIndex(), lLandmarks);
+		}
 
 		// Ignore frames where there is no landmarks (i.e. the tracking quality was 0)
-		if(lLandmarks.count() == 0)
+		// or not enough landmarks for the backend used
+		if(lLandmarks.count() <= qMax(m_iLeftEye, m_iRightEye))
 		{
-			setProgress(int(float(frameIndex()) / float(frameCount()) * 100.0f));
+			updateProgress();
+			if(isCheckpointDue())
+			{
+				processBatch(oData);
+				saveCheckpoint(oData);
+			}
+			continue;
+		}
+
+		// Reuse the energies of the last frame filtered if the face barely moved
+		// since then (its energies might still be waiting in the batch)
+		if(m_bGating && oGate.isRedundant(lLandmarks) && iLastFrame >= 0)
+		{
+			if(m_lBatchFrames.contains(iLastFrame))
+				processBatch(oData);
+			QList<float> lEnergies = oData.energies(iLastFrame);
+
+			// Measure the relative error against the energies filtered (if requested)
+			if(m_bGateValidate)
+			{
+				Mat oTensor;
+				QList<QPoint> lCropLandmarks;
+				QList<float> lFiltered;
+				Mat oCrop = cropAndNormalize(oFrame, lLandmarks, lCropLandmarks);
+				m_oBank.filter(oCrop, oTensor);
+				m_oPooling.pool(oTensor, lCropLandmarks, lFiltered);
+
+				double dDiff = 0, dSum = 0;
+				for(int i = 0; i < qMin(lFiltered.count(), lEnergies.count()); i++)
+				{
+					dDiff += qAbs(lEnergies[i] - lFiltered[i]);
+					dSum += qAbs(lFiltered[i]);
+				}
+				oGate.addError(dSum > 0 ? dDiff / dSum : 0);
+			}
+
+			storeEnergies(oData, frameIndex(), fQuality, lEnergies, true);
+			updateProgress();
+			if(isCheckpointDue())
+			{
+				processBatch(oData);
+				saveCheckpoint(oData);
+			}
 			continue;
 		}
 
 		// Crop the face region and normalize its image (so the distance
 		// between eyes is 50 pixels)
-		oFrame = cropAndNormalize(oFrame, lLandmarks);
-
-		// Filter the frame with the bank of Gabor kernels
-		QList<Mat> lResponses;
-		m_oBank.filter(oFrame, lResponses);
+		Mat oCrop;
+		QList<QPoint> lCropLandmarks;
+		{
+			ScopedStageTimer oTimer(profile(), TaskProfile::CropStage);
+			oCrop = cropAndNormalize(oFrame, lLandmarks, lCropLandmarks);
+		}
 
-		// Store the landmarks obtained in the map
-		//oData.add(frameIndex(), oTracker.getLandmarks(), oTracker.getQuality());
+		// Queue the crop to be filtered with the bank of Gabor kernels (the
+		// crop may still share the memory of the frame, which is reused by
+		// the capture of the next frames)
+		m_lBatchCrops.append(oCrop.datastart == oFrame.datastart ? oCrop.clone() : oCrop);
+		m_lBatchLandmarks.append(lCropLandmarks);
+		m_lBatchFrames.append(frameIndex());
+		m_lBatchQualities.append(fQuality);
+		iLastFrame = frameIndex();
+		if(m_lBatchCrops.count() >= m_iBatchSize)
+			processBatch(oData);
 
 		// Indicate progress
-		setProgress(int(float(frameIndex()) / float(frameCount()) * 100.0f));
+		updateProgress();
+
+		// Persist the partial results periodically (to allow resuming)
+		if(isCheckpointDue())
+		{
+			processBatch(oData);
+			saveCheckpoint(oData);
+		}
 	}
 
+	// Filter the frames still waiting in the batch
+	processBatch(oData);
+
+	if(m_bGating)
+		qInfo().noquote() << QApplication::translate("GaborExtractionTask", "gating of file %1: %2").arg(inputFile(), oGate.toString());
+
 	// End the task accordingly (with cancellation or success)
 	if(isCancelled())
+	{
+		// Keep the work done so far, so it can be resumed later
+		if(isCheckpointEnabled())
+			saveCheckpoint(oData);
 		end(CancelRequested);
+	}
 	else
 		end(QVariant::fromValue(oData));
 }
 
 // +-----------------------------------------------------------
 Mat fsdk::GaborExtractionTask::cropAndNormalize(const Mat &oImage, const QList<QPoint> &lLandmarks) const
+{
+	QList<QPoint> lCropLandmarks;
+	return cropAndNormalize(oImage, lLandmarks, lCropLandmarks);
+}
+
+// +-----------------------------------------------------------
+Mat fsdk::GaborExtractionTask::cropAndNormalize(const Mat &oImage, const QList<QPoint> &lLandmarks, QList<QPoint> &lCropLandmarks) const
 {
 	// Get the face region: the region that encloses all landmarks
 	int iMinX = oImage.cols;
 	int iMinY = oImage.rows;
 	int iMaxX = 0;
 	int iMaxY = 0;
-	for(uint i = 0; i < CSIROFaceTracker::landmarksCount(); i++)
+	for(int i = 0; i < lLandmarks.count(); i++)
 	{
 		QPoint oPoint = lLandmarks[i];
 		if(oPoint.x() < iMinX)
@@ -123,8 +360,8 @@ Mat fsdk::GaborExtractionTask::cropAndNormalize(const Mat &oImage, const QList<Q
 	Mat oRet = oImage(Rect(iMinX, iMinY, iMaxX - iMinX, iMaxY - iMinY));
 
 	// Calculate the distance between the eyes
-	QPoint oLeftEye(lLandmarks[LEFT_EYE_INNER_CORNER]);
-	QPoint oRightEye(lLandmarks[RIGHT_EYE_INNER_CORNER]);
+	QPoint oLeftEye(lLandmarks[m_iLeftEye]);
+	QPoint oRightEye(lLandmarks[m_iRightEye]);
 	float fDistance = std::ceil(QVector2D(oRightEye - oLeftEye).length());
 
 	// Scale the image so the distance between the eyes is close to 50 pixels
@@ -134,5 +371,63 @@ Mat fsdk::GaborExtractionTask::cropAndNormalize(const Mat &oImage, const QList<Q
 	oSize.height *= fScale;
 	resize(oRet, oRet, oSize);
 
+	// Map the landmarks to the coordinates of the crop
+	double dScaleX = double(oSize.width) / (iMaxX - iMinX);
+	double dScaleY = double(oSize.height) / (iMaxY - iMinY);
+	lCropLandmarks.clear();
+	foreach(QPoint oPoint, lLandmarks)
+		lCropLandmarks.append(QPoint(qRound((oPoint.x() - iMinX) * dScaleX), qRound((oPoint.y() - iMinY) * dScaleY)));
+
 	return oRet;
+}
+
+// +-----------------------------------------------------------
+void fsdk::GaborExtractionTask::processBatch(GaborData &oData)
+{
+	if(m_lBatchCrops.isEmpty())
+		return;
+
+	// Filter all crops with the bank of Gabor kernels at once
+	{
+		ScopedStageTimer oTimer(profile(), TaskProfile::FilteringStage);
+		m_oBank.filter(m_lBatchCrops, m_lTensors);
+	}
+
+	for(int i = 0; i < m_lBatchCrops.count(); i++)
+	{
+		// Get the energies (statistics of the magnitude of the responses over
+		// the regions)
+		QList<float> lEnergies;
+		{
+			ScopedStageTimer oTimer(profile(), TaskProfile::FilteringStage);
+			m_oPooling.pool(m_lTensors[i], m_lBatchLandmarks[i], lEnergies);
+		}
+
+		storeEnergies(oData, m_lBatchFrames[i], m_lBatchQualities[i], lEnergies, false);
+	}
+
+	m_lBatchCrops.clear();
+	m_lBatchLandmarks.clear();
+	m_lBatchFrames.clear();
+	m_lBatchQualities.clear();
+}
+
+// +-----------------------------------------------------------
+void fsdk::GaborExtractionTask::storeEnergies(GaborData &oData, const int iFrame, const float fQuality, const QList<float> &lEnergies, const bool bReused)
+{
+	// Store the energies in the map
+	oData.add(iFrame, lEnergies);
+	if(bReused)
+		oData.setReused(iFrame, true);
+
+	// Report the energies of the frame right away (if requested)
+	if(isStreaming())
+	{
+		GaborData oResult;
+		oResult.setLabels(oData.labels());
+		oResult.add(iFrame, lEnergies);
+		oResult.setReused(iFrame, bReused);
+		streamResult(QVariant::fromValue(oResult), iFrame);
+	}
+	publish(0, fQuality, lEnergies, iFrame);
 }
\ No newline at end of file
@@ -24,6 +24,7 @@
 #include "extractiontask.h"
 #include "gaborbank.h"
 #include "gabordata.h"
+#include "regionpooling.h"
 
 namespace fsdk
 {
@@ -40,10 +41,115 @@ namespace fsdk
 		 * @param sVideoFile QString with the path and name of the video
 		 * file to process.
 		 * @param sLandmarksFile QString with the path and name of the CSV with
-		 * the facial landmarks in the video file.
+		 * the facial landmarks in the video file. If it is empty, the face is
+		 * tracked while the frames are processed (which is required for the
+		 * live inputs, see LiveSource).
 		 */
 		GaborExtractionTask(const QString &sVideoFile, const QString &sLandmarksFile);
 
+		/**
+		 * Sets the face tracker backend that produced the landmarks file (so the
+		 * indexes of the eye corners used in the normalization of the face are
+		 * known), or that tracks the face if there is no landmarks file. It must
+		 * be called before the task is started.
+		 * @param sName QString with the name of the backend (see FaceTrackerRegistry).
+		 * If it is empty, the default backend is used.
+		 * @return Boolean indicating if the backend is registered and provides
+		 * the eye corners (true) or not (false, case in which the task keeps its
+		 * previous backend).
+		 */
+		bool setTrackerBackend(const QString &sName);
+
+		/**
+		 * Enables or disables the temporal smoothing of the landmarks read
+		 * (see LandmarksFilter), which reduces the noise in the features due
+		 * to the jitter of the tracking and fills the short gaps where the face
+		 * was lost. It is not needed if the landmarks were already smoothed
+		 * during their extraction. It must be called before the task is started.
+		 * @param bEnabled Boolean indicating if the smoothing is enabled (true)
+		 * or not (false, the default).
+		 * @param iMaxGap Integer with the maximum number of consecutive frames
+		 * without landmarks that are filled. The default is 5.
+		 */
+		void setSmoothing(const bool bEnabled, const int iMaxGap = 5);
+
+		/**
+		 * Sets the pooling of the responses of the kernels over regions of the
+		 * face (see RegionPooling), which defines the features produced for
+		 * each frame. The default is the mean energy of each kernel in the
+		 * whole face. It must be called before the task is started.
+		 * @param oPooling RegionPooling with the regions and statistics to use.
+		 * Its face parts (if used) must be located with the same backend set
+		 * with setTrackerBackend().
+		 */
+		void setPooling(const RegionPooling &oPooling);
+
+		/**
+		 * Sets the bank of Gabor filters used to extract the responses, with its
+		 * pyramid and precision settings (replacing the ones of setPyramid() and
+		 * setPrecision()). It must be called before the task is started.
+		 * @param oBank GaborBank with the bank of filters. The default is
+		 * GaborBank::defaultBank().
+		 */
+		void setBank(const GaborBank &oBank);
+
+		/**
+		 * Gets the bank of Gabor filters used to extract the responses.
+		 * @return GaborBank with the bank of filters.
+		 */
+		GaborBank bank() const;
+
+		/**
+		 * Enables or disables the multi-scale (pyramid) filtering of the face
+		 * crops (see GaborBank::setPyramid()), which is faster but produces an
+		 * approximation of the responses. It must be called before the task is
+		 * started.
+		 * @param bEnabled Boolean indicating if the pyramid filtering is enabled
+		 * (true) or not (false, the default).
+		 */
+		void setPyramid(const bool bEnabled);
+
+		/**
+		 * Sets the numeric precision of the filtering of the face crops (see
+		 * GaborBank::setPrecision()). The fixed-point precision is faster but
+		 * produces an approximation of the responses. It must be called before
+		 * the task is started.
+		 * @param ePrecision Value of the GaborKernel::Precision enumeration with
+		 * the precision. The default is GaborKernel::FloatPrecision.
+		 */
+		void setPrecision(const GaborKernel::Precision ePrecision);
+
+		/**
+		 * Sets the number of face crops filtered together in a batch (see
+		 * GaborBank::filter(const QList<cv::Mat>&, QList<cv::Mat>&, const GaborBank::TensorLayout)),
+		 * so the taps of each kernel are reused from the cache for several frames.
+		 * The results of a frame are only stored (and streamed/published) when its
+		 * batch is filtered, so larger batches also increase the latency of the
+		 * live inputs. It must be called before the task is started.
+		 * @param iSize Integer with the number of face crops per batch. The default
+		 * is 1 (i.e. each frame is filtered as soon as it is read).
+		 */
+		void setBatchSize(const int iSize);
+
+		/**
+		 * Enables or disables the gating of the redundant frames (see FrameGate).
+		 * When enabled, the frames whose landmarks barely moved since the last
+		 * frame filtered are not cropped nor filtered: the energies of that frame
+		 * are reused and the frame is marked as reused in the data. It must be
+		 * called before the task is started.
+		 * @param bEnabled Boolean indicating if the gating is enabled (true) or
+		 * not (false, the default).
+		 * @param dThreshold Double with the mean displacement of the landmarks (in
+		 * pixels) below which a frame is redundant. The default is 2.
+		 * @param iMaxReused Integer with the maximum number of consecutive frames
+		 * reused. The default is 30.
+		 * @param bValidate Boolean indicating if the reused energies are validated
+		 * against the filtering (true) or not (false, the default). When validated,
+		 * the reused frames are also filtered (so the task gets no faster) and the
+		 * relative error of the energies is reported at the end with an info message.
+		 */
+		void setGating(const bool bEnabled, const double dThreshold = 2.0, const int iMaxReused = 30, const bool bValidate = false);
+
 	public slots:
 
 		/**
@@ -54,16 +160,102 @@ namespace fsdk
 		void run();
 
 	protected:
-		
+
+		/**
+		 * Crops the face region of a frame and scales it so the distance
+		 * between the eyes is close to 50 pixels.
+		 * @param oImage OpenCV's Mat with the frame.
+		 * @param lLandmarks QList of QPoint with the facial landmarks in the frame.
+		 * @return OpenCV's Mat with the face crop.
+		 */
 		cv::Mat cropAndNormalize(const cv::Mat &oImage, const QList<QPoint> &lLandmarks) const;
 
+		/**
+		 * Crops the face region of a frame and scales it so the distance
+		 * between the eyes is close to 50 pixels, also mapping the landmarks
+		 * to the coordinates of the crop.
+		 * @param oImage OpenCV's Mat with the frame.
+		 * @param lLandmarks QList of QPoint with the facial landmarks in the frame.
+		 * @param lCropLandmarks Reference to a QList of QPoint to receive the
+		 * landmarks in the coordinates of the face crop.
+		 * @return OpenCV's Mat with the face crop.
+		 */
+		cv::Mat cropAndNormalize(const cv::Mat &oImage, const QList<QPoint> &lLandmarks, QList<QPoint> &lCropLandmarks) const;
+
+		/**
+		 * Filters the face crops waiting in the batch and stores (and streams/
+		 * publishes) their energies. It must be called when the batch is full,
+		 * before the checkpoints and at the end of the task.
+		 * @param oData Reference to the GaborData that receives the energies.
+		 */
+		void processBatch(GaborData &oData);
+
+		/**
+		 * Stores (and streams/publishes) the energies of a frame.
+		 * @param oData Reference to the GaborData that receives the energies.
+		 * @param iFrame Integer with the index of the frame.
+		 * @param fQuality Float with the tracking quality of the frame.
+		 * @param lEnergies QList of float with the energies of the frame.
+		 * @param bReused Boolean indicating if the energies were reused from a
+		 * previous frame (true) or computed (false).
+		 */
+		void storeEnergies(GaborData &oData, const int iFrame, const float fQuality, const QList<float> &lEnergies, const bool bReused);
+
 	private:
 
-		/** Name of the CSV file with the landmarks in the video being processed. */
+		/** Name of the CSV file with the landmarks in the video being processed (empty to track the face). */
 		QString m_sLandmarksFile;
 
+		/** Name of the face tracker backend used (empty for the default one). */
+		QString m_sTrackerBackend;
+
 		/** Bank of Gabor filters used to extract the responses. */
 		GaborBank m_oBank;
+
+		/** Index of the inner corner of the left eye in the landmarks. */
+		int m_iLeftEye;
+
+		/** Index of the inner corner of the right eye in the landmarks. */
+		int m_iRightEye;
+
+		/** Indicates if the landmarks are temporally smoothed. */
+		bool m_bSmoothing;
+
+		/** Maximum number of consecutive frames filled by the smoothing. */
+		int m_iMaxGap;
+
+		/** Pooling of the responses of the kernels over the regions of the face. */
+		RegionPooling m_oPooling;
+
+		/** Number of face crops filtered together in a batch. */
+		int m_iBatchSize;
+
+		/** Face crops waiting to be filtered in the batch. */
+		QList<cv::Mat> m_lBatchCrops;
+
+		/** Landmarks of the face crops in the batch, in the coordinates of the crops. */
+		QList<QList<QPoint> > m_lBatchLandmarks;
+
+		/** Indexes of the frames of the face crops in the batch. */
+		QList<int> m_lBatchFrames;
+
+		/** Tracking qualities of the faces in the batch. */
+		QList<float> m_lBatchQualities;
+
+		/** Tensors with the responses of the batch (their memory is reused between the batches). */
+		QList<cv::Mat> m_lTensors;
+
+		/** Indicates if the redundant frames are gated. */
+		bool m_bGating;
+
+		/** Mean displacement of the landmarks below which a frame is redundant. */
+		double m_dGateThreshold;
+
+		/** Maximum number of consecutive frames reused. */
+		int m_iGateMaxReused;
+
+		/** Indicates if the reused energies are validated against the filtering. */
+		bool m_bGateValidate;
 	};
 }
 
@@ -18,6 +18,10 @@
  */
 
 #include "gaborkernel.h"
+#include <climits>
+#include <cfloat>
+#include <algorithm>
+#include <vector>
 
 using namespace cv;
 
@@ -29,6 +33,8 @@ fsdk::GaborKernel::GaborKernel()
 	m_dPsi = CV_PI / 2;
 	m_dSigma = 0;
 	m_iWindowSize = 3;
+	m_ePrecision = FloatPrecision;
+	m_dFixedScale = 1;
 }
 
 // +-----------------------------------------------------------
@@ -42,6 +48,8 @@ fsdk::GaborKernel::GaborKernel(const int iWindowSize, const double dTheta, const
 	if(m_iWindowSize % 2 == 0)
 		m_iWindowSize++;
 
+	m_ePrecision = FloatPrecision;
+	m_dFixedScale = 1;
 	rebuildKernel();
 }
 
@@ -54,6 +62,8 @@ fsdk::GaborKernel::GaborKernel(const double dTheta, const double dLambda, const
 	m_dSigma = 0.56 * m_dLambda;
 	m_iWindowSize = 1 + 2 * std::ceil(std::sqrt(-2 * std::pow(m_dSigma, 2) * std::log(0.005))); // Kernel size is based on sigma (to limit the cutoff to 0.5%)
 
+	m_ePrecision = FloatPrecision;
+	m_dFixedScale = 1;
 	rebuildKernel();
 }
 
@@ -68,6 +78,10 @@ fsdk::GaborKernel::GaborKernel(const GaborKernel &oOther)
 
 	m_oRealComp = oOther.m_oRealComp.clone();
 	m_oImaginaryComp = oOther.m_oImaginaryComp.clone();
+	m_ePrecision = oOther.m_ePrecision;
+	m_oRowFixed = oOther.m_oRowFixed.clone();
+	m_oColumnTaps = oOther.m_oColumnTaps.clone();
+	m_dFixedScale = oOther.m_dFixedScale;
 }
 
 // +-----------------------------------------------------------
@@ -81,6 +95,10 @@ fsdk::GaborKernel& fsdk::GaborKernel::operator=(const GaborKernel &oOther)
 
 	m_oRealComp = oOther.m_oRealComp.clone();
 	m_oImaginaryComp = oOther.m_oImaginaryComp.clone();
+	m_ePrecision = oOther.m_ePrecision;
+	m_oRowFixed = oOther.m_oRowFixed.clone();
+	m_oColumnTaps = oOther.m_oColumnTaps.clone();
+	m_dFixedScale = oOther.m_dFixedScale;
 
 	return *this;
 }
@@ -117,7 +135,168 @@ void fsdk::GaborKernel::rebuildKernel()
 			m_oRealComp.at<float>(y + iHalfSize, x + iHalfSize) = (float)(dGauss * dRealSignal);
 			m_oImaginaryComp.at<float>(y + iHalfSize, x + iHalfSize) = (float)(dGauss * dImagSignal);
 		}
-	}	
+	}
+
+	if(m_ePrecision == FixedPointPrecision)
+		quantize();	
+}
+
+// +-----------------------------------------------------------
+void fsdk::GaborKernel::setPrecision(const Precision ePrecision)
+{
+	m_ePrecision = ePrecision;
+	if(m_ePrecision == FixedPointPrecision)
+		quantize();
+	else
+	{
+		m_oRowFixed.release();
+		m_oColumnTaps.release();
+		m_dFixedScale = 1;
+	}
+}
+
+// +-----------------------------------------------------------
+fsdk::GaborKernel::Precision fsdk::GaborKernel::precision() const
+{
+	return m_ePrecision;
+}
+
+// +-----------------------------------------------------------
+double fsdk::GaborKernel::quantizationError() const
+{
+	if(m_ePrecision != FixedPointPrecision || m_oRealComp.empty())
+		return 0;
+
+	// Kernel effectively applied: the outer product of the vertical taps and
+	// the quantized horizontal taps (as complex numbers)
+	Mat oRow;
+	m_oRowFixed.convertTo(oRow, CV_32F, 1 / m_dFixedScale);
+	Mat oColumn = m_oColumnTaps.t();
+	Mat oReal = oColumn.col(0) * oRow.row(0) - oColumn.col(1) * oRow.row(1);
+	Mat oImaginary = oColumn.col(0) * oRow.row(1) + oColumn.col(1) * oRow.row(0);
+
+	double dError = std::pow(norm(oReal, m_oRealComp, NORM_L2), 2) + std::pow(norm(oImaginary, m_oImaginaryComp, NORM_L2), 2);
+	double dNorm = std::pow(norm(m_oRealComp, NORM_L2), 2) + std::pow(norm(m_oImaginaryComp, NORM_L2), 2);
+	return dNorm > 0 ? std::sqrt(dError / dNorm) : 0;
+}
+
+// +-----------------------------------------------------------
+void fsdk::GaborKernel::quantize()
+{
+	if(m_oRealComp.empty())
+		return;
+
+	// The kernel is separable, since its Gaussian envelope is isotropic and its
+	// carrier is a complex exponential: it is the product of a horizontal factor
+	// g(x)exp(i*fx*x) and a vertical factor g(y)exp(i*(fy*y + psi))
+	int iHalfSize = (m_iWindowSize - 1) / 2;
+	double dFreqX = 2 * CV_PI * std::cos(m_dTheta) / m_dLambda;
+	double dFreqY = 2 * CV_PI * std::sin(m_dTheta) / m_dLambda;
+
+	Mat oRow(2, m_iWindowSize, CV_64F);
+	m_oColumnTaps.create(2, m_iWindowSize, CV_32F);
+	for(int i = 0; i < m_iWindowSize; i++)
+	{
+		int t = i - iHalfSize;
+		double dGauss = exp(-(std::pow(t, 2) / (2 * std::pow(m_dSigma, 2))));
+		oRow.at<double>(0, i) = dGauss * std::cos(dFreqX * t);
+		oRow.at<double>(1, i) = dGauss * std::sin(dFreqX * t);
+		m_oColumnTaps.at<float>(0, i) = (float)(dGauss * std::cos(dFreqY * t + m_dPsi));
+		m_oColumnTaps.at<float>(1, i) = (float)(dGauss * std::sin(dFreqY * t + m_dPsi));
+	}
+
+	// The scale is limited by the largest tap (that must fit in 16 bits) and by
+	// the largest possible accumulation (the sum of the taps times the largest
+	// 8-bit pixel, that must fit in 32 bits). The number of taps is discounted
+	// from the limit of the accumulation to account for the rounding of the taps
+	double dMax;
+	minMaxLoc(abs(oRow), NULL, &dMax);
+	double dSum = std::max(norm(oRow.row(0), NORM_L1), norm(oRow.row(1), NORM_L1));
+
+	double dScale = SHRT_MAX / std::max(dMax, DBL_EPSILON);
+	double dLimit = (double(INT_MAX) / UCHAR_MAX - m_iWindowSize) / std::max(dSum, DBL_EPSILON);
+	m_dFixedScale = std::min(dScale, dLimit);
+
+	// convertTo rounds to the nearest integer
+	oRow.convertTo(m_oRowFixed, CV_16S, m_dFixedScale);
+}
+
+// +-----------------------------------------------------------
+void fsdk::GaborKernel::filterFixedPoint(const Mat &oImage, Mat &oReal, Mat &oImaginary) const
+{
+	// Pad the image once (with the same border used by filter2D) and widen
+	// it to 16 bits, so the products are computed in 16-bit lanes
+	int iHalfSize = (m_iWindowSize - 1) / 2;
+	Mat oPadded;
+	copyMakeBorder(oImage, oPadded, iHalfSize, iHalfSize, iHalfSize, iHalfSize, BORDER_REFLECT_101);
+	oPadded.convertTo(oPadded, CV_16S);
+	int iRows = oPadded.rows - 2 * iHalfSize;
+	int iCols = oPadded.cols - 2 * iHalfSize;
+
+	// Horizontal pass over all rows of the padded image, in fixed point (the
+	// inner loop is a multiply-add of contiguous 16-bit values into 32-bit
+	// accumulators, which the compilers vectorize)
+	Mat oRowReal(oPadded.rows, iCols, CV_32F);
+	Mat oRowImaginary(oPadded.rows, iCols, CV_32F);
+	std::vector<int> vReal(iCols), vImaginary(iCols);
+	const short *pRealTaps = m_oRowFixed.ptr<short>(0);
+	const short *pImaginaryTaps = m_oRowFixed.ptr<short>(1);
+	float fInvScale = static_cast<float>(1 / m_dFixedScale);
+	for(int y = 0; y < oPadded.rows; y++)
+	{
+		std::fill(vReal.begin(), vReal.end(), 0);
+		std::fill(vImaginary.begin(), vImaginary.end(), 0);
+		int *pReal = vReal.data();
+		int *pImaginary = vImaginary.data();
+
+		const short *pPixels = oPadded.ptr<short>(y);
+		for(int iCol = 0; iCol < m_iWindowSize; iCol++)
+		{
+			int iRealTap = pRealTaps[iCol];
+			int iImaginaryTap = pImaginaryTaps[iCol];
+			const short *pSource = pPixels + iCol;
+			for(int x = 0; x < iCols; x++)
+			{
+				pReal[x] += iRealTap * pSource[x];
+				pImaginary[x] += iImaginaryTap * pSource[x];
+			}
+		}
+
+		float *pRealOut = oRowReal.ptr<float>(y);
+		float *pImaginaryOut = oRowImaginary.ptr<float>(y);
+		for(int x = 0; x < iCols; x++)
+		{
+			pRealOut[x] = pReal[x] * fInvScale;
+			pImaginaryOut[x] = pImaginary[x] * fInvScale;
+		}
+	}
+
+	// Vertical pass in float, multiplying the complex results of the rows by
+	// the complex taps of the vertical factor
+	oReal.create(iRows, iCols, CV_32F);
+	oImaginary.create(iRows, iCols, CV_32F);
+	const float *pColumnReal = m_oColumnTaps.ptr<float>(0);
+	const float *pColumnImaginary = m_oColumnTaps.ptr<float>(1);
+	for(int y = 0; y < iRows; y++)
+	{
+		float *pRealOut = oReal.ptr<float>(y);
+		float *pImaginaryOut = oImaginary.ptr<float>(y);
+		std::fill(pRealOut, pRealOut + iCols, 0.0f);
+		std::fill(pImaginaryOut, pImaginaryOut + iCols, 0.0f);
+
+		for(int iRow = 0; iRow < m_iWindowSize; iRow++)
+		{
+			float fRealTap = pColumnReal[iRow];
+			float fImaginaryTap = pColumnImaginary[iRow];
+			const float *pRowReal = oRowReal.ptr<float>(y + iRow);
+			const float *pRowImaginary = oRowImaginary.ptr<float>(y + iRow);
+			for(int x = 0; x < iCols; x++)
+			{
+				pRealOut[x] += fRealTap * pRowReal[x] - fImaginaryTap * pRowImaginary[x];
+				pImaginaryOut[x] += fRealTap * pRowImaginary[x] + fImaginaryTap * pRowReal[x];
+			}
+		}
+	}
 }
 
 // +-----------------------------------------------------------
@@ -258,18 +437,23 @@ double fsdk::GaborKernel::bandWidth() const
 }
 
 // +-----------------------------------------------------------
-void fsdk::GaborKernel::filter(const Mat &oImage, Mat &oResponses)
+void fsdk::GaborKernel::filter(const Mat &oImage, Mat &oResponses) const
 {
 	Mat oReal, oImaginary;
 	filter(oImage, oResponses, oReal, oImaginary);
 }
 
 // +-----------------------------------------------------------
-void fsdk::GaborKernel::filter(const Mat &oImage, Mat &oResponses, Mat &oReal, Mat &oImaginary)
+void fsdk::GaborKernel::filter(const Mat &oImage, Mat &oResponses, Mat &oReal, Mat &oImaginary) const
 {
 	// Convolve the image with the two components
-	filter2D(oImage, oReal, CV_32F, m_oRealComp);
-	filter2D(oImage, oImaginary, CV_32F, m_oImaginaryComp);
+	if(m_ePrecision == FixedPointPrecision && oImage.type() == CV_8UC1)
+		filterFixedPoint(oImage, oReal, oImaginary);
+	else
+	{
+		filter2D(oImage, oReal, CV_32F, m_oRealComp);
+		filter2D(oImage, oImaginary, CV_32F, m_oImaginaryComp);
+	}
 
 	// Calculate the response (the magnitude/energy)
 	magnitude(oReal, oImaginary, oResponses);
@@ -194,6 +194,52 @@ namespace fsdk
 			ImaginaryComp
 		};
 
+		/**
+		 * Numeric precisions of the filtering.
+		 */
+		enum Precision
+		{
+			/** Float (CV_32F) taps and accumulation (the convolution of OpenCV). */
+			FloatPrecision,
+
+			/**
+			 * Separable fixed-point filtering of 8-bit images: the kernel is applied
+			 * as the product of a horizontal and a vertical complex factor (it is
+			 * separable, since its Gaussian envelope is isotropic), so the cost per
+			 * pixel grows with the window size instead of with its square. The
+			 * horizontal taps are quantized to 16-bit integers and their products
+			 * accumulated in 32-bit integers (so twice as many values fit in each
+			 * SIMD register); the vertical pass is done in float. Images that are
+			 * not 8-bit are filtered in float.
+			 */
+			FixedPointPrecision
+		};
+
+		/**
+		 * Sets the numeric precision of the filtering.
+		 * @param ePrecision Value of the Precision enumeration with the precision.
+		 * The default is FloatPrecision.
+		 */
+		void setPrecision(const Precision ePrecision);
+
+		/**
+		 * Gets the numeric precision of the filtering.
+		 * @return Value of the Precision enumeration with the precision.
+		 */
+		Precision precision() const;
+
+		/**
+		 * Gets the error of the quantization of the taps in the fixed-point
+		 * precision, as the L2 norm of the differences between the kernel
+		 * effectively applied (the product of the quantized horizontal taps and
+		 * the vertical taps) and the float kernel (of both components) over the
+		 * L2 norm of the float kernel. Since the convolution is linear, it is also a bound of the
+		 * relative error of the components of the responses.
+		 * @return Double with the relative error of the quantization (0 in the
+		 * float precision).
+		 */
+		double quantizationError() const;
+
 		/**
 		 * Gets the OpenCV's Mat with the kernel data of the given component.
 		 * @param eComp Value of the KernelComponent enumeration with the component
@@ -225,7 +271,7 @@ namespace fsdk
 		 * @param oResponses Reference to an OpenCV's Mat that will receive the filter
 		 * responses.
 		 */
-		void filter(const cv::Mat &oImage, cv::Mat &oResponses);
+		void filter(const cv::Mat &oImage, cv::Mat &oResponses) const;
 
 		/**
 		 * Filters the given image with the kernel and get the responses (that is,
@@ -240,7 +286,7 @@ namespace fsdk
 		 * @param oImaginary Reference to an OpenCV's Mat that will receive the imaginary
 		 * component of the responses.
 		 */
-		void filter(const cv::Mat &oImage, cv::Mat &oResponses, cv::Mat &oReal, cv::Mat &oImaginary);
+		void filter(const cv::Mat &oImage, cv::Mat &oResponses, cv::Mat &oReal, cv::Mat &oImaginary) const;
 
 	protected:
 
@@ -249,6 +295,27 @@ namespace fsdk
 		 */
 		void rebuildKernel();
 
+		/**
+		 * Decomposes the kernel in its horizontal and vertical complex factors,
+		 * and quantizes the horizontal one to 16-bit integers with the largest
+		 * scale for which neither the taps nor the accumulation of the products
+		 * with 8-bit pixels overflow.
+		 */
+		void quantize();
+
+		/**
+		 * Filters an 8-bit image with the separable factors of the kernel. The
+		 * rows are filtered with the quantized horizontal taps (accumulated in
+		 * 32-bit integers and then converted to float, with the scale of the
+		 * quantization removed), and the results with the vertical taps.
+		 * @param oImage OpenCV's Mat with the 8-bit image in which to apply the filter.
+		 * @param oReal Reference to an OpenCV's Mat that will receive the real component
+		 * of the responses.
+		 * @param oImaginary Reference to an OpenCV's Mat that will receive the imaginary
+		 * component of the responses.
+		 */
+		void filterFixedPoint(const cv::Mat &oImage, cv::Mat &oReal, cv::Mat &oImaginary) const;
+
 	private:
 
 		/** Orientation (θ) of the sinusoidal carrier of the kernel, in radians. */
@@ -271,6 +338,18 @@ namespace fsdk
 
 		/** OpenCV's Mat with the imaginary data for the Gabor kernel. */
 		cv::Mat m_oImaginaryComp;
+
+		/** Numeric precision of the filtering. */
+		Precision m_ePrecision;
+
+		/** OpenCV's Mat with the real (first row) and imaginary (second row) horizontal taps quantized to 16-bit integers (only in the fixed-point precision). */
+		cv::Mat m_oRowFixed;
+
+		/** OpenCV's Mat with the real (first row) and imaginary (second row) vertical taps (only in the fixed-point precision). */
+		cv::Mat m_oColumnTaps;
+
+		/** Scale of the quantized taps (i.e. quantized = round(float * scale)). */
+		double m_dFixedScale;
 	};
 }
 
@@ -0,0 +1,217 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "imagesequence.h"
+#include "csvfile.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QCollator>
+#include <QMutexLocker>
+#include <QApplication>
+#include <QDebug>
+#include <algorithm>
+
+// Prefix of the sequences given with a wildcard (or explicitly as a sequence)
+#define SEQUENCE_PREFIX "images:"
+
+// Name filters of the image files listed from a directory
+#define IMAGE_FILTERS { "*.jpg", "*.jpeg", "*.png", "*.bmp", "*.tif", "*.tiff", "*.pgm", "*.ppm", "*.pbm", "*.webp" }
+
+// +-----------------------------------------------------------
+fsdk::ImageSequence::ImageSequence(const QString &sInput, const int iWorkers, const int iReadAhead)
+{
+	m_sInput = sInput;
+	m_iReadFlags = CV_LOAD_IMAGE_COLOR;
+	m_iReadAhead = qMax(iReadAhead, 1);
+	m_iNextDecode = 0;
+	m_iNextRead = 0;
+	if(iWorkers > 0)
+		m_oPool.setMaxThreadCount(iWorkers);
+}
+
+// +-----------------------------------------------------------
+fsdk::ImageSequence::~ImageSequence()
+{
+	stop();
+}
+
+// +-----------------------------------------------------------
+bool fsdk::ImageSequence::isImageSequence(const QString &sInput)
+{
+	return sInput.startsWith(SEQUENCE_PREFIX) || QFileInfo(sInput).isDir();
+}
+
+// +-----------------------------------------------------------
+QString fsdk::ImageSequence::listingFileName(const QString &sDataFilename)
+{
+	return sDataFilename + ".images.csv";
+}
+
+// +-----------------------------------------------------------
+bool fsdk::ImageSequence::open()
+{
+	QString sPath = m_sInput;
+	if(sPath.startsWith(SEQUENCE_PREFIX))
+		sPath = sPath.mid(QString(SEQUENCE_PREFIX).length());
+
+	// List all images of a directory, or the files that match the wildcard
+	QDir oDir;
+	QStringList lFilters;
+	if(QFileInfo(sPath).isDir())
+	{
+		oDir.setPath(sPath);
+		lFilters = QStringList(IMAGE_FILTERS);
+	}
+	else
+	{
+		QFileInfo oPath(sPath);
+		oDir = oPath.dir();
+		lFilters.append(oPath.fileName());
+	}
+
+	QStringList lNames = oDir.entryList(lFilters, QDir::Files | QDir::Readable);
+	if(lNames.isEmpty())
+	{
+		qWarning().noquote() << QApplication::translate("ImageSequence", "no image files in the sequence %1").arg(m_sInput);
+		return false;
+	}
+
+	// Sort the names comparing the numbers by their values
+	QCollator oCollator;
+	oCollator.setNumericMode(true);
+	std::sort(lNames.begin(), lNames.end(), oCollator);
+
+	m_lFiles.clear();
+	foreach(QString sName, lNames)
+		m_lFiles.append(oDir.absoluteFilePath(sName));
+	return true;
+}
+
+// +-----------------------------------------------------------
+int fsdk::ImageSequence::count() const
+{
+	return m_lFiles.count();
+}
+
+// +-----------------------------------------------------------
+QString fsdk::ImageSequence::fileName(const int iIndex) const
+{
+	return m_lFiles.value(iIndex);
+}
+
+// +-----------------------------------------------------------
+bool fsdk::ImageSequence::saveListing(const QString &sFilename) const
+{
+	CSVFile oListing;
+	oListing.header().append({ "Frame", "File" });
+	for(int i = 0; i < m_lFiles.count(); i++)
+		oListing.addLine({ QString::number(i), m_lFiles[i] });
+	return oListing.write(sFilename);
+}
+
+// +-----------------------------------------------------------
+void fsdk::ImageSequence::setReadFlags(const int iFlags)
+{
+	m_iReadFlags = iFlags;
+}
+
+// +-----------------------------------------------------------
+void fsdk::ImageSequence::start(const QList<int> &lIndexes)
+{
+	stop();
+	m_lIndexes = lIndexes;
+	m_iNextDecode = 0;
+	m_iNextRead = 0;
+	submit();
+}
+
+// +-----------------------------------------------------------
+bool fsdk::ImageSequence::read(cv::Mat &oFrame, int &iIndex)
+{
+	while(m_iNextRead < m_lIndexes.count())
+	{
+		// Wait for the next image to be decoded
+		{
+			QMutexLocker oLocker(&m_oMutex);
+			while(!m_mDecoded.contains(m_iNextRead))
+				m_oImageDecoded.wait(&m_oMutex);
+			oFrame = m_mDecoded.take(m_iNextRead);
+		}
+
+		iIndex = m_lIndexes[m_iNextRead];
+		m_iNextRead++;
+		submit();
+
+		if(!oFrame.empty())
+			return true;
+
+		qWarning().noquote() << QApplication::translate("ImageSequence", "could not read the image file %1; it will be skipped").arg(fileName(iIndex));
+	}
+
+	oFrame = cv::Mat();
+	iIndex = -1;
+	return false;
+}
+
+// +-----------------------------------------------------------
+void fsdk::ImageSequence::stop()
+{
+	m_oPool.clear();
+	m_oPool.waitForDone();
+
+	QMutexLocker oLocker(&m_oMutex);
+	m_mDecoded.clear();
+	m_lIndexes.clear();
+	m_iNextDecode = 0;
+	m_iNextRead = 0;
+}
+
+// +-----------------------------------------------------------
+void fsdk::ImageSequence::decoded(const int iPosition, const cv::Mat &oImage)
+{
+	QMutexLocker oLocker(&m_oMutex);
+	m_mDecoded.insert(iPosition, oImage);
+	m_oImageDecoded.wakeAll();
+}
+
+// +-----------------------------------------------------------
+void fsdk::ImageSequence::submit()
+{
+	while(m_iNextDecode < m_lIndexes.count() && m_iNextDecode - m_iNextRead < m_iReadAhead)
+	{
+		m_oPool.start(new ImageDecodeJob(this, m_iNextDecode, fileName(m_lIndexes[m_iNextDecode]), m_iReadFlags));
+		m_iNextDecode++;
+	}
+}
+
+// +-----------------------------------------------------------
+fsdk::ImageDecodeJob::ImageDecodeJob(ImageSequence *pSequence, const int iPosition, const QString &sFilename, const int iFlags)
+{
+	m_pSequence = pSequence;
+	m_iPosition = iPosition;
+	m_sFilename = sFilename;
+	m_iFlags = iFlags;
+	setAutoDelete(true);
+}
+
+// +-----------------------------------------------------------
+void fsdk::ImageDecodeJob::run()
+{
+	m_pSequence->decoded(m_iPosition, cv::imread(m_sFilename.toStdString(), m_iFlags));
+}
\ No newline at end of file
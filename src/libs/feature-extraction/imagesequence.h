@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef IMAGESEQUENCE_H
+#define IMAGESEQUENCE_H
+
+#include "libexport.h"
+#include <QRunnable>
+#include <QThreadPool>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QStringList>
+#include <QMap>
+#include <opencv2/opencv.hpp>
+
+namespace fsdk
+{
+	/**
+	 * Sequence of image files processed as a single stream of frames (each image
+	 * is a frame, indexed by its position in the sequence), so a dataset of still
+	 * images is processed by a single extraction task, with a single tracker and
+	 * a single output file. The images are decoded ahead of their use by a pool
+	 * of worker threads, in parallel, while the frames already decoded are
+	 * processed. The sequences are given as:
+	 * - the path of a directory, for all image files in it;
+	 * - "images:<path>", for the path of a directory or for a path with wildcards
+	 *   in the file name part (for instance, "images:dataset/subject01_*.png").
+	 * The files are sorted by name, with the numbers in the names compared by
+	 * their values (so "frame2.png" comes before "frame10.png").
+	 */
+	class SHARED_LIB_EXPORT ImageSequence
+	{
+	public:
+
+		/**
+		 * Class constructor.
+		 * @param sInput QString with the sequence (see the class documentation).
+		 * @param iWorkers Integer with the number of threads that decode the
+		 * images. The default is 0, meaning the number of processor cores.
+		 * @param iReadAhead Integer with the maximum number of images decoded
+		 * ahead of their use. The default is 16.
+		 */
+		ImageSequence(const QString &sInput, const int iWorkers = 0, const int iReadAhead = 16);
+
+		/**
+		 * Class destructor.
+		 */
+		virtual ~ImageSequence();
+
+		/**
+		 * Queries if the given input is a sequence of images (see the class
+		 * documentation).
+		 * @param sInput QString with the input.
+		 * @return Boolean indicating if the input is a sequence (true) or not (false).
+		 */
+		static bool isImageSequence(const QString &sInput);
+
+		/**
+		 * Gets the name of the file that lists the images of a sequence next to a
+		 * data file extracted from it (see saveListing()).
+		 * @param sDataFilename QString with the name of the data file.
+		 * @return QString with the name of the listing file.
+		 */
+		static QString listingFileName(const QString &sDataFilename);
+
+		/**
+		 * Lists the image files of the sequence.
+		 * @return Boolean indicating if the sequence has images (true) or if it
+		 * is invalid or empty (false).
+		 */
+		bool open();
+
+		/**
+		 * Gets the number of images in the sequence.
+		 * @return Integer with the number of images.
+		 */
+		int count() const;
+
+		/**
+		 * Gets the name of an image file of the sequence.
+		 * @param iIndex Integer with the index of the image in the sequence.
+		 * @return QString with the path and name of the file, or an empty
+		 * QString if the index is invalid.
+		 */
+		QString fileName(const int iIndex) const;
+
+		/**
+		 * Saves the listing of the images of the sequence to a CSV file, with
+		 * the index of each image (i.e. its frame) and the name of its file.
+		 * @param sFilename QString with the name of the CSV file.
+		 * @return Boolean indicating if the listing was saved (true) or not (false).
+		 */
+		bool saveListing(const QString &sFilename) const;
+
+		/**
+		 * Sets the flags used to decode the images (see cv::imread()). It must
+		 * be called before start(). The default is CV_LOAD_IMAGE_COLOR.
+		 * @param iFlags Integer with the flags.
+		 */
+		void setReadFlags(const int iFlags);
+
+		/**
+		 * Starts decoding the given images, in order (discarding the images still
+		 * waiting to be read, if any).
+		 * @param lIndexes QList of integers with the indexes of the images to read.
+		 */
+		void start(const QList<int> &lIndexes);
+
+		/**
+		 * Reads the next image, waiting for it to be decoded if necessary. The
+		 * images that can not be decoded are skipped with a warning.
+		 * @param oFrame Reference to an OpenCV's Mat to receive the image.
+		 * @param iIndex Reference to an integer to receive the index of the image.
+		 * @return Boolean indicating if an image was read (true) or if all images
+		 * were read (false).
+		 */
+		bool read(cv::Mat &oFrame, int &iIndex);
+
+		/**
+		 * Stops decoding the images and waits for the workers to finish.
+		 */
+		void stop();
+
+		/**
+		 * Stores an image decoded (called by the workers).
+		 * @param iPosition Integer with the position of the image in the images
+		 * being read.
+		 * @param oImage OpenCV's Mat with the image decoded (empty if the image
+		 * could not be decoded).
+		 */
+		void decoded(const int iPosition, const cv::Mat &oImage);
+
+	protected:
+
+		/**
+		 * Queues the decoding of the next images, up to the read ahead.
+		 */
+		void submit();
+
+	private:
+
+		/** Sequence given. */
+		QString m_sInput;
+
+		/** Names of the image files, in order. */
+		QStringList m_lFiles;
+
+		/** Flags used to decode the images. */
+		int m_iReadFlags;
+
+		/** Maximum number of images decoded ahead of their use. */
+		int m_iReadAhead;
+
+		/** Pool of the workers that decode the images. */
+		QThreadPool m_oPool;
+
+		/** Indexes of the images being read, in order. */
+		QList<int> m_lIndexes;
+
+		/** Position in the images being read of the next image to decode. */
+		int m_iNextDecode;
+
+		/** Position in the images being read of the next image to read. */
+		int m_iNextRead;
+
+		/** Images decoded and not yet read, by their position. */
+		QMap<int, cv::Mat> m_mDecoded;
+
+		/** Mutex that protects the images decoded. */
+		QMutex m_oMutex;
+
+		/** Condition signaled when an image is decoded. */
+		QWaitCondition m_oImageDecoded;
+	};
+
+	/**
+	 * Job that decodes an image of an ImageSequence in one of its workers.
+	 */
+	class ImageDecodeJob: public QRunnable
+	{
+	public:
+
+		/**
+		 * Class constructor.
+		 * @param pSequence Instance of the ImageSequence that receives the image.
+		 * @param iPosition Integer with the position of the image in the images
+		 * being read.
+		 * @param sFilename QString with the name of the image file.
+		 * @param iFlags Integer with the flags used to decode the image.
+		 */
+		ImageDecodeJob(ImageSequence *pSequence, const int iPosition, const QString &sFilename, const int iFlags);
+
+		/**
+		 * Decodes the image and gives it to the sequence.
+		 */
+		void run();
+
+	private:
+
+		/** Sequence that receives the image. */
+		ImageSequence *m_pSequence;
+
+		/** Position of the image in the images being read. */
+		int m_iPosition;
+
+		/** Name of the image file. */
+		QString m_sFilename;
+
+		/** Flags used to decode the image. */
+		int m_iFlags;
+	};
+}
+
+#endif // IMAGESEQUENCE_H
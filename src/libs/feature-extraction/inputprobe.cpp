@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "inputprobe.h"
+#include <QThreadPool>
+#include <algorithm>
+
+using namespace cv;
+
+// +-----------------------------------------------------------
+fsdk::InputProbe::InputProbe(const QString &sInputFile)
+{
+	qRegisterMetaType<fsdk::InputProbe>("fsdk::InputProbe");
+	m_sInputFile = sInputFile;
+	m_bValid = false;
+	m_iFrameCount = 0;
+	m_dFrameRate = 0;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::InputProbe::probe()
+{
+	m_bValid = false;
+	m_iFrameCount = 0;
+	m_dFrameRate = 0;
+	m_oFrameSize = Size();
+
+	// Opening a video only reads its headers (the frame count is a costly
+	// call in some backends, but still much cheaper than decoding)
+	VideoCapture oCap;
+	if(oCap.open(m_sInputFile.toStdString()))
+	{
+		m_iFrameCount = qMax(static_cast<int>(oCap.get(CV_CAP_PROP_FRAME_COUNT)), 0);
+		m_dFrameRate = qMax(oCap.get(CV_CAP_PROP_FPS), 0.0);
+		m_oFrameSize = Size(static_cast<int>(oCap.get(CV_CAP_PROP_FRAME_WIDTH)), static_cast<int>(oCap.get(CV_CAP_PROP_FRAME_HEIGHT)));
+		m_bValid = true;
+	}
+	else
+	{
+		// If it is not a video, it might be an image
+		Mat oImage = imread(m_sInputFile.toStdString(), CV_LOAD_IMAGE_UNCHANGED);
+		if(!oImage.empty())
+		{
+			m_iFrameCount = 1;
+			m_oFrameSize = oImage.size();
+			m_bValid = true;
+		}
+	}
+
+	return m_bValid;
+}
+
+// +-----------------------------------------------------------
+QString fsdk::InputProbe::inputFile() const
+{
+	return m_sInputFile;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::InputProbe::isValid() const
+{
+	return m_bValid;
+}
+
+// +-----------------------------------------------------------
+int fsdk::InputProbe::frameCount() const
+{
+	return m_iFrameCount;
+}
+
+// +-----------------------------------------------------------
+double fsdk::InputProbe::frameRate() const
+{
+	return m_dFrameRate;
+}
+
+// +-----------------------------------------------------------
+cv::Size fsdk::InputProbe::frameSize() const
+{
+	return m_oFrameSize;
+}
+
+// +-----------------------------------------------------------
+QList<fsdk::InputProbe> fsdk::InputProbe::probeAll(const QStringList &lInputFiles, const int iWorkers)
+{
+	QList<InputProbe> lProbes;
+	foreach(QString sInputFile, lInputFiles)
+		lProbes.append(InputProbe(sInputFile));
+
+	// The jobs write directly to the items of the list (which is not changed
+	// until all of them are done, so the items are not moved)
+	QThreadPool oPool;
+	if(iWorkers > 0)
+		oPool.setMaxThreadCount(iWorkers);
+	for(int i = 0; i < lProbes.count(); i++)
+		oPool.start(new InputProbeJob(&lProbes[i]));
+	oPool.waitForDone();
+
+	return lProbes;
+}
+
+// +-----------------------------------------------------------
+QStringList fsdk::InputProbe::longestFirst(const QList<InputProbe> &lProbes)
+{
+	QList<InputProbe> lOrdered = lProbes;
+	std::stable_sort(lOrdered.begin(), lOrdered.end(), hasMoreFrames);
+
+	QStringList lInputFiles;
+	foreach(InputProbe oProbe, lOrdered)
+		lInputFiles.append(oProbe.inputFile());
+	return lInputFiles;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::InputProbe::hasMoreFrames(const InputProbe &oFirst, const InputProbe &oSecond)
+{
+	return oFirst.frameCount() > oSecond.frameCount();
+}
+
+// +-----------------------------------------------------------
+fsdk::InputProber::InputProber(QObject *pParent): QObject(pParent)
+{
+}
+
+// +-----------------------------------------------------------
+fsdk::InputProber::~InputProber()
+{
+	m_oPool.waitForDone();
+}
+
+// +-----------------------------------------------------------
+void fsdk::InputProber::start(const QStringList &lInputFiles, const int iWorkers)
+{
+	// The list is only replaced when no jobs are writing to its items
+	m_oPool.waitForDone();
+	m_lProbes.clear();
+	foreach(QString sInputFile, lInputFiles)
+		m_lProbes.append(InputProbe(sInputFile));
+
+	if(iWorkers > 0)
+		m_oPool.setMaxThreadCount(iWorkers);
+	for(int i = 0; i < m_lProbes.count(); i++)
+		m_oPool.start(new InputProbeJob(&m_lProbes[i], this));
+}
+
+// +-----------------------------------------------------------
+fsdk::InputProbeJob::InputProbeJob(InputProbe *pProbe, InputProber *pProber)
+{
+	m_pProbe = pProbe;
+	m_pProber = pProber;
+	setAutoDelete(true);
+}
+
+// +-----------------------------------------------------------
+void fsdk::InputProbeJob::run()
+{
+	m_pProbe->probe();
+
+	// The signal is queued to the thread of the prober (a copy of the metadata
+	// is sent, so the receiver never reads the item while it is written)
+	if(m_pProber)
+		emit m_pProber->inputProbed(*m_pProbe);
+}
\ No newline at end of file
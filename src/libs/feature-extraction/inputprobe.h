@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INPUTPROBE_H
+#define INPUTPROBE_H
+
+#include "libexport.h"
+#include <QObject>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QStringList>
+#include <QList>
+#include <opencv2/opencv.hpp>
+
+namespace fsdk
+{
+	/**
+	 * Metadata of an input file (number of frames, frame rate and resolution),
+	 * queried without processing the file, so a batch of files can be planned
+	 * before it is processed: the batch progress can count all the frames from
+	 * the begining and the longest files can be started first, so they do not
+	 * delay the end of the batch. The files of a batch are probed in parallel
+	 * (see probeAll(), or InputProber to receive the metadata as soon as each
+	 * file is probed).
+	 */
+	class SHARED_LIB_EXPORT InputProbe
+	{
+	public:
+
+		/**
+		 * Class constructor.
+		 * @param sInputFile QString with the name of the image/video file.
+		 */
+		InputProbe(const QString &sInputFile = QString());
+
+		/**
+		 * Queries the metadata of the file. The videos are only opened (not
+		 * decoded); the images are decoded, since they have a single frame.
+		 * @return Boolean indicating if the file could be read (true) or not
+		 * (false).
+		 */
+		bool probe();
+
+		/**
+		 * Gets the name of the file probed.
+		 * @return QString with the name of the file.
+		 */
+		QString inputFile() const;
+
+		/**
+		 * Queries if the file was probed with success.
+		 * @return Boolean indicating if the metadata is valid (true) or not (false).
+		 */
+		bool isValid() const;
+
+		/**
+		 * Gets the number of frames of the file.
+		 * @return Integer with the number of frames (1 for the images), or 0 if
+		 * it is unknown.
+		 */
+		int frameCount() const;
+
+		/**
+		 * Gets the frame rate of the file.
+		 * @return Double with the frame rate in frames per second, or 0 if it is
+		 * unknown (or the file is an image).
+		 */
+		double frameRate() const;
+
+		/**
+		 * Gets the resolution of the frames of the file.
+		 * @return OpenCV's Size with the size of the frames (empty if unknown).
+		 */
+		cv::Size frameSize() const;
+
+		/**
+		 * Probes the given files in parallel, with a pool of worker threads.
+		 * @param lInputFiles QStringList with the names of the files.
+		 * @param iWorkers Integer with the number of threads that probe the
+		 * files. The default is 0, meaning the number of processor cores.
+		 * @return QList of InputProbe with the metadata of the files, in the
+		 * same order of the names given.
+		 */
+		static QList<InputProbe> probeAll(const QStringList &lInputFiles, const int iWorkers = 0);
+
+		/**
+		 * Orders the files probed by their number of frames, the longest first
+		 * (the files with an unknown number of frames are kept at the end, in
+		 * their original order).
+		 * @param lProbes QList of InputProbe with the metadata of the files.
+		 * @return QStringList with the names of the files in the new order.
+		 */
+		static QStringList longestFirst(const QList<InputProbe> &lProbes);
+
+	protected:
+
+		/**
+		 * Compares the number of frames of two files (used to order them).
+		 * @param oFirst InputProbe with the metadata of the first file.
+		 * @param oSecond InputProbe with the metadata of the second file.
+		 * @return Boolean indicating if the first file has more frames than the
+		 * second one (true) or not (false).
+		 */
+		static bool hasMoreFrames(const InputProbe &oFirst, const InputProbe &oSecond);
+
+	private:
+
+		/** Name of the file probed. */
+		QString m_sInputFile;
+
+		/** Indicates if the file was probed with success. */
+		bool m_bValid;
+
+		/** Number of frames of the file (0 if unknown). */
+		int m_iFrameCount;
+
+		/** Frame rate of the file (0 if unknown). */
+		double m_dFrameRate;
+
+		/** Resolution of the frames of the file. */
+		cv::Size m_oFrameSize;
+	};
+
+	/**
+	 * Prober of a batch of input files in background, so their tasks need not
+	 * wait for all of them to be probed: the metadata of each file is signaled
+	 * as soon as it is known (in no particular order).
+	 */
+	class SHARED_LIB_EXPORT InputProber: public QObject
+	{
+		Q_OBJECT
+
+	public:
+
+		/**
+		 * Class constructor.
+		 * @param pParent Instance of the parent object.
+		 */
+		InputProber(QObject *pParent = 0);
+
+		/**
+		 * Class destructor. It waits for the files being probed.
+		 */
+		virtual ~InputProber();
+
+		/**
+		 * Starts probing the given files in parallel, with a pool of worker
+		 * threads. It returns right away; the metadata of the files is given
+		 * by the signal inputProbed().
+		 * @param lInputFiles QStringList with the names of the files.
+		 * @param iWorkers Integer with the number of threads that probe the
+		 * files. The default is 0, meaning the number of processor cores.
+		 */
+		void start(const QStringList &lInputFiles, const int iWorkers = 0);
+
+	signals:
+
+		/**
+		 * Signal indicating that one of the files has been probed.
+		 * @param oProbe InputProbe with the metadata of the file (that might
+		 * not be valid, if the file could not be read).
+		 */
+		void inputProbed(const fsdk::InputProbe &oProbe);
+
+	private:
+
+		/** Pool of threads where the files are probed. */
+		QThreadPool m_oPool;
+
+		/** Metadata of the files probed (not changed while they are probed). */
+		QList<InputProbe> m_lProbes;
+	};
+
+	/**
+	 * Job that probes an input file in one of the workers of InputProbe::probeAll()
+	 * or of InputProber.
+	 */
+	class InputProbeJob: public QRunnable
+	{
+	public:
+
+		/**
+		 * Class constructor.
+		 * @param pProbe Instance of the InputProbe to probe.
+		 * @param pProber Instance of the InputProber that signals the metadata
+		 * of the file once it is probed. The default is 0 (no signal).
+		 */
+		InputProbeJob(InputProbe *pProbe, InputProber *pProber = 0);
+
+		/**
+		 * Probes the file.
+		 */
+		void run();
+
+	private:
+
+		/** Metadata of the file probed. */
+		InputProbe *m_pProbe;
+
+		/** Prober that signals the metadata of the file (if any). */
+		InputProber *m_pProber;
+	};
+}
+
+Q_DECLARE_METATYPE(fsdk::InputProbe);
+
+#endif // INPUTPROBE_H
@@ -20,12 +20,16 @@
 #include "landmarksdata.h"
 #include "csvfile.h"
 #include <QApplication>
+#include <QFileInfo>
 
 // +-----------------------------------------------------------
 fsdk::LandmarksData::LandmarksData()
 {
 	qRegisterMetaType<fsdk::LandmarksData>("fsdk::LandmarksData");
 	m_iLandmarksCount = 0;
+	m_oPyramid.reset(1);
+	m_oPyramid.setLabels({ "Quality" });
+	m_bPyramidValid = true;
 }
 
 // +-----------------------------------------------------------
@@ -34,6 +38,9 @@ fsdk::LandmarksData::LandmarksData(const LandmarksData& oOther)
 	m_mLandmarks = oOther.m_mLandmarks;
 	m_mQualities = oOther.m_mQualities;
 	m_iLandmarksCount = oOther.m_iLandmarksCount;
+	m_sReused = oOther.m_sReused;
+	m_oPyramid = oOther.m_oPyramid;
+	m_bPyramidValid = oOther.m_bPyramidValid;
 }
 
 // +-----------------------------------------------------------
@@ -63,6 +70,22 @@ float fsdk::LandmarksData::quality(const int iFrame) const
 void fsdk::LandmarksData::setQuality(const int iFrame, const float fValue)
 {
 	m_mQualities[iFrame] = qMin(qMax(fValue, 1.0f), 0.0f);
+	m_bPyramidValid = false;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::LandmarksData::isReused(const int iFrame) const
+{
+	return m_sReused.contains(iFrame);
+}
+
+// +-----------------------------------------------------------
+void fsdk::LandmarksData::setReused(const int iFrame, const bool bReused)
+{
+	if(bReused)
+		m_sReused.insert(iFrame);
+	else
+		m_sReused.remove(iFrame);
 }
 
 // +-----------------------------------------------------------
@@ -71,12 +94,23 @@ const QList<QPoint> fsdk::LandmarksData::landmarks(int iFrame) const
 	return m_mLandmarks[iFrame];
 }
 
+// +-----------------------------------------------------------
+QList<int> fsdk::LandmarksData::frames() const
+{
+	return m_mLandmarks.keys();
+}
+
 // +-----------------------------------------------------------
 void fsdk::LandmarksData::add(const int iFrame, const QList<QPoint> &lPoints, const float fQuality)
 {
 	m_mLandmarks[iFrame] = lPoints;
 	m_mQualities[iFrame] = fQuality;
 	m_iLandmarksCount = qMax(m_iLandmarksCount, lPoints.count());
+
+	// Frames added in ascending order (as during the extraction) simply
+	// extend the pyramid; any other change requires rebuilding it
+	if(m_bPyramidValid)
+		m_bPyramidValid = m_oPyramid.append(iFrame, { fQuality });
 }
 
 // +-----------------------------------------------------------
@@ -84,6 +118,8 @@ void fsdk::LandmarksData::remove(const int iFrame)
 {
 	m_mLandmarks.remove(iFrame);
 	m_mQualities.remove(iFrame);
+	m_sReused.remove(iFrame);
+	m_bPyramidValid = false;
 
 	m_iLandmarksCount = 0;
 	QMap<int, QList<QPoint>>::const_iterator it;
@@ -96,7 +132,10 @@ void fsdk::LandmarksData::clear()
 {
 	m_mLandmarks.clear();
 	m_mQualities.clear();
+	m_sReused.clear();
 	m_iLandmarksCount = 0;
+	m_oPyramid.reset(1);
+	m_bPyramidValid = true;
 }
 
 // +-----------------------------------------------------------
@@ -105,8 +144,12 @@ bool fsdk::LandmarksData::saveToCSV(const QString &sFilename) const
 	CSVFile oData;
 	QStringList lLine;
 
-	// Add a header
+	// Add a header (the column of the reused frames only if there are any,
+	// so the files of the extractions without gating are kept unchanged)
+	bool bReused = !m_sReused.isEmpty();
 	oData.header().append({ "Frame", "Quality" });
+	if(bReused)
+		oData.header().append("Reused");
 
 	QString sNum;
 	for(int i = 0; i < m_iLandmarksCount; i++)
@@ -121,12 +164,18 @@ bool fsdk::LandmarksData::saveToCSV(const QString &sFilename) const
 	{
 		lLine.clear();
 		lLine.append({ QString::number(it.key()), QString::number(m_mQualities[it.key()]) });
+		if(bReused)
+			lLine.append(m_sReused.contains(it.key()) ? "1" : "0");
 		foreach(QPoint oPoint, it.value())
 			lLine.append({ QString::number(oPoint.x()), QString::number(oPoint.y()) });
 		oData.addLine(lLine);
 	}
 		
-	return oData.write(sFilename);
+	if(!oData.write(sFilename))
+		return false;
+
+	// Store the summary pyramid next to the data file
+	return pyramid().save(SignalPyramid::fileName(sFilename));
 }
 
 // +-----------------------------------------------------------
@@ -141,12 +190,16 @@ bool fsdk::LandmarksData::readFromCSV(const QString &sFilename)
 
 	QMap<int, QList<QPoint>> mLandmarks;
 	QMap<int, float> mQualities;
+	QSet<int> sReused;
 	int iLandmarksCount = 0;
 
+	// Files with reused frames have an additional column after the quality
+	int iFirst = oData.header().value(2) == "Reused" ? 3 : 2;
+
 	QList<QStringList> lData = oData.lines();
 	foreach(QStringList lLine, lData)
 	{
-		if(lLine.count() < 2)
+		if(lLine.count() < iFirst)
 		{
 			qDebug().noquote() << QApplication::translate("LandmarksData", "format error in landmarks CSV file");
 			return false;
@@ -154,9 +207,11 @@ bool fsdk::LandmarksData::readFromCSV(const QString &sFilename)
 
 		int iFrame = lLine[0].toInt();
 		float fQuality = lLine[1].toFloat();
+		if(iFirst == 3 && lLine[2].toInt() != 0)
+			sReused.insert(iFrame);
 
 		QList<QPoint> lPoints;
-		for(int i = 2; i < lLine.count() - 1; i += 2)
+		for(int i = iFirst; i < lLine.count() - 1; i += 2)
 		{
 			int x = lLine[i].toInt();
 			int y = lLine[i + 1].toInt();
@@ -171,8 +226,17 @@ bool fsdk::LandmarksData::readFromCSV(const QString &sFilename)
 
 	m_mQualities = mQualities;
 	m_mLandmarks = mLandmarks;
+	m_sReused = sReused;
 	m_iLandmarksCount = iLandmarksCount;
 
+	// Use the stored summary pyramid if it is up to date with the data file
+	QFileInfo oPyramidFile(SignalPyramid::fileName(sFilename));
+	int iFrames = m_mQualities.isEmpty() ? 0 : m_mQualities.lastKey() + 1;
+	m_bPyramidValid = oPyramidFile.exists() &&
+		oPyramidFile.lastModified() >= QFileInfo(sFilename).lastModified() &&
+		m_oPyramid.load(oPyramidFile.filePath()) &&
+		m_oPyramid.signalsCount() == 1 && m_oPyramid.framesCount() == iFrames;
+
 	return true;
 }
 
@@ -182,6 +246,33 @@ int fsdk::LandmarksData::landmarksCount() const
 	return m_iLandmarksCount;
 }
 
+// +-----------------------------------------------------------
+const fsdk::SignalPyramid &fsdk::LandmarksData::pyramid() const
+{
+	if(!m_bPyramidValid)
+		rebuildPyramid();
+	return m_oPyramid;
+}
+
+// +-----------------------------------------------------------
+fsdk::SignalSummary fsdk::LandmarksData::qualitySummary(const int iFirstFrame, const int iLastFrame) const
+{
+	return pyramid().summary(0, iFirstFrame, iLastFrame);
+}
+
+// +-----------------------------------------------------------
+void fsdk::LandmarksData::rebuildPyramid() const
+{
+	m_oPyramid.reset(1);
+	m_oPyramid.setLabels({ "Quality" });
+
+	QMap<int, float>::const_iterator it;
+	for(it = m_mQualities.cbegin(); it != m_mQualities.cend(); ++it)
+		m_oPyramid.append(it.key(), { it.value() });
+
+	m_bPyramidValid = true;
+}
+
 // +-----------------------------------------------------------
 QDebug operator<<(QDebug oDbg, const fsdk::LandmarksData &oData)
 {
@@ -21,7 +21,9 @@
 #define LANDMARKSDATA_H
 
 #include "libexport.h"
+#include "signalpyramid.h"
 #include <QMap>
+#include <QSet>
 #include <QList>
 #include <QPoint>
 #include <QMetaType>
@@ -84,6 +86,24 @@ namespace fsdk
 		 */
 		void setQuality(const int iFrame, const float fValue);
 
+		/**
+		 * Queries if the landmarks of the given frame were reused from a previous
+		 * frame (i.e. the frame was skipped by a FrameGate, instead of tracked).
+		 * @param iFrame Integer with the index of the frame.
+		 * @return Boolean indicating if the landmarks were reused (true) or
+		 * tracked (false).
+		 */
+		bool isReused(const int iFrame) const;
+
+		/**
+		 * Marks the landmarks of the given frame as reused from a previous frame
+		 * (or as tracked).
+		 * @param iFrame Integer with the index of the frame.
+		 * @param bReused Boolean indicating if the landmarks were reused (true)
+		 * or tracked (false).
+		 */
+		void setReused(const int iFrame, const bool bReused);
+
 		/**
 		 * Queries the landmarks of a given frame. Same as operator[].
 		 * @param iFrame Integer with the index of the frame to get the
@@ -94,6 +114,13 @@ namespace fsdk
 		 */
 		const QList<QPoint> landmarks(int iFrame) const;
 
+		/**
+		 * Gets the indexes of the frames in the data.
+		 * @return QList of integers with the indexes of the frames, in
+		 * ascending order.
+		 */
+		QList<int> frames() const;
+
 		/**
 		 * Adds data of the given frame.
 		 * @param iFrame Integer with the number of the video frame.
@@ -116,7 +143,8 @@ namespace fsdk
 		void clear();
 
 		/**
-		 * Saves the landmarks data to the given CSV file.
+		 * Saves the landmarks data to the given CSV file. If the landmarks of any
+		 * frame were reused, a column "Reused" is added after the quality.
 		 * @param sFilename QString with the name of the file
 		 * to save the data to.
 		 * @return Boolean indicating if the saving was succesful
@@ -140,6 +168,32 @@ namespace fsdk
 		 */
 		int landmarksCount() const;
 
+		/**
+		 * Gets the multi-resolution summary of the tracking qualities. The
+		 * pyramid is built incrementally as frames are added in ascending
+		 * order, and rebuilt on demand after other changes.
+		 * @return Const reference to the SignalPyramid with the summary of
+		 * the tracking qualities.
+		 */
+		const SignalPyramid &pyramid() const;
+
+		/**
+		 * Gets the summary (minimum, maximum and mean) of the tracking quality
+		 * in a range of frames, in O(log n).
+		 * @param iFirstFrame Integer with the first frame of the range.
+		 * @param iLastFrame Integer with the last frame of the range (inclusive).
+		 * @return SignalSummary with the summary of the quality in the range.
+		 */
+		SignalSummary qualitySummary(const int iFirstFrame, const int iLastFrame) const;
+
+	protected:
+
+		/**
+		 * Rebuilds the pyramid with the summary of the tracking qualities
+		 * from the existing frame data.
+		 */
+		void rebuildPyramid() const;
+
 	private:
 
 		/** Mapping between frame number and list of 2D points of landmarks. */
@@ -151,6 +205,15 @@ namespace fsdk
 		/** Number of landmarks used by the tracker. */
 		int m_iLandmarksCount;
 
+		/** Frames whose landmarks were reused from a previous frame. */
+		QSet<int> m_sReused;
+
+		/** Multi-resolution summary of the tracking qualities. */
+		mutable SignalPyramid m_oPyramid;
+
+		/** Indicates if the pyramid is in sync with the frame data. */
+		mutable bool m_bPyramidValid;
+
 	};
 }
 
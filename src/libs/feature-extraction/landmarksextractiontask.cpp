@@ -19,47 +19,392 @@
 
 #include "landmarksextractiontask.h"
 #include "landmarksdata.h"
-#include "csirofacetracker.h"
+#include "facetrackerregistry.h"
+#include "scaledfacetracker.h"
+#include "multifacetracker.h"
+#include "trackingvalidation.h"
+#include "landmarksfilter.h"
+#include "framegate.h"
+#include <QScopedPointer>
+#include <QApplication>
+#include <QDebug>
 
 // +-----------------------------------------------------------
 fsdk::LandmarksExtractionTask::LandmarksExtractionTask(QString sInputFile, float fResetQuality):
 	ExtractionTask(sInputFile)
 {
 	m_fResetQuality = qMax(qMin(fResetQuality, 1.0f), 0.0f);	
+	m_dTrackingScale = 1.0;
+	m_bTrackingROI = false;
+	m_bValidate = false;
+	m_bSmoothing = false;
+	m_iMaxGap = 5;
+	m_iMaxFaces = 1;
+	m_bGating = false;
+	m_dGateThreshold = 2.0;
+	m_iGateMaxReused = 30;
+	m_bGateValidate = false;
+}
+
+// +-----------------------------------------------------------
+void fsdk::LandmarksExtractionTask::setTrackingMode(const double dScale, const bool bUseROI)
+{
+	m_dTrackingScale = qMin(qMax(dScale, 0.05), 1.0);
+	m_bTrackingROI = bUseROI;
+}
+
+// +-----------------------------------------------------------
+void fsdk::LandmarksExtractionTask::setValidationEnabled(const bool bEnabled)
+{
+	m_bValidate = bEnabled;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::LandmarksExtractionTask::setTrackerBackend(const QString &sName)
+{
+	if(!FaceTrackerRegistry::backend(sName))
+		return false;
+
+	m_sTrackerBackend = sName;
+	return true;
+}
+
+// +-----------------------------------------------------------
+void fsdk::LandmarksExtractionTask::setSmoothing(const bool bEnabled, const int iMaxGap)
+{
+	m_bSmoothing = bEnabled;
+	m_iMaxGap = qMax(iMaxGap, 0);
+}
+
+// +-----------------------------------------------------------
+void fsdk::LandmarksExtractionTask::setMultiFace(const int iMaxFaces, const QString &sDetectorFile)
+{
+	m_iMaxFaces = qMax(iMaxFaces, 1);
+	m_sDetectorFile = sDetectorFile;
+}
+
+// +-----------------------------------------------------------
+void fsdk::LandmarksExtractionTask::setGating(const bool bEnabled, const double dThreshold, const int iMaxReused, const bool bValidate)
+{
+	m_bGating = bEnabled;
+	m_dGateThreshold = qMax(dThreshold, 0.0);
+	m_iGateMaxReused = qMax(iMaxReused, 0);
+	m_bGateValidate = bValidate;
 }
 
 // +-----------------------------------------------------------
 void fsdk::LandmarksExtractionTask::run()
 {
-	CSIROFaceTracker oTracker;
+	if(m_iMaxFaces > 1)
+	{
+		if(m_bGating)
+			qWarning().noquote() << QApplication::translate("LandmarksExtractionTask", "the gating of redundant frames is not available with multiple faces; all frames of file %1 will be tracked").arg(inputFile());
+		runMultiFace();
+		return;
+	}
+
 	Mat oFrame;
 	LandmarksData oData;
 
+	// Create the tracker (with the reduced resolution/ROI tracking, if requested)
+	const FaceTrackerBackend *pBackend = FaceTrackerRegistry::backend(m_sTrackerBackend);
+	if(!pBackend)
+	{
+		end(InvalidInputParameters);
+		return;
+	}
+
+	bool bScaled = m_dTrackingScale < 1.0 || m_bTrackingROI;
+	QScopedPointer<FaceTracker> pTracker(pBackend->create());
+	if(bScaled)
+		pTracker.reset(new ScaledFaceTracker(pTracker.take(), m_dTrackingScale, m_bTrackingROI));
+
+	// Full resolution tracker used to validate the scaled tracking (if requested)
+	QScopedPointer<FaceTracker> pReference;
+	TrackingValidation oValidation(pBackend->landmarkIndex(FaceTracker::LeftEyeInnerCorner), pBackend->landmarkIndex(FaceTracker::RightEyeInnerCorner));
+	if(bScaled && m_bValidate)
+		pReference.reset(pBackend->create());
+
+	// Gate of the redundant frames (if requested), with the results of the last
+	// frame tracked and the validation of the results reused
+	FrameGate oGate(m_dGateThreshold, m_iGateMaxReused);
+	QList<QPoint> lLastLandmarks;
+	float fLastQuality = 0.0f;
+	TrackingValidation oGateValidation(pBackend->landmarkIndex(FaceTracker::LeftEyeInnerCorner), pBackend->landmarkIndex(FaceTracker::RightEyeInnerCorner));
+
 	// Start the task (if start fails, it will emit taskError())
 	if(!start())
 		return;
-	
+
+	// The images of a sequence are unrelated, so the face is detected again in
+	// each one of them and the temporal smoothing and gating do not apply
+	if(isImageSequence() && (m_bSmoothing || m_bGating))
+	{
+		qWarning().noquote() << QApplication::translate("LandmarksExtractionTask", "the smoothing and the gating are ignored for the image sequence %1").arg(inputFile());
+		m_bSmoothing = false;
+		m_bGating = false;
+	}
+
+	// Resume from the last checkpoint, if there is one (the state of the tracker
+	// is not persisted, so it simply redetects the face in the first frame)
+	if(!resumeCheckpoint(oData))
+	{
+		end(InvalidInputFile);
+		return;
+	}
+
+	// Publish the coordinates of the landmarks (if requested)
+	if(!openPublishing(pTracker->landmarksCount() * 2))
+	{
+		end(InvalidInputParameters);
+		return;
+	}
+
+	// Temporal filter of the landmarks (if requested)
+	LandmarksFilter oFilter(videoFrameRate(), m_iMaxGap);
+
 	// Process while not cancelled and there are frames
 	while(!isCancelled() && !nextFrame().empty())
 	{
-		// Track the face in current image/video frame
-		oTracker.track(frame());
+		// Check if the frame barely changed since the last frame tracked (in
+		// which case it is only tracked to validate the results reused)
+		bool bReused = m_bGating && oGate.isRedundant(frame());
+		bool bTracked = !bReused || m_bGateValidate;
+
+		// Track the face in current image/video frame (with the landmarks
+		// predicted by the filter as the initial guess)
+		if(bTracked)
+		{
+			ScopedStageTimer oTimer(profile(), TaskProfile::TrackingStage);
+			if(isImageSequence())
+				pTracker->reset();
+			if(m_bSmoothing)
+				pTracker->setPrediction(oFilter.predict(frameIndex()));
+			pTracker->track(frame());
+		}
+
+		QList<QPoint> lLandmarks;
+		float fQuality;
+		if(bReused)
+		{
+			// Reuse the results of the last frame tracked
+			lLandmarks = lLastLandmarks;
+			fQuality = fLastQuality;
+			if(m_bGateValidate)
+				oGateValidation.add(pTracker->getLandmarks(), pTracker->getQuality(), lLandmarks, fQuality);
+		}
+		else
+		{
+			// Smooth the landmarks obtained (or fill a short gap)
+			lLandmarks = pTracker->getLandmarks();
+			fQuality = pTracker->getQuality();
+			if(m_bSmoothing)
+			{
+				ScopedStageTimer oTimer(profile(), TaskProfile::SmoothingStage);
+				lLandmarks = oFilter.filter(frameIndex(), lLandmarks);
+			}
+			lLastLandmarks = lLandmarks;
+			fLastQuality = fQuality;
+		}
+
+		// Store the landmarks in the map
+		oData.add(frameIndex(), lLandmarks, fQuality);
+		if(bReused)
+			oData.setReused(frameIndex(), true);
+
+		// Report the landmarks of the frame right away (if requested)
+		if(isStreaming())
+		{
+			LandmarksData oResult;
+			oResult.add(frameIndex(), lLandmarks, fQuality);
+			oResult.setReused(frameIndex(), bReused);
+			streamResult(QVariant::fromValue(oResult));
+		}
+		publish(0, fQuality, lLandmarks);
 
-		// Store the landmarks obtained in the map
-		oData.add(frameIndex(), oTracker.getLandmarks(), oTracker.getQuality());
+		// Compare with the full resolution tracking
+		if(pReference && !bReused)
+		{
+			if(isImageSequence())
+				pReference->reset();
+			pReference->track(frame());
+			oValidation.add(pReference->getLandmarks(), pReference->getQuality(), pTracker->getLandmarks(), pTracker->getQuality());
+			if(pReference->getQuality() < m_fResetQuality)
+				pReference->reset();
+		}
 
 		// Reset the tracker if its quality gets lower than the configured value
-		// (it makes the whole process much slower, but yields better results)
-		if(oTracker.getQuality() < m_fResetQuality)
-			oTracker.reset();
+		// (it makes the whole process much slower, but yields better results).
+		// The gate is also reset, so the results of a poor tracking are not reused
+		if(bTracked && pTracker->getQuality() < m_fResetQuality)
+		{
+			ScopedStageTimer oTimer(profile(), TaskProfile::ResetStage);
+			pTracker->reset();
+			if(!bReused)
+				oGate.reset();
+		}
 
 		// Indicate progress
-		setProgress(int(float(frameIndex()) / float(frameCount()) * 100.0f));
+		updateProgress();
+
+		// Persist the partial results periodically (to allow resuming)
+		if(isCheckpointDue())
+			saveCheckpoint(oData);
 	}
 
+	if(pReference)
+		qInfo().noquote() << QApplication::translate("LandmarksExtractionTask", "tracking validation of file %1: %2").arg(inputFile(), oValidation.toString());
+	if(m_bGating)
+		qInfo().noquote() << QApplication::translate("LandmarksExtractionTask", "gating of file %1: %2").arg(inputFile(), oGate.toString());
+	if(m_bGating && m_bGateValidate)
+		qInfo().noquote() << QApplication::translate("LandmarksExtractionTask", "gating validation of file %1: %2").arg(inputFile(), oGateValidation.toString());
+
 	// End the task accordingly (with cancellation or success)
 	if(isCancelled())
+	{
+		// Keep the work done so far, so it can be resumed later
+		if(isCheckpointEnabled())
+			saveCheckpoint(oData);
 		end(CancelRequested);
+	}
+	else
+		end(QVariant::fromValue(oData));
+}
+
+// +-----------------------------------------------------------
+void fsdk::LandmarksExtractionTask::runMultiFace()
+{
+	FaceTracksData oData;
+
+	// Create the tracker of the faces
+	if(!FaceTrackerRegistry::backend(m_sTrackerBackend))
+	{
+		end(InvalidInputParameters);
+		return;
+	}
+
+	MultiFaceTracker oTracker(m_sTrackerBackend, m_iMaxFaces, m_dTrackingScale, m_fResetQuality);
+	if(!m_sDetectorFile.isEmpty() && !oTracker.setDetector(m_sDetectorFile))
+	{
+		end(InvalidInputParameters);
+		return;
+	}
+	if(!oTracker.hasDetector())
+		qWarning().noquote() << QApplication::translate("LandmarksExtractionTask", "no face detector available; only one face will be tracked in file %1").arg(inputFile());
+
+	// Start the task (if start fails, it will emit taskError())
+	if(!start())
+		return;
+
+	// The images of a sequence are unrelated, so the faces are detected again
+	// in each one of them and the temporal smoothing does not apply
+	if(isImageSequence() && m_bSmoothing)
+	{
+		qWarning().noquote() << QApplication::translate("LandmarksExtractionTask", "the smoothing is ignored for the image sequence %1").arg(inputFile());
+		m_bSmoothing = false;
+	}
+
+	// Resume from the last checkpoint, if there is one (the faces are detected
+	// again, so they might receive different IDs)
+	if(!resumeCheckpoint(oData))
+	{
+		end(InvalidInputFile);
+		return;
+	}
+
+	// Publish the coordinates of the landmarks of each face (if requested)
+	if(!openPublishing(FaceTrackerRegistry::backend(m_sTrackerBackend)->landmarksCount() * 2))
+	{
+		end(InvalidInputParameters);
+		return;
+	}
+
+	// Temporal filters of the landmarks of each face (if requested)
+	QMap<int, LandmarksFilter> mFilters;
+
+	// Process while not cancelled and there are frames
+	while(!isCancelled() && !nextFrame().empty())
+	{
+		// Results of the current frame only (if they are streamed)
+		FaceTracksData oResult;
+
+		// Track the faces in current frame (with the landmarks predicted by
+		// the filters as the initial guesses)
+		{
+			ScopedStageTimer oTimer(profile(), TaskProfile::TrackingStage);
+			QMap<int, LandmarksFilter>::const_iterator it;
+			for(it = mFilters.cbegin(); it != mFilters.cend(); ++it)
+				oTracker.setPrediction(it.key(), it.value().predict(frameIndex()));
+			if(isImageSequence())
+				oTracker.reset();
+			oTracker.track(frame());
+		}
+
+		// Store the landmarks of the faces tracked (smoothed, if requested)
+		QList<int> lFaces = oTracker.faces();
+		foreach(int iFace, lFaces)
+		{
+			QList<QPoint> lLandmarks = oTracker.getLandmarks(iFace);
+			if(m_bSmoothing)
+			{
+				ScopedStageTimer oTimer(profile(), TaskProfile::SmoothingStage);
+				if(!mFilters.contains(iFace))
+					mFilters.insert(iFace, LandmarksFilter(videoFrameRate(), m_iMaxGap));
+				lLandmarks = mFilters[iFace].filter(frameIndex(), lLandmarks);
+			}
+			oData.add(frameIndex(), iFace, lLandmarks, oTracker.getQuality(iFace));
+			if(isStreaming())
+				oResult.add(frameIndex(), iFace, lLandmarks, oTracker.getQuality(iFace));
+			publish(iFace, oTracker.getQuality(iFace), lLandmarks);
+		}
+
+		// Fill the short gaps of the faces lost
+		if(m_bSmoothing)
+		{
+			ScopedStageTimer oTimer(profile(), TaskProfile::SmoothingStage);
+			QMap<int, LandmarksFilter>::iterator it = mFilters.begin();
+			while(it != mFilters.end())
+			{
+				if(lFaces.contains(it.key()))
+				{
+					++it;
+					continue;
+				}
+
+				QList<QPoint> lLandmarks = it.value().filter(frameIndex(), QList<QPoint>());
+				if(lLandmarks.isEmpty())
+					it = mFilters.erase(it);
+				else
+				{
+					oData.add(frameIndex(), it.key(), lLandmarks, 0.0f);
+					if(isStreaming())
+						oResult.add(frameIndex(), it.key(), lLandmarks, 0.0f);
+					publish(it.key(), 0.0f, lLandmarks);
+					++it;
+				}
+			}
+		}
+
+		// Report the landmarks of the frame right away (if requested)
+		if(isStreaming())
+			streamResult(QVariant::fromValue(oResult));
+
+		// Indicate progress
+		updateProgress();
+
+		// Persist the partial results periodically (to allow resuming)
+		if(isCheckpointDue())
+			saveCheckpoint(oData);
+	}
+
+	// End the task accordingly (with cancellation or success)
+	if(isCancelled())
+	{
+		// Keep the work done so far, so it can be resumed later
+		if(isCheckpointEnabled())
+			saveCheckpoint(oData);
+		end(CancelRequested);
+	}
 	else
 		end(QVariant::fromValue(oData));
 }
\ No newline at end of file
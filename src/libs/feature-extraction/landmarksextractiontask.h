@@ -23,6 +23,7 @@
 #include "libexport.h"
 #include "extractiontask.h"
 #include "landmarksdata.h"
+#include "facetracksdata.h"
 #include <QObject>
 #include <QRunnable>
 
@@ -47,6 +48,88 @@ namespace fsdk
 		 */
 		LandmarksExtractionTask(QString sInputFile, float fResetQuality = 0.2f);
 
+		/**
+		 * Sets up the tracking on reduced resolution frames and/or only on a
+		 * region of interest around the face (see ScaledFaceTracker), which
+		 * is much faster on high resolution videos. It must be called before
+		 * the task is started.
+		 * @param dScale Double with the scale factor applied to the frames
+		 * before tracking, in range (0, 1]. The default is 1 (full resolution).
+		 * @param bUseROI Boolean indicating if the tracking should be done
+		 * only on a region around the face (true) or not (false, the default).
+		 */
+		void setTrackingMode(const double dScale, const bool bUseROI);
+
+		/**
+		 * Enables or disables the validation of the reduced resolution/ROI
+		 * tracking against the full resolution tracking. When enabled, every
+		 * frame is also tracked at full resolution (so the task gets slower)
+		 * and the differences between the landmarks are reported at the end
+		 * with an info message.
+		 * @param bEnabled Boolean indicating if the validation is enabled
+		 * (true) or not (false, the default).
+		 */
+		void setValidationEnabled(const bool bEnabled);
+
+		/**
+		 * Sets the face tracker backend used to extract the landmarks (see
+		 * FaceTrackerRegistry). It must be called before the task is started.
+		 * @param sName QString with the name of the backend. If it is empty,
+		 * the default backend is used.
+		 * @return Boolean indicating if the backend is registered (true) or
+		 * not (false, case in which the task keeps its previous backend).
+		 */
+		bool setTrackerBackend(const QString &sName);
+
+		/**
+		 * Enables or disables the temporal smoothing of the landmarks (see
+		 * LandmarksFilter). When enabled, the landmarks stored are smoothed,
+		 * the short gaps where the face is lost are filled with the predicted
+		 * landmarks (keeping the tracking quality of 0 reported by the tracker)
+		 * and the predictions are given to the tracker as an initial guess.
+		 * It must be called before the task is started.
+		 * @param bEnabled Boolean indicating if the smoothing is enabled (true)
+		 * or not (false, the default).
+		 * @param iMaxGap Integer with the maximum number of consecutive frames
+		 * without landmarks that are filled. The default is 5.
+		 */
+		void setSmoothing(const bool bEnabled, const int iMaxGap = 5);
+
+		/**
+		 * Sets up the tracking of several faces per frame (see MultiFaceTracker).
+		 * When more than one face is tracked, the task produces a FaceTracksData
+		 * (instead of a LandmarksData) with the landmarks of each face, the
+		 * tracking mode set with setTrackingMode() is applied to each face (always
+		 * with the ROI) and the tracking validation is not available. It must be
+		 * called before the task is started.
+		 * @param iMaxFaces Integer with the maximum number of faces tracked. The
+		 * default is 1 (i.e. the single face tracking).
+		 * @param sDetectorFile QString with the name of the Haar cascade file used
+		 * to detect the faces. If it is empty, the default cascade is used.
+		 */
+		void setMultiFace(const int iMaxFaces, const QString &sDetectorFile = QString());
+
+		/**
+		 * Enables or disables the gating of the redundant frames (see FrameGate).
+		 * When enabled, the frames whose downsampled gray levels barely changed
+		 * since the last frame tracked are not tracked: the landmarks and quality
+		 * of that frame are reused and the frame is marked as reused in the data.
+		 * The gating is only available in the single face tracking. It must be
+		 * called before the task is started.
+		 * @param bEnabled Boolean indicating if the gating is enabled (true) or
+		 * not (false, the default).
+		 * @param dThreshold Double with the mean absolute difference of the gray
+		 * levels below which a frame is redundant. The default is 2.
+		 * @param iMaxReused Integer with the maximum number of consecutive frames
+		 * reused. The default is 30.
+		 * @param bValidate Boolean indicating if the reused landmarks are validated
+		 * against the tracking (true) or not (false, the default). When validated,
+		 * the reused frames are also tracked (so the task gets no faster) and the
+		 * differences between the landmarks are reported at the end with an info
+		 * message.
+		 */
+		void setGating(const bool bEnabled, const double dThreshold = 2.0, const int iMaxReused = 30, const bool bValidate = false);
+
 	public slots:
 
 		/**
@@ -56,6 +139,14 @@ namespace fsdk
 		 */
 		void run();
 
+	protected:
+
+		/**
+		 * Performs the extraction of the landmarks of several faces per frame
+		 * (called by run() if more than one face is tracked).
+		 */
+		void runMultiFace();
+
 	private:
 
 		/**
@@ -63,6 +154,42 @@ namespace fsdk
 		 * quality gets lower than this value).
 		 */
 		float m_fResetQuality;
+
+		/** Scale factor applied to the frames before tracking. */
+		double m_dTrackingScale;
+
+		/** Indicates if the tracking is done only on a region around the face. */
+		bool m_bTrackingROI;
+
+		/** Indicates if the tracking is validated against the full resolution. */
+		bool m_bValidate;
+
+		/** Name of the face tracker backend used (empty for the default one). */
+		QString m_sTrackerBackend;
+
+		/** Indicates if the landmarks are temporally smoothed. */
+		bool m_bSmoothing;
+
+		/** Maximum number of consecutive frames filled by the smoothing. */
+		int m_iMaxGap;
+
+		/** Maximum number of faces tracked. */
+		int m_iMaxFaces;
+
+		/** Name of the Haar cascade file used to detect the faces (empty for the default one). */
+		QString m_sDetectorFile;
+
+		/** Indicates if the redundant frames are gated. */
+		bool m_bGating;
+
+		/** Change of the gray levels below which a frame is redundant. */
+		double m_dGateThreshold;
+
+		/** Maximum number of consecutive frames reused. */
+		int m_iGateMaxReused;
+
+		/** Indicates if the reused landmarks are validated against the tracking. */
+		bool m_bGateValidate;
 	};
 }
 
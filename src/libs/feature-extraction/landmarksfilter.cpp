@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "landmarksfilter.h"
+#include <QtMath>
+
+// Cutoff frequency (in Hz) of the filter of the velocities
+#define DERIVATIVE_CUTOFF 1.0
+
+// +-----------------------------------------------------------
+fsdk::LandmarksFilter::LandmarksFilter(const double dFrameRate, const int iMaxGap, const double dMinCutoff, const double dBeta)
+{
+	setFrameRate(dFrameRate);
+	m_iMaxGap = qMax(iMaxGap, 0);
+	m_dMinCutoff = qMax(dMinCutoff, 0.001);
+	m_dBeta = qMax(dBeta, 0.0);
+	m_iLastFrame = -1;
+	m_iMissing = 0;
+}
+
+// +-----------------------------------------------------------
+void fsdk::LandmarksFilter::setFrameRate(const double dFrameRate)
+{
+	m_dFrameRate = dFrameRate > 0 ? dFrameRate : 30;
+}
+
+// +-----------------------------------------------------------
+int fsdk::LandmarksFilter::maxGap() const
+{
+	return m_iMaxGap;
+}
+
+// +-----------------------------------------------------------
+double fsdk::LandmarksFilter::smoothingFactor(const double dElapsed, const double dCutoff)
+{
+	double dTau = 1.0 / (2 * M_PI * dCutoff);
+	return 1.0 / (1.0 + dTau / dElapsed);
+}
+
+// +-----------------------------------------------------------
+QList<QPoint> fsdk::LandmarksFilter::filter(const int iFrame, const QList<QPoint> &lLandmarks)
+{
+	// Face not tracked: fill the gap with the prediction while it is short
+	if(lLandmarks.isEmpty())
+	{
+		if(++m_iMissing > m_iMaxGap)
+		{
+			reset();
+			return QList<QPoint>();
+		}
+		return predict(iFrame);
+	}
+	m_iMissing = 0;
+
+	// First frame (or a different number of landmarks): simply take the values
+	int iCount = lLandmarks.count() * 2;
+	if(m_iLastFrame < 0 || iFrame <= m_iLastFrame || m_vValues.count() != iCount)
+	{
+		m_vValues.resize(iCount);
+		m_vVelocities.fill(0.0, iCount);
+		for(int i = 0; i < lLandmarks.count(); i++)
+		{
+			m_vValues[2 * i] = lLandmarks[i].x();
+			m_vValues[2 * i + 1] = lLandmarks[i].y();
+		}
+		m_iLastFrame = iFrame;
+		return lLandmarks;
+	}
+
+	// One-Euro filter of each coordinate
+	double dElapsed = (iFrame - m_iLastFrame) / m_dFrameRate;
+	double dVelocityFactor = smoothingFactor(dElapsed, DERIVATIVE_CUTOFF);
+	double *pValues = m_vValues.data();
+	double *pVelocities = m_vVelocities.data();
+
+	QList<QPoint> lRet;
+	lRet.reserve(lLandmarks.count());
+	for(int i = 0; i < lLandmarks.count(); i++)
+	{
+		double dCoords[2] = { double(lLandmarks[i].x()), double(lLandmarks[i].y()) };
+		for(int j = 0; j < 2; j++)
+		{
+			int k = 2 * i + j;
+			double dVelocity = (dCoords[j] - pValues[k]) / dElapsed;
+			pVelocities[k] += dVelocityFactor * (dVelocity - pVelocities[k]);
+
+			double dFactor = smoothingFactor(dElapsed, m_dMinCutoff + m_dBeta * qAbs(pVelocities[k]));
+			pValues[k] += dFactor * (dCoords[j] - pValues[k]);
+		}
+		lRet.append(QPoint(qRound(pValues[2 * i]), qRound(pValues[2 * i + 1])));
+	}
+
+	m_iLastFrame = iFrame;
+	return lRet;
+}
+
+// +-----------------------------------------------------------
+QList<QPoint> fsdk::LandmarksFilter::predict(const int iFrame) const
+{
+	QList<QPoint> lRet;
+	if(m_iLastFrame < 0 || iFrame <= m_iLastFrame)
+		return lRet;
+
+	// Constant velocity model
+	double dElapsed = (iFrame - m_iLastFrame) / m_dFrameRate;
+	lRet.reserve(m_vValues.count() / 2);
+	for(int i = 0; i < m_vValues.count(); i += 2)
+		lRet.append(QPoint(qRound(m_vValues[i] + m_vVelocities[i] * dElapsed), qRound(m_vValues[i + 1] + m_vVelocities[i + 1] * dElapsed)));
+
+	return lRet;
+}
+
+// +-----------------------------------------------------------
+void fsdk::LandmarksFilter::apply(LandmarksData &oData)
+{
+	reset();
+	foreach(int iFrame, oData.frames())
+	{
+		QList<QPoint> lLandmarks = filter(iFrame, oData.landmarks(iFrame));
+		if(!lLandmarks.isEmpty())
+			oData.add(iFrame, lLandmarks, oData.quality(iFrame));
+	}
+}
+
+// +-----------------------------------------------------------
+void fsdk::LandmarksFilter::reset()
+{
+	m_iLastFrame = -1;
+	m_iMissing = 0;
+	m_vValues.clear();
+	m_vVelocities.clear();
+}
\ No newline at end of file
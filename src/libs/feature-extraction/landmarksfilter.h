@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LANDMARKSFILTER_H
+#define LANDMARKSFILTER_H
+
+#include "libexport.h"
+#include "landmarksdata.h"
+#include <QList>
+#include <QPoint>
+#include <QVector>
+
+namespace fsdk
+{
+	/**
+	 * Temporal filter of the facial landmarks tracked along the frames of a
+	 * video. Each coordinate is smoothed with a One-Euro filter (a low-pass
+	 * filter whose cutoff frequency grows with the speed of the coordinate,
+	 * so the jitter is removed while the face is still and the lag is kept low
+	 * while it moves). The filter also keeps the (smoothed) velocity of the
+	 * coordinates, used to predict the landmarks in the next frames with a
+	 * constant velocity model: the predictions fill the short gaps where the
+	 * tracker loses the face, and they can be given to the tracker as an
+	 * initial guess (see FaceTracker::setPrediction()).
+	 * The frames must be filtered in ascending order (i.e. in streaming mode).
+	 */
+	class SHARED_LIB_EXPORT LandmarksFilter
+	{
+	public:
+
+		/**
+		 * Class constructor.
+		 * @param dFrameRate Double with the frame rate of the video, in frames
+		 * per second (used to convert the frame indexes to time).
+		 * @param iMaxGap Integer with the maximum number of consecutive frames
+		 * (among the frames filtered) without landmarks that are filled with the
+		 * predicted landmarks. The default is 5.
+		 * @param dMinCutoff Double with the minimum cutoff frequency of the
+		 * filter, in Hz (lower values remove more jitter). The default is 1.
+		 * @param dBeta Double with the increase of the cutoff frequency per
+		 * pixel/second of speed (higher values reduce the lag). The default
+		 * is 0.01.
+		 */
+		LandmarksFilter(const double dFrameRate = 30, const int iMaxGap = 5, const double dMinCutoff = 1.0, const double dBeta = 0.01);
+
+		/**
+		 * Sets the frame rate of the video.
+		 * @param dFrameRate Double with the frame rate in frames per second.
+		 */
+		void setFrameRate(const double dFrameRate);
+
+		/**
+		 * Gets the maximum number of consecutive frames without landmarks
+		 * that are filled with the predicted landmarks.
+		 * @return Integer with the maximum gap, in frames.
+		 */
+		int maxGap() const;
+
+		/**
+		 * Filters the landmarks tracked in a frame.
+		 * @param iFrame Integer with the index of the frame (it must be greater
+		 * than the index of the previous frame filtered).
+		 * @param lLandmarks QList of QPoint with the landmarks tracked in the
+		 * frame, or an empty QList if the face was not tracked.
+		 * @return QList of QPoint with the smoothed landmarks, the predicted
+		 * landmarks if the face was not tracked but the gap is still short,
+		 * or an empty QList otherwise (case in which the filter is reset).
+		 */
+		QList<QPoint> filter(const int iFrame, const QList<QPoint> &lLandmarks);
+
+		/**
+		 * Predicts the landmarks in a frame from the current state of the filter
+		 * (i.e. from the last landmarks filtered and their velocity).
+		 * @param iFrame Integer with the index of the frame to predict.
+		 * @return QList of QPoint with the predicted landmarks, or an empty
+		 * QList if there is no prediction (i.e. the filter has no state).
+		 */
+		QList<QPoint> predict(const int iFrame) const;
+
+		/**
+		 * Filters all frames of the given landmarks data (in ascending order of
+		 * the frames), replacing the landmarks by the smoothed ones and filling
+		 * the short gaps. The tracking qualities are not changed.
+		 * @param oData Reference to the LandmarksData to filter.
+		 */
+		void apply(LandmarksData &oData);
+
+		/**
+		 * Resets the filter, discarding its state.
+		 */
+		void reset();
+
+	protected:
+
+		/**
+		 * Calculates the smoothing factor of an exponential filter with the
+		 * given cutoff frequency.
+		 * @param dElapsed Double with the time elapsed since the previous sample,
+		 * in seconds.
+		 * @param dCutoff Double with the cutoff frequency, in Hz.
+		 * @return Double with the smoothing factor in range (0, 1].
+		 */
+		static double smoothingFactor(const double dElapsed, const double dCutoff);
+
+	private:
+
+		/** Frame rate of the video, in frames per second. */
+		double m_dFrameRate;
+
+		/** Maximum number of consecutive frames filled with predictions. */
+		int m_iMaxGap;
+
+		/** Minimum cutoff frequency, in Hz. */
+		double m_dMinCutoff;
+
+		/** Increase of the cutoff frequency per pixel/second of speed. */
+		double m_dBeta;
+
+		/** Index of the last frame with landmarks (-1 if the filter has no state). */
+		int m_iLastFrame;
+
+		/** Number of consecutive frames filtered without landmarks. */
+		int m_iMissing;
+
+		/** Smoothed coordinates (x and y of each landmark, interleaved). */
+		QVector<double> m_vValues;
+
+		/** Smoothed velocities of the coordinates, in pixels per second. */
+		QVector<double> m_vVelocities;
+	};
+}
+
+#endif // LANDMARKSFILTER_H
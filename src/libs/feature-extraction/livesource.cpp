@@ -0,0 +1,262 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "livesource.h"
+#include <QRegularExpression>
+#include <QApplication>
+#include <QDebug>
+
+#ifndef WIN32
+	#include <fcntl.h>
+	#include <poll.h>
+	#include <unistd.h>
+	#include <errno.h>
+#endif
+
+// Default frame rate of the live inputs that do not report it
+#define DEFAULT_FRAME_RATE 30
+
+// Interval of the waits for data in the named pipes, in milliseconds
+#define PIPE_POLL_TIMEOUT 100
+
+// +-----------------------------------------------------------
+fsdk::LiveSource::LiveSource(const QString &sInput, const int iQueueSize, const DropPolicy ePolicy, const int iMaxLatency)
+{
+	m_sInput = sInput;
+	m_eType = sInput.startsWith("pipe:") ? PipeSource : CameraSource;
+	m_dFrameRate = DEFAULT_FRAME_RATE;
+	m_iQueueSize = qMax(iQueueSize, 1);
+	m_ePolicy = ePolicy;
+	m_iMaxLatency = qMax(iMaxLatency, 0);
+	m_iCaptured = 0;
+	m_iDropped = 0;
+}
+
+// +-----------------------------------------------------------
+fsdk::LiveSource::~LiveSource()
+{
+	stop();
+}
+
+// +-----------------------------------------------------------
+bool fsdk::LiveSource::isLiveInput(const QString &sInput)
+{
+	return sInput.startsWith("camera:") || sInput.startsWith("pipe:");
+}
+
+// +-----------------------------------------------------------
+bool fsdk::LiveSource::open()
+{
+	if(m_eType == CameraSource)
+	{
+		bool bValid;
+		int iDevice = m_sInput.mid(QString("camera:").length()).toInt(&bValid);
+		if(!bValid || !m_oCap.open(iDevice))
+			return false;
+
+		double dFrameRate = m_oCap.get(CV_CAP_PROP_FPS);
+		if(dFrameRate > 0)
+			m_dFrameRate = dFrameRate;
+	}
+	else
+	{
+		QRegularExpression oRE("^pipe:([0-9]+)x([0-9]+)(@([0-9]+(\\.[0-9]+)?))?:(.+)$");
+		QRegularExpressionMatch oMatch = oRE.match(m_sInput);
+		if(!oMatch.hasMatch())
+		{
+			qWarning().noquote() << QApplication::translate("LiveSource", "invalid pipe input: %1 (expected pipe:<width>x<height>[@<fps>]:<path>)").arg(m_sInput);
+			return false;
+		}
+
+		m_oPipeFrameSize = cv::Size(oMatch.captured(1).toInt(), oMatch.captured(2).toInt());
+		if(!oMatch.captured(4).isEmpty())
+			m_dFrameRate = oMatch.captured(4).toDouble();
+		if(m_oPipeFrameSize.area() <= 0 || m_dFrameRate <= 0)
+			return false;
+
+#ifdef WIN32
+		m_oPipe.setFileName(oMatch.captured(6));
+		if(!m_oPipe.open(QIODevice::ReadOnly | QIODevice::Unbuffered))
+			return false;
+#else
+		// Open without blocking (a blocking open of a FIFO only returns when a
+		// writer connects, which might never happen)
+		int iFd = ::open(QFile::encodeName(oMatch.captured(6)).constData(), O_RDONLY | O_NONBLOCK);
+		if(iFd < 0)
+			return false;
+		if(!m_oPipe.open(iFd, QIODevice::ReadOnly | QIODevice::Unbuffered, QFileDevice::AutoCloseHandle))
+		{
+			::close(iFd);
+			return false;
+		}
+#endif
+	}
+
+	return true;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::LiveSource::capture(cv::Mat &oFrame)
+{
+	if(m_eType == CameraSource)
+		return m_oCap.read(oFrame) && !oFrame.empty();
+
+	// Read a whole raw frame (a pipe might return less bytes per read)
+	oFrame.create(m_oPipeFrameSize, CV_8UC3);
+	qint64 iSize = static_cast<qint64>(oFrame.total() * oFrame.elemSize());
+	qint64 iRead = 0;
+	while(iRead < iSize)
+	{
+		qint64 iBytes = readPipe(reinterpret_cast<char*>(oFrame.data) + iRead, iSize - iRead);
+		if(iBytes <= 0)
+			return false;
+		iRead += iBytes;
+	}
+	return true;
+}
+
+// +-----------------------------------------------------------
+qint64 fsdk::LiveSource::readPipe(char *pData, const qint64 iSize)
+{
+#ifdef WIN32
+	return m_oPipe.read(pData, iSize);
+#else
+	int iFd = m_oPipe.handle();
+	while(static_cast<int>(m_oStopRequested) == 0)
+	{
+		struct pollfd oPoll;
+		oPoll.fd = iFd;
+		oPoll.events = POLLIN;
+		oPoll.revents = 0;
+
+		// Until a writer connects, the pipe has no events (so it keeps waiting);
+		// after the writer closes it, the read returns 0 (the end of the input)
+		int iRet = poll(&oPoll, 1, PIPE_POLL_TIMEOUT);
+		if(iRet < 0 && errno != EINTR)
+			return -1;
+		if(iRet <= 0)
+			continue;
+
+		ssize_t iBytes = ::read(iFd, pData, static_cast<size_t>(iSize));
+		if(iBytes < 0 && (errno == EAGAIN || errno == EINTR))
+			continue;
+		return static_cast<qint64>(iBytes);
+	}
+	return -1;
+#endif
+}
+
+// +-----------------------------------------------------------
+void fsdk::LiveSource::run()
+{
+	m_oClock.start();
+
+	cv::Mat oFrame;
+	while(static_cast<int>(m_oStopRequested) == 0 && capture(oFrame))
+	{
+		QMutexLocker oLocker(&m_oMutex);
+		int iFrame = m_iCaptured++;
+
+		// Apply the drop policy if the processing is falling behind
+		if(m_qFrames.count() >= m_iQueueSize)
+		{
+			m_iDropped++;
+			if(m_ePolicy == DropNewest)
+				continue;
+
+			m_qFrames.dequeue();
+			m_qIndexes.dequeue();
+			m_qTimes.dequeue();
+		}
+
+		// The frame is cloned because the capture reuses its buffer
+		m_qFrames.enqueue(oFrame.clone());
+		m_qIndexes.enqueue(iFrame);
+		m_qTimes.enqueue(m_oClock.elapsed());
+		m_oFrameQueued.wakeAll();
+	}
+
+	QMutexLocker oLocker(&m_oMutex);
+	m_oFrameQueued.wakeAll();
+}
+
+// +-----------------------------------------------------------
+bool fsdk::LiveSource::read(cv::Mat &oFrame, int &iFrame, const int iTimeout)
+{
+	QMutexLocker oLocker(&m_oMutex);
+	if(m_qFrames.isEmpty() && isRunning())
+		m_oFrameQueued.wait(&m_oMutex, iTimeout);
+	if(m_qFrames.isEmpty())
+		return false;
+
+	// Discard the frames that waited too long (but always keep the newest one)
+	if(m_iMaxLatency > 0)
+	{
+		qint64 iNow = m_oClock.elapsed();
+		while(m_qFrames.count() > 1 && iNow - m_qTimes.head() > m_iMaxLatency)
+		{
+			m_qFrames.dequeue();
+			m_qIndexes.dequeue();
+			m_qTimes.dequeue();
+			m_iDropped++;
+		}
+	}
+
+	oFrame = m_qFrames.dequeue();
+	iFrame = m_qIndexes.dequeue();
+	m_qTimes.dequeue();
+	return true;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::LiveSource::atEnd()
+{
+	QMutexLocker oLocker(&m_oMutex);
+	return !isRunning() && m_qFrames.isEmpty();
+}
+
+// +-----------------------------------------------------------
+void fsdk::LiveSource::stop()
+{
+	// The capture thread checks the request between the frames (and, for the
+	// named pipes, between the waits for data), so it finishes shortly
+	m_oStopRequested.testAndSetOrdered(0, 1);
+	wait();
+	m_oCap.release();
+	m_oPipe.close();
+}
+
+// +-----------------------------------------------------------
+double fsdk::LiveSource::frameRate() const
+{
+	return m_dFrameRate;
+}
+
+// +-----------------------------------------------------------
+int fsdk::LiveSource::capturedFrames()
+{
+	QMutexLocker oLocker(&m_oMutex);
+	return m_iCaptured;
+}
+
+// +-----------------------------------------------------------
+int fsdk::LiveSource::droppedFrames()
+{
+	QMutexLocker oLocker(&m_oMutex);
+	return m_iDropped;
+}
\ No newline at end of file
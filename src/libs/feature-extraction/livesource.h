@@ -0,0 +1,235 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIVESOURCE_H
+#define LIVESOURCE_H
+
+#include "libexport.h"
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QQueue>
+#include <QFile>
+#include <QElapsedTimer>
+#include <QAtomicInt>
+#include <opencv2/opencv.hpp>
+
+namespace fsdk
+{
+	/**
+	 * Live source of frames (a camera or a named pipe with raw frames) read in
+	 * its own thread into a bounded queue, so the capture is never blocked by
+	 * the processing. When the processing falls behind, frames are dropped
+	 * according to the drop policy, and frames older than the maximum latency
+	 * are discarded when read, so the latency of the results stays bounded.
+	 * The inputs are given as:
+	 * - "camera:<index>", for a camera device (a V4L2 device in Linux);
+	 * - "pipe:<width>x<height>[@<fps>]:<path>", for a named pipe (or any file)
+	 *   with raw frames in the BGR24 format (for instance, written by ffmpeg
+	 *   with "-f rawvideo -pix_fmt bgr24").
+	 */
+	class SHARED_LIB_EXPORT LiveSource: public QThread
+	{
+		Q_OBJECT
+	public:
+
+		/**
+		 * Policies to drop frames when the queue is full.
+		 */
+		enum DropPolicy
+		{
+			/** Drops the oldest frame in the queue (i.e. keeps the latency low). */
+			DropOldest,
+
+			/** Drops the new frame captured (i.e. keeps the sequence of the frames queued). */
+			DropNewest
+		};
+
+		/**
+		 * Class constructor.
+		 * @param sInput QString with the live input (see the class documentation).
+		 * @param iQueueSize Integer with the maximum number of frames queued. The
+		 * default is 2.
+		 * @param ePolicy Value of the DropPolicy enumeration with the policy to
+		 * drop frames when the queue is full. The default is DropOldest.
+		 * @param iMaxLatency Integer with the maximum time, in milliseconds, that
+		 * a frame may wait in the queue (0 means no limit). The default is 200.
+		 */
+		LiveSource(const QString &sInput, const int iQueueSize = 2, const DropPolicy ePolicy = DropOldest, const int iMaxLatency = 200);
+
+		/**
+		 * Class destructor.
+		 */
+		virtual ~LiveSource();
+
+		/**
+		 * Queries if the given input is a live input (see the class documentation).
+		 * @param sInput QString with the input.
+		 * @return Boolean indicating if the input is a live input (true) or not (false).
+		 */
+		static bool isLiveInput(const QString &sInput);
+
+		/**
+		 * Opens the live input (opening a named pipe blocks until the writer opens
+		 * it). It must be called before the thread is started.
+		 * @return Boolean indicating if the input was opened (true) or not (false).
+		 */
+		bool open();
+
+		/**
+		 * Reads the oldest frame in the queue (discarding the frames that exceeded
+		 * the maximum latency, as long as there is a newer one), waiting for a frame
+		 * to be captured if the queue is empty.
+		 * @param oFrame Reference to an OpenCV's Mat to receive the frame.
+		 * @param iFrame Reference to an integer to receive the index of the frame
+		 * (the count of frames captured, including the dropped ones).
+		 * @param iTimeout Integer with the maximum time to wait, in milliseconds.
+		 * @return Boolean indicating if a frame was read (true) or not (false, if
+		 * the timeout elapsed or the source ended; see atEnd()).
+		 */
+		bool read(cv::Mat &oFrame, int &iFrame, const int iTimeout);
+
+		/**
+		 * Queries if the source ended (i.e. the capture stopped and all frames
+		 * queued were read).
+		 * @return Boolean indicating if the source ended (true) or not (false).
+		 */
+		bool atEnd();
+
+		/**
+		 * Stops the capture and waits for the thread to finish. The named pipes
+		 * are read without blocking, so the capture stops within a short time
+		 * even if their writer stalls or never connects (except on Windows, where
+		 * it only stops after the next frame is received or the writer closes it).
+		 */
+		void stop();
+
+		/**
+		 * Gets the frame rate of the live input (as reported by the camera or
+		 * given in the input, or 30 if it is not known).
+		 * @return Double with the frame rate in frames per second.
+		 */
+		double frameRate() const;
+
+		/**
+		 * Gets the number of frames captured so far.
+		 * @return Integer with the number of frames captured.
+		 */
+		int capturedFrames();
+
+		/**
+		 * Gets the number of frames dropped so far (due to the queue being full
+		 * or to the maximum latency).
+		 * @return Integer with the number of frames dropped.
+		 */
+		int droppedFrames();
+
+	protected:
+
+		/**
+		 * Captures the frames until the input ends or stop() is called.
+		 */
+		void run();
+
+		/**
+		 * Captures a frame from the input.
+		 * @param oFrame Reference to an OpenCV's Mat to receive the frame.
+		 * @return Boolean indicating if a frame was captured (true) or if the
+		 * input ended (false).
+		 */
+		bool capture(cv::Mat &oFrame);
+
+		/**
+		 * Reads the bytes available in the named pipe, waiting for them in short
+		 * intervals so a request to stop is noticed even if no data arrives.
+		 * @param pData Pointer to the buffer to receive the bytes.
+		 * @param iSize Long integer with the maximum number of bytes to read.
+		 * @return Long integer with the number of bytes read, 0 if the writer
+		 * closed the pipe or -1 if an error happened or the capture was stopped.
+		 */
+		qint64 readPipe(char *pData, const qint64 iSize);
+
+	private:
+
+		/** Types of the live inputs. */
+		enum SourceType
+		{
+			/** Camera device. */
+			CameraSource,
+
+			/** Named pipe with raw frames. */
+			PipeSource
+		};
+
+		/** Live input. */
+		QString m_sInput;
+
+		/** Type of the live input. */
+		SourceType m_eType;
+
+		/** OpenCV's object used to read from the camera. */
+		cv::VideoCapture m_oCap;
+
+		/** Named pipe with the raw frames. */
+		QFile m_oPipe;
+
+		/** Size of the raw frames in the named pipe. */
+		cv::Size m_oPipeFrameSize;
+
+		/** Frame rate of the live input. */
+		double m_dFrameRate;
+
+		/** Maximum number of frames queued. */
+		int m_iQueueSize;
+
+		/** Policy to drop frames when the queue is full. */
+		DropPolicy m_ePolicy;
+
+		/** Maximum time that a frame may wait in the queue, in milliseconds. */
+		int m_iMaxLatency;
+
+		/** Frames queued. */
+		QQueue<cv::Mat> m_qFrames;
+
+		/** Indexes of the frames queued. */
+		QQueue<int> m_qIndexes;
+
+		/** Times when the frames queued were captured, in milliseconds. */
+		QQueue<qint64> m_qTimes;
+
+		/** Mutex that protects the queue and the counters. */
+		QMutex m_oMutex;
+
+		/** Condition signaled when a frame is queued or the capture stops. */
+		QWaitCondition m_oFrameQueued;
+
+		/** Clock of the capture. */
+		QElapsedTimer m_oClock;
+
+		/** Number of frames captured. */
+		int m_iCaptured;
+
+		/** Number of frames dropped. */
+		int m_iDropped;
+
+		/** Indicates if the capture was requested to stop. */
+		QAtomicInt m_oStopRequested;
+	};
+}
+
+#endif // LIVESOURCE_H
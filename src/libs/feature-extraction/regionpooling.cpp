@@ -0,0 +1,324 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "regionpooling.h"
+#include "gaborbank.h"
+#include <opencv2/imgproc/imgproc.hpp>
+#include <cmath>
+#include <QVector2D>
+#include <QApplication>
+#include <QDebug>
+
+using namespace cv;
+
+// Size of the eye regions, in proportion to the width of the eye (corner to corner)
+#define EYE_WIDTH 1.6f
+#define EYE_HEIGHT 1.0f
+
+// Size of the brow regions and their distance above the eye centers, in proportion to the width of the eye
+#define BROW_WIDTH 1.8f
+#define BROW_HEIGHT 0.8f
+#define BROW_OFFSET 0.9f
+
+// Size of the nose region, in proportion to the distance between the inner corners of the eyes
+#define NOSE_SIZE 1.0f
+
+// Size of the mouth region, in proportion to the width of the mouth (corner to corner)
+#define MOUTH_WIDTH 1.4f
+#define MOUTH_HEIGHT 0.8f
+
+// +-----------------------------------------------------------
+fsdk::RegionPooling::RegionPooling()
+{
+	m_eMode = WholeFace;
+	m_iRows = 1;
+	m_iColumns = 1;
+	m_iStatistics = Mean;
+}
+
+// +-----------------------------------------------------------
+void fsdk::RegionPooling::setWholeFace()
+{
+	m_eMode = WholeFace;
+}
+
+// +-----------------------------------------------------------
+void fsdk::RegionPooling::setGrid(const int iRows, const int iColumns)
+{
+	m_eMode = Grid;
+	m_iRows = qMax(iRows, 1);
+	m_iColumns = qMax(iColumns, 1);
+}
+
+// +-----------------------------------------------------------
+bool fsdk::RegionPooling::setFaceParts(const FaceTrackerBackend *pBackend)
+{
+	if(!pBackend)
+		return false;
+
+	QList<FaceTracker::Landmark> lLandmarks;
+	lLandmarks << FaceTracker::LeftEyeInnerCorner << FaceTracker::LeftEyeOuterCorner
+			   << FaceTracker::RightEyeInnerCorner << FaceTracker::RightEyeOuterCorner
+			   << FaceTracker::NoseTip << FaceTracker::MouthLeftCorner << FaceTracker::MouthRightCorner;
+
+	QMap<FaceTracker::Landmark, int> mIndexes;
+	foreach(FaceTracker::Landmark eLandmark, lLandmarks)
+	{
+		int iIndex = pBackend->landmarkIndex(eLandmark);
+		if(iIndex < 0)
+			return false;
+		mIndexes[eLandmark] = iIndex;
+	}
+
+	m_eMode = FaceParts;
+	m_mIndexes = mIndexes;
+	return true;
+}
+
+// +-----------------------------------------------------------
+void fsdk::RegionPooling::setStatistics(const int iStatistics)
+{
+	m_iStatistics = iStatistics & (Mean | StdDev | Max);
+	if(!m_iStatistics)
+		m_iStatistics = Mean;
+}
+
+// +-----------------------------------------------------------
+fsdk::RegionPooling::RegionMode fsdk::RegionPooling::mode() const
+{
+	return m_eMode;
+}
+
+// +-----------------------------------------------------------
+int fsdk::RegionPooling::statistics() const
+{
+	return m_iStatistics;
+}
+
+// +-----------------------------------------------------------
+int fsdk::RegionPooling::regionsCount() const
+{
+	return regionNames().count();
+}
+
+// +-----------------------------------------------------------
+QStringList fsdk::RegionPooling::regionNames() const
+{
+	QStringList lNames;
+	switch(m_eMode)
+	{
+		case Grid:
+			for(int iRow = 0; iRow < m_iRows; iRow++)
+				for(int iColumn = 0; iColumn < m_iColumns; iColumn++)
+					lNames.append(QString("r%1c%2").arg(iRow).arg(iColumn));
+			break;
+
+		case FaceParts:
+			lNames << "leftEye" << "rightEye" << "leftBrow" << "rightBrow" << "nose" << "mouth";
+			break;
+
+		default:
+			lNames << "face";
+			break;
+	}
+	return lNames;
+}
+
+// +-----------------------------------------------------------
+QStringList fsdk::RegionPooling::labels(const QStringList &lKernelLabels) const
+{
+	// Keep the labels of the kernels when there is nothing else to tell apart
+	if(m_eMode == WholeFace && m_iStatistics == Mean)
+		return lKernelLabels;
+
+	QStringList lStatistics;
+	if(m_iStatistics & Mean)
+		lStatistics.append("mean");
+	if(m_iStatistics & StdDev)
+		lStatistics.append("std");
+	if(m_iStatistics & Max)
+		lStatistics.append("max");
+
+	QStringList lRegions = regionNames();
+	QStringList lLabels;
+	foreach(QString sKernel, lKernelLabels)
+		foreach(QString sRegion, lRegions)
+			foreach(QString sStatistic, lStatistics)
+				lLabels.append(QString("%1_%2_%3").arg(sKernel).arg(sRegion).arg(sStatistic));
+	return lLabels;
+}
+
+// +-----------------------------------------------------------
+QList<Rect> fsdk::RegionPooling::regions(const Size &oSize, const QList<QPoint> &lLandmarks) const
+{
+	QList<Rect> lRegions;
+	switch(m_eMode)
+	{
+		case Grid:
+		{
+			// The cells are distributed so their sizes differ at most by one pixel
+			for(int iRow = 0; iRow < m_iRows; iRow++)
+			{
+				int iTop = iRow * oSize.height / m_iRows;
+				int iBottom = (iRow + 1) * oSize.height / m_iRows;
+				for(int iColumn = 0; iColumn < m_iColumns; iColumn++)
+				{
+					int iLeft = iColumn * oSize.width / m_iColumns;
+					int iRight = (iColumn + 1) * oSize.width / m_iColumns;
+					lRegions.append(Rect(iLeft, iTop, iRight - iLeft, iBottom - iTop));
+				}
+			}
+			break;
+		}
+
+		case FaceParts:
+		{
+			// Check if all the semantic landmarks are available
+			bool bAvailable = true;
+			foreach(int iIndex, m_mIndexes)
+				if(iIndex >= lLandmarks.count())
+				{
+					bAvailable = false;
+					break;
+				}
+
+			if(!bAvailable)
+			{
+				for(int i = 0; i < regionsCount(); i++)
+					lRegions.append(Rect());
+				break;
+			}
+
+			QPoint oLeftInner = lLandmarks[m_mIndexes[FaceTracker::LeftEyeInnerCorner]];
+			QPoint oLeftOuter = lLandmarks[m_mIndexes[FaceTracker::LeftEyeOuterCorner]];
+			QPoint oRightInner = lLandmarks[m_mIndexes[FaceTracker::RightEyeInnerCorner]];
+			QPoint oRightOuter = lLandmarks[m_mIndexes[FaceTracker::RightEyeOuterCorner]];
+			QPoint oNose = lLandmarks[m_mIndexes[FaceTracker::NoseTip]];
+			QPoint oMouthLeft = lLandmarks[m_mIndexes[FaceTracker::MouthLeftCorner]];
+			QPoint oMouthRight = lLandmarks[m_mIndexes[FaceTracker::MouthRightCorner]];
+
+			// Eyes
+			QVector2D oLeftEye = QVector2D(oLeftInner + oLeftOuter) / 2;
+			QVector2D oRightEye = QVector2D(oRightInner + oRightOuter) / 2;
+			float fLeftWidth = QVector2D(oLeftOuter - oLeftInner).length();
+			float fRightWidth = QVector2D(oRightOuter - oRightInner).length();
+			lRegions.append(centeredRect(oLeftEye.x(), oLeftEye.y(), fLeftWidth * EYE_WIDTH, fLeftWidth * EYE_HEIGHT, oSize));
+			lRegions.append(centeredRect(oRightEye.x(), oRightEye.y(), fRightWidth * EYE_WIDTH, fRightWidth * EYE_HEIGHT, oSize));
+
+			// Brows (right above the eyes)
+			lRegions.append(centeredRect(oLeftEye.x(), oLeftEye.y() - fLeftWidth * BROW_OFFSET, fLeftWidth * BROW_WIDTH, fLeftWidth * BROW_HEIGHT, oSize));
+			lRegions.append(centeredRect(oRightEye.x(), oRightEye.y() - fRightWidth * BROW_OFFSET, fRightWidth * BROW_WIDTH, fRightWidth * BROW_HEIGHT, oSize));
+
+			// Nose
+			float fEyesDistance = QVector2D(oRightInner - oLeftInner).length();
+			lRegions.append(centeredRect(oNose.x(), oNose.y(), fEyesDistance * NOSE_SIZE, fEyesDistance * NOSE_SIZE, oSize));
+
+			// Mouth
+			QVector2D oMouth = QVector2D(oMouthLeft + oMouthRight) / 2;
+			float fMouthWidth = QVector2D(oMouthRight - oMouthLeft).length();
+			lRegions.append(centeredRect(oMouth.x(), oMouth.y(), fMouthWidth * MOUTH_WIDTH, fMouthWidth * MOUTH_HEIGHT, oSize));
+			break;
+		}
+
+		default:
+			lRegions.append(Rect(0, 0, oSize.width, oSize.height));
+			break;
+	}
+	return lRegions;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::RegionPooling::pool(const Mat &oTensor, const QList<QPoint> &lLandmarks, QList<float> &lValues)
+{
+	if(oTensor.dims != 3 || oTensor.type() != CV_32F)
+	{
+		qWarning().noquote() << QApplication::translate("RegionPooling", "the responses must be given in the planar layout");
+		return false;
+	}
+
+	QList<Rect> lRegions = regions(Size(oTensor.size[2], oTensor.size[1]), lLandmarks);
+	bool bSquares = (m_iStatistics & StdDev) != 0;
+
+	lValues.clear();
+	for(int iKernel = 0; iKernel < oTensor.size[0]; iKernel++)
+	{
+		Mat oPlane = GaborBank::plane(oTensor, iKernel);
+
+		// Single pass over the responses of the kernel (the squares are
+		// only needed for the standard deviation)
+		if(bSquares)
+			integral(oPlane, m_oSum, m_oSqSum, CV_64F);
+		else
+			integral(oPlane, m_oSum, CV_64F);
+
+		foreach(Rect oRegion, lRegions)
+		{
+			if(oRegion.area() <= 0)
+			{
+				if(m_iStatistics & Mean)
+					lValues.append(0.0f);
+				if(m_iStatistics & StdDev)
+					lValues.append(0.0f);
+				if(m_iStatistics & Max)
+					lValues.append(0.0f);
+				continue;
+			}
+
+			double dArea = oRegion.area();
+			double dMean = regionSum(m_oSum, oRegion) / dArea;
+			if(m_iStatistics & Mean)
+				lValues.append(static_cast<float>(dMean));
+
+			if(m_iStatistics & StdDev)
+			{
+				// The variance might get slightly negative due to rounding errors
+				double dVariance = regionSum(m_oSqSum, oRegion) / dArea - dMean * dMean;
+				lValues.append(static_cast<float>(std::sqrt(qMax(dVariance, 0.0))));
+			}
+
+			if(m_iStatistics & Max)
+			{
+				double dMax;
+				minMaxLoc(oPlane(oRegion), NULL, &dMax);
+				lValues.append(static_cast<float>(dMax));
+			}
+		}
+	}
+
+	return true;
+}
+
+// +-----------------------------------------------------------
+double fsdk::RegionPooling::regionSum(const Mat &oIntegral, const Rect &oRegion)
+{
+	int iLeft = oRegion.x;
+	int iTop = oRegion.y;
+	int iRight = oRegion.x + oRegion.width;
+	int iBottom = oRegion.y + oRegion.height;
+
+	return oIntegral.at<double>(iBottom, iRight) - oIntegral.at<double>(iTop, iRight)
+		 - oIntegral.at<double>(iBottom, iLeft) + oIntegral.at<double>(iTop, iLeft);
+}
+
+// +-----------------------------------------------------------
+Rect fsdk::RegionPooling::centeredRect(const float fX, const float fY, const float fWidth, const float fHeight, const Size &oSize)
+{
+	Rect oRect(qRound(fX - fWidth / 2), qRound(fY - fHeight / 2), qRound(fWidth), qRound(fHeight));
+	return oRect & Rect(0, 0, oSize.width, oSize.height);
+}
\ No newline at end of file
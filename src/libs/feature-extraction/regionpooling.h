@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REGIONPOOLING_H
+#define REGIONPOOLING_H
+
+#include "libexport.h"
+#include "facetrackerregistry.h"
+#include <opencv2/core/core.hpp>
+#include <QList>
+#include <QMap>
+#include <QPoint>
+#include <QStringList>
+
+namespace fsdk
+{
+	/**
+	 * Pools the responses of the kernels of a Gabor bank (see GaborBank::filter())
+	 * over regions of the face, producing a compact descriptor per frame with
+	 * statistics of the energy of each kernel in each region. The regions are
+	 * either the whole face crop, the cells of a regular grid over the crop or
+	 * parts of the face (eyes, brows, nose and mouth) located from the facial
+	 * landmarks. The mean and standard deviation of a region are computed from
+	 * the integral images of the responses, so they cost O(1) per region and
+	 * kernel (after a single O(width x height) pass per kernel, regardless of the
+	 * number and size of the regions). The maximum can not be obtained from the
+	 * integral images, so it requires a scan of the region and is optional.
+	 */
+	class SHARED_LIB_EXPORT RegionPooling
+	{
+	public:
+
+		/**
+		 * Modes of definition of the regions.
+		 */
+		enum RegionMode
+		{
+			/** A single region with the whole face crop. */
+			WholeFace,
+
+			/** The cells of a regular grid over the face crop. */
+			Grid,
+
+			/** The parts of the face, located from the facial landmarks. */
+			FaceParts
+		};
+
+		/**
+		 * Statistics of the energy computed in each region (they can be combined).
+		 */
+		enum Statistic
+		{
+			/** Mean energy in the region (O(1) from the integral images). */
+			Mean = 0x01,
+
+			/** Standard deviation of the energy in the region (O(1) from the integral images). */
+			StdDev = 0x02,
+
+			/** Maximum energy in the region (requires a scan of the region). */
+			Max = 0x04
+		};
+
+		/**
+		 * Class constructor. Creates a pooling with the whole face as the
+		 * single region and only the mean as statistic (i.e. the mean energy
+		 * of each kernel).
+		 */
+		RegionPooling();
+
+		/**
+		 * Uses the whole face crop as the single region.
+		 */
+		void setWholeFace();
+
+		/**
+		 * Uses the cells of a regular grid over the face crop as the regions.
+		 * @param iRows Integer with the number of rows of the grid.
+		 * @param iColumns Integer with the number of columns of the grid.
+		 */
+		void setGrid(const int iRows, const int iColumns);
+
+		/**
+		 * Uses the parts of the face (left eye, right eye, left brow, right brow,
+		 * nose and mouth) as the regions. The parts are rectangles placed around
+		 * the semantic landmarks of the face tracker backend (the brows are placed
+		 * right above the eyes).
+		 * @param pBackend Instance of the FaceTrackerBackend that produced the
+		 * landmarks (used to get the indexes of the semantic landmarks).
+		 * @return Boolean indicating if the backend provides all the semantic
+		 * landmarks required (true) or not (false, case in which the regions are
+		 * not changed).
+		 */
+		bool setFaceParts(const FaceTrackerBackend *pBackend);
+
+		/**
+		 * Sets the statistics computed in each region.
+		 * @param iStatistics Integer with a combination (OR) of values of the
+		 * Statistic enumeration. It must include at least one statistic.
+		 */
+		void setStatistics(const int iStatistics);
+
+		/**
+		 * Gets the mode of definition of the regions.
+		 * @return Value of the RegionMode enumeration.
+		 */
+		RegionMode mode() const;
+
+		/**
+		 * Gets the statistics computed in each region.
+		 * @return Integer with a combination of values of the Statistic enumeration.
+		 */
+		int statistics() const;
+
+		/**
+		 * Gets the number of regions.
+		 * @return Integer with the number of regions.
+		 */
+		int regionsCount() const;
+
+		/**
+		 * Gets the names of the regions (for instance, "r0c1" for the cell in the
+		 * first row and second column of the grid, or "mouth").
+		 * @return QStringList with the names of the regions, in the order in which
+		 * they are pooled.
+		 */
+		QStringList regionNames() const;
+
+		/**
+		 * Builds the labels of the values pooled (see pool()), from the labels of
+		 * the kernels. With the whole face and the mean only the labels are the
+		 * labels of the kernels; otherwise each label is composed by the label of
+		 * the kernel, the name of the region and the name of the statistic (for
+		 * instance, "w3_o0_mouth_std").
+		 * @param lKernelLabels QStringList with the labels of the kernels, in the
+		 * order of their IDs in the bank.
+		 * @return QStringList with the labels of the values pooled.
+		 */
+		QStringList labels(const QStringList &lKernelLabels) const;
+
+		/**
+		 * Computes the regions in a face crop.
+		 * @param oSize OpenCV's Size with the size of the face crop.
+		 * @param lLandmarks QList of QPoint with the facial landmarks in the
+		 * coordinates of the face crop (used only with the parts of the face).
+		 * @return QList of OpenCV's Rect with the regions, clipped to the crop.
+		 * A region that can not be located (for instance, if the landmarks are
+		 * missing) is empty.
+		 */
+		QList<cv::Rect> regions(const cv::Size &oSize, const QList<QPoint> &lLandmarks) const;
+
+		/**
+		 * Pools the responses of the kernels over the regions. The values are
+		 * ordered by kernel, then by region and then by statistic (in the order
+		 * of the Statistic enumeration), and the values of the empty regions are 0.
+		 * @param oTensor OpenCV's Mat with the responses of all kernels in the
+		 * planar layout (see GaborBank::TensorLayout).
+		 * @param lLandmarks QList of QPoint with the facial landmarks in the
+		 * coordinates of the face crop (used only with the parts of the face).
+		 * @param lValues Reference to a QList of float to receive the values pooled.
+		 * @return Boolean indicating if the pooling was successful (true) or not
+		 * (false, if the tensor is not in the planar layout).
+		 */
+		bool pool(const cv::Mat &oTensor, const QList<QPoint> &lLandmarks, QList<float> &lValues);
+
+	protected:
+
+		/**
+		 * Sums the values of an integral image inside a region.
+		 * @param oIntegral OpenCV's Mat with the integral image (CV_64F, with
+		 * one row and one column more than the image).
+		 * @param oRegion OpenCV's Rect with the region in the image.
+		 * @return Double with the sum of the values inside the region.
+		 */
+		static double regionSum(const cv::Mat &oIntegral, const cv::Rect &oRegion);
+
+		/**
+		 * Computes a rectangle centered at a point and clipped to the face crop.
+		 * @param fX Float with the horizontal coordinate of the center.
+		 * @param fY Float with the vertical coordinate of the center.
+		 * @param fWidth Float with the width of the rectangle.
+		 * @param fHeight Float with the height of the rectangle.
+		 * @param oSize OpenCV's Size with the size of the face crop.
+		 * @return OpenCV's Rect with the rectangle clipped.
+		 */
+		static cv::Rect centeredRect(const float fX, const float fY, const float fWidth, const float fHeight, const cv::Size &oSize);
+
+	private:
+
+		/** Mode of definition of the regions. */
+		RegionMode m_eMode;
+
+		/** Number of rows of the grid. */
+		int m_iRows;
+
+		/** Number of columns of the grid. */
+		int m_iColumns;
+
+		/**
+		 * Indexes of the semantic landmarks used to locate the parts of the face
+		 * (semantic landmark x index in the landmarks of the backend).
+		 */
+		QMap<FaceTracker::Landmark, int> m_mIndexes;
+
+		/** Statistics computed in each region. */
+		int m_iStatistics;
+
+		/** Buffer with the integral image of the responses (reused between the frames). */
+		cv::Mat m_oSum;
+
+		/** Buffer with the integral image of the squared responses (reused between the frames). */
+		cv::Mat m_oSqSum;
+	};
+}
+
+#endif // REGIONPOOLING_H
@@ -0,0 +1,361 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "signalpyramid.h"
+#include <QApplication>
+#include <QFile>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QDebug>
+#include <qmath.h>
+#include <limits>
+
+// Number of entries of a level summarized by each entry of the level above
+#define PYRAMID_FANOUT 4
+
+// Identification and version of the pyramid files
+#define PYRAMID_MAGIC 0x46535059
+#define PYRAMID_VERSION 1
+
+// +-----------------------------------------------------------
+fsdk::SignalSummary::SignalSummary()
+{
+	m_fMin = 0;
+	m_fMax = 0;
+	m_dSum = 0;
+	m_iCount = 0;
+}
+
+// +-----------------------------------------------------------
+fsdk::SignalSummary::SignalSummary(const float fValue)
+{
+	m_fMin = fValue;
+	m_fMax = fValue;
+	m_dSum = fValue;
+	m_iCount = 1;
+}
+
+// +-----------------------------------------------------------
+void fsdk::SignalSummary::merge(const SignalSummary &oOther)
+{
+	if(oOther.m_iCount == 0)
+		return;
+
+	if(m_iCount == 0)
+	{
+		*this = oOther;
+		return;
+	}
+
+	m_fMin = qMin(m_fMin, oOther.m_fMin);
+	m_fMax = qMax(m_fMax, oOther.m_fMax);
+	m_dSum += oOther.m_dSum;
+	m_iCount += oOther.m_iCount;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::SignalSummary::isEmpty() const
+{
+	return m_iCount == 0;
+}
+
+// +-----------------------------------------------------------
+uint fsdk::SignalSummary::count() const
+{
+	return m_iCount;
+}
+
+// +-----------------------------------------------------------
+float fsdk::SignalSummary::minimum() const
+{
+	return m_fMin;
+}
+
+// +-----------------------------------------------------------
+float fsdk::SignalSummary::maximum() const
+{
+	return m_fMax;
+}
+
+// +-----------------------------------------------------------
+double fsdk::SignalSummary::sum() const
+{
+	return m_dSum;
+}
+
+// +-----------------------------------------------------------
+double fsdk::SignalSummary::mean() const
+{
+	return m_iCount == 0 ? 0 : m_dSum / m_iCount;
+}
+
+// +-----------------------------------------------------------
+fsdk::SignalPyramid::SignalPyramid(const int iSignals)
+{
+	reset(iSignals);
+}
+
+// +-----------------------------------------------------------
+void fsdk::SignalPyramid::reset(const int iSignals)
+{
+	m_iSignals = qMax(iSignals, 0);
+	m_vValues.clear();
+	m_lLevels.clear();
+	if(m_lLabels.size() != m_iSignals)
+		m_lLabels.clear();
+}
+
+// +-----------------------------------------------------------
+int fsdk::SignalPyramid::signalsCount() const
+{
+	return m_iSignals;
+}
+
+// +-----------------------------------------------------------
+int fsdk::SignalPyramid::framesCount() const
+{
+	return m_iSignals == 0 ? 0 : m_vValues.size() / m_iSignals;
+}
+
+// +-----------------------------------------------------------
+int fsdk::SignalPyramid::levelsCount() const
+{
+	return m_lLevels.size() + 1;
+}
+
+// +-----------------------------------------------------------
+QStringList fsdk::SignalPyramid::labels() const
+{
+	return m_lLabels;
+}
+
+// +-----------------------------------------------------------
+void fsdk::SignalPyramid::setLabels(const QStringList &lLabels)
+{
+	m_lLabels = lLabels;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::SignalPyramid::append(const int iFrame, const QList<float> &lValues)
+{
+	int iFrames = framesCount();
+	if(m_iSignals == 0 || iFrame < iFrames)
+		return false;
+
+	// Skipped frames are stored as NaN so they do not count in the summaries
+	const float fNaN = std::numeric_limits<float>::quiet_NaN();
+	QList<float> lEmpty;
+	for(int i = 0; i < m_iSignals; i++)
+		lEmpty.append(fNaN);
+
+	for(int iCur = iFrames; iCur <= iFrame; iCur++)
+	{
+		const QList<float> &lCur = iCur == iFrame ? lValues : lEmpty;
+		for(int i = 0; i < m_iSignals; i++)
+			m_vValues.append(i < lCur.size() ? lCur[i] : 0);
+
+		// Build the entries of the upper levels whose groups have just been completed
+		int iEntries = iCur + 1;
+		for(int iLevel = 0; iEntries % PYRAMID_FANOUT == 0; iLevel++)
+		{
+			if(iLevel == m_lLevels.size())
+				m_lLevels.append(QVector<SignalSummary>());
+
+			int iFirst = iEntries - PYRAMID_FANOUT;
+			for(int i = 0; i < m_iSignals; i++)
+			{
+				SignalSummary oSummary;
+				for(int j = iFirst; j < iEntries; j++)
+					oSummary.merge(entry(iLevel, j, i));
+				m_lLevels[iLevel].append(oSummary);
+			}
+
+			iEntries = m_lLevels[iLevel].size() / m_iSignals;
+		}
+	}
+
+	return true;
+}
+
+// +-----------------------------------------------------------
+fsdk::SignalSummary fsdk::SignalPyramid::entry(const int iLevel, const int iEntry, const int iSignal) const
+{
+	if(iLevel == 0)
+	{
+		float fValue = m_vValues[iEntry * m_iSignals + iSignal];
+		return qIsNaN(fValue) ? SignalSummary() : SignalSummary(fValue);
+	}
+	else
+		return m_lLevels[iLevel - 1][iEntry * m_iSignals + iSignal];
+}
+
+// +-----------------------------------------------------------
+fsdk::SignalSummary fsdk::SignalPyramid::summary(const int iSignal, int iFirstFrame, int iLastFrame) const
+{
+	SignalSummary oRet;
+	if(iSignal < 0 || iSignal >= m_iSignals)
+		return oRet;
+
+	iFirstFrame = qMax(iFirstFrame, 0);
+	iLastFrame = qMin(iLastFrame, framesCount() - 1);
+
+	// Ascend the levels consuming the entries at the borders of the range that
+	// are not aligned with the groups of the level above. Since the groups are
+	// summarized as soon as they are completed, the aligned part of the range
+	// is always available in the level above.
+	int iFirst = iFirstFrame;
+	int iLast = iLastFrame;
+	for(int iLevel = 0; iFirst <= iLast; iLevel++)
+	{
+		bool bTop = iLevel == m_lLevels.size();
+		while(iFirst <= iLast && (bTop || iFirst % PYRAMID_FANOUT != 0))
+			oRet.merge(entry(iLevel, iFirst++, iSignal));
+		while(iFirst <= iLast && (iLast + 1) % PYRAMID_FANOUT != 0)
+			oRet.merge(entry(iLevel, iLast--, iSignal));
+
+		iFirst /= PYRAMID_FANOUT;
+		iLast = (iLast + 1) / PYRAMID_FANOUT - 1;
+	}
+
+	return oRet;
+}
+
+// +-----------------------------------------------------------
+QList<fsdk::SignalSummary> fsdk::SignalPyramid::summaries(const int iSignal, const int iFirstFrame, const int iLastFrame, const int iBins) const
+{
+	QList<SignalSummary> lRet;
+	if(iBins <= 0 || iLastFrame < iFirstFrame)
+		return lRet;
+
+	double dWidth = double(iLastFrame - iFirstFrame + 1) / iBins;
+	for(int i = 0; i < iBins; i++)
+	{
+		int iFirst = iFirstFrame + qCeil(i * dWidth);
+		int iLast = iFirstFrame + qCeil((i + 1) * dWidth) - 1;
+		lRet.append(summary(iSignal, iFirst, qMin(iLast, iLastFrame)));
+	}
+
+	return lRet;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::SignalPyramid::save(const QString &sFilename) const
+{
+	QSaveFile oFile(sFilename);
+	if(!oFile.open(QIODevice::WriteOnly))
+	{
+		qWarning().noquote() << QApplication::translate("SignalPyramid", "error opening file %1 for writing").arg(sFilename);
+		return false;
+	}
+
+	QDataStream oStream(&oFile);
+	oStream.setVersion(QDataStream::Qt_5_0);
+	oStream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+	oStream << quint32(PYRAMID_MAGIC) << quint32(PYRAMID_VERSION) << quint32(PYRAMID_FANOUT);
+	oStream << qint32(m_iSignals) << m_lLabels << m_vValues;
+
+	oStream << qint32(m_lLevels.size());
+	foreach(const QVector<SignalSummary> &vLevel, m_lLevels)
+	{
+		oStream << qint32(vLevel.size());
+		foreach(const SignalSummary &oSummary, vLevel)
+		{
+			oStream << oSummary.m_fMin << oSummary.m_fMax << quint32(oSummary.m_iCount);
+			oStream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+			oStream << oSummary.m_dSum;
+			oStream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+		}
+	}
+
+	if(oStream.status() != QDataStream::Ok || !oFile.commit())
+	{
+		qWarning().noquote() << QApplication::translate("SignalPyramid", "error writing to file %1").arg(sFilename);
+		return false;
+	}
+
+	return true;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::SignalPyramid::load(const QString &sFilename)
+{
+	QFile oFile(sFilename);
+	if(!oFile.open(QIODevice::ReadOnly))
+	{
+		qWarning().noquote() << QApplication::translate("SignalPyramid", "error opening file %1 for reading").arg(sFilename);
+		return false;
+	}
+
+	QDataStream oStream(&oFile);
+	oStream.setVersion(QDataStream::Qt_5_0);
+	oStream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+	quint32 iMagic, iVersion, iFanout;
+	oStream >> iMagic >> iVersion >> iFanout;
+	if(iMagic != PYRAMID_MAGIC || iVersion != PYRAMID_VERSION || iFanout != PYRAMID_FANOUT)
+	{
+		qWarning().noquote() << QApplication::translate("SignalPyramid", "the file %1 does not contain a valid signal pyramid").arg(sFilename);
+		return false;
+	}
+
+	qint32 iSignals, iLevels;
+	QStringList lLabels;
+	QVector<float> vValues;
+	QList<QVector<SignalSummary>> lLevels;
+
+	oStream >> iSignals >> lLabels >> vValues >> iLevels;
+	for(int i = 0; i < iLevels && oStream.status() == QDataStream::Ok; i++)
+	{
+		qint32 iSize;
+		oStream >> iSize;
+
+		QVector<SignalSummary> vLevel;
+		for(int j = 0; j < iSize && oStream.status() == QDataStream::Ok; j++)
+		{
+			SignalSummary oSummary;
+			quint32 iCount;
+			oStream >> oSummary.m_fMin >> oSummary.m_fMax >> iCount;
+			oStream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+			oStream >> oSummary.m_dSum;
+			oStream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+			oSummary.m_iCount = iCount;
+			vLevel.append(oSummary);
+		}
+		lLevels.append(vLevel);
+	}
+
+	if(oStream.status() != QDataStream::Ok || iSignals <= 0 || vValues.size() % iSignals != 0)
+	{
+		qWarning().noquote() << QApplication::translate("SignalPyramid", "error reading the signal pyramid from file %1").arg(sFilename);
+		return false;
+	}
+
+	m_iSignals = iSignals;
+	m_lLabels = lLabels;
+	m_vValues = vValues;
+	m_lLevels = lLevels;
+	return true;
+}
+
+// +-----------------------------------------------------------
+QString fsdk::SignalPyramid::fileName(const QString &sDataFilename)
+{
+	return sDataFilename + ".pyr";
+}
@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SIGNALPYRAMID_H
+#define SIGNALPYRAMID_H
+
+#include "libexport.h"
+#include <QVector>
+#include <QList>
+#include <QStringList>
+
+namespace fsdk
+{
+	/**
+	 * Summary (minimum, maximum, mean and number of values) of a signal
+	 * over a range of frames.
+	 */
+	class SHARED_LIB_EXPORT SignalSummary
+	{
+	public:
+		/**
+		 * Class constructor. Creates an empty summary.
+		 */
+		SignalSummary();
+
+		/**
+		 * Class constructor. Creates the summary of a single value.
+		 * @param fValue Float with the value.
+		 */
+		SignalSummary(const float fValue);
+
+		/**
+		 * Merges another summary into this one.
+		 * @param oOther Const reference to the other SignalSummary.
+		 */
+		void merge(const SignalSummary &oOther);
+
+		/**
+		 * Indicates if the summary is empty (i.e. it has no values).
+		 * @return Boolean indicating if the summary is empty (true) or not (false).
+		 */
+		bool isEmpty() const;
+
+		/**
+		 * Gets the number of values summarized.
+		 * @return Unsigned integer with the number of values.
+		 */
+		uint count() const;
+
+		/**
+		 * Gets the minimum value (or 0 if the summary is empty).
+		 * @return Float with the minimum value.
+		 */
+		float minimum() const;
+
+		/**
+		 * Gets the maximum value (or 0 if the summary is empty).
+		 * @return Float with the maximum value.
+		 */
+		float maximum() const;
+
+		/**
+		 * Gets the sum of the values.
+		 * @return Double with the sum of the values.
+		 */
+		double sum() const;
+
+		/**
+		 * Gets the mean value (or 0 if the summary is empty).
+		 * @return Double with the mean value.
+		 */
+		double mean() const;
+
+	private:
+
+		/** Minimum value. */
+		float m_fMin;
+
+		/** Maximum value. */
+		float m_fMax;
+
+		/** Sum of the values. */
+		double m_dSum;
+
+		/** Number of values. */
+		uint m_iCount;
+
+		friend class SignalPyramid;
+	};
+
+	/**
+	 * Multi-resolution summary of per-frame signals (for instance, the tracking
+	 * quality or the Gabor energies along a video). Each level of the pyramid
+	 * summarizes groups of PYRAMID_FANOUT entries of the level below, so the
+	 * summary of any range of frames is obtained in O(log n) instead of O(n).
+	 * The pyramid is built incrementally as the frames are appended, and it
+	 * can be stored in a file next to the data file (see fileName()).
+	 */
+	class SHARED_LIB_EXPORT SignalPyramid
+	{
+	public:
+		/**
+		 * Class constructor.
+		 * @param iSignals Integer with the number of signals summarized.
+		 */
+		SignalPyramid(const int iSignals = 0);
+
+		/**
+		 * Removes all frames and sets the number of signals summarized.
+		 * @param iSignals Integer with the number of signals summarized.
+		 */
+		void reset(const int iSignals);
+
+		/**
+		 * Gets the number of signals summarized.
+		 * @return Integer with the number of signals.
+		 */
+		int signalsCount() const;
+
+		/**
+		 * Gets the number of frames summarized (i.e. the index of the last
+		 * frame appended plus one).
+		 * @return Integer with the number of frames.
+		 */
+		int framesCount() const;
+
+		/**
+		 * Gets the number of levels in the pyramid (the first level holds
+		 * the values of each frame).
+		 * @return Integer with the number of levels.
+		 */
+		int levelsCount() const;
+
+		/**
+		 * Gets the labels of the signals.
+		 * @return QStringList with the labels of the signals.
+		 */
+		QStringList labels() const;
+
+		/**
+		 * Sets the labels of the signals.
+		 * @param lLabels QStringList with the labels of the signals.
+		 */
+		void setLabels(const QStringList &lLabels);
+
+		/**
+		 * Appends the values of the signals in a frame. The frames must be
+		 * appended in ascending order; skipped frames are considered without
+		 * values (i.e. they are not included in the summaries).
+		 * @param iFrame Integer with the index of the frame.
+		 * @param lValues QList of float values with the values of each signal
+		 * (missing values are considered 0).
+		 * @return Boolean indicating if the frame was appended (true) or not
+		 * (false, if the frame is before the last frame appended).
+		 */
+		bool append(const int iFrame, const QList<float> &lValues);
+
+		/**
+		 * Gets the summary of a signal in a range of frames.
+		 * @param iSignal Integer with the index of the signal.
+		 * @param iFirstFrame Integer with the first frame of the range.
+		 * @param iLastFrame Integer with the last frame of the range (inclusive).
+		 * @return SignalSummary with the summary of the signal in the range
+		 * (empty if there are no values in the range).
+		 */
+		SignalSummary summary(const int iSignal, int iFirstFrame, int iLastFrame) const;
+
+		/**
+		 * Gets the summaries of a signal in consecutive bins of a range of frames
+		 * (useful to plot zoomed-out views of the signal).
+		 * @param iSignal Integer with the index of the signal.
+		 * @param iFirstFrame Integer with the first frame of the range.
+		 * @param iLastFrame Integer with the last frame of the range (inclusive).
+		 * @param iBins Integer with the number of bins to split the range into.
+		 * @return QList of SignalSummary with the summary of each bin.
+		 */
+		QList<SignalSummary> summaries(const int iSignal, const int iFirstFrame, const int iLastFrame, const int iBins) const;
+
+		/**
+		 * Saves the pyramid to the given file.
+		 * @param sFilename QString with the name of the file.
+		 * @return Boolean indicating if the saving was succesful
+		 * (true) or not (false).
+		 */
+		bool save(const QString &sFilename) const;
+
+		/**
+		 * Loads the pyramid from the given file.
+		 * @param sFilename QString with the name of the file.
+		 * @return Boolean indicating if the loading was succesful
+		 * (true) or not (false).
+		 */
+		bool load(const QString &sFilename);
+
+		/**
+		 * Gets the name of the file used to store the pyramid of a data file.
+		 * @param sDataFilename QString with the name of the data (CSV) file.
+		 * @return QString with the name of the pyramid file.
+		 */
+		static QString fileName(const QString &sDataFilename);
+
+	protected:
+
+		/**
+		 * Gets the summary of an entry of a level.
+		 * @param iLevel Integer with the level.
+		 * @param iEntry Integer with the index of the entry in the level.
+		 * @param iSignal Integer with the index of the signal.
+		 * @return SignalSummary with the summary of the entry.
+		 */
+		SignalSummary entry(const int iLevel, const int iEntry, const int iSignal) const;
+
+	private:
+
+		/** Number of signals summarized. */
+		int m_iSignals;
+
+		/** Labels of the signals. */
+		QStringList m_lLabels;
+
+		/** Values of each frame (NaN for frames without values), in frame-major order. */
+		QVector<float> m_vValues;
+
+		/** Summaries of the upper levels, in entry-major order. */
+		QList<QVector<SignalSummary>> m_lLevels;
+	};
+}
+
+#endif // SIGNALPYRAMID_H
@@ -0,0 +1,272 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "taskprofile.h"
+#include <QApplication>
+#include <QJsonArray>
+#include <QStringList>
+#include <QtMath>
+#include <cmath>
+#include <limits>
+
+// Number of buckets of the latency histograms per power of two
+#define BUCKETS_PER_OCTAVE 4
+
+// Number of buckets of the latency histograms (they cover times up to
+// 2^40 ns, i.e. about 18 minutes)
+#define BUCKETS_COUNT (40 * BUCKETS_PER_OCTAVE)
+
+// +-----------------------------------------------------------
+fsdk::TaskProfile::TaskProfile(const bool bEnabled)
+{
+	qRegisterMetaType<fsdk::TaskProfile>("fsdk::TaskProfile");
+	m_bEnabled = bEnabled;
+	m_iFrames = 0;
+	m_iElapsed = 0;
+	m_vCounts.fill(0, StagesCount);
+	m_vTotals.fill(0, StagesCount);
+	m_vMinimums.fill(std::numeric_limits<qint64>::max(), StagesCount);
+	m_vMaximums.fill(0, StagesCount);
+	m_vHistograms.fill(0, StagesCount * BUCKETS_COUNT);
+}
+
+// +-----------------------------------------------------------
+bool fsdk::TaskProfile::isEnabled() const
+{
+	return m_bEnabled;
+}
+
+// +-----------------------------------------------------------
+void fsdk::TaskProfile::setEnabled(const bool bEnabled)
+{
+	m_bEnabled = bEnabled;
+}
+
+// +-----------------------------------------------------------
+void fsdk::TaskProfile::add(const Stage eStage, const qint64 iNanoseconds)
+{
+	if(!m_bEnabled)
+		return;
+
+	m_vCounts[eStage]++;
+	m_vTotals[eStage] += iNanoseconds;
+	m_vMinimums[eStage] = qMin(m_vMinimums[eStage], iNanoseconds);
+	m_vMaximums[eStage] = qMax(m_vMaximums[eStage], iNanoseconds);
+
+	int iBucket = iNanoseconds <= 1 ? 0 : int(std::log2(double(iNanoseconds)) * BUCKETS_PER_OCTAVE);
+	m_vHistograms[eStage * BUCKETS_COUNT + qMin(iBucket, BUCKETS_COUNT - 1)]++;
+}
+
+// +-----------------------------------------------------------
+void fsdk::TaskProfile::addFrames(const int iFrames)
+{
+	if(m_bEnabled)
+		m_iFrames += iFrames;
+}
+
+// +-----------------------------------------------------------
+void fsdk::TaskProfile::addElapsed(const qint64 iNanoseconds)
+{
+	if(m_bEnabled)
+		m_iElapsed += iNanoseconds;
+}
+
+// +-----------------------------------------------------------
+void fsdk::TaskProfile::merge(const TaskProfile &oOther)
+{
+	m_iFrames += oOther.m_iFrames;
+	m_iElapsed += oOther.m_iElapsed;
+	for(int i = 0; i < StagesCount; i++)
+	{
+		m_vCounts[i] += oOther.m_vCounts[i];
+		m_vTotals[i] += oOther.m_vTotals[i];
+		m_vMinimums[i] = qMin(m_vMinimums[i], oOther.m_vMinimums[i]);
+		m_vMaximums[i] = qMax(m_vMaximums[i], oOther.m_vMaximums[i]);
+	}
+	for(int i = 0; i < m_vHistograms.count(); i++)
+		m_vHistograms[i] += oOther.m_vHistograms[i];
+}
+
+// +-----------------------------------------------------------
+qint64 fsdk::TaskProfile::frames() const
+{
+	return m_iFrames;
+}
+
+// +-----------------------------------------------------------
+qint64 fsdk::TaskProfile::count(const Stage eStage) const
+{
+	return m_vCounts[eStage];
+}
+
+// +-----------------------------------------------------------
+qint64 fsdk::TaskProfile::total(const Stage eStage) const
+{
+	return m_vTotals[eStage];
+}
+
+// +-----------------------------------------------------------
+double fsdk::TaskProfile::percentile(const Stage eStage, const double dPercentile) const
+{
+	qint64 iCount = m_vCounts[eStage];
+	if(iCount == 0)
+		return 0;
+
+	// Find the bucket of the percentile and use its geometric center
+	// (limited to the times actually observed)
+	qint64 iRank = qMax(qint64(qCeil(iCount * qBound(0.0, dPercentile, 100.0) / 100.0)), qint64(1));
+	qint64 iSum = 0;
+	int iBucket = 0;
+	for(; iBucket < BUCKETS_COUNT - 1; iBucket++)
+	{
+		iSum += m_vHistograms[eStage * BUCKETS_COUNT + iBucket];
+		if(iSum >= iRank)
+			break;
+	}
+
+	double dValue = qPow(2, (iBucket + 0.5) / BUCKETS_PER_OCTAVE);
+	return qBound(double(m_vMinimums[eStage]), dValue, double(m_vMaximums[eStage]));
+}
+
+// +-----------------------------------------------------------
+QString fsdk::TaskProfile::stageName(const Stage eStage)
+{
+	switch(eStage)
+	{
+		case DecodeStage:
+			return "decode";
+		case TrackingStage:
+			return "tracking";
+		case ResetStage:
+			return "reset";
+		case CropStage:
+			return "crop";
+		case FilteringStage:
+			return "filtering";
+		case LoadingStage:
+			return "loading";
+		case SerializationStage:
+			return "serialization";
+		case SmoothingStage:
+			return "smoothing";
+		default:
+			return "unknown";
+	}
+}
+
+// +-----------------------------------------------------------
+QJsonObject fsdk::TaskProfile::toJson() const
+{
+	QJsonObject oRet;
+	oRet["frames"] = double(m_iFrames);
+	oRet["elapsed_ms"] = m_iElapsed / 1e6;
+	oRet["frames_per_second"] = m_iElapsed > 0 ? m_iFrames * 1e9 / m_iElapsed : 0.0;
+
+	QJsonObject oStages;
+	for(int i = 0; i < StagesCount; i++)
+	{
+		Stage eStage = static_cast<Stage>(i);
+		if(m_vCounts[i] == 0)
+			continue;
+
+		QJsonObject oStage;
+		oStage["count"] = double(m_vCounts[i]);
+		oStage["total_ms"] = m_vTotals[i] / 1e6;
+		oStage["mean_us"] = m_vTotals[i] / 1e3 / m_vCounts[i];
+		oStage["min_us"] = m_vMinimums[i] / 1e3;
+		oStage["p50_us"] = percentile(eStage, 50) / 1e3;
+		oStage["p90_us"] = percentile(eStage, 90) / 1e3;
+		oStage["p99_us"] = percentile(eStage, 99) / 1e3;
+		oStage["max_us"] = m_vMaximums[i] / 1e3;
+		oStage["per_second"] = m_vTotals[i] > 0 ? m_vCounts[i] * 1e9 / m_vTotals[i] : 0.0;
+
+		// Only the buckets with values are reported, with their upper bounds
+		QJsonArray aHistogram;
+		for(int j = 0; j < BUCKETS_COUNT; j++)
+		{
+			qint64 iValue = m_vHistograms[i * BUCKETS_COUNT + j];
+			if(iValue == 0)
+				continue;
+
+			QJsonObject oBucket;
+			oBucket["upper_us"] = qPow(2, double(j + 1) / BUCKETS_PER_OCTAVE) / 1e3;
+			oBucket["count"] = double(iValue);
+			aHistogram.append(oBucket);
+		}
+		oStage["histogram"] = aHistogram;
+
+		oStages[stageName(eStage)] = oStage;
+	}
+	oRet["stages"] = oStages;
+
+	return oRet;
+}
+
+// +-----------------------------------------------------------
+QString fsdk::TaskProfile::toText() const
+{
+	QStringList lLines;
+	lLines.append(QApplication::translate("TaskProfile", "%1 frames in %2 s (%3 frames/s)")
+		.arg(m_iFrames).arg(m_iElapsed / 1e9, 0, 'f', 2).arg(m_iElapsed > 0 ? m_iFrames * 1e9 / m_iElapsed : 0.0, 0, 'f', 2));
+
+	lLines.append(QString("%1 %2 %3 %4 %5 %6 %7 %8")
+		.arg(QApplication::translate("TaskProfile", "stage"), -14)
+		.arg(QApplication::translate("TaskProfile", "count"), 10)
+		.arg(QApplication::translate("TaskProfile", "total (s)"), 10)
+		.arg(QApplication::translate("TaskProfile", "mean (ms)"), 10)
+		.arg(QApplication::translate("TaskProfile", "p50 (ms)"), 10)
+		.arg(QApplication::translate("TaskProfile", "p99 (ms)"), 10)
+		.arg(QApplication::translate("TaskProfile", "max (ms)"), 10)
+		.arg(QApplication::translate("TaskProfile", "per s"), 10));
+
+	for(int i = 0; i < StagesCount; i++)
+	{
+		Stage eStage = static_cast<Stage>(i);
+		if(m_vCounts[i] == 0)
+			continue;
+
+		lLines.append(QString("%1 %2 %3 %4 %5 %6 %7 %8")
+			.arg(stageName(eStage), -14)
+			.arg(m_vCounts[i], 10)
+			.arg(m_vTotals[i] / 1e9, 10, 'f', 3)
+			.arg(m_vTotals[i] / 1e6 / m_vCounts[i], 10, 'f', 3)
+			.arg(percentile(eStage, 50) / 1e6, 10, 'f', 3)
+			.arg(percentile(eStage, 99) / 1e6, 10, 'f', 3)
+			.arg(m_vMaximums[i] / 1e6, 10, 'f', 3)
+			.arg(m_vTotals[i] > 0 ? m_vCounts[i] * 1e9 / m_vTotals[i] : 0.0, 10, 'f', 1));
+	}
+
+	return lLines.join('\n');
+}
+
+// +-----------------------------------------------------------
+fsdk::ScopedStageTimer::ScopedStageTimer(TaskProfile &oProfile, const TaskProfile::Stage eStage):
+	m_oProfile(oProfile)
+{
+	m_eStage = eStage;
+	if(m_oProfile.isEnabled())
+		m_oTimer.start();
+}
+
+// +-----------------------------------------------------------
+fsdk::ScopedStageTimer::~ScopedStageTimer()
+{
+	if(m_oTimer.isValid())
+		m_oProfile.add(m_eStage, m_oTimer.nsecsElapsed());
+}
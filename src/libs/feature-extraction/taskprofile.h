@@ -0,0 +1,235 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TASKPROFILE_H
+#define TASKPROFILE_H
+
+#include "libexport.h"
+#include <QString>
+#include <QVector>
+#include <QJsonObject>
+#include <QElapsedTimer>
+#include <QMetaType>
+
+namespace fsdk
+{
+	/**
+	 * Per-stage timing of the extraction tasks. Each stage accumulates the
+	 * number of executions, the total, minimum and maximum times and a latency
+	 * histogram with logarithmic buckets (four per power of two, so percentiles
+	 * are estimated with an error below 10%). When profiling is disabled, the
+	 * timers do not even read the clock, so the overhead is negligible.
+	 */
+	class SHARED_LIB_EXPORT TaskProfile
+	{
+	public:
+
+		/**
+		 * Stages of the extraction that are timed.
+		 */
+		enum Stage
+		{
+			/** Decoding of the frames from the input file. */
+			DecodeStage,
+
+			/** Tracking of the face in a frame. */
+			TrackingStage,
+
+			/** Reset of the face tracker. */
+			ResetStage,
+
+			/** Cropping and normalization of the face region. */
+			CropStage,
+
+			/** Filtering of the face region with the Gabor bank. */
+			FilteringStage,
+
+			/** Loading of the input data files (other than the images/videos). */
+			LoadingStage,
+
+			/** Serialization of the data extracted. */
+			SerializationStage,
+
+			/** Temporal smoothing of the landmarks. */
+			SmoothingStage,
+
+			/** Number of stages (not a stage itself). */
+			StagesCount
+		};
+
+		/**
+		 * Class constructor.
+		 * @param bEnabled Boolean indicating if the profiling is enabled
+		 * (true) or not (false). The default is false.
+		 */
+		TaskProfile(const bool bEnabled = false);
+
+		/**
+		 * Queries if the profiling is enabled.
+		 * @return Boolean indicating if the profiling is enabled (true) or not (false).
+		 */
+		bool isEnabled() const;
+
+		/**
+		 * Enables or disables the profiling.
+		 * @param bEnabled Boolean indicating if the profiling is enabled (true) or not (false).
+		 */
+		void setEnabled(const bool bEnabled);
+
+		/**
+		 * Adds the time of one execution of a stage.
+		 * @param eStage Value of the Stage enum with the stage executed.
+		 * @param iNanoseconds Long integer with the time of the execution in nanoseconds.
+		 */
+		void add(const Stage eStage, const qint64 iNanoseconds);
+
+		/**
+		 * Adds a number of frames to the frames processed.
+		 * @param iFrames Integer with the number of frames.
+		 */
+		void addFrames(const int iFrames = 1);
+
+		/**
+		 * Adds a time to the total processing time (the wall time of the tasks).
+		 * @param iNanoseconds Long integer with the time in nanoseconds.
+		 */
+		void addElapsed(const qint64 iNanoseconds);
+
+		/**
+		 * Merges the timing of another profile into this one (for instance, to
+		 * report the totals of the tasks of several input files).
+		 * @param oOther Const reference to the other TaskProfile.
+		 */
+		void merge(const TaskProfile &oOther);
+
+		/**
+		 * Gets the number of frames processed.
+		 * @return Long integer with the number of frames processed.
+		 */
+		qint64 frames() const;
+
+		/**
+		 * Gets the number of executions of a stage.
+		 * @param eStage Value of the Stage enum with the stage.
+		 * @return Long integer with the number of executions.
+		 */
+		qint64 count(const Stage eStage) const;
+
+		/**
+		 * Gets the total time of the executions of a stage.
+		 * @param eStage Value of the Stage enum with the stage.
+		 * @return Long integer with the total time in nanoseconds.
+		 */
+		qint64 total(const Stage eStage) const;
+
+		/**
+		 * Estimates a percentile of the times of the executions of a stage
+		 * from its latency histogram.
+		 * @param eStage Value of the Stage enum with the stage.
+		 * @param dPercentile Double with the percentile in range [0, 100].
+		 * @return Double with the estimated time in nanoseconds (0 if the stage
+		 * was not executed).
+		 */
+		double percentile(const Stage eStage, const double dPercentile) const;
+
+		/**
+		 * Gets the name of a stage.
+		 * @param eStage Value of the Stage enum with the stage.
+		 * @return QString with the name of the stage.
+		 */
+		static QString stageName(const Stage eStage);
+
+		/**
+		 * Produces the report of the profiling in JSON: the frames processed,
+		 * the processing time and throughput, and the statistics and latency
+		 * histogram of each stage executed.
+		 * @return QJsonObject with the report.
+		 */
+		QJsonObject toJson() const;
+
+		/**
+		 * Produces the report of the profiling as a human-readable table.
+		 * @return QString with the report.
+		 */
+		QString toText() const;
+
+	private:
+
+		/** Indicates if the profiling is enabled. */
+		bool m_bEnabled;
+
+		/** Number of frames processed. */
+		qint64 m_iFrames;
+
+		/** Total processing time in nanoseconds. */
+		qint64 m_iElapsed;
+
+		/** Number of executions of each stage. */
+		QVector<qint64> m_vCounts;
+
+		/** Total time of each stage in nanoseconds. */
+		QVector<qint64> m_vTotals;
+
+		/** Minimum time of each stage in nanoseconds. */
+		QVector<qint64> m_vMinimums;
+
+		/** Maximum time of each stage in nanoseconds. */
+		QVector<qint64> m_vMaximums;
+
+		/** Latency histogram of each stage (StagesCount x number of buckets). */
+		QVector<qint64> m_vHistograms;
+	};
+
+	/**
+	 * Times the execution of a stage from its construction to its destruction
+	 * (i.e. until the end of the scope where it is declared), adding the time
+	 * to a TaskProfile if the profiling is enabled.
+	 */
+	class SHARED_LIB_EXPORT ScopedStageTimer
+	{
+	public:
+		/**
+		 * Class constructor. Starts timing the stage.
+		 * @param oProfile Reference to the TaskProfile to add the time to.
+		 * @param eStage Value of the TaskProfile::Stage enum with the stage timed.
+		 */
+		ScopedStageTimer(TaskProfile &oProfile, const TaskProfile::Stage eStage);
+
+		/**
+		 * Class destructor. Adds the time of the stage to the profile.
+		 */
+		~ScopedStageTimer();
+
+	private:
+
+		/** Profile to add the time to. */
+		TaskProfile &m_oProfile;
+
+		/** Stage timed. */
+		TaskProfile::Stage m_eStage;
+
+		/** Timer of the stage. */
+		QElapsedTimer m_oTimer;
+	};
+}
+
+// Declare the class as a Qt metatype
+Q_DECLARE_METATYPE(fsdk::TaskProfile);
+
+#endif // TASKPROFILE_H
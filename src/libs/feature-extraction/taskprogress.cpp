@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "taskprogress.h"
+#include <QtMath>
+
+// +-----------------------------------------------------------
+fsdk::TaskProgress::TaskProgress(const int iFrames, const int iFrameCount, const double dFrameRate, const qint64 iElapsed)
+{
+	qRegisterMetaType<fsdk::TaskProgress>("fsdk::TaskProgress");
+	m_iFrames = iFrames;
+	m_iFrameCount = iFrameCount;
+	m_dFrameRate = dFrameRate;
+	m_iElapsed = iElapsed;
+}
+
+// +-----------------------------------------------------------
+int fsdk::TaskProgress::frames() const
+{
+	return m_iFrames;
+}
+
+// +-----------------------------------------------------------
+int fsdk::TaskProgress::frameCount() const
+{
+	return m_iFrameCount;
+}
+
+// +-----------------------------------------------------------
+double fsdk::TaskProgress::frameRate() const
+{
+	return m_dFrameRate;
+}
+
+// +-----------------------------------------------------------
+qint64 fsdk::TaskProgress::elapsed() const
+{
+	return m_iElapsed;
+}
+
+// +-----------------------------------------------------------
+int fsdk::TaskProgress::percent() const
+{
+	if(m_iFrameCount <= 0)
+		return 0;
+	return qMin(qMax(int(qint64(m_iFrames) * 100 / m_iFrameCount), 0), 100);
+}
+
+// +-----------------------------------------------------------
+qint64 fsdk::TaskProgress::remaining() const
+{
+	if(m_iFrameCount <= 0 || m_dFrameRate <= 0)
+		return -1;
+	return qRound64(qMax(m_iFrameCount - m_iFrames, 0) / m_dFrameRate * 1000.0);
+}
+
+// +-----------------------------------------------------------
+QString fsdk::TaskProgress::formatTime(const qint64 iTime)
+{
+	if(iTime < 0)
+		return "--:--:--";
+
+	qint64 iSecs = iTime / 1000;
+	return QString("%1:%2:%3").arg(iSecs / 3600, 2, 10, QChar('0'))
+							  .arg((iSecs / 60) % 60, 2, 10, QChar('0'))
+							  .arg(iSecs % 60, 2, 10, QChar('0'));
+}
+
+// +-----------------------------------------------------------
+fsdk::BatchProgress::BatchProgress(const int iTasksCount)
+{
+	m_iTasksCount = iTasksCount;
+}
+
+// +-----------------------------------------------------------
+void fsdk::BatchProgress::setTasksCount(const int iTasksCount)
+{
+	m_iTasksCount = iTasksCount;
+}
+
+// +-----------------------------------------------------------
+int fsdk::BatchProgress::tasksCount() const
+{
+	return m_iTasksCount;
+}
+
+// +-----------------------------------------------------------
+int fsdk::BatchProgress::finishedCount() const
+{
+	return m_mFinished.count();
+}
+
+// +-----------------------------------------------------------
+void fsdk::BatchProgress::update(const QString &sTask, const TaskProgress &oProgress)
+{
+	if(!m_mFinished.contains(sTask))
+		m_mTasks[sTask] = oProgress;
+}
+
+// +-----------------------------------------------------------
+void fsdk::BatchProgress::estimate(const QString &sTask, const int iFrameCount)
+{
+	if(!m_mTasks.contains(sTask) && !m_mFinished.contains(sTask))
+		m_mTasks[sTask] = TaskProgress(0, iFrameCount);
+}
+
+// +-----------------------------------------------------------
+void fsdk::BatchProgress::finish(const QString &sTask)
+{
+	// A concluded task has all its frames processed (or, if it failed,
+	// it will not process any more frames)
+	TaskProgress oProgress = m_mTasks.value(sTask);
+	m_mTasks[sTask] = TaskProgress(oProgress.frames(), oProgress.frames(), 0, oProgress.elapsed());
+	m_mFinished[sTask] = true;
+}
+
+// +-----------------------------------------------------------
+void fsdk::BatchProgress::totals(double &dFrames, double &dFrameCount) const
+{
+	dFrames = 0;
+	dFrameCount = 0;
+
+	int iKnown = 0;
+	foreach(TaskProgress oProgress, m_mTasks)
+	{
+		dFrames += oProgress.frames();
+		if(oProgress.frameCount() > 0)
+		{
+			dFrameCount += qMax(oProgress.frameCount(), oProgress.frames());
+			iKnown++;
+		}
+		else
+			dFrameCount += oProgress.frames();
+	}
+
+	// Estimate the frames of the tasks not started yet with the average of
+	// the tasks whose number of frames is known
+	int iUnknown = m_iTasksCount - m_mTasks.count();
+	if(iUnknown > 0 && iKnown > 0)
+		dFrameCount += iUnknown * (dFrameCount / m_mTasks.count());
+}
+
+// +-----------------------------------------------------------
+int fsdk::BatchProgress::percent() const
+{
+	if(m_iTasksCount > 0 && finishedCount() >= m_iTasksCount)
+		return 100;
+
+	double dFrames, dFrameCount;
+	totals(dFrames, dFrameCount);
+	if(dFrameCount <= 0)
+		return 0;
+	return qMin(qMax(int(dFrames * 100 / dFrameCount), 0), 100);
+}
+
+// +-----------------------------------------------------------
+double fsdk::BatchProgress::frameRate() const
+{
+	double dRate = 0;
+	foreach(TaskProgress oProgress, m_mTasks)
+		dRate += oProgress.frameRate();
+	return dRate;
+}
+
+// +-----------------------------------------------------------
+qint64 fsdk::BatchProgress::remaining() const
+{
+	double dRate = frameRate();
+	if(dRate <= 0)
+		return -1;
+
+	double dFrames, dFrameCount;
+	totals(dFrames, dFrameCount);
+	if(dFrameCount <= 0)
+		return -1;
+	return qRound64(qMax(dFrameCount - dFrames, 0.0) / dRate * 1000.0);
+}
\ No newline at end of file
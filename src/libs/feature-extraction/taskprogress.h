@@ -0,0 +1,217 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef TASKPROGRESS_H
+#define TASKPROGRESS_H
+
+#include "libexport.h"
+#include <QString>
+#include <QMap>
+#include <QMetaType>
+
+namespace fsdk
+{
+	/**
+	 * Snapshot of the progress of an extraction task: the number of frames
+	 * already processed, the total number of frames in the input file, the
+	 * smoothed processing rate (in frames per second) and the elapsed time.
+	 */
+	class SHARED_LIB_EXPORT TaskProgress
+	{
+	public:
+
+		/**
+		 * Class constructor.
+		 * @param iFrames Integer with the number of frames processed.
+		 * @param iFrameCount Integer with the total number of frames of the
+		 * input file, or 0 if it is not known.
+		 * @param dFrameRate Double with the processing rate in frames per second.
+		 * @param iElapsed Long integer with the time elapsed since the task
+		 * started, in milliseconds.
+		 */
+		TaskProgress(const int iFrames = 0, const int iFrameCount = 0, const double dFrameRate = 0, const qint64 iElapsed = 0);
+
+		/**
+		 * Gets the number of frames processed.
+		 * @return Integer with the number of frames processed.
+		 */
+		int frames() const;
+
+		/**
+		 * Gets the total number of frames of the input file.
+		 * @return Integer with the number of frames, or 0 if it is not known.
+		 */
+		int frameCount() const;
+
+		/**
+		 * Gets the processing rate.
+		 * @return Double with the (smoothed) processing rate in frames per second.
+		 */
+		double frameRate() const;
+
+		/**
+		 * Gets the time elapsed since the task started.
+		 * @return Long integer with the elapsed time in milliseconds.
+		 */
+		qint64 elapsed() const;
+
+		/**
+		 * Gets the progress percent.
+		 * @return Integer in range [0, 100] with the progress percent (it is
+		 * always 0 if the number of frames of the input file is not known).
+		 */
+		int percent() const;
+
+		/**
+		 * Gets the estimated time remaining to conclude the task.
+		 * @return Long integer with the time remaining in milliseconds, or -1
+		 * if it can not be estimated (i.e. the number of frames or the rate are
+		 * not known yet).
+		 */
+		qint64 remaining() const;
+
+		/**
+		 * Formats a time in milliseconds as "hh:mm:ss", for displaying it.
+		 * @param iTime Long integer with the time in milliseconds. If it is
+		 * negative, the time is considered unknown.
+		 * @return QString with the time formatted (or "--:--:--" if unknown).
+		 */
+		static QString formatTime(const qint64 iTime);
+
+	private:
+
+		/** Number of frames processed. */
+		int m_iFrames;
+
+		/** Total number of frames of the input file (or 0 if unknown). */
+		int m_iFrameCount;
+
+		/** Processing rate in frames per second. */
+		double m_dFrameRate;
+
+		/** Time elapsed since the task started, in milliseconds. */
+		qint64 m_iElapsed;
+	};
+
+	/**
+	 * Aggregation of the progress of all the tasks in a batch of extractions,
+	 * so a single batch-level percent, rate and estimated time remaining can be
+	 * presented. The number of frames of the tasks not started yet is estimated
+	 * from the average of the tasks already known.
+	 */
+	class SHARED_LIB_EXPORT BatchProgress
+	{
+	public:
+
+		/**
+		 * Class constructor.
+		 * @param iTasksCount Integer with the number of tasks in the batch.
+		 */
+		BatchProgress(const int iTasksCount = 0);
+
+		/**
+		 * Sets the number of tasks in the batch.
+		 * @param iTasksCount Integer with the number of tasks in the batch.
+		 */
+		void setTasksCount(const int iTasksCount);
+
+		/**
+		 * Gets the number of tasks in the batch.
+		 * @return Integer with the number of tasks in the batch.
+		 */
+		int tasksCount() const;
+
+		/**
+		 * Gets the number of tasks already concluded (with success or not).
+		 * @return Integer with the number of tasks concluded.
+		 */
+		int finishedCount() const;
+
+		/**
+		 * Updates the progress of one of the tasks.
+		 * @param sTask QString with the identification of the task (i.e. its
+		 * input file).
+		 * @param oProgress TaskProgress with the current progress of the task.
+		 */
+		void update(const QString &sTask, const TaskProgress &oProgress);
+
+		/**
+		 * Gives the number of frames of a task known in advance (for instance,
+		 * by probing its input file), so it is not estimated from the other
+		 * tasks. It has no effect if the task has already reported its progress.
+		 * @param sTask QString with the identification of the task (i.e. its
+		 * input file).
+		 * @param iFrameCount Integer with the number of frames of the task.
+		 */
+		void estimate(const QString &sTask, const int iFrameCount);
+
+		/**
+		 * Indicates that one of the tasks has been concluded (with success or not),
+		 * so it no longer contributes to the batch rate and all its frames are
+		 * considered processed.
+		 * @param sTask QString with the identification of the task (i.e. its
+		 * input file).
+		 */
+		void finish(const QString &sTask);
+
+		/**
+		 * Gets the progress percent of the batch.
+		 * @return Integer in range [0, 100] with the progress percent.
+		 */
+		int percent() const;
+
+		/**
+		 * Gets the processing rate of the batch (the sum of the rates of the
+		 * tasks in execution).
+		 * @return Double with the processing rate in frames per second.
+		 */
+		double frameRate() const;
+
+		/**
+		 * Gets the estimated time remaining to conclude the batch.
+		 * @return Long integer with the time remaining in milliseconds, or -1
+		 * if it can not be estimated yet.
+		 */
+		qint64 remaining() const;
+
+	protected:
+
+		/**
+		 * Gets the number of frames processed and the (estimated) total number
+		 * of frames of the whole batch.
+		 * @param dFrames Reference to a double to receive the frames processed.
+		 * @param dFrameCount Reference to a double to receive the total frames.
+		 */
+		void totals(double &dFrames, double &dFrameCount) const;
+
+	private:
+
+		/** Number of tasks in the batch. */
+		int m_iTasksCount;
+
+		/** Last progress of each task known (tasks not started are not included). */
+		QMap<QString, TaskProgress> m_mTasks;
+
+		/** Tasks already concluded. */
+		QMap<QString, bool> m_mFinished;
+	};
+}
+
+Q_DECLARE_METATYPE(fsdk::TaskProgress);
+
+#endif // TASKPROGRESS_H
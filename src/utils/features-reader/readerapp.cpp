@@ -0,0 +1,254 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "readerapp.h"
+#include "version.h"
+#include <QCommandLineParser>
+#include <QRegularExpression>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QDebug>
+#include <iostream>
+
+// +-----------------------------------------------------------
+fsdk::ReaderApp::ReaderApp(int &argc, char **argv, const QString &sOrgName, const QString &sOrgDomain, const QString &sAppName, const QString &sAppVersion, const bool bUseSettings):
+	Application(argc, argv, sOrgName, sOrgDomain, sAppName, sAppVersion, bUseSettings)
+{
+	m_iCount = 0;
+	m_iPollInterval = 50;
+	m_iWaitTime = 10;
+	m_bPrint = true;
+	m_bPrintStats = false;
+
+	// Replace the original message pattern from the parent class Application.
+	// i.e.: - remove the source and line number from trace even in debug;
+	//       - add the progress level instead of the log type;
+	qSetMessagePattern("%{time yyyy.MM.dd h:mm:ss.zzz} [%{if-critical}l1%{endif}%{if-warning}l2%{endif}%{if-info}l3%{endif}%{if-debug}l4%{endif}]: %{message}");
+	setLogLevel(Critical);
+}
+
+// +-----------------------------------------------------------
+fsdk::ReaderApp::CommandLineParseResult fsdk::ReaderApp::parseCommandLine()
+{
+	//***************************************
+	//* Sets up the command line parser
+	//***************************************
+	QCommandLineParser oParser;
+
+	oParser.setApplicationDescription(tr("Reads the features published by the extractors (with the option --publish) "
+		"and prints them as CSV lines with the frame, the face, the quality, the latency of the "
+		"handoff in microseconds and the features."));
+	oParser.setSingleDashWordOptionMode(QCommandLineParser::ParseAsLongOptions);
+
+	// Key argument
+	oParser.addPositionalArgument("key",
+		tr("Key of the shared memory given to the extractor with --publish."),
+		tr("<key>")
+	);
+
+	// Messages level option
+	QCommandLineOption oMsgLevelOpt(QStringList({"l", "level"}),
+		tr("Level of the messages to display, in range [1,4]: \n"
+		   "1: only error messages (default).\n"
+		   "2: error and warning messages.\n"
+		   "3: error, warning and info messages.\n"
+		   "4: error, warning, info and progress messages.\n"
+		), tr("value"), "1"
+	);
+	oParser.addOption(oMsgLevelOpt);
+
+	// Reading options
+	QCommandLineOption oCountOpt(QStringList({ "n", "count" }),
+		tr("Number of records to read before terminating (default is 0, i.e. until interrupted)."),
+		tr("records"), "0"
+	);
+	oParser.addOption(oCountOpt);
+
+	QCommandLineOption oPollOpt(QStringList({ "poll" }),
+		tr("Interval in microseconds between the checks for new records (default is 50). "
+		   "Use 0 to check continuously, for the lowest latency."
+		), tr("us"), "50"
+	);
+	oParser.addOption(oPollOpt);
+
+	QCommandLineOption oWaitOpt(QStringList({ "wait" }),
+		tr("Time in seconds to wait for the extractor to create the ring buffer (default is 10)."),
+		tr("seconds"), "10"
+	);
+	oParser.addOption(oWaitOpt);
+
+	QCommandLineOption oQuietOpt(QStringList({ "q", "quiet" }),
+		tr("Does not print the records (useful along with --stats to measure the handoff).")
+	);
+	oParser.addOption(oQuietOpt);
+
+	QCommandLineOption oStatsOpt(QStringList({ "stats" }),
+		tr("Prints the number of records read and lost, and the latency of the handoff, at the end.")
+	);
+	oParser.addOption(oStatsOpt);
+
+	// Help and version options
+	QCommandLineOption oHelpOpt = oParser.addHelpOption();
+	QCommandLineOption oVersionOpt = oParser.addVersionOption();
+
+	//***************************************
+	//* Parse the arguments received
+	//***************************************
+	if(!oParser.parse(arguments()))
+	{
+		qCritical().noquote() << oParser.errorText() << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+
+	// Check if help was requested
+	if(oParser.isSet(oHelpOpt))
+	{
+		oParser.showHelp();
+		return CommandLineHelpRequested;
+	}
+
+	// Check if version was requested
+	if(oParser.isSet(oVersionOpt))
+	{
+		oParser.showVersion();
+		return CommandLineVersionRequested;
+	}
+
+	// Get the requested message level
+	QRegularExpression oRELevel("^[1-4]$");
+	bool bValid = oRELevel.match(oParser.value(oMsgLevelOpt)).hasMatch();
+	if(!bValid)
+	{
+		qCritical().noquote() << tr("invalid message level: %1").arg(oParser.value(oMsgLevelOpt)) << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+	int iLevel = oParser.value(oMsgLevelOpt).toInt();
+	setLogLevel(static_cast<LogLevel>(iLevel));
+
+	// Get the reading options
+	m_iCount = oParser.value(oCountOpt).toLongLong(&bValid);
+	if(!bValid || m_iCount < 0)
+	{
+		qCritical().noquote() << tr("invalid number of records: %1").arg(oParser.value(oCountOpt)) << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+
+	m_iPollInterval = oParser.value(oPollOpt).toInt(&bValid);
+	if(!bValid || m_iPollInterval < 0)
+	{
+		qCritical().noquote() << tr("invalid polling interval: %1").arg(oParser.value(oPollOpt)) << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+
+	m_iWaitTime = oParser.value(oWaitOpt).toInt(&bValid);
+	if(!bValid || m_iWaitTime < 0)
+	{
+		qCritical().noquote() << tr("invalid waiting time: %1").arg(oParser.value(oWaitOpt)) << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+
+	m_bPrint = !oParser.isSet(oQuietOpt);
+	m_bPrintStats = oParser.isSet(oStatsOpt);
+
+	// Check the key argument
+	if(oParser.positionalArguments().count() != 1)
+	{
+		qCritical().noquote() << tr("the argument <key> is required") << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+	m_sKey = oParser.positionalArguments().at(0);
+
+	return CommandLineOk;
+}
+
+// +-----------------------------------------------------------
+void fsdk::ReaderApp::run()
+{
+	// Wait for the extractor to create the ring buffer
+	FeatureRing oRing(m_sKey);
+	QElapsedTimer oTimer;
+	oTimer.start();
+	while(!oRing.attach())
+	{
+		if(static_cast<int>(m_oCancelRequested) == 1 || oTimer.hasExpired(m_iWaitTime * qint64(1000)))
+		{
+			qCritical().noquote() << tr("could not attach to the ring buffer %1").arg(m_sKey);
+			exit(-2);
+			return;
+		}
+		QThread::msleep(100);
+	}
+	qInfo().noquote() << tr("attached to the ring buffer %1 (%2 records of up to %3 values)").arg(m_sKey).arg(oRing.capacity()).arg(oRing.valuesCount());
+
+	// Read the records until the count is reached or the application is cancelled
+	int iFrame, iFace;
+	float fQuality;
+	QList<float> lValues;
+	qint64 iTimestamp;
+	qint64 iRead = 0;
+	qint64 iLatencySum = 0;
+	qint64 iLatencyMax = 0;
+	while(static_cast<int>(m_oCancelRequested) == 0 && (m_iCount == 0 || iRead < m_iCount))
+	{
+		FeatureRing::ReadResult eResult = oRing.read(iFrame, iFace, fQuality, lValues, iTimestamp);
+		if(eResult == FeatureRing::NoRecord)
+		{
+			if(m_iPollInterval > 0)
+				QThread::usleep(m_iPollInterval);
+			continue;
+		}
+
+		qint64 iLatency = FeatureRing::now() - iTimestamp;
+		iLatencySum += iLatency;
+		iLatencyMax = qMax(iLatencyMax, iLatency);
+		iRead++;
+
+		if(eResult == FeatureRing::RecordsLost)
+			qWarning().noquote() << tr("%1 records lost so far (the reader is too slow)").arg(oRing.lostRecords());
+
+		if(m_bPrint)
+		{
+			QStringList lLine;
+			lLine.append(QString::number(iFrame));
+			lLine.append(QString::number(iFace));
+			lLine.append(QString::number(fQuality));
+			lLine.append(QString::number(iLatency));
+			foreach(float fValue, lValues)
+				lLine.append(QString::number(fValue));
+			std::cout << lLine.join(',').toStdString() << std::endl;
+		}
+	}
+
+	if(m_bPrintStats)
+		std::cout << tr("records read: %1, records lost: %2, handoff latency: mean %3 us, max %4 us")
+			.arg(iRead).arg(oRing.lostRecords()).arg(iRead > 0 ? iLatencySum / iRead : 0).arg(iLatencyMax).toStdString() << std::endl;
+
+	exit(0);
+}
+
+// +-----------------------------------------------------------
+void fsdk::ReaderApp::cancel()
+{
+	m_oCancelRequested.testAndSetOrdered(0, 1);
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef READERAPP_H
+#define READERAPP_H
+
+#include "application.h"
+#include "featurering.h"
+#include <QAtomicInt>
+
+namespace fsdk
+{
+	/**
+	 * Implements a custom application to run the features reader console application,
+	 * which consumes the features published by the extractors in a ring buffer in
+	 * the shared memory (see FeatureRing).
+	 * It depends upon the definition of the macro 'CONSOLE' in CMakeLists.txt
+	 * (check source of Application for details).
+	 */
+	class ReaderApp: public Application
+	{
+		Q_OBJECT
+	public:
+
+		/**
+		 * Class constructor.
+		 * @param argc Number of arguments received from the command line.
+		 * @param argv Array of char pointers with the arguments received from the command line.
+		 * @param sOrgName QString with the name of the organization that manages the application.
+		 * @param sOrgDomain QString with the domain of the organization in which the application exists.
+		 * @param sAppName QString with the name of the application.
+		 * @param sAppVersion QString with the application version.
+		 * @param bUseSettings Boolean indicating if the application shall create a configuration area
+		 * or not (in the Operating System's designated local, such as the Registry in Windows).
+		 * The default is false (i.e. not to use settings).
+		 */
+		ReaderApp(int &argc, char **argv, const QString &sOrgName, const QString &sOrgDomain, const QString &sAppName, const QString &sAppVersion, const bool bUseSettings = false);
+
+		/**
+		 * Enumeration that defines the possible outcomes of the parsing
+		 * of the command line arguments.
+		 */
+		enum CommandLineParseResult
+		{
+			/** The command line was parsed correctly with all required arguments. */
+			CommandLineOk,
+
+			/** There was an error in the parsing of the command line arguments. */
+			CommandLineError,
+
+			/** The user requested the application to display its version information. */
+			CommandLineVersionRequested,
+
+			/** The user requested the application to display its help information. */
+			CommandLineHelpRequested
+		};
+
+		/**
+		 * Parses the command line arguments.
+		 * @return One of the values in the CommandLineParseResult enum indicating
+		 * how the parsing of the command line proceeded.
+		 */
+		CommandLineParseResult parseCommandLine();
+
+		/**
+		 * Cancel the reading and terminate the application.
+		 */
+		void cancel();
+
+	public slots:
+
+		/**
+		 * Reads the records from the ring buffer until the number of records
+		 * requested is read or the application is cancelled.
+		 */
+		void run();
+
+	private:
+
+		/** Key of the shared memory with the ring buffer. */
+		QString m_sKey;
+
+		/** Number of records to read (0 to read until cancelled). */
+		qint64 m_iCount;
+
+		/** Interval between the checks for new records, in microseconds. */
+		int m_iPollInterval;
+
+		/** Time to wait for the ring buffer to be created, in seconds. */
+		int m_iWaitTime;
+
+		/** Indicates if the records are printed. */
+		bool m_bPrint;
+
+		/** Indicates if the statistics of the reading are printed at the end. */
+		bool m_bPrintStats;
+
+		/** Atomic integer to control the cancel request in a thread-safe way. */
+		QAtomicInt m_oCancelRequested;
+	};
+}
+
+#endif // READERAPP_H
@@ -0,0 +1,335 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchapp.h"
+#include "benchmarks.h"
+#include "facetrackerregistry.h"
+#include "version.h"
+#include <QCommandLineParser>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QDateTime>
+#include <QSysInfo>
+#include <QThread>
+#include <QFile>
+#include <QDebug>
+#include <iostream>
+
+using namespace cv;
+
+// +-----------------------------------------------------------
+fsdk::BenchApp::BenchApp(int &argc, char **argv, const QString &sOrgName, const QString &sOrgDomain, const QString &sAppName, const QString &sAppVersion, const bool bUseSettings):
+	Application(argc, argv, sOrgName, sOrgDomain, sAppName, sAppVersion, bUseSettings)
+{
+	// Replace the original message pattern from the parent class Application.
+	// i.e.: - remove the source and line number from trace even in debug;
+	//       - add the progress level instead of the log type;
+	qSetMessagePattern("%{time yyyy.MM.dd h:mm:ss.zzz} [%{if-critical}l1%{endif}%{if-warning}l2%{endif}%{if-info}l3%{endif}%{if-debug}l4%{endif}]: %{message}");
+	setLogLevel(Critical);
+
+	m_bListOnly = false;
+	m_bQuick = false;
+	m_iMinIterations = 10;
+	m_iMinTime = 1000;
+}
+
+// +-----------------------------------------------------------
+fsdk::BenchApp::~BenchApp()
+{
+	qDeleteAll(m_lBenchmarks);
+}
+
+// +-----------------------------------------------------------
+fsdk::BenchApp::CommandLineParseResult fsdk::BenchApp::parseCommandLine()
+{
+	//***************************************
+	//* Sets up the command line parser
+	//***************************************
+	QCommandLineParser oParser;
+
+	oParser.setApplicationDescription(tr("Benchmarks of the hot paths of the Fun SDK, using synthetic data."));
+	oParser.setSingleDashWordOptionMode(QCommandLineParser::ParseAsLongOptions);
+
+	QCommandLineOption oOutputOpt(QStringList({ "o", "output" }),
+		tr("Saves the results to the given JSON file (and logs the progress) instead of "
+			"printing them to the standard output."
+		), tr("file")
+	);
+	oParser.addOption(oOutputOpt);
+
+	QCommandLineOption oFilterOpt(QStringList({ "f", "filter" }),
+		tr("Regular expression to select the benchmarks to run by their identification "
+			"(example: -f \"^GaborBank::filter/kernels=32\")."
+		), tr("expression")
+	);
+	oParser.addOption(oFilterOpt);
+
+	QCommandLineOption oListOpt(QStringList({ "l", "list" }),
+		tr("Lists the identification of the benchmarks instead of running them.")
+	);
+	oParser.addOption(oListOpt);
+
+	QCommandLineOption oQuickOpt(QStringList({ "q", "quick" }),
+		tr("Uses smaller inputs and shorter times (for smoke testing the benchmarks).")
+	);
+	oParser.addOption(oQuickOpt);
+
+	QCommandLineOption oIterationsOpt(QStringList({ "n", "iterations" }),
+		tr("Minimum number of iterations of each benchmark (default is 10)."
+		), tr("value"), "10"
+	);
+	oParser.addOption(oIterationsOpt);
+
+	QCommandLineOption oTimeOpt(QStringList({ "t", "time" }),
+		tr("Minimum time in milliseconds of each benchmark (default is 1000)."
+		), tr("value"), "1000"
+	);
+	oParser.addOption(oTimeOpt);
+
+	// Help and version options
+	QCommandLineOption oHelpOpt = oParser.addHelpOption();
+	QCommandLineOption oVersionOpt = oParser.addVersionOption();
+
+	//***************************************
+	//* Parse the arguments received
+	//***************************************
+	if(!oParser.parse(arguments()))
+	{
+		qCritical().noquote() << oParser.errorText() << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+
+	// Check if help was requested
+	if(oParser.isSet(oHelpOpt))
+	{
+		oParser.showHelp();
+		return CommandLineHelpRequested;
+	}
+
+	// Check if version was requested
+	if(oParser.isSet(oVersionOpt))
+	{
+		oParser.showVersion();
+		return CommandLineVersionRequested;
+	}
+
+	//***************************************
+	//* Handle the argument values
+	//***************************************
+	if(oParser.positionalArguments().count() > 0)
+	{
+		qCritical().noquote() << tr("unexpected arguments %1").arg(oParser.positionalArguments().join(',')) << endl;
+		return CommandLineError;
+	}
+
+	if(oParser.isSet(oFilterOpt))
+	{
+		m_oFilter.setPattern(oParser.value(oFilterOpt));
+		if(!m_oFilter.isValid())
+		{
+			qCritical().noquote() << tr("invalid filter expression %1").arg(oParser.value(oFilterOpt)) << endl;
+			return CommandLineError;
+		}
+	}
+
+	bool bOk;
+	m_iMinIterations = oParser.value(oIterationsOpt).toInt(&bOk);
+	if(!bOk || m_iMinIterations < 1)
+	{
+		qCritical().noquote() << tr("invalid number of iterations %1").arg(oParser.value(oIterationsOpt)) << endl;
+		return CommandLineError;
+	}
+
+	m_iMinTime = oParser.value(oTimeOpt).toInt(&bOk);
+	if(!bOk || m_iMinTime < 0)
+	{
+		qCritical().noquote() << tr("invalid time %1").arg(oParser.value(oTimeOpt)) << endl;
+		return CommandLineError;
+	}
+
+	m_bListOnly = oParser.isSet(oListOpt);
+	m_bQuick = oParser.isSet(oQuickOpt);
+	if(m_bQuick)
+	{
+		m_iMinIterations = qMin(m_iMinIterations, 3);
+		m_iMinTime = qMin(m_iMinTime, 100);
+	}
+
+	// Log the progress only if the results do not go to the standard output
+	m_sOutputFile = oParser.value(oOutputOpt);
+	if(!m_sOutputFile.isEmpty())
+		setLogLevel(Info);
+
+	return CommandLineOk;
+}
+
+// +-----------------------------------------------------------
+void fsdk::BenchApp::addBenchmark(Benchmark *pBenchmark)
+{
+	if(m_oFilter.pattern().isEmpty() || m_oFilter.match(pBenchmark->id()).hasMatch())
+		m_lBenchmarks.append(pBenchmark);
+	else
+		delete pBenchmark;
+}
+
+// +-----------------------------------------------------------
+void fsdk::BenchApp::createBenchmarks()
+{
+	QList<int> lCropSizes = m_bQuick ? QList<int>({ 64 }) : QList<int>({ 64, 128, 256 });
+	QList<int> lLines = m_bQuick ? QList<int>({ 100 }) : QList<int>({ 1000, 10000, 50000 });
+	QList<Size> lFrameSizes = m_bQuick ? QList<Size>({ Size(320, 240) }) : QList<Size>({ Size(320, 240), Size(640, 480), Size(1280, 720) });
+	int iFrames = m_bQuick ? 10 : 100;
+	QString sWorkDir = m_oWorkDir.path();
+
+	// Gabor kernels (the window size grows with the wavelength)
+	foreach(double dLambda, QList<double>({ 3, 6, 9, 12 }))
+		addBenchmark(new KernelRebuildBenchmark(dLambda));
+
+	foreach(int iCropSize, lCropSizes)
+		foreach(double dLambda, QList<double>({ 3, 12 }))
+		{
+			addBenchmark(new KernelFilterBenchmark(dLambda, iCropSize));
+			addBenchmark(new KernelFilterBenchmark(dLambda, iCropSize, GaborKernel::FixedPointPrecision));
+		}
+
+	// Gabor banks (1, 8, 16 and 32 kernels - the last is the default bank)
+	foreach(int iCropSize, lCropSizes)
+	{
+		addBenchmark(new BankFilterBenchmark(1, 1, iCropSize));
+		addBenchmark(new BankFilterBenchmark(1, 8, iCropSize));
+		addBenchmark(new BankFilterBenchmark(2, 8, iCropSize));
+		addBenchmark(new BankFilterBenchmark(4, 8, iCropSize));
+		addBenchmark(new BankFilterBenchmark(4, 8, iCropSize, true, GaborBank::PlanarLayout));
+		addBenchmark(new BankFilterBenchmark(4, 8, iCropSize, true, GaborBank::InterleavedLayout));
+		addBenchmark(new BankFilterBenchmark(4, 8, iCropSize, true, GaborBank::PlanarLayout, true));
+		addBenchmark(new BankFilterBenchmark(4, 8, iCropSize, true, GaborBank::PlanarLayout, false, GaborKernel::FixedPointPrecision));
+	}
+
+	// Batches of face crops filtered with the default bank (the throughput is
+	// comparable with the one of the single crop)
+	foreach(int iCropSize, lCropSizes)
+		foreach(int iBatchSize, QList<int>({ 1, 4, 16 }))
+			addBenchmark(new BatchFilterBenchmark(iCropSize, iBatchSize));
+
+	// Pooling of the responses of the default bank over the face regions
+	foreach(int iCropSize, lCropSizes)
+	{
+		addBenchmark(new RegionPoolingBenchmark(iCropSize, RegionPooling::WholeFace, RegionPooling::Mean));
+		addBenchmark(new RegionPoolingBenchmark(iCropSize, RegionPooling::Grid, RegionPooling::Mean | RegionPooling::StdDev));
+		addBenchmark(new RegionPoolingBenchmark(iCropSize, RegionPooling::Grid, RegionPooling::Mean | RegionPooling::StdDev | RegionPooling::Max));
+		addBenchmark(new RegionPoolingBenchmark(iCropSize, RegionPooling::FaceParts, RegionPooling::Mean | RegionPooling::StdDev));
+	}
+
+	// Face cropping, video decoding and tracking
+	foreach(Size oFrameSize, lFrameSizes)
+	{
+		addBenchmark(new CropBenchmark(oFrameSize));
+		addBenchmark(new VideoDecodeBenchmark(sWorkDir, oFrameSize, iFrames));
+		addBenchmark(new FrameDecodeBenchmark(sWorkDir, oFrameSize, iFrames, ExtractionTask::ColorDecode));
+		addBenchmark(new FrameDecodeBenchmark(sWorkDir, oFrameSize, iFrames, ExtractionTask::LumaDecode));
+		foreach(QString sBackend, FaceTrackerRegistry::backends())
+		{
+			addBenchmark(new FaceTrackingBenchmark(oFrameSize, iFrames, 1.0, false, sBackend));
+			addBenchmark(new FaceTrackingBenchmark(oFrameSize, iFrames, 0.5, false, sBackend));
+			addBenchmark(new FaceTrackingBenchmark(oFrameSize, iFrames, 0.5, true, sBackend));
+		}
+	}
+
+	// Files
+	foreach(int iLines, lLines)
+	{
+		addBenchmark(new CSVWriteBenchmark(sWorkDir, iLines));
+		addBenchmark(new CSVReadBenchmark(sWorkDir, iLines));
+		addBenchmark(new LandmarksLoadBenchmark(sWorkDir, iLines));
+		addBenchmark(new LandmarksFilterBenchmark(iLines));
+	}
+}
+
+// +-----------------------------------------------------------
+void fsdk::BenchApp::run()
+{
+	if(!m_oWorkDir.isValid())
+	{
+		qCritical().noquote() << tr("error creating a temporary directory for the synthetic data");
+		exit(-1);
+		return;
+	}
+
+	createBenchmarks();
+
+	if(m_bListOnly)
+	{
+		foreach(Benchmark *pBenchmark, m_lBenchmarks)
+			std::cout << pBenchmark->id().toStdString() << std::endl;
+		exit(0);
+		return;
+	}
+
+	QJsonArray aResults;
+	int iErrors = 0;
+	for(int i = 0; i < m_lBenchmarks.count(); i++)
+	{
+		qInfo().noquote() << tr("running benchmark %1 of %2: %3").arg(i + 1).arg(m_lBenchmarks.count()).arg(m_lBenchmarks[i]->id());
+
+		QJsonObject oResult = m_lBenchmarks[i]->measure(m_iMinIterations, m_iMinTime);
+		if(oResult.contains("error"))
+		{
+			qWarning().noquote() << tr("benchmark %1 failed: %2").arg(m_lBenchmarks[i]->id(), oResult["error"].toString());
+			iErrors++;
+		}
+		aResults.append(oResult);
+	}
+
+	// Identification of the build and of the machine, so results can be compared
+	QJsonObject oRoot;
+	oRoot["version"] = QString(FSDK_VERSION);
+	oRoot["qt_version"] = QString(qVersion());
+	oRoot["opencv_version"] = QString(CV_VERSION);
+#ifdef QT_DEBUG
+	oRoot["build_type"] = QString("debug");
+#else
+	oRoot["build_type"] = QString("release");
+#endif
+	oRoot["cpu_architecture"] = QSysInfo::currentCpuArchitecture();
+	oRoot["cpu_threads"] = QThread::idealThreadCount();
+	oRoot["os"] = QSysInfo::prettyProductName();
+	oRoot["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+	oRoot["min_iterations"] = m_iMinIterations;
+	oRoot["min_time_ms"] = m_iMinTime;
+	oRoot["benchmarks"] = aResults;
+
+	QByteArray oJson = QJsonDocument(oRoot).toJson(QJsonDocument::Indented);
+	if(m_sOutputFile.isEmpty())
+		std::cout << oJson.constData();
+	else
+	{
+		QFile oFile(m_sOutputFile);
+		if(!oFile.open(QIODevice::WriteOnly) || oFile.write(oJson) != oJson.size())
+		{
+			qCritical().noquote() << tr("error writing the results to file %1").arg(m_sOutputFile);
+			exit(-2);
+			return;
+		}
+		qInfo().noquote() << tr("results saved to file %1").arg(m_sOutputFile);
+	}
+
+	exit(iErrors == 0 ? 0 : -3);
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCHAPP_H
+#define BENCHAPP_H
+
+#include "application.h"
+#include "benchmark.h"
+#include <QList>
+#include <QRegularExpression>
+#include <QTemporaryDir>
+
+namespace fsdk
+{
+	/**
+	 * Implements a custom application to run the benchmarks of the hot paths
+	 * of the SDK (Gabor filtering, face cropping, CSV and landmarks files, video
+	 * decoding and face tracking) with synthetic data, producing the results in
+	 * JSON so they can be compared between builds.
+	 * It depends upon the definition of the macro 'CONSOLE' in CMakeLists.txt
+	 * (check source of Application for details).
+	 */
+	class BenchApp: public Application
+	{
+		Q_OBJECT
+	public:
+
+		/**
+		 * Class constructor.
+		 * @param argc Number of arguments received from the command line.
+		 * @param argv Array of char pointers with the arguments received from the command line.
+		 * @param sOrgName QString with the name of the organization that manages the application.
+		 * @param sOrgDomain QString with the domain of the organization in which the application exists.
+		 * @param sAppName QString with the name of the application.
+		 * @param sAppVersion QString with the application version.
+		 * @param bUseSettings Boolean indicating if the application shall create a configuration area
+		 * or not (in the Operating System's designated local, such as the Registry in Windows).
+		 * The default is false (i.e. not to use settings).
+		 */
+		BenchApp(int &argc, char **argv, const QString &sOrgName, const QString &sOrgDomain, const QString &sAppName, const QString &sAppVersion, const bool bUseSettings = false);
+
+		/**
+		 * Class destructor.
+		 */
+		virtual ~BenchApp();
+
+		/**
+		 * Enumeration that defines the possible outcomes of the parsing
+		 * of the command line arguments.
+		 */
+		enum CommandLineParseResult
+		{
+			/** The command line was parsed correctly with all required arguments. */
+			CommandLineOk,
+
+			/** There was an error in the parsing of the command line arguments. */
+			CommandLineError,
+
+			/** The user requested the application to display its version information. */
+			CommandLineVersionRequested,
+
+			/** The user requested the application to display its help information. */
+			CommandLineHelpRequested
+		};
+
+		/**
+		 * Parses the command line arguments.
+		 * @return One of the values in the CommandLineParseResult enum indicating
+		 * how the parsing of the command line proceeded.
+		 */
+		CommandLineParseResult parseCommandLine();
+
+	public slots:
+
+		/**
+		 * Runs the benchmarks. The termination will be indicated
+		 * by the signal finished().
+		 */
+		void run();
+
+	protected:
+
+		/**
+		 * Creates the benchmarks (only the ones selected by the filter).
+		 */
+		void createBenchmarks();
+
+		/**
+		 * Adds a benchmark to the list of benchmarks to run, if it is selected
+		 * by the filter (otherwise, the benchmark is destroyed).
+		 * @param pBenchmark Instance of the Benchmark to add.
+		 */
+		void addBenchmark(Benchmark *pBenchmark);
+
+	private:
+
+		/** Benchmarks to run. */
+		QList<Benchmark*> m_lBenchmarks;
+
+		/** Expression used to select the benchmarks to run by their identification. */
+		QRegularExpression m_oFilter;
+
+		/** Name of the JSON file to save the results (if empty, they are printed). */
+		QString m_sOutputFile;
+
+		/** Indicates if the benchmarks should only be listed (instead of run). */
+		bool m_bListOnly;
+
+		/** Indicates if the benchmarks should use smaller inputs and times. */
+		bool m_bQuick;
+
+		/** Minimum number of iterations of each benchmark. */
+		int m_iMinIterations;
+
+		/** Minimum time (in milliseconds) of each benchmark. */
+		int m_iMinTime;
+
+		/** Temporary directory for the synthetic files. */
+		QTemporaryDir m_oWorkDir;
+	};
+}
+
+#endif // BENCHAPP_H
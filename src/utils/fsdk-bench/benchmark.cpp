@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmark.h"
+#include <QElapsedTimer>
+#include <QVector>
+#include <QStringList>
+#include <QtMath>
+#include <algorithm>
+
+// Maximum number of iterations of a benchmark (to limit the time spent
+// with very fast code)
+#define MAX_ITERATIONS 1000000
+
+// +-----------------------------------------------------------
+fsdk::Benchmark::Benchmark(const QString &sName)
+{
+	m_sName = sName;
+	m_iItems = 0;
+}
+
+// +-----------------------------------------------------------
+fsdk::Benchmark::~Benchmark()
+{
+}
+
+// +-----------------------------------------------------------
+QString fsdk::Benchmark::name() const
+{
+	return m_sName;
+}
+
+// +-----------------------------------------------------------
+QString fsdk::Benchmark::id() const
+{
+	QStringList lParts(m_sName);
+	QVariantMap::const_iterator it;
+	for(it = m_mParameters.cbegin(); it != m_mParameters.cend(); ++it)
+		lParts.append(QString("%1=%2").arg(it.key(), it.value().toString()));
+	return lParts.join('/');
+}
+
+// +-----------------------------------------------------------
+QVariantMap fsdk::Benchmark::parameters() const
+{
+	return m_mParameters;
+}
+
+// +-----------------------------------------------------------
+void fsdk::Benchmark::setParameter(const QString &sName, const QVariant &vValue)
+{
+	m_mParameters[sName] = vValue;
+}
+
+// +-----------------------------------------------------------
+void fsdk::Benchmark::setItemsPerIteration(const int iItems)
+{
+	m_iItems = iItems;
+}
+
+// +-----------------------------------------------------------
+void fsdk::Benchmark::setMetric(const QString &sName, const QVariant &vValue)
+{
+	m_mMetrics[sName] = vValue;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::Benchmark::setUp()
+{
+	return true;
+}
+
+// +-----------------------------------------------------------
+void fsdk::Benchmark::tearDown()
+{
+}
+
+// +-----------------------------------------------------------
+QJsonObject fsdk::Benchmark::measure(const int iMinIterations, const qint64 iMinTime)
+{
+	QJsonObject oRet;
+	oRet["id"] = id();
+	oRet["name"] = m_sName;
+	oRet["parameters"] = QJsonObject::fromVariantMap(m_mParameters);
+
+	if(!setUp())
+	{
+		oRet["error"] = QString("set up failed");
+		tearDown();
+		return oRet;
+	}
+
+	// Warm up (caches, lazy allocations, etc)
+	iterate();
+
+	QVector<qint64> vTimes;
+	QElapsedTimer oTotal, oIteration;
+	oTotal.start();
+	while(vTimes.count() < MAX_ITERATIONS && (vTimes.count() < iMinIterations || oTotal.elapsed() < iMinTime))
+	{
+		oIteration.start();
+		iterate();
+		vTimes.append(oIteration.nsecsElapsed());
+	}
+
+	tearDown();
+
+	// Statistics of the times of the iterations
+	std::sort(vTimes.begin(), vTimes.end());
+	double dSum = 0;
+	foreach(qint64 iTime, vTimes)
+		dSum += iTime;
+	double dMean = dSum / vTimes.count();
+
+	double dVar = 0;
+	foreach(qint64 iTime, vTimes)
+		dVar += qPow(iTime - dMean, 2);
+	dVar /= vTimes.count();
+
+	oRet["iterations"] = vTimes.count();
+	oRet["mean_ns"] = dMean;
+	oRet["stddev_ns"] = qSqrt(dVar);
+	oRet["min_ns"] = double(vTimes.first());
+	oRet["median_ns"] = double(vTimes[vTimes.count() / 2]);
+	oRet["p95_ns"] = double(vTimes[qMin(int(vTimes.count() * 0.95), vTimes.count() - 1)]);
+	oRet["max_ns"] = double(vTimes.last());
+	if(m_iItems > 0)
+	{
+		oRet["items_per_iteration"] = m_iItems;
+		oRet["items_per_second"] = m_iItems * 1e9 / dMean;
+	}
+	if(!m_mMetrics.isEmpty())
+		oRet["metrics"] = QJsonObject::fromVariantMap(m_mMetrics);
+
+	return oRet;
+}
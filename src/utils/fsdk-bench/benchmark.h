@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <QString>
+#include <QVariantMap>
+#include <QJsonObject>
+
+namespace fsdk
+{
+	/**
+	 * Base class for the benchmarks of the hot paths of the SDK. Subclasses
+	 * prepare their (synthetic) input data in setUp() and execute one iteration
+	 * of the code measured in iterate(); the iterations are repeated and timed
+	 * by measure(), that produces the results in a machine-readable format.
+	 */
+	class Benchmark
+	{
+	public:
+		/**
+		 * Class constructor.
+		 * @param sName QString with the name of the benchmark (the code measured).
+		 */
+		Benchmark(const QString &sName);
+
+		/**
+		 * Class destructor.
+		 */
+		virtual ~Benchmark();
+
+		/**
+		 * Gets the name of the benchmark.
+		 * @return QString with the name of the benchmark.
+		 */
+		QString name() const;
+
+		/**
+		 * Gets the identification of the benchmark, composed by its name and
+		 * the values of its parameters (for instance, "GaborBank::filter/kernels=48/crop=128").
+		 * @return QString with the identification of the benchmark.
+		 */
+		QString id() const;
+
+		/**
+		 * Gets the parameters of the benchmark (bank sizes, crop sizes, etc).
+		 * @return QVariantMap with the parameters of the benchmark.
+		 */
+		QVariantMap parameters() const;
+
+		/**
+		 * Runs the benchmark: sets it up, executes one warm-up iteration and then
+		 * repeats the iterations until both the minimum number of iterations and
+		 * the minimum time have been reached.
+		 * @param iMinIterations Integer with the minimum number of iterations.
+		 * @param iMinTime Long integer with the minimum time in milliseconds.
+		 * @return QJsonObject with the results (identification, parameters, number
+		 * of iterations, statistics of the times in nanoseconds and the other
+		 * metrics, if any), or with a member "error" if the benchmark could not
+		 * be set up.
+		 */
+		QJsonObject measure(const int iMinIterations, const qint64 iMinTime);
+
+	protected:
+
+		/**
+		 * Sets the value of a parameter of the benchmark.
+		 * @param sName QString with the name of the parameter.
+		 * @param vValue QVariant with the value of the parameter.
+		 */
+		void setParameter(const QString &sName, const QVariant &vValue);
+
+		/**
+		 * Sets the number of items (frames, lines, etc) processed by each
+		 * iteration, so the results also include the throughput.
+		 * @param iItems Integer with the number of items per iteration.
+		 */
+		void setItemsPerIteration(const int iItems);
+
+		/**
+		 * Sets the value of a metric of the benchmark other than the times (for
+		 * instance, the error of an approximation), included in the results.
+		 * @param sName QString with the name of the metric.
+		 * @param vValue QVariant with the value of the metric.
+		 */
+		void setMetric(const QString &sName, const QVariant &vValue);
+
+		/**
+		 * Prepares the data used by the iterations. The default implementation
+		 * does nothing.
+		 * @return Boolean indicating if the preparation was successful (true)
+		 * or not (false).
+		 */
+		virtual bool setUp();
+
+		/**
+		 * Releases the data used by the iterations. The default implementation
+		 * does nothing.
+		 */
+		virtual void tearDown();
+
+		/**
+		 * Executes one iteration of the code measured.
+		 */
+		virtual void iterate() = 0;
+
+	private:
+
+		/** Name of the benchmark. */
+		QString m_sName;
+
+		/** Parameters of the benchmark. */
+		QVariantMap m_mParameters;
+
+		/** Items processed by each iteration (0 if not applicable). */
+		int m_iItems;
+
+		/** Metrics of the benchmark (other than the times). */
+		QVariantMap m_mMetrics;
+	};
+}
+
+#endif // BENCHMARK_H
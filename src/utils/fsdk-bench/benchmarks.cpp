@@ -0,0 +1,553 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmarks.h"
+#include "syntheticdata.h"
+#include "landmarksdata.h"
+#include "signalpyramid.h"
+#include "facetrackerregistry.h"
+#include "scaledfacetracker.h"
+#include <QDir>
+#include <QFile>
+#include <stdexcept>
+#include <cmath>
+
+using namespace cv;
+
+// Wavelengths of the kernels in the default Gabor bank
+#define BANK_WAVELENGTHS { 3, 6, 9, 12 }
+
+// Tracking quality below which the tracker is reset (the default
+// of the landmarks extractor)
+#define RESET_QUALITY 0.2f
+
+// Size of the frames used for the landmarks files
+#define LANDMARKS_FRAME_SIZE Size(640, 480)
+
+// +-----------------------------------------------------------
+fsdk::KernelRebuildBenchmark::KernelRebuildBenchmark(const double dLambda):
+	Benchmark("GaborKernel::rebuildKernel"),
+	m_oKernel(0, dLambda)
+{
+	setParameter("lambda", dLambda);
+	setParameter("window", m_oKernel.windowSize());
+}
+
+// +-----------------------------------------------------------
+void fsdk::KernelRebuildBenchmark::iterate()
+{
+	m_oKernel.rebuildKernel();
+}
+
+// +-----------------------------------------------------------
+fsdk::KernelFilterBenchmark::KernelFilterBenchmark(const double dLambda, const int iCropSize, const GaborKernel::Precision ePrecision):
+	Benchmark("GaborKernel::filter"),
+	m_oKernel(0, dLambda)
+{
+	m_iCropSize = iCropSize;
+	m_oKernel.setPrecision(ePrecision);
+	setParameter("lambda", dLambda);
+	setParameter("window", m_oKernel.windowSize());
+	setParameter("crop", iCropSize);
+	if(ePrecision == GaborKernel::FixedPointPrecision)
+		setParameter("precision", "fixed");
+}
+
+// +-----------------------------------------------------------
+bool fsdk::KernelFilterBenchmark::setUp()
+{
+	Size oSize(m_iCropSize, m_iCropSize);
+	m_oImage = SyntheticData::faceImage(oSize, SyntheticData::landmarks(Point2f(m_iCropSize / 2.0f, m_iCropSize / 2.0f), m_iCropSize * 0.8f));
+
+	// Compare the responses with the ones of the float precision
+	if(m_oKernel.precision() != GaborKernel::FloatPrecision)
+	{
+		GaborKernel oFloat(m_oKernel);
+		oFloat.setPrecision(GaborKernel::FloatPrecision);
+
+		Mat oFloatResponses, oResponses;
+		oFloat.filter(m_oImage, oFloatResponses);
+		m_oKernel.filter(m_oImage, oResponses);
+
+		double dNorm = norm(oFloatResponses, NORM_L1);
+		setMetric("quantization_error", m_oKernel.quantizationError());
+		setMetric("response_error", dNorm > 0 ? norm(oResponses, oFloatResponses, NORM_L1) / dNorm : 0);
+	}
+
+	return true;
+}
+
+// +-----------------------------------------------------------
+void fsdk::KernelFilterBenchmark::iterate()
+{
+	m_oKernel.filter(m_oImage, m_oResponses);
+}
+
+// +-----------------------------------------------------------
+fsdk::BankFilterBenchmark::BankFilterBenchmark(const int iWavelengths, const int iOrientations, const int iCropSize, const bool bTensor, const GaborBank::TensorLayout eLayout, const bool bPyramid, const GaborKernel::Precision ePrecision):
+	Benchmark("GaborBank::filter")
+{
+	QList<double> lWavelengths = QList<double>(BANK_WAVELENGTHS).mid(0, iWavelengths);
+	QList<double> lOrientations;
+	for(int i = 0; i < iOrientations; i++)
+		lOrientations.append(i * CV_PI / iOrientations);
+	m_oBank = GaborBank(lWavelengths, lOrientations);
+
+	m_iCropSize = iCropSize;
+	m_bTensor = bTensor;
+	m_eLayout = eLayout;
+	setParameter("kernels", m_oBank.kernels().count());
+	setParameter("crop", iCropSize);
+	setParameter("output", !bTensor ? "list" : (eLayout == GaborBank::PlanarLayout ? "planar" : "interleaved"));
+	if(bPyramid)
+	{
+		m_oBank.setPyramid(true);
+		setParameter("pyramid", true);
+	}
+	if(ePrecision == GaborKernel::FixedPointPrecision)
+	{
+		m_oBank.setPrecision(ePrecision);
+		setParameter("precision", "fixed");
+	}
+}
+
+// +-----------------------------------------------------------
+bool fsdk::BankFilterBenchmark::setUp()
+{
+	Size oSize(m_iCropSize, m_iCropSize);
+	m_oImage = SyntheticData::faceImage(oSize, SyntheticData::landmarks(Point2f(m_iCropSize / 2.0f, m_iCropSize / 2.0f), m_iCropSize * 0.8f));
+
+	// Compare the responses of the pyramid/fixed-point with the ones of the
+	// direct filtering in float
+	if(m_oBank.isPyramid() || m_oBank.precision() != GaborKernel::FloatPrecision)
+	{
+		GaborBank oDirect(m_oBank);
+		oDirect.setPyramid(false);
+		oDirect.setPrecision(GaborKernel::FloatPrecision);
+
+		Mat oDirectTensor, oPyramidTensor;
+		oDirect.filter(m_oImage, oDirectTensor);
+		m_oBank.filter(m_oImage, oPyramidTensor);
+
+		// Relative errors of the energies (mean responses) and of the maps of
+		// the responses (L1 norm of the differences over the L1 norm of the
+		// direct responses), for each kernel
+		double dMaxEnergyError = 0, dSumEnergyError = 0;
+		double dMaxMapError = 0, dSumMapError = 0;
+		for(int i = 0; i < m_oBank.kernelsCount(); i++)
+		{
+			Mat oDirectPlane = GaborBank::plane(oDirectTensor, i);
+			Mat oPyramidPlane = GaborBank::plane(oPyramidTensor, i);
+
+			double dDirectEnergy = mean(oDirectPlane)[0];
+			double dEnergyError = dDirectEnergy > 0 ? std::abs(mean(oPyramidPlane)[0] - dDirectEnergy) / dDirectEnergy : 0;
+			double dDirectNorm = norm(oDirectPlane, NORM_L1);
+			double dMapError = dDirectNorm > 0 ? norm(oPyramidPlane, oDirectPlane, NORM_L1) / dDirectNorm : 0;
+
+			dMaxEnergyError = qMax(dMaxEnergyError, dEnergyError);
+			dSumEnergyError += dEnergyError;
+			dMaxMapError = qMax(dMaxMapError, dMapError);
+			dSumMapError += dMapError;
+		}
+
+		int iKernels = qMax(m_oBank.kernelsCount(), 1);
+		setMetric("energy_error_max", dMaxEnergyError);
+		setMetric("energy_error_mean", dSumEnergyError / iKernels);
+		setMetric("map_error_max", dMaxMapError);
+		setMetric("map_error_mean", dSumMapError / iKernels);
+	}
+
+	return true;
+}
+
+// +-----------------------------------------------------------
+void fsdk::BankFilterBenchmark::iterate()
+{
+	if(m_bTensor)
+		m_oBank.filter(m_oImage, m_oTensor, m_eLayout);
+	else
+	{
+		m_lResponses.clear();
+		m_oBank.filter(m_oImage, m_lResponses);
+	}
+}
+
+// +-----------------------------------------------------------
+fsdk::BatchFilterBenchmark::BatchFilterBenchmark(const int iCropSize, const int iBatchSize):
+	Benchmark("GaborBank::filter(batch)")
+{
+	m_oBank = GaborBank::defaultBank();
+	m_iCropSize = iCropSize;
+	m_iBatchSize = iBatchSize;
+	setParameter("kernels", m_oBank.kernelsCount());
+	setParameter("crop", iCropSize);
+	setParameter("batch", iBatchSize);
+	setItemsPerIteration(iBatchSize);
+}
+
+// +-----------------------------------------------------------
+bool fsdk::BatchFilterBenchmark::setUp()
+{
+	Size oSize(m_iCropSize, m_iCropSize);
+	m_lImages.clear();
+	for(int i = 0; i < m_iBatchSize; i++)
+	{
+		Point2f oCenter(m_iCropSize / 2.0f + i % 3 - 1, m_iCropSize / 2.0f + i % 2);
+		m_lImages.append(SyntheticData::faceImage(oSize, SyntheticData::landmarks(oCenter, m_iCropSize * 0.8f)));
+	}
+	return true;
+}
+
+// +-----------------------------------------------------------
+void fsdk::BatchFilterBenchmark::iterate()
+{
+	m_oBank.filter(m_lImages, m_lTensors);
+}
+
+// +-----------------------------------------------------------
+fsdk::RegionPoolingBenchmark::RegionPoolingBenchmark(const int iCropSize, const RegionPooling::RegionMode eMode, const int iStatistics):
+	Benchmark("RegionPooling::pool")
+{
+	m_iCropSize = iCropSize;
+	if(eMode == RegionPooling::Grid)
+		m_oPooling.setGrid(4, 4);
+	else if(eMode == RegionPooling::FaceParts)
+		m_oPooling.setFaceParts(FaceTrackerRegistry::backend());
+	m_oPooling.setStatistics(iStatistics);
+
+	QStringList lStatistics;
+	if(m_oPooling.statistics() & RegionPooling::Mean)
+		lStatistics.append("mean");
+	if(m_oPooling.statistics() & RegionPooling::StdDev)
+		lStatistics.append("std");
+	if(m_oPooling.statistics() & RegionPooling::Max)
+		lStatistics.append("max");
+
+	setParameter("crop", iCropSize);
+	setParameter("regions", m_oPooling.regionsCount());
+	setParameter("statistics", lStatistics.join("+"));
+}
+
+// +-----------------------------------------------------------
+bool fsdk::RegionPoolingBenchmark::setUp()
+{
+	Size oSize(m_iCropSize, m_iCropSize);
+	m_lLandmarks = SyntheticData::landmarks(Point2f(m_iCropSize / 2.0f, m_iCropSize / 2.0f), m_iCropSize * 0.8f);
+	Mat oImage = SyntheticData::faceImage(oSize, m_lLandmarks);
+	return GaborBank::defaultBank().filter(oImage, m_oTensor);
+}
+
+// +-----------------------------------------------------------
+void fsdk::RegionPoolingBenchmark::iterate()
+{
+	m_oPooling.pool(m_oTensor, m_lLandmarks, m_lValues);
+}
+
+// +-----------------------------------------------------------
+fsdk::CropBenchmark::CropBenchmark(const Size &oFrameSize):
+	Benchmark("GaborExtractionTask::cropAndNormalize")
+{
+	m_oFrameSize = oFrameSize;
+	setParameter("frame", QString("%1x%2").arg(oFrameSize.width).arg(oFrameSize.height));
+}
+
+// +-----------------------------------------------------------
+bool fsdk::CropBenchmark::setUp()
+{
+	m_lLandmarks = SyntheticData::landmarks(Point2f(m_oFrameSize.width / 2.0f, m_oFrameSize.height / 2.0f), m_oFrameSize.width * 0.4f);
+	m_oFrame = SyntheticData::faceImage(m_oFrameSize, m_lLandmarks);
+	return true;
+}
+
+// +-----------------------------------------------------------
+void fsdk::CropBenchmark::iterate()
+{
+	m_oTask.cropAndNormalize(m_oFrame, m_lLandmarks);
+}
+
+// +-----------------------------------------------------------
+fsdk::LandmarksFileBenchmark::LandmarksFileBenchmark(const QString &sName, const QString &sWorkDir, const int iFrames):
+	Benchmark(sName)
+{
+	m_sWorkDir = sWorkDir;
+	m_iFrames = iFrames;
+	setParameter("lines", iFrames);
+	setItemsPerIteration(iFrames);
+}
+
+// +-----------------------------------------------------------
+QString fsdk::LandmarksFileBenchmark::fileName() const
+{
+	return QDir(m_sWorkDir).filePath(QString("landmarks-%1.csv").arg(m_iFrames));
+}
+
+// +-----------------------------------------------------------
+bool fsdk::LandmarksFileBenchmark::setUp()
+{
+	return SyntheticData::landmarksData(LANDMARKS_FRAME_SIZE, m_iFrames).saveToCSV(fileName());
+}
+
+// +-----------------------------------------------------------
+void fsdk::LandmarksFileBenchmark::tearDown()
+{
+	QFile::remove(fileName());
+	QFile::remove(SignalPyramid::fileName(fileName()));
+}
+
+// +-----------------------------------------------------------
+fsdk::CSVWriteBenchmark::CSVWriteBenchmark(const QString &sWorkDir, const int iFrames):
+	LandmarksFileBenchmark("CSVFile::write", sWorkDir, iFrames)
+{
+}
+
+// +-----------------------------------------------------------
+bool fsdk::CSVWriteBenchmark::setUp()
+{
+	return LandmarksFileBenchmark::setUp() && m_oData.read(fileName());
+}
+
+// +-----------------------------------------------------------
+void fsdk::CSVWriteBenchmark::iterate()
+{
+	m_oData.write(fileName());
+}
+
+// +-----------------------------------------------------------
+fsdk::CSVReadBenchmark::CSVReadBenchmark(const QString &sWorkDir, const int iFrames):
+	LandmarksFileBenchmark("CSVFile::read", sWorkDir, iFrames)
+{
+}
+
+// +-----------------------------------------------------------
+void fsdk::CSVReadBenchmark::iterate()
+{
+	CSVFile oData;
+	oData.read(fileName());
+}
+
+// +-----------------------------------------------------------
+fsdk::LandmarksLoadBenchmark::LandmarksLoadBenchmark(const QString &sWorkDir, const int iFrames):
+	LandmarksFileBenchmark("LandmarksData::readFromCSV", sWorkDir, iFrames)
+{
+}
+
+// +-----------------------------------------------------------
+void fsdk::LandmarksLoadBenchmark::iterate()
+{
+	LandmarksData oData;
+	oData.readFromCSV(fileName());
+}
+
+// +-----------------------------------------------------------
+fsdk::LandmarksFilterBenchmark::LandmarksFilterBenchmark(const int iFrames):
+	Benchmark("LandmarksFilter::filter")
+{
+	m_iFrames = iFrames;
+	setParameter("frames", iFrames);
+	setItemsPerIteration(iFrames);
+}
+
+// +-----------------------------------------------------------
+bool fsdk::LandmarksFilterBenchmark::setUp()
+{
+	LandmarksData oData = SyntheticData::landmarksData(Size(1280, 720), m_iFrames);
+	for(int i = 0; i < m_iFrames; i++)
+		m_lLandmarks.append(oData.landmarks(i));
+	return true;
+}
+
+// +-----------------------------------------------------------
+void fsdk::LandmarksFilterBenchmark::iterate()
+{
+	m_oFilter.reset();
+	for(int i = 0; i < m_lLandmarks.count(); i++)
+		m_oFilter.filter(i, m_lLandmarks[i]);
+}
+
+// +-----------------------------------------------------------
+fsdk::VideoDecodeBenchmark::VideoDecodeBenchmark(const QString &sWorkDir, const Size &oFrameSize, const int iFrames):
+	Benchmark("VideoCapture::read")
+{
+	m_oFrameSize = oFrameSize;
+	m_iFrames = iFrames;
+	m_sFileName = QDir(sWorkDir).filePath(QString("video-%1x%2.avi").arg(oFrameSize.width).arg(oFrameSize.height));
+	setParameter("frame", QString("%1x%2").arg(oFrameSize.width).arg(oFrameSize.height));
+	setParameter("frames", iFrames);
+	setItemsPerIteration(iFrames);
+}
+
+// +-----------------------------------------------------------
+bool fsdk::VideoDecodeBenchmark::setUp()
+{
+	return SyntheticData::writeVideo(m_sFileName, m_oFrameSize, m_iFrames);
+}
+
+// +-----------------------------------------------------------
+void fsdk::VideoDecodeBenchmark::tearDown()
+{
+	QFile::remove(m_sFileName);
+}
+
+// +-----------------------------------------------------------
+void fsdk::VideoDecodeBenchmark::iterate()
+{
+	VideoCapture oCap(m_sFileName.toStdString());
+	Mat oFrame;
+	while(oCap.read(oFrame))
+		;
+}
+
+// +-----------------------------------------------------------
+fsdk::BenchDecodeTask::BenchDecodeTask(const QString &sInputFile, const DecodeMode eMode):
+	ExtractionTask(sInputFile)
+{
+	setDecodeMode(eMode);
+}
+
+// +-----------------------------------------------------------
+void fsdk::BenchDecodeTask::run()
+{
+	if(!start())
+		return;
+
+	while(!nextFrame().empty())
+	{
+		if(frame().channels() == 3)
+			cvtColor(frame(), m_oGray, CV_BGR2GRAY);
+		else
+			m_oGray = frame();
+	}
+	end(QVariant());
+}
+
+// +-----------------------------------------------------------
+fsdk::FrameDecodeBenchmark::FrameDecodeBenchmark(const QString &sWorkDir, const Size &oFrameSize, const int iFrames, const ExtractionTask::DecodeMode eMode):
+	Benchmark("ExtractionTask::nextFrame")
+{
+	m_oFrameSize = oFrameSize;
+	m_iFrames = iFrames;
+	m_eMode = eMode;
+	m_sFileName = QDir(sWorkDir).filePath(QString("decode-%1x%2.avi").arg(oFrameSize.width).arg(oFrameSize.height));
+	setParameter("frame", QString("%1x%2").arg(oFrameSize.width).arg(oFrameSize.height));
+	setParameter("frames", iFrames);
+	setParameter("decode", eMode == ExtractionTask::LumaDecode ? "luma" : "color");
+	setItemsPerIteration(iFrames);
+}
+
+// +-----------------------------------------------------------
+bool fsdk::FrameDecodeBenchmark::setUp()
+{
+	return SyntheticData::writeVideo(m_sFileName, m_oFrameSize, m_iFrames);
+}
+
+// +-----------------------------------------------------------
+void fsdk::FrameDecodeBenchmark::tearDown()
+{
+	QFile::remove(m_sFileName);
+}
+
+// +-----------------------------------------------------------
+void fsdk::FrameDecodeBenchmark::iterate()
+{
+	BenchDecodeTask oTask(m_sFileName, m_eMode);
+	oTask.run();
+}
+
+// +-----------------------------------------------------------
+fsdk::FaceTrackingBenchmark::FaceTrackingBenchmark(const Size &oFrameSize, const int iFrames, const double dScale, const bool bUseROI, const QString &sBackend):
+	Benchmark("FaceTracker::track")
+{
+	m_sBackend = sBackend.isEmpty() ? FaceTrackerRegistry::defaultBackend() : sBackend;
+	m_oFrameSize = oFrameSize;
+	m_iFrames = iFrames;
+	m_dScale = dScale;
+	m_bUseROI = bUseROI;
+	m_pTracker = NULL;
+	setParameter("tracker", m_sBackend);
+	setParameter("frame", QString("%1x%2").arg(oFrameSize.width).arg(oFrameSize.height));
+	setParameter("frames", iFrames);
+	if(dScale < 1.0 || bUseROI)
+	{
+		setParameter("scale", dScale);
+		setParameter("roi", bUseROI);
+	}
+	setItemsPerIteration(iFrames);
+}
+
+// +-----------------------------------------------------------
+fsdk::FaceTrackingBenchmark::~FaceTrackingBenchmark()
+{
+	tearDown();
+}
+
+// +-----------------------------------------------------------
+bool fsdk::FaceTrackingBenchmark::setUp()
+{
+	// The CSIRO tracker throws a pointer to the exception if it fails to load its models
+	try
+	{
+		m_pTracker = FaceTrackerRegistry::create(m_sBackend);
+	}
+	catch(std::runtime_error *pException)
+	{
+		delete pException;
+		m_pTracker = NULL;
+	}
+	if(!m_pTracker)
+		return false;
+
+	// The frames are the same of the synthetic videos (the schematic face
+	// is not necessarily detected, so this mostly measures the detection
+	// path followed while the tracker searches for a face)
+	if(m_dScale < 1.0 || m_bUseROI)
+		m_pTracker = new ScaledFaceTracker(m_pTracker, m_dScale, m_bUseROI);
+
+	LandmarksData oData = SyntheticData::landmarksData(m_oFrameSize, m_iFrames);
+	for(int i = 0; i < m_iFrames; i++)
+	{
+		Mat oFrame;
+		cvtColor(SyntheticData::faceImage(m_oFrameSize, oData.landmarks(i), i), oFrame, CV_GRAY2BGR);
+		m_lFrames.append(oFrame);
+	}
+
+	return true;
+}
+
+// +-----------------------------------------------------------
+void fsdk::FaceTrackingBenchmark::tearDown()
+{
+	if(m_pTracker)
+	{
+		delete m_pTracker;
+		m_pTracker = NULL;
+	}
+	m_lFrames.clear();
+}
+
+// +-----------------------------------------------------------
+void fsdk::FaceTrackingBenchmark::iterate()
+{
+	m_pTracker->reset();
+	for(int i = 0; i < m_lFrames.count(); i++)
+	{
+		m_pTracker->track(m_lFrames[i]);
+		if(m_pTracker->getQuality() < RESET_QUALITY)
+			m_pTracker->reset();
+	}
+}
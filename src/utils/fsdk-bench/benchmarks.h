@@ -0,0 +1,681 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+#include "benchmark.h"
+#include "gaborkernel.h"
+#include "gaborbank.h"
+#include "gaborextractiontask.h"
+#include "regionpooling.h"
+#include "landmarksfilter.h"
+#include "csvfile.h"
+#include <opencv2/opencv.hpp>
+#include <QList>
+
+namespace fsdk
+{
+	class FaceTracker;
+
+	/**
+	 * Gabor kernel that exposes the (protected) rebuilding of its components.
+	 */
+	class BenchKernel: public GaborKernel
+	{
+	public:
+		/**
+		 * Class constructor.
+		 * @param dTheta Double with the orientation of the kernel (in radians).
+		 * @param dLambda Double with the wavelength of the kernel (in pixels).
+		 */
+		BenchKernel(const double dTheta, const double dLambda): GaborKernel(dTheta, dLambda) {};
+
+		using GaborKernel::rebuildKernel;
+	};
+
+	/**
+	 * Gabor extraction task that exposes the (protected) cropping and
+	 * normalization of the face region.
+	 */
+	class BenchGaborTask: public GaborExtractionTask
+	{
+	public:
+		/**
+		 * Class constructor.
+		 */
+		BenchGaborTask(): GaborExtractionTask("", "") {};
+
+		using GaborExtractionTask::cropAndNormalize;
+	};
+
+	/**
+	 * Measures GaborKernel::rebuildKernel() (the window size grows with
+	 * the wavelength).
+	 */
+	class KernelRebuildBenchmark: public Benchmark
+	{
+	public:
+		/**
+		 * Class constructor.
+		 * @param dLambda Double with the wavelength of the kernel (in pixels).
+		 */
+		KernelRebuildBenchmark(const double dLambda);
+
+	protected:
+
+		/**
+		 * Rebuilds the kernel.
+		 */
+		void iterate();
+
+	private:
+
+		/** Kernel rebuilt. */
+		BenchKernel m_oKernel;
+	};
+
+	/**
+	 * Measures GaborKernel::filter() on a synthetic face crop.
+	 */
+	class KernelFilterBenchmark: public Benchmark
+	{
+	public:
+		/**
+		 * Class constructor.
+		 * @param dLambda Double with the wavelength of the kernel (in pixels).
+		 * @param iCropSize Integer with the size (width and height) of the crop.
+		 * @param ePrecision Value of the GaborKernel::Precision enumeration with the
+		 * precision of the filtering. The default is GaborKernel::FloatPrecision.
+		 * With the fixed-point precision, the errors of the quantization and of the
+		 * responses against the float precision are reported as metrics.
+		 */
+		KernelFilterBenchmark(const double dLambda, const int iCropSize, const GaborKernel::Precision ePrecision = GaborKernel::FloatPrecision);
+
+	protected:
+
+		/**
+		 * Generates the crop image (and, with the fixed-point precision, measures
+		 * the errors against the float precision).
+		 * @return Boolean indicating if the set up was successful (always true).
+		 */
+		bool setUp();
+
+		/**
+		 * Filters the crop image with the kernel.
+		 */
+		void iterate();
+
+	private:
+
+		/** Kernel used to filter. */
+		GaborKernel m_oKernel;
+
+		/** Size of the crop image. */
+		int m_iCropSize;
+
+		/** Crop image. */
+		cv::Mat m_oImage;
+
+		/** Responses of the filtering. */
+		cv::Mat m_oResponses;
+	};
+
+	/**
+	 * Measures GaborBank::filter() on a synthetic face crop.
+	 */
+	class BankFilterBenchmark: public Benchmark
+	{
+	public:
+		/**
+		 * Class constructor.
+		 * @param iWavelengths Integer with the number of wavelengths of the bank
+		 * (the first ones of the default bank).
+		 * @param iOrientations Integer with the number of orientations of the bank
+		 * (evenly distributed in [0, PI)).
+		 * @param iCropSize Integer with the size (width and height) of the crop.
+		 * @param bTensor Boolean indicating if the responses are written to a single
+		 * tensor (true) or to a list of Mats (false, the default).
+		 * @param eLayout Value of the GaborBank::TensorLayout enumeration with the
+		 * layout of the tensor (if used). The default is GaborBank::PlanarLayout.
+		 * @param bPyramid Boolean indicating if the bank uses the multi-scale
+		 * (pyramid) filtering (true) or not (false, the default).
+		 * @param ePrecision Value of the GaborKernel::Precision enumeration with the
+		 * precision of the filtering. The default is GaborKernel::FloatPrecision.
+		 * With the pyramid or the fixed-point precision, the relative errors of the
+		 * responses against the direct filtering in float are reported as metrics.
+		 */
+		BankFilterBenchmark(const int iWavelengths, const int iOrientations, const int iCropSize, const bool bTensor = false, const GaborBank::TensorLayout eLayout = GaborBank::PlanarLayout, const bool bPyramid = false, const GaborKernel::Precision ePrecision = GaborKernel::FloatPrecision);
+
+	protected:
+
+		/**
+		 * Generates the crop image (and, with the pyramid or the fixed-point
+		 * precision, measures the errors against the direct filtering in float).
+		 * @return Boolean indicating if the set up was successful (always true).
+		 */
+		bool setUp();
+
+		/**
+		 * Filters the crop image with the bank.
+		 */
+		void iterate();
+
+	private:
+
+		/** Bank used to filter. */
+		GaborBank m_oBank;
+
+		/** Size of the crop image. */
+		int m_iCropSize;
+
+		/** Crop image. */
+		cv::Mat m_oImage;
+
+		/** Responses of the filtering. */
+		QList<cv::Mat> m_lResponses;
+
+		/** Indicates if the responses are written to a single tensor. */
+		bool m_bTensor;
+
+		/** Layout of the tensor. */
+		GaborBank::TensorLayout m_eLayout;
+
+		/** Tensor with the responses of the filtering (reused among the iterations). */
+		cv::Mat m_oTensor;
+	};
+
+	/**
+	 * Measures GaborBank::filter() on a batch of synthetic face crops (with the
+	 * default bank and the planar layout).
+	 */
+	class BatchFilterBenchmark: public Benchmark
+	{
+	public:
+		/**
+		 * Class constructor.
+		 * @param iCropSize Integer with the size (width and height) of the crops.
+		 * @param iBatchSize Integer with the number of crops in the batch.
+		 */
+		BatchFilterBenchmark(const int iCropSize, const int iBatchSize);
+
+	protected:
+
+		/**
+		 * Generates the crop images (each with the face slightly displaced).
+		 * @return Boolean indicating if the set up was successful (always true).
+		 */
+		bool setUp();
+
+		/**
+		 * Filters the batch of crops with the bank.
+		 */
+		void iterate();
+
+	private:
+
+		/** Bank used to filter. */
+		GaborBank m_oBank;
+
+		/** Size of the crop images. */
+		int m_iCropSize;
+
+		/** Number of crops in the batch. */
+		int m_iBatchSize;
+
+		/** Crop images. */
+		QList<cv::Mat> m_lImages;
+
+		/** Tensors with the responses of the filtering (reused among the iterations). */
+		QList<cv::Mat> m_lTensors;
+	};
+
+	/**
+	 * Measures RegionPooling::pool() on the responses of the default bank.
+	 */
+	class RegionPoolingBenchmark: public Benchmark
+	{
+	public:
+		/**
+		 * Class constructor.
+		 * @param iCropSize Integer with the size (width and height) of the crop.
+		 * @param eMode Value of the RegionPooling::RegionMode enumeration with the
+		 * regions (the grid has 4x4 cells).
+		 * @param iStatistics Integer with the combination of values of the
+		 * RegionPooling::Statistic enumeration computed.
+		 */
+		RegionPoolingBenchmark(const int iCropSize, const RegionPooling::RegionMode eMode, const int iStatistics);
+
+	protected:
+
+		/**
+		 * Generates the crop image and filters it with the bank.
+		 * @return Boolean indicating if the set up was successful (true) or
+		 * not (false).
+		 */
+		bool setUp();
+
+		/**
+		 * Pools the responses over the regions.
+		 */
+		void iterate();
+
+	private:
+
+		/** Pooling measured. */
+		RegionPooling m_oPooling;
+
+		/** Size of the crop image. */
+		int m_iCropSize;
+
+		/** Landmarks of the face in the crop image. */
+		QList<QPoint> m_lLandmarks;
+
+		/** Tensor with the responses of the default bank. */
+		cv::Mat m_oTensor;
+
+		/** Values pooled. */
+		QList<float> m_lValues;
+	};
+
+	/**
+	 * Measures GaborExtractionTask::cropAndNormalize() on a synthetic frame.
+	 */
+	class CropBenchmark: public Benchmark
+	{
+	public:
+		/**
+		 * Class constructor.
+		 * @param oFrameSize OpenCV's Size with the size of the frame.
+		 */
+		CropBenchmark(const cv::Size &oFrameSize);
+
+	protected:
+
+		/**
+		 * Generates the frame and its landmarks.
+		 * @return Boolean indicating if the set up was successful (always true).
+		 */
+		bool setUp();
+
+		/**
+		 * Crops and normalizes the face region of the frame.
+		 */
+		void iterate();
+
+	private:
+
+		/** Task that implements the cropping. */
+		BenchGaborTask m_oTask;
+
+		/** Size of the frame. */
+		cv::Size m_oFrameSize;
+
+		/** Frame image. */
+		cv::Mat m_oFrame;
+
+		/** Landmarks of the face in the frame. */
+		QList<QPoint> m_lLandmarks;
+	};
+
+	/**
+	 * Base class for the benchmarks that use files with synthetic landmarks
+	 * data (written by setUp() in a working directory).
+	 */
+	class LandmarksFileBenchmark: public Benchmark
+	{
+	public:
+		/**
+		 * Class constructor.
+		 * @param sName QString with the name of the benchmark.
+		 * @param sWorkDir QString with the directory where to write the files.
+		 * @param iFrames Integer with the number of frames (lines) in the file.
+		 */
+		LandmarksFileBenchmark(const QString &sName, const QString &sWorkDir, const int iFrames);
+
+	protected:
+
+		/**
+		 * Writes the landmarks file.
+		 * @return Boolean indicating if the set up was successful (true) or not (false).
+		 */
+		bool setUp();
+
+		/**
+		 * Removes the files written.
+		 */
+		void tearDown();
+
+		/**
+		 * Gets the name of the landmarks file.
+		 * @return QString with the name of the file.
+		 */
+		QString fileName() const;
+
+	private:
+
+		/** Directory where the files are written. */
+		QString m_sWorkDir;
+
+		/** Number of frames in the file. */
+		int m_iFrames;
+	};
+
+	/**
+	 * Measures CSVFile::write() with the contents of a landmarks file.
+	 */
+	class CSVWriteBenchmark: public LandmarksFileBenchmark
+	{
+	public:
+		/**
+		 * Class constructor.
+		 * @param sWorkDir QString with the directory where to write the files.
+		 * @param iFrames Integer with the number of frames (lines) in the file.
+		 */
+		CSVWriteBenchmark(const QString &sWorkDir, const int iFrames);
+
+	protected:
+
+		/**
+		 * Loads the contents to write.
+		 * @return Boolean indicating if the set up was successful (true) or not (false).
+		 */
+		bool setUp();
+
+		/**
+		 * Writes the contents to the file.
+		 */
+		void iterate();
+
+	private:
+
+		/** Contents written. */
+		CSVFile m_oData;
+	};
+
+	/**
+	 * Measures CSVFile::read() of a landmarks file.
+	 */
+	class CSVReadBenchmark: public LandmarksFileBenchmark
+	{
+	public:
+		/**
+		 * Class constructor.
+		 * @param sWorkDir QString with the directory where to write the files.
+		 * @param iFrames Integer with the number of frames (lines) in the file.
+		 */
+		CSVReadBenchmark(const QString &sWorkDir, const int iFrames);
+
+	protected:
+
+		/**
+		 * Reads the file.
+		 */
+		void iterate();
+	};
+
+	/**
+	 * Measures LandmarksData::readFromCSV().
+	 */
+	class LandmarksLoadBenchmark: public LandmarksFileBenchmark
+	{
+	public:
+		/**
+		 * Class constructor.
+		 * @param sWorkDir QString with the directory where to write the files.
+		 * @param iFrames Integer with the number of frames (lines) in the file.
+		 */
+		LandmarksLoadBenchmark(const QString &sWorkDir, const int iFrames);
+
+	protected:
+
+		/**
+		 * Loads the landmarks data from the file.
+		 */
+		void iterate();
+	};
+
+	/**
+	 * Measures LandmarksFilter::filter() on the landmarks of a synthetic video.
+	 */
+	class LandmarksFilterBenchmark: public Benchmark
+	{
+	public:
+		/**
+		 * Class constructor.
+		 * @param iFrames Integer with the number of frames filtered per iteration.
+		 */
+		LandmarksFilterBenchmark(const int iFrames);
+
+	protected:
+
+		/**
+		 * Generates the landmarks.
+		 * @return Boolean indicating if the set up was successful (always true).
+		 */
+		bool setUp();
+
+		/**
+		 * Filters the landmarks of all frames.
+		 */
+		void iterate();
+
+	private:
+
+		/** Number of frames filtered per iteration. */
+		int m_iFrames;
+
+		/** Landmarks of the frames. */
+		QList<QList<QPoint>> m_lLandmarks;
+
+		/** Filter used. */
+		LandmarksFilter m_oFilter;
+	};
+
+	/**
+	 * Measures the decoding of all frames of a synthetic video.
+	 */
+	class VideoDecodeBenchmark: public Benchmark
+	{
+	public:
+		/**
+		 * Class constructor.
+		 * @param sWorkDir QString with the directory where to write the video.
+		 * @param oFrameSize OpenCV's Size with the size of the frames.
+		 * @param iFrames Integer with the number of frames in the video.
+		 */
+		VideoDecodeBenchmark(const QString &sWorkDir, const cv::Size &oFrameSize, const int iFrames);
+
+	protected:
+
+		/**
+		 * Writes the video.
+		 * @return Boolean indicating if the set up was successful (true) or not (false).
+		 */
+		bool setUp();
+
+		/**
+		 * Removes the video.
+		 */
+		void tearDown();
+
+		/**
+		 * Decodes all frames of the video.
+		 */
+		void iterate();
+
+	private:
+
+		/** Name of the video file. */
+		QString m_sFileName;
+
+		/** Size of the frames. */
+		cv::Size m_oFrameSize;
+
+		/** Number of frames in the video. */
+		int m_iFrames;
+	};
+
+	/**
+	 * Extraction task that only decodes the frames of its input file and gets
+	 * their gray levels (as the face trackers and the Gabor filtering do).
+	 */
+	class BenchDecodeTask: public ExtractionTask
+	{
+	public:
+		/**
+		 * Class constructor.
+		 * @param sInputFile QString with the name of the video file.
+		 * @param eMode Value of the ExtractionTask::DecodeMode enumeration with
+		 * how the frames are decoded.
+		 */
+		BenchDecodeTask(const QString &sInputFile, const DecodeMode eMode);
+
+		/**
+		 * Decodes all frames of the video.
+		 */
+		void run();
+
+	private:
+
+		/** Buffer with the gray levels of the frames (reused between the frames). */
+		cv::Mat m_oGray;
+	};
+
+	/**
+	 * Measures ExtractionTask::nextFrame() with the frames decoded in BGR (and
+	 * converted to gray by the consumer) or with only their luma kept.
+	 */
+	class FrameDecodeBenchmark: public Benchmark
+	{
+	public:
+		/**
+		 * Class constructor.
+		 * @param sWorkDir QString with the directory where to write the video.
+		 * @param oFrameSize OpenCV's Size with the size of the frames.
+		 * @param iFrames Integer with the number of frames in the video.
+		 * @param eMode Value of the ExtractionTask::DecodeMode enumeration with
+		 * how the frames are decoded.
+		 */
+		FrameDecodeBenchmark(const QString &sWorkDir, const cv::Size &oFrameSize, const int iFrames, const ExtractionTask::DecodeMode eMode);
+
+	protected:
+
+		/**
+		 * Writes the video.
+		 * @return Boolean indicating if the set up was successful (true) or not (false).
+		 */
+		bool setUp();
+
+		/**
+		 * Removes the video.
+		 */
+		void tearDown();
+
+		/**
+		 * Decodes all frames of the video with an extraction task.
+		 */
+		void iterate();
+
+	private:
+
+		/** Name of the video file. */
+		QString m_sFileName;
+
+		/** Size of the frames. */
+		cv::Size m_oFrameSize;
+
+		/** Number of frames in the video. */
+		int m_iFrames;
+
+		/** How the frames are decoded. */
+		ExtractionTask::DecodeMode m_eMode;
+	};
+
+	/**
+	 * Measures FaceTracker::track() of a registered backend (with the resets done
+	 * by the landmarks extraction) on the frames of a synthetic video, at full
+	 * resolution or with the reduced resolution/ROI tracking of ScaledFaceTracker.
+	 */
+	class FaceTrackingBenchmark: public Benchmark
+	{
+	public:
+		/**
+		 * Class constructor.
+		 * @param oFrameSize OpenCV's Size with the size of the frames.
+		 * @param iFrames Integer with the number of frames tracked per iteration.
+		 * @param dScale Double with the scale factor applied to the frames before
+		 * tracking (1 means full resolution).
+		 * @param bUseROI Boolean indicating if the tracking is done only on a
+		 * region around the face.
+		 * @param sBackend QString with the name of the face tracker backend (if
+		 * empty, the default backend is used).
+		 */
+		FaceTrackingBenchmark(const cv::Size &oFrameSize, const int iFrames, const double dScale = 1.0, const bool bUseROI = false, const QString &sBackend = QString());
+
+		/**
+		 * Class destructor.
+		 */
+		virtual ~FaceTrackingBenchmark();
+
+	protected:
+
+		/**
+		 * Generates the frames and creates the tracker.
+		 * @return Boolean indicating if the set up was successful (true) or not
+		 * (false, if the tracker could not be created).
+		 */
+		bool setUp();
+
+		/**
+		 * Destroys the tracker and the frames.
+		 */
+		void tearDown();
+
+		/**
+		 * Tracks the face in all frames.
+		 */
+		void iterate();
+
+	private:
+
+		/** Size of the frames. */
+		cv::Size m_oFrameSize;
+
+		/** Number of frames tracked per iteration. */
+		int m_iFrames;
+
+		/** Frames tracked. */
+		QList<cv::Mat> m_lFrames;
+
+		/** Scale factor applied to the frames before tracking. */
+		double m_dScale;
+
+		/** Indicates if the tracking is done only on a region around the face. */
+		bool m_bUseROI;
+
+		/** Name of the face tracker backend. */
+		QString m_sBackend;
+
+		/** Face tracker. */
+		FaceTracker *m_pTracker;
+	};
+}
+
+#endif // BENCHMARKS_H
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "syntheticdata.h"
+#include <QtMath>
+
+using namespace cv;
+
+// +-----------------------------------------------------------
+void fsdk::SyntheticData::appendArc(QList<QPoint> &lPoints, const Point2f &oCenter, const Size2f &oAxes, const double dStart, const double dEnd, const int iCount)
+{
+	for(int i = 0; i < iCount; i++)
+	{
+		double dAngle = qDegreesToRadians(iCount == 1 ? dStart : dStart + (dEnd - dStart) * i / (iCount - 1));
+		lPoints.append(QPoint(qRound(oCenter.x + oAxes.width * qCos(dAngle)), qRound(oCenter.y + oAxes.height * qSin(dAngle))));
+	}
+}
+
+// +-----------------------------------------------------------
+QList<QPoint> fsdk::SyntheticData::landmarks(const Point2f &oCenter, const float fWidth)
+{
+	// Layout of the 66 landmarks of the CSIRO tracker: jaw (0-16), right and
+	// left brows (17-26), nose (27-35), right and left eyes (36-47), outer
+	// and inner lips (48-65)
+	QList<QPoint> lRet;
+	float fUnit = fWidth / 2;
+	Point2f oRightEye(oCenter.x - fUnit * 0.4f, oCenter.y - fUnit * 0.25f);
+	Point2f oLeftEye(oCenter.x + fUnit * 0.4f, oCenter.y - fUnit * 0.25f);
+	Point2f oMouth(oCenter.x, oCenter.y + fUnit * 0.55f);
+
+	appendArc(lRet, oCenter, Size2f(fUnit, fUnit * 1.1f), 180, 0, 17);
+	appendArc(lRet, Point2f(oRightEye.x, oRightEye.y - fUnit * 0.1f), Size2f(fUnit * 0.25f, fUnit * 0.1f), 180, 360, 5);
+	appendArc(lRet, Point2f(oLeftEye.x, oLeftEye.y - fUnit * 0.1f), Size2f(fUnit * 0.25f, fUnit * 0.1f), 180, 360, 5);
+	for(int i = 0; i < 4; i++)
+		lRet.append(QPoint(qRound(oCenter.x), qRound(oCenter.y - fUnit * 0.2f + i * fUnit * 0.13f)));
+	appendArc(lRet, Point2f(oCenter.x, oCenter.y + fUnit * 0.25f), Size2f(fUnit * 0.2f, fUnit * 0.05f), 180, 0, 5);
+	appendArc(lRet, oRightEye, Size2f(fUnit * 0.18f, fUnit * 0.08f), 180, 360, 4);
+	appendArc(lRet, oRightEye, Size2f(fUnit * 0.18f, fUnit * 0.08f), 60, 120, 2);
+	appendArc(lRet, oLeftEye, Size2f(fUnit * 0.18f, fUnit * 0.08f), 180, 360, 4);
+	appendArc(lRet, oLeftEye, Size2f(fUnit * 0.18f, fUnit * 0.08f), 60, 120, 2);
+	appendArc(lRet, oMouth, Size2f(fUnit * 0.35f, fUnit * 0.15f), 180, 540, 12);
+	appendArc(lRet, oMouth, Size2f(fUnit * 0.25f, fUnit * 0.06f), 180, 360, 3);
+	appendArc(lRet, oMouth, Size2f(fUnit * 0.25f, fUnit * 0.06f), 0, 180, 3);
+
+	// The eye arcs above start at the outer corner of the right eye and at the
+	// inner corner of the left eye, as expected by the tracker layout
+	return lRet;
+}
+
+// +-----------------------------------------------------------
+Mat fsdk::SyntheticData::faceImage(const Size &oSize, const QList<QPoint> &lLandmarks, const int iSeed)
+{
+	Mat oRet(oSize, CV_8UC1);
+	RNG oRng(iSeed);
+	oRng.fill(oRet, RNG::NORMAL, Scalar(110), Scalar(25));
+	GaussianBlur(oRet, oRet, Size(5, 5), 0);
+
+	// Draw the face, eyes, nose and mouth with the contours of the landmarks
+	std::vector<Point> vPoints;
+	foreach(QPoint oPoint, lLandmarks)
+		vPoints.push_back(Point(oPoint.x(), oPoint.y()));
+
+	std::vector<Point> vJaw(vPoints.begin(), vPoints.begin() + 17);
+	Rect oFace = boundingRect(vJaw);
+	ellipse(oRet, Point(oFace.x + oFace.width / 2, oFace.y), Size(oFace.width / 2, oFace.height), 0, 0, 360, Scalar(170), -1);
+
+	const int aContours[][2] = { { 17, 22 }, { 22, 27 }, { 27, 31 }, { 31, 36 }, { 36, 42 }, { 42, 48 }, { 48, 60 }, { 60, 66 } };
+	for(uint i = 0; i < sizeof(aContours) / sizeof(aContours[0]); i++)
+	{
+		std::vector<Point> vContour(vPoints.begin() + aContours[i][0], vPoints.begin() + aContours[i][1]);
+		polylines(oRet, vContour, i >= 4, Scalar(40), 2, CV_AA);
+	}
+
+	return oRet;
+}
+
+// +-----------------------------------------------------------
+Point2f fsdk::SyntheticData::faceCenter(const Size &oSize, const int iFrame)
+{
+	return Point2f(oSize.width / 2.0f + 20 * std::sin(iFrame / 25.0), oSize.height / 2.0f + 10 * std::cos(iFrame / 40.0));
+}
+
+// +-----------------------------------------------------------
+fsdk::LandmarksData fsdk::SyntheticData::landmarksData(const Size &oSize, const int iFrames)
+{
+	LandmarksData oRet;
+	float fWidth = oSize.width * 0.4f;
+	for(int i = 0; i < iFrames; i++)
+		oRet.add(i, landmarks(faceCenter(oSize, i), fWidth), 0.5f + 0.5f * std::sin(i / 100.0));
+	return oRet;
+}
+
+// +-----------------------------------------------------------
+bool fsdk::SyntheticData::writeVideo(const QString &sFileName, const Size &oSize, const int iFrames, const double dFrameRate)
+{
+	VideoWriter oWriter(sFileName.toStdString(), CV_FOURCC('M', 'J', 'P', 'G'), dFrameRate, oSize, true);
+	if(!oWriter.isOpened())
+		return false;
+
+	float fWidth = oSize.width * 0.4f;
+	Mat oFrame;
+	for(int i = 0; i < iFrames; i++)
+	{
+		cvtColor(faceImage(oSize, landmarks(faceCenter(oSize, i), fWidth), i), oFrame, CV_GRAY2BGR);
+		oWriter << oFrame;
+	}
+
+	return true;
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2016-2017 Luiz Carlos Vieira (http://www.luiz.vieira.nom.br)
+ *
+ * This file is part of Fun SDK (FSDK).
+ *
+ * FSDK is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FSDK is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SYNTHETICDATA_H
+#define SYNTHETICDATA_H
+
+#include "landmarksdata.h"
+#include <opencv2/opencv.hpp>
+#include <QList>
+#include <QPoint>
+
+namespace fsdk
+{
+	/**
+	 * Generates the synthetic images, videos and data files used by the
+	 * benchmarks, so they do not depend on recorded sessions. The images
+	 * contain a schematic face (with textured noise) and the corresponding
+	 * 66 landmarks in the layout used by the CSIRO face tracker.
+	 */
+	class SyntheticData
+	{
+	public:
+
+		/**
+		 * Generates the landmarks of a face.
+		 * @param oCenter OpenCV's Point2f with the center of the face.
+		 * @param fWidth Float with the width of the face in pixels.
+		 * @return QList of QPoint with the 66 landmarks of the face.
+		 */
+		static QList<QPoint> landmarks(const cv::Point2f &oCenter, const float fWidth);
+
+		/**
+		 * Generates a grayscale image with a face drawn over a noisy background.
+		 * @param oSize OpenCV's Size with the size of the image.
+		 * @param lLandmarks QList of QPoint with the landmarks of the face (as
+		 * generated by landmarks()).
+		 * @param iSeed Integer with the seed of the noise.
+		 * @return OpenCV's Mat with the image (CV_8UC1).
+		 */
+		static cv::Mat faceImage(const cv::Size &oSize, const QList<QPoint> &lLandmarks, const int iSeed = 0);
+
+		/**
+		 * Generates the landmarks data of a video in which the face slowly
+		 * moves around the center of the frames.
+		 * @param oSize OpenCV's Size with the size of the frames.
+		 * @param iFrames Integer with the number of frames.
+		 * @return LandmarksData with the landmarks and qualities of each frame.
+		 */
+		static LandmarksData landmarksData(const cv::Size &oSize, const int iFrames);
+
+		/**
+		 * Writes a video file (MJPG codec) with the frames of a face slowly
+		 * moving around the center of the frames (matching landmarksData()).
+		 * @param sFileName QString with the name of the video file.
+		 * @param oSize OpenCV's Size with the size of the frames.
+		 * @param iFrames Integer with the number of frames.
+		 * @param dFrameRate Double with the frame rate of the video.
+		 * @return Boolean indicating if the video was written (true) or not (false).
+		 */
+		static bool writeVideo(const QString &sFileName, const cv::Size &oSize, const int iFrames, const double dFrameRate = 30);
+
+	protected:
+
+		/**
+		 * Gets the center of the face in a frame of the synthetic videos.
+		 * @param oSize OpenCV's Size with the size of the frames.
+		 * @param iFrame Integer with the index of the frame.
+		 * @return OpenCV's Point2f with the center of the face.
+		 */
+		static cv::Point2f faceCenter(const cv::Size &oSize, const int iFrame);
+
+		/**
+		 * Appends points along an elliptical arc to a list of landmarks.
+		 * @param lPoints Reference to the QList of QPoint to append to.
+		 * @param oCenter OpenCV's Point2f with the center of the ellipse.
+		 * @param oAxes OpenCV's Size2f with the half-axes of the ellipse.
+		 * @param dStart Double with the start angle in degrees.
+		 * @param dEnd Double with the end angle in degrees.
+		 * @param iCount Integer with the number of points to append.
+		 */
+		static void appendArc(QList<QPoint> &lPoints, const cv::Point2f &oCenter, const cv::Size2f &oAxes, const double dStart, const double dEnd, const int iCount);
+	};
+}
+
+#endif // SYNTHETICDATA_H
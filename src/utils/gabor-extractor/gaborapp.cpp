@@ -25,7 +25,14 @@
 #include <QThreadPool>
 #include <QRegExp>
 #include "naming.h"
+#include "facetrackerregistry.h"
+#include "livesource.h"
+#include "imagesequence.h"
+#include "resultcache.h"
 #include <QRegularExpression>
+#include <QJsonDocument>
+#include <QFile>
+#include <QFileInfo>
 #include "gaborbank.h"
 #include "imageman.h"
 
@@ -40,11 +47,32 @@
 fsdk::GaborApp::GaborApp(int &argc, char **argv, const QString &sOrgName, const QString &sOrgDomain, const QString &sAppName, const QString &sAppVersion, const bool bUseSettings):
 	Application(argc, argv, sOrgName, sOrgDomain, sAppName, sAppVersion, bUseSettings)
 {
+	m_bPrintProfile = false;
+	m_bResume = false;
+	m_iCheckpointInterval = 60;
+	m_bSmoothing = false;
+	m_iMaxGap = 5;
+	m_bPyramid = false;
+	m_bFixedPoint = false;
+	m_iBatchSize = 1;
+	m_bGating = false;
+	m_dGateThreshold = 2.0;
+	m_iGateMaxReused = 30;
+	m_bGateValidate = false;
+	m_bLumaDecode = false;
+	m_bStreaming = false;
+	m_iLiveQueueSize = 2;
+	m_iLiveMaxLatency = 200;
+	m_iLiveDuration = 0;
+	m_iPublishCapacity = 256;
+
 	// Replace the original message pattern from the parent class Application.
 	// i.e.: - remove the source and line number from trace even in debug;
 	//       - add the progress level instead of the log type;
 	qSetMessagePattern("%{time yyyy.MM.dd h:mm:ss.zzz} [%{if-critical}l1%{endif}%{if-warning}l2%{endif}%{if-info}l3%{endif}%{if-debug}l4%{endif}]: %{message}");
 	setLogLevel(Critical);
+
+	connect(&m_oProber, &InputProber::inputProbed, this, &GaborApp::inputProbed);
 }
 
 // +-----------------------------------------------------------
@@ -60,13 +88,22 @@ fsdk::GaborApp::CommandLineParseResult fsdk::GaborApp::parseCommandLine()
 
 	// Input file option
 	oParser.addPositionalArgument("input file",
-		tr("Image or video file (wildcard masks can be used) to use for the Gabor responses extraction."),
+		tr("Image or video file (wildcard masks can be used) to use for the Gabor responses extraction, "
+		   "or a live input: camera:<index> for a camera device, or pipe:<width>x<height>[@<fps>]:<path> "
+		   "for a named pipe with raw BGR24 frames, or a sequence of images processed as the frames of a "
+		   "single input (with a single <landmarks file> and <output file>): a directory, or "
+		   "images:<wildcard mask>. A ** directory in the wildcard masks lists the subdirectories "
+		   "recursively (e.g. videos/**/*.mp4 with landmarks/**/*.csv and gabor/**/*.csv, whose "
+		   "subdirectories mirror the ones of the input files). A batch can also be given as "
+		   "@<manifest file>: a CSV file (without header) with an input file, its <landmarks file> "
+		   "(or -) and its <output file> in each line, case in which the other arguments are omitted."),
 		tr("<input file>")
 	);
 
 	// Landmarks file option
 	oParser.addPositionalArgument("landmarks file",
-		tr("CSV file (wildcard masks can be used) with the facial landmarks in the input file."),
+		tr("CSV file (wildcard masks can be used) with the facial landmarks in the input file, "
+		   "or - for a live input (whose face is tracked during the extraction)."),
 		tr("<landmarks file>")
 	);
 
@@ -93,6 +130,199 @@ fsdk::GaborApp::CommandLineParseResult fsdk::GaborApp::parseCommandLine()
 	);
 	oParser.addOption(oAutoConfirmOpt);
 
+	// Face tracker option
+	QCommandLineOption oTrackerOpt(QStringList({ "t", "tracker" }),
+		tr("%1, among: %2 (default is %3).").arg(tr("Face tracker that produced the <landmarks file>"))
+			.arg(FaceTrackerRegistry::backends().join(", ")).arg(FaceTrackerRegistry::defaultBackend()),
+		tr("name"), FaceTrackerRegistry::defaultBackend()
+	);
+	oParser.addOption(oTrackerOpt);
+
+	// Temporal smoothing options
+	QCommandLineOption oSmoothOpt(QStringList({ "smooth" }),
+		tr("Smooths the landmarks read along the frames (reducing the noise in the features due to the jitter of the tracking) and fills the short gaps where the face was lost.")
+	);
+	oParser.addOption(oSmoothOpt);
+
+	QCommandLineOption oMaxGapOpt(QStringList({ "max-gap" }),
+		tr("Maximum number of consecutive frames without landmarks filled by --smooth (default is 5)."),
+		tr("frames"), "5"
+	);
+	oParser.addOption(oMaxGapOpt);
+
+	// Region pooling options
+	QCommandLineOption oPoolOpt(QStringList({ "pool" }),
+		tr("Regions of the face where the Gabor responses are pooled: face (the whole face), grid:<rows>x<columns> (the cells of a grid over the face) or parts (eyes, brows, nose and mouth). The default is face."),
+		tr("regions"), "face"
+	);
+	oParser.addOption(oPoolOpt);
+
+	QCommandLineOption oPoolStatsOpt(QStringList({ "pool-stats" }),
+		tr("Comma-separated statistics of the Gabor responses computed in each region, among: mean, std, max (default is mean). The max is slower, since it is not computed from the integral images."),
+		tr("list"), "mean"
+	);
+	oParser.addOption(oPoolStatsOpt);
+
+	// Multi-scale filtering option
+	QCommandLineOption oPyramidOpt(QStringList({ "pyramid" }),
+		tr("Filters the larger wavelengths on downsampled images with smaller kernels (faster, but the responses are an approximation of the ones of the direct filtering).")
+	);
+	oParser.addOption(oPyramidOpt);
+
+	// Fixed-point filtering option
+	QCommandLineOption oFixedPointOpt(QStringList({ "fixed-point" }),
+		tr("Filters with 16-bit integer kernels and 32-bit integer accumulation (faster, but the responses are an approximation of the ones of the float filtering).")
+	);
+	oParser.addOption(oFixedPointOpt);
+
+	// Batched filtering option
+	QCommandLineOption oBatchOpt(QStringList({ "batch" }),
+		tr("Number of face crops filtered together, so the kernels are reused from the cache for several frames (default is 1). The results of live inputs are delayed by up to this number of frames."),
+		tr("frames"), "1"
+	);
+	oParser.addOption(oBatchOpt);
+
+	// Gating options
+	QCommandLineOption oGateOpt(QStringList({ "gate" }),
+		tr("Skips the filtering of the frames where the face barely moved since the last frame "
+		   "filtered, reusing its energies: a frame is skipped if the mean displacement of its "
+		   "landmarks is below the given threshold, in pixels (e.g. 2). The frames skipped are "
+		   "marked in the column Reused of the <csv file>."
+		), tr("threshold")
+	);
+	oParser.addOption(oGateOpt);
+
+	QCommandLineOption oGateMaxOpt(QStringList({ "gate-max" }),
+		tr("Maximum number of consecutive frames skipped by --gate (default is 30)."),
+		tr("frames"), "30"
+	);
+	oParser.addOption(oGateMaxOpt);
+
+	QCommandLineOption oGateValidateOpt(QStringList({ "gate-validate" }),
+		tr("Also filters the frames skipped by --gate and reports the relative error of "
+		   "the energies reused at the end of each file."
+		)
+	);
+	oParser.addOption(oGateValidateOpt);
+
+	// Decoding option
+	QCommandLineOption oLumaOpt(QStringList({ "luma" }),
+		tr("Keeps only the luma (gray levels) of the frames as they are decoded, so the face tracker and the Gabor filtering need no color conversion and the copies of the frames are a third of the size.")
+	);
+	oParser.addOption(oLumaOpt);
+
+	// Frame selection options
+	QCommandLineOption oStrideOpt(QStringList({ "stride" }),
+		tr("Processes only every Nth frame of the video files (default is 1, i.e. all frames)."),
+		tr("N"), "1"
+	);
+	oParser.addOption(oStrideOpt);
+
+	QCommandLineOption oFramesOpt(QStringList({ "frames" }),
+		tr("Processes only the given frames and ranges of frames of the video files "
+		   "(e.g. \"0-299,450,600-899\"). The stride, if given, applies to the ranges."
+		), tr("list")
+	);
+	oParser.addOption(oFramesOpt);
+
+	QCommandLineOption oTimesOpt(QStringList({ "times" }),
+		tr("Processes only the frames in the given time ranges of the video files, in "
+		   "seconds or [[hh:]mm:]ss (e.g. \"65.5-90,00:02:00-00:02:30\"). The stride, if "
+		   "given, applies to the ranges."
+		), tr("list")
+	);
+	oParser.addOption(oTimesOpt);
+
+	// Live input and streaming options
+	QCommandLineOption oStreamOpt(QStringList({ "stream" }),
+		tr("Prints the Gabor responses of each frame to the standard output as soon as "
+		   "it is processed, as CSV lines with the frame and the responses.")
+	);
+	oParser.addOption(oStreamOpt);
+
+	QCommandLineOption oLiveQueueOpt(QStringList({ "live-queue" }),
+		tr("Maximum number of frames of a live input waiting to be processed; the oldest "
+		   "ones are dropped when the extraction falls behind (default is 2)."
+		), tr("frames"), "2"
+	);
+	oParser.addOption(oLiveQueueOpt);
+
+	QCommandLineOption oLiveLatencyOpt(QStringList({ "live-latency" }),
+		tr("Maximum time in milliseconds that a frame of a live input may wait to be "
+		   "processed before being dropped (default is 200). Use 0 for no limit."
+		), tr("ms"), "200"
+	);
+	oParser.addOption(oLiveLatencyOpt);
+
+	QCommandLineOption oLiveDurationOpt(QStringList({ "live-duration" }),
+		tr("Time in seconds after which the extraction of a live input ends (default is 0, "
+		   "i.e. until the input ends or the application is interrupted)."
+		), tr("seconds"), "0"
+	);
+	oParser.addOption(oLiveDurationOpt);
+
+	QCommandLineOption oPublishOpt(QStringList({ "publish" }),
+		tr("Publishes the Gabor responses of each frame, as soon as it is processed, to a ring buffer "
+		   "in the shared memory with the given key, to be consumed by other processes "
+		   "(see the utility ffread). Only one input can be processed with this option."
+		), tr("key")
+	);
+	oParser.addOption(oPublishOpt);
+
+	QCommandLineOption oPublishCapacityOpt(QStringList({ "publish-capacity" }),
+		tr("Number of frames kept in the ring buffer of --publish (default is 256)."),
+		tr("frames"), "256"
+	);
+	oParser.addOption(oPublishCapacityOpt);
+
+	// Checkpointing options
+	QCommandLineOption oResumeOpt(QStringList({ "r", "resume" }),
+		tr("Resumes a previous execution that was interrupted: the input files whose "
+		   "CSV files were already concluded are skipped and the others continue "
+		   "from their last checkpoint (if any).")
+	);
+	oParser.addOption(oResumeOpt);
+
+	QCommandLineOption oCheckpointOpt(QStringList({ "c", "checkpoint" }),
+		tr("Interval in seconds between the checkpoints of the partial results of "
+		   "each input file (default is 60). Use 0 to disable the checkpoints."
+		), tr("seconds"), "60"
+	);
+	oParser.addOption(oCheckpointOpt);
+
+	// Result cache options
+	QCommandLineOption oCacheOpt(QStringList({ "cache" }),
+		tr("Directory of a cache of the results: the <output file> of an input file (with the "
+		   "summary pyramid saved along with it) that was already processed with the same "
+		   "landmarks and options is taken from the cache (instead of processing the file "
+		   "again), and the new results are added to it. The "
+		   "input and landmarks files are compared by a fast hash of their contents. Live "
+		   "inputs and image sequences are not cached."
+		), tr("directory")
+	);
+	oParser.addOption(oCacheOpt);
+
+	QCommandLineOption oCacheSizeOpt(QStringList({ "cache-size" }),
+		tr("Maximum size of the results kept in the cache of --cache, in megabytes "
+		   "(default is 1024). The results used less recently are evicted first."
+		), tr("MB"), "1024"
+	);
+	oParser.addOption(oCacheSizeOpt);
+
+	// Profiling options
+	QCommandLineOption oProfileOpt(QStringList({ "profile" }),
+		tr("Prints the timing of the stages of the extraction (throughput and latency "
+		   "percentiles of decoding, loading, cropping, filtering and serialization) at the end.")
+	);
+	oParser.addOption(oProfileOpt);
+
+	QCommandLineOption oProfileJsonOpt(QStringList({ "profile-json" }),
+		tr("Saves the timing of the stages of the extraction, including the latency "
+		   "histograms, to the given JSON file at the end."
+		), tr("file")
+	);
+	oParser.addOption(oProfileJsonOpt);
+
 	// Help and version options
 	QCommandLineOption oHelpOpt = oParser.addHelpOption();
 	QCommandLineOption oVersionOpt = oParser.addVersionOption();
@@ -134,6 +364,202 @@ fsdk::GaborApp::CommandLineParseResult fsdk::GaborApp::parseCommandLine()
 	int iLevel = oParser.value(oMsgLevelOpt).toInt();
 	setLogLevel(static_cast<LogLevel>(iLevel));
 
+	// Get the face tracker option
+	m_sTrackerBackend = oParser.value(oTrackerOpt);
+	if(!FaceTrackerRegistry::backend(m_sTrackerBackend))
+	{
+		qCritical().noquote() << tr("unknown face tracker: %1").arg(m_sTrackerBackend) << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+
+	// Get the temporal smoothing options
+	m_bSmoothing = oParser.isSet(oSmoothOpt);
+	m_iMaxGap = oParser.value(oMaxGapOpt).toInt(&bValid);
+	if(!bValid || m_iMaxGap < 0)
+	{
+		qCritical().noquote() << tr("invalid maximum gap: %1").arg(oParser.value(oMaxGapOpt)) << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+
+	// Get the region pooling options
+	m_oPooling = RegionPooling();
+	QString sPool = oParser.value(oPoolOpt).toLower();
+	QRegExp oGridExp("^grid:([0-9]+)x([0-9]+)$");
+	if(oGridExp.exactMatch(sPool) && oGridExp.cap(1).toInt() > 0 && oGridExp.cap(2).toInt() > 0)
+		m_oPooling.setGrid(oGridExp.cap(1).toInt(), oGridExp.cap(2).toInt());
+	else if(sPool == "parts")
+	{
+		if(!m_oPooling.setFaceParts(FaceTrackerRegistry::backend(m_sTrackerBackend)))
+		{
+			qCritical().noquote() << tr("the face tracker %1 does not provide the landmarks required to locate the parts of the face").arg(m_sTrackerBackend) << endl;
+			return CommandLineError;
+		}
+	}
+	else if(sPool != "face")
+	{
+		qCritical().noquote() << tr("invalid pooling regions: %1").arg(oParser.value(oPoolOpt)) << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+
+	int iStatistics = 0;
+	foreach(QString sStatistic, oParser.value(oPoolStatsOpt).toLower().split(",", QString::SkipEmptyParts))
+	{
+		sStatistic = sStatistic.trimmed();
+		if(sStatistic == "mean")
+			iStatistics |= RegionPooling::Mean;
+		else if(sStatistic == "std")
+			iStatistics |= RegionPooling::StdDev;
+		else if(sStatistic == "max")
+			iStatistics |= RegionPooling::Max;
+		else
+		{
+			qCritical().noquote() << tr("invalid pooling statistic: %1").arg(sStatistic) << endl;
+			oParser.showHelp();
+			return CommandLineError;
+		}
+	}
+	if(!iStatistics)
+	{
+		qCritical().noquote() << tr("no pooling statistic given") << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+	m_oPooling.setStatistics(iStatistics);
+
+	// Get the multi-scale filtering option
+	m_bPyramid = oParser.isSet(oPyramidOpt);
+
+	// Get the fixed-point filtering option
+	m_bFixedPoint = oParser.isSet(oFixedPointOpt);
+
+	// Get the batched filtering option
+	m_iBatchSize = oParser.value(oBatchOpt).toInt(&bValid);
+	if(!bValid || m_iBatchSize < 1)
+	{
+		qCritical().noquote() << tr("invalid batch size: %1").arg(oParser.value(oBatchOpt)) << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+
+	// Get the gating options
+	m_bGating = oParser.isSet(oGateOpt);
+	if(m_bGating)
+	{
+		m_dGateThreshold = oParser.value(oGateOpt).toDouble(&bValid);
+		if(!bValid || m_dGateThreshold <= 0)
+		{
+			qCritical().noquote() << tr("invalid gating threshold: %1").arg(oParser.value(oGateOpt)) << endl;
+			oParser.showHelp();
+			return CommandLineError;
+		}
+	}
+	m_iGateMaxReused = oParser.value(oGateMaxOpt).toInt(&bValid);
+	if(!bValid || m_iGateMaxReused < 1)
+	{
+		qCritical().noquote() << tr("invalid maximum number of frames skipped: %1").arg(oParser.value(oGateMaxOpt)) << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+	m_bGateValidate = oParser.isSet(oGateValidateOpt);
+
+	// Get the decoding option
+	m_bLumaDecode = oParser.isSet(oLumaOpt);
+
+	// Get the frame selection options
+	int iStride = oParser.value(oStrideOpt).toInt(&bValid);
+	if(!bValid || iStride < 1)
+	{
+		qCritical().noquote() << tr("invalid stride: %1").arg(oParser.value(oStrideOpt)) << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+	m_oSelection.clear();
+	m_oSelection.setStride(iStride);
+
+	if(oParser.isSet(oFramesOpt) && !m_oSelection.parseFrames(oParser.value(oFramesOpt)))
+	{
+		qCritical().noquote() << tr("invalid list of frames: %1").arg(oParser.value(oFramesOpt)) << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+
+	if(oParser.isSet(oTimesOpt) && !m_oSelection.parseTimes(oParser.value(oTimesOpt)))
+	{
+		qCritical().noquote() << tr("invalid list of time ranges: %1").arg(oParser.value(oTimesOpt)) << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+
+	// Get the live input and streaming options
+	m_bStreaming = oParser.isSet(oStreamOpt);
+	m_iLiveQueueSize = oParser.value(oLiveQueueOpt).toInt(&bValid);
+	if(!bValid || m_iLiveQueueSize < 1)
+	{
+		qCritical().noquote() << tr("invalid live queue size: %1").arg(oParser.value(oLiveQueueOpt)) << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+	m_iLiveMaxLatency = oParser.value(oLiveLatencyOpt).toInt(&bValid);
+	if(!bValid || m_iLiveMaxLatency < 0)
+	{
+		qCritical().noquote() << tr("invalid live latency: %1").arg(oParser.value(oLiveLatencyOpt)) << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+	m_iLiveDuration = oParser.value(oLiveDurationOpt).toInt(&bValid);
+	if(!bValid || m_iLiveDuration < 0)
+	{
+		qCritical().noquote() << tr("invalid live duration: %1").arg(oParser.value(oLiveDurationOpt)) << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+
+	// Get the publishing options
+	m_sPublishKey = oParser.value(oPublishOpt);
+	m_iPublishCapacity = oParser.value(oPublishCapacityOpt).toInt(&bValid);
+	if(!bValid || m_iPublishCapacity < 1)
+	{
+		qCritical().noquote() << tr("invalid publishing capacity: %1").arg(oParser.value(oPublishCapacityOpt)) << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+
+	// Get the checkpointing options
+	m_bResume = oParser.isSet(oResumeOpt);
+	m_iCheckpointInterval = oParser.value(oCheckpointOpt).toInt(&bValid);
+	if(!bValid || m_iCheckpointInterval < 0)
+	{
+		qCritical().noquote() << tr("invalid checkpoint interval: %1").arg(oParser.value(oCheckpointOpt)) << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+
+	// Get the result cache options
+	if(oParser.isSet(oCacheOpt))
+	{
+		int iCacheSize = oParser.value(oCacheSizeOpt).toInt(&bValid);
+		if(!bValid || iCacheSize < 1)
+		{
+			qCritical().noquote() << tr("invalid cache size: %1").arg(oParser.value(oCacheSizeOpt)) << endl;
+			oParser.showHelp();
+			return CommandLineError;
+		}
+		if(!m_oCache.open(oParser.value(oCacheOpt), qint64(iCacheSize) * 1024 * 1024))
+		{
+			qCritical().noquote() << tr("invalid cache directory: %1").arg(oParser.value(oCacheOpt)) << endl;
+			oParser.showHelp();
+			return CommandLineError;
+		}
+	}
+
+	// Get the profiling options
+	m_bPrintProfile = oParser.isSet(oProfileOpt);
+	m_sProfileFile = oParser.value(oProfileJsonOpt);
+	m_oProfile.setEnabled(m_bPrintProfile || !m_sProfileFile.isEmpty());
+
 	// Check the input and landmark files, as well as the CSV files (or wildcards) arguments
 	switch(oParser.positionalArguments().count())
 	{
@@ -143,11 +569,16 @@ fsdk::GaborApp::CommandLineParseResult fsdk::GaborApp::parseCommandLine()
 			return CommandLineError;
 
 		case 1:
+			// The manifests include the landmarks and CSV files
+			if(Naming::isManifest(oParser.positionalArguments().at(0)))
+				break;
 			qCritical().noquote() << tr("the arguments <landmarks file> and <csv file> are required") << endl;
 			oParser.showHelp();
 			return CommandLineError;
 
 		case 2:
+			if(Naming::isManifest(oParser.positionalArguments().at(0)))
+				break;
 			qCritical().noquote() << tr("the argument <csv file> is required") << endl;
 			oParser.showHelp();
 			return CommandLineError;
@@ -168,76 +599,190 @@ fsdk::GaborApp::CommandLineParseResult fsdk::GaborApp::parseCommandLine()
 
 	// Map the input image/video/wildcard to the landmarks and CSV file/wildcard
 	QString sInputFile = oParser.positionalArguments().at(0);
-	QString sLandmarksFile = oParser.positionalArguments().at(1);
-	QString sCSVFile = oParser.positionalArguments().at(2);
+	QString sLandmarksFile = oParser.positionalArguments().value(1);
+	QString sCSVFile = oParser.positionalArguments().value(2);
 	
-	QMap<QString, QString> mMapping[2];
-	Naming::WildcardListingReturn aRet[2];
-	aRet[0] = Naming::wildcardListing(sInputFile, sLandmarksFile, mMapping[0]);
-	aRet[1] = Naming::wildcardListing(sLandmarksFile, sCSVFile, mMapping[1]);
-
-	for(int i = 0; i < 2; i++)
+	m_mTaskFiles.clear();
+	if(Naming::isManifest(sInputFile))
 	{
-		QString sSrc = (i == 0 ? sInputFile : sLandmarksFile);
-		QString sTgt = (i == 0 ? sLandmarksFile : sCSVFile);
-
-		switch(aRet[i])
+		if(oParser.positionalArguments().count() > 1)
 		{
-			case Naming::InvalidSourceWildcard:
-				qCritical().noquote() << tr("invalid wildcard for the file: %1").arg(sSrc) << endl;
-				oParser.showHelp();
-				return CommandLineError;
+			qCritical().noquote() << tr("unexpected arguments: %1").arg(oParser.positionalArguments().mid(1).join(' ')) << endl;
+			oParser.showHelp();
+			return CommandLineError;
+		}
 
-			case Naming::InvalidTargetWildcard:
-				qCritical().noquote() << tr("invalid wildcard for the file: %1").arg(sTgt) << endl;
+		// The manifest is read one line at a time
+		QMap<QString, QStringList> mManifest;
+		int iLine;
+		switch(Naming::manifestListing(sInputFile, 2, mManifest, iLine))
+		{
+			case Naming::ManifestNotReadable:
+				qCritical().noquote() << tr("manifest file can not be read: %1").arg(sInputFile.mid(1)) << endl;
 				oParser.showHelp();
 				return CommandLineError;
 
-			case Naming::DifferentWildcards:
-				qCritical().noquote() << tr("the wildcards between file %1 and %2 must be the same").arg(sSrc).arg(sTgt) << endl;
+			case Naming::InvalidManifestLine:
+				qCritical().noquote() << tr("invalid line %1 in the manifest file %2 (expected an input file, a landmarks file and a CSV file)").arg(iLine).arg(sInputFile.mid(1)) << endl;
 				oParser.showHelp();
 				return CommandLineError;
 
-			case Naming::FileNotExist:
-				qCritical().noquote() << tr("file does not exist: %1").arg(sSrc) << endl;
+			case Naming::DuplicateManifestInput:
+				qCritical().noquote() << tr("line %1 of the manifest file %2 lists an input already listed before").arg(iLine).arg(sInputFile.mid(1)) << endl;
 				oParser.showHelp();
 				return CommandLineError;
 
-			case Naming::EmptySourceListing:
-				qCritical().noquote() << tr("file wildcard did not return any file: %1").arg(sSrc) << endl;
+			case Naming::EmptyManifest:
+				qCritical().noquote() << tr("manifest file did not list any file: %1").arg(sInputFile.mid(1)) << endl;
 				oParser.showHelp();
 				return CommandLineError;
 
-			case Naming::ListingOk:
+			case Naming::ManifestOk:
 				break;
 		}
+
+		// A landmarks file - means that the face is tracked during the extraction
+		QMap<QString, QStringList>::const_iterator itManifest;
+		for(itManifest = mManifest.cbegin(); itManifest != mManifest.cend(); ++itManifest)
+		{
+			QString sLandmarks = itManifest.value().at(0);
+			m_mTaskFiles[itManifest.key()] = TaskPair(sLandmarks == "-" ? QString() : sLandmarks, itManifest.value().at(1));
+		}
+	}
+	else if(LiveSource::isLiveInput(sInputFile))
+	{
+		// The live inputs are not files, so they can not be listed (and their
+		// landmarks must be tracked while the frames are processed)
+		if(sLandmarksFile != "-")
+		{
+			qCritical().noquote() << tr("the landmarks of the live input %1 must be tracked during the extraction (use - as the <landmarks file>)").arg(sInputFile) << endl;
+			oParser.showHelp();
+			return CommandLineError;
+		}
+		m_mTaskFiles[sInputFile] = TaskPair(QString(), sCSVFile);
+	}
+	else if(ImageSequence::isImageSequence(sInputFile))
+	{
+		// The image sequences are a single input, with a single landmarks file
+		// (or none, if their faces are tracked while the images are processed)
+		if(sLandmarksFile != "-" && !QFile::exists(sLandmarksFile))
+		{
+			qCritical().noquote() << tr("file does not exist: %1").arg(sLandmarksFile) << endl;
+			oParser.showHelp();
+			return CommandLineError;
+		}
+		m_mTaskFiles[sInputFile] = TaskPair(sLandmarksFile == "-" ? QString() : sLandmarksFile, sCSVFile);
+	}
+	else
+	{
+		QMap<QString, QString> mMapping[2];
+		Naming::WildcardListingReturn aRet[2];
+		aRet[0] = Naming::wildcardListing(sInputFile, sLandmarksFile, mMapping[0]);
+		aRet[1] = Naming::wildcardListing(sLandmarksFile, sCSVFile, mMapping[1]);
+
+		for(int i = 0; i < 2; i++)
+		{
+			QString sSrc = (i == 0 ? sInputFile : sLandmarksFile);
+			QString sTgt = (i == 0 ? sLandmarksFile : sCSVFile);
+
+			switch(aRet[i])
+			{
+				case Naming::InvalidSourceWildcard:
+					qCritical().noquote() << tr("invalid wildcard for the file: %1").arg(sSrc) << endl;
+					oParser.showHelp();
+					return CommandLineError;
+
+				case Naming::InvalidTargetWildcard:
+					qCritical().noquote() << tr("invalid wildcard for the file: %1").arg(sTgt) << endl;
+					oParser.showHelp();
+					return CommandLineError;
+
+				case Naming::DifferentWildcards:
+					qCritical().noquote() << tr("the wildcards between file %1 and %2 must be the same").arg(sSrc).arg(sTgt) << endl;
+					oParser.showHelp();
+					return CommandLineError;
+
+				case Naming::FileNotExist:
+					qCritical().noquote() << tr("file does not exist: %1").arg(sSrc) << endl;
+					oParser.showHelp();
+					return CommandLineError;
+
+				case Naming::EmptySourceListing:
+					qCritical().noquote() << tr("file wildcard did not return any file: %1").arg(sSrc) << endl;
+					oParser.showHelp();
+					return CommandLineError;
+
+				case Naming::ListingOk:
+					break;
+			}
+		}
+
+		if(mMapping[0].count() != mMapping[1].count()) // Sanity check
+		{
+			qCritical().noquote() << tr("something unexpected happened when processing the wildcards in command line");
+			return CommandLineError;
+		}
+
+		// Add the files to the final task map
+		for(int i = 0; i < mMapping[0].count(); i++)
+		{
+			QString sInput = (mMapping[0].cbegin() + i).key();
+			QString sLandmarks = (mMapping[0].cbegin() + i).value();
+			QString sCSV = (mMapping[1].cbegin() + i).value();
+			m_mTaskFiles[sInput] = TaskPair(sLandmarks, sCSV);
+		}
 	}
 
-	if(mMapping[0].count() != mMapping[1].count()) // Sanity check
+	// Create the directories of the CSV files mirrored from the input files
+	// (or given in a manifest), since they might not exist yet
+	if(Naming::isManifest(sInputFile) || Naming::isRecursiveWildcard(sInputFile))
 	{
-		qCritical().noquote() << tr("something unexpected happened when processing the wildcards in command line");
-		return CommandLineError;
+		QMap<QString, TaskPair>::const_iterator itFile;
+		for(itFile = m_mTaskFiles.cbegin(); itFile != m_mTaskFiles.cend(); ++itFile)
+			QDir().mkpath(QFileInfo(itFile.value().second).absolutePath());
 	}
 
-	// Add the files to the final task map
-	m_mTaskFiles.clear();
-	for(int i = 0; i < mMapping[0].count(); i++)
+	// The ring buffer of the features published can only have one writer
+	if(!m_sPublishKey.isEmpty() && m_mTaskFiles.count() > 1)
 	{
-		QString sInput = (mMapping[0].cbegin() + i).key();
-		QString sLandmarks = (mMapping[0].cbegin() + i).value();
-		QString sCSV = (mMapping[1].cbegin() + i).value();
-		m_mTaskFiles[sInput] = TaskPair(sLandmarks, sCSV);
+		qCritical().noquote() << tr("only one input file can be processed with --publish") << endl;
+		oParser.showHelp();
+		return CommandLineError;
 	}
 
-	// Check if existing CSV files should be overwriting
+	// If resuming, skip the input files already concluded (i.e. whose CSV files
+	// exist with contents and have no checkpoint pending)
 	QStringList lIgnored;
-	bool bAutoConfirm = oParser.isSet(oAutoConfirmOpt);
 	QMap<QString, TaskPair>::const_iterator it;
+	if(m_bResume)
+	{
+		for(it = m_mTaskFiles.cbegin(); it != m_mTaskFiles.cend(); ++it)
+		{
+			QString sInputFile = it.key();
+			QString sCSVFile = it.value().second;
+
+			if(!QFile::exists(ExtractionTask::checkpointFileName(sCSVFile)) && QFileInfo(sCSVFile).size() > 0)
+				lIgnored.append(sInputFile);
+		}
+		foreach(QString sIgnored, lIgnored)
+		{
+			qInfo().noquote() << tr("skipping input file %1 because it was already concluded").arg(sIgnored);
+			m_mTaskFiles.remove(sIgnored);
+		}
+	}
+
+	// Check if existing CSV files should be overwriting (the ones being resumed
+	// from a checkpoint are not really overwritten)
+	lIgnored.clear();
+	bool bAutoConfirm = oParser.isSet(oAutoConfirmOpt);
 	for(it = m_mTaskFiles.cbegin(); it != m_mTaskFiles.cend(); ++it)
 	{
 		QString sInputFile = it.key();
 		QString sCSVFile = it.value().second;
 
+		if(m_bResume && QFile::exists(ExtractionTask::checkpointFileName(sCSVFile)))
+			continue;
+
 		if(!confirmOverwrite(sCSVFile, bAutoConfirm))
 			lIgnored.append(sInputFile);
 	}
@@ -272,8 +817,70 @@ fsdk::GaborApp::CommandLineParseResult fsdk::GaborApp::parseCommandLine()
 		m_mTaskFiles.remove(sIgnored);
 	}
 
-	// If no tasks remain, terminate with error
-	if(m_mTaskFiles.count() == 0)
+	// Take the results of the input files already processed with the same
+	// landmarks and options from the cache (the ones being resumed are
+	// processed anyway)
+	int iCached = 0;
+	m_mCacheKeys.clear();
+	if(m_oCache.isOpen())
+	{
+		// Options that change the responses extracted, including the definition
+		// of the bank of filters (and the tool version, since the filtering and
+		// the trackers may change between versions)
+		GaborBank oBank = createBank();
+		QStringList lBank;
+		foreach(GaborKernel oKernel, oBank.kernels())
+			lBank.append(QString("%1/%2/%3/%4/%5").arg(oKernel.lambda()).arg(oKernel.theta()).arg(oKernel.sigma()).arg(oKernel.psi()).arg(oKernel.windowSize()));
+
+		QStringList lParameters;
+		lParameters.append(QString("tool=%1 %2").arg(applicationName(), applicationVersion()));
+		lParameters.append(QString("tracker=%1").arg(m_sTrackerBackend));
+		lParameters.append(QString("bank=%1").arg(lBank.join(';')));
+		lParameters.append(QString("pyramid=%1").arg(oBank.isPyramid()));
+		lParameters.append(QString("precision=%1").arg(oBank.precision()));
+		lParameters.append(QString("smooth=%1").arg(m_bSmoothing ? QString::number(m_iMaxGap) : QString("off")));
+		lParameters.append(QString("pool=%1").arg(oParser.value(oPoolOpt).toLower()));
+		lParameters.append(QString("pool-stats=%1").arg(oParser.value(oPoolStatsOpt).toLower()));
+		lParameters.append(QString("gate=%1").arg(m_bGating ? QString("%1/%2").arg(m_dGateThreshold).arg(m_iGateMaxReused) : QString("off")));
+		lParameters.append(QString("luma=%1").arg(m_bLumaDecode));
+		lParameters.append(QString("stride=%1").arg(oParser.value(oStrideOpt)));
+		lParameters.append(QString("frames=%1").arg(oParser.value(oFramesOpt)));
+		lParameters.append(QString("times=%1").arg(oParser.value(oTimesOpt)));
+
+		lIgnored.clear();
+		for(it = m_mTaskFiles.cbegin(); it != m_mTaskFiles.cend(); ++it)
+		{
+			QString sInputFile = it.key();
+			QString sLandmarksFile = it.value().first;
+			QString sCSVFile = it.value().second;
+
+			if(LiveSource::isLiveInput(sInputFile) || ImageSequence::isImageSequence(sInputFile))
+				continue;
+
+			QStringList lFiles(sInputFile);
+			if(!sLandmarksFile.isEmpty())
+				lFiles.append(sLandmarksFile);
+			QString sKey = ResultCache::key(lFiles, lParameters);
+			if(sKey.isEmpty())
+				continue;
+			m_mCacheKeys[sInputFile] = sKey;
+
+			if(m_bResume && QFile::exists(ExtractionTask::checkpointFileName(sCSVFile)))
+				continue;
+
+			if(m_oCache.fetch(sKey, sCSVFile))
+				lIgnored.append(sInputFile);
+		}
+		foreach(QString sIgnored, lIgnored)
+		{
+			qInfo().noquote() << tr("taking the Gabor responses of input file %1 from the cache").arg(sIgnored);
+			m_mTaskFiles.remove(sIgnored);
+		}
+		iCached = lIgnored.count();
+	}
+
+	// If no tasks remain (and no results were taken from the cache), terminate with error
+	if(m_mTaskFiles.count() == 0 && iCached == 0)
 		return CommandLineError;
 
 	// Otherwise, go on! :)
@@ -379,16 +986,47 @@ bool fsdk::GaborApp::confirmWritable(const QString sCSVFilename, bool &bAutoIgno
 	}
 }
 
+// +-----------------------------------------------------------
+fsdk::GaborBank fsdk::GaborApp::createBank() const
+{
+	GaborBank oBank = GaborBank::defaultBank();
+	oBank.setPyramid(m_bPyramid);
+	oBank.setPrecision(m_bFixedPoint ? GaborKernel::FixedPointPrecision : GaborKernel::FloatPrecision);
+	return oBank;
+}
+
 // +-----------------------------------------------------------
 fsdk::GaborExtractionTask* fsdk::GaborApp::createTask(const QString &sInputFile, const QString &sLandmarksFile)
 {
 	GaborExtractionTask *pTask = new GaborExtractionTask(sInputFile, sLandmarksFile);
 	pTask->setAutoDelete(false);
+	pTask->setProfilingEnabled(m_oProfile.isEnabled());
+	pTask->setFrameSelection(m_oSelection);
+	pTask->setDecodeMode(m_bLumaDecode ? ExtractionTask::LumaDecode : ExtractionTask::ColorDecode);
+	pTask->setTrackerBackend(m_sTrackerBackend);
+	pTask->setSmoothing(m_bSmoothing, m_iMaxGap);
+	pTask->setPooling(m_oPooling);
+	pTask->setBank(createBank());
+	pTask->setBatchSize(m_iBatchSize);
+	pTask->setGating(m_bGating, m_dGateThreshold, m_iGateMaxReused, m_bGateValidate);
+	pTask->setLiveOptions(m_iLiveQueueSize, m_iLiveMaxLatency, m_iLiveDuration);
+	pTask->setStreaming(m_bStreaming);
+	pTask->setPublishing(m_sPublishKey, m_iPublishCapacity);
+
+	// Enable the checkpoints (discarding any previous one if not resuming)
+	QString sCheckpointFile = ExtractionTask::checkpointFileName(m_mTaskFiles[sInputFile].second);
+	if(!m_bResume)
+		ExtractionTask::removeCheckpoint(sCheckpointFile);
+	if(m_iCheckpointInterval > 0)
+		pTask->setCheckpoint(sCheckpointFile, m_iCheckpointInterval);
+
 	m_lTasks.append(pTask);
 
 	connect(pTask, &GaborExtractionTask::taskError, this, &GaborApp::taskError);
 	connect(pTask, &GaborExtractionTask::taskProgress, this, &GaborApp::taskProgress);
 	connect(pTask, &GaborExtractionTask::taskFinished, this, &GaborApp::taskFinished);
+	connect(pTask, &GaborExtractionTask::taskResult, this, &GaborApp::taskResult);
+	connect(pTask, &GaborExtractionTask::taskProfiled, this, &GaborApp::taskProfiled);
 
 	return pTask;
 }
@@ -401,6 +1039,8 @@ void fsdk::GaborApp::deleteTask(fsdk::GaborExtractionTask* pTask)
 	disconnect(pTask, &GaborExtractionTask::taskError, this, &GaborApp::taskError);
 	disconnect(pTask, &GaborExtractionTask::taskProgress, this, &GaborApp::taskProgress);
 	disconnect(pTask, &GaborExtractionTask::taskFinished, this, &GaborApp::taskFinished);
+	disconnect(pTask, &GaborExtractionTask::taskResult, this, &GaborApp::taskResult);
+	disconnect(pTask, &GaborExtractionTask::taskProfiled, this, &GaborApp::taskProfiled);
 
 	delete pTask;
 }
@@ -408,16 +1048,79 @@ void fsdk::GaborApp::deleteTask(fsdk::GaborExtractionTask* pTask)
 // +-----------------------------------------------------------
 void fsdk::GaborApp::run()
 {
-	QMap<QString, TaskPair>::const_iterator it;
-	for(it = m_mTaskFiles.cbegin(); it != m_mTaskFiles.cend(); ++it)
+	// All results might have been taken from the cache
+	if(m_mTaskFiles.count() == 0)
 	{
-		QString sInputFile = it.key();
-		QString sLandmarksFile = it.value().first;
-		GaborExtractionTask *pTask = createTask(sInputFile, sLandmarksFile);
+		reportProfile();
+		exit(0);
+		return;
+	}
+
+	m_oBatchProgress.setTasksCount(m_mTaskFiles.count());
+
+	// Only the files can be probed (the live inputs and the image sequences
+	// are started after them)
+	QStringList lFiles, lOthers;
+	foreach(QString sInputFile, m_mTaskFiles.keys())
+	{
+		if(LiveSource::isLiveInput(sInputFile) || ImageSequence::isImageSequence(sInputFile))
+			lOthers.append(sInputFile);
+		else
+			lFiles.append(sInputFile);
+	}
+	m_lPending = lFiles + lOthers;
+	startTasks();
+
+	// Probe the files of the tasks still waiting in background, so the batch
+	// progress knows their number of frames and the longest ones are started
+	// first (see inputProbed())
+	QStringList lProbed;
+	foreach(QString sInputFile, lFiles)
+	{
+		if(m_lPending.contains(sInputFile))
+			lProbed.append(sInputFile);
+	}
+	if(lProbed.count() > 0)
+		m_oProber.start(lProbed);
+}
+
+// +-----------------------------------------------------------
+void fsdk::GaborApp::startTasks()
+{
+	// Only as many tasks as the threads of the pool are started, so the ones
+	// waiting can still be reordered as their input files are probed
+	while(m_lPending.count() > 0 && m_lTasks.count() < QThreadPool::globalInstance()->maxThreadCount())
+	{
+		QString sInputFile = m_lPending.takeFirst();
+		GaborExtractionTask *pTask = createTask(sInputFile, m_mTaskFiles[sInputFile].first);
 		QThreadPool::globalInstance()->start(pTask);
 	}
 }
 
+// +-----------------------------------------------------------
+void fsdk::GaborApp::inputProbed(const fsdk::InputProbe &oProbe)
+{
+	if(oProbe.frameCount() <= 0)
+		return;
+
+	// Give the number of frames of the file to the batch progress, so it does
+	// not need to estimate it while the task is not started
+	double dFrameRate = oProbe.frameRate() > 0 ? oProbe.frameRate() : 30;
+	int iFrameCount = m_oSelection.isAll() ? oProbe.frameCount() : m_oSelection.count(oProbe.frameCount(), dFrameRate);
+	m_oBatchProgress.estimate(oProbe.inputFile(), iFrameCount);
+	m_mFrameCounts[oProbe.inputFile()] = iFrameCount;
+
+	// Move the task (if still waiting) ahead of the ones with fewer frames or
+	// not probed yet, so the longest files do not delay the end of the batch
+	if(m_lPending.removeOne(oProbe.inputFile()))
+	{
+		int iPos = 0;
+		while(iPos < m_lPending.count() && m_mFrameCounts.value(m_lPending[iPos]) >= iFrameCount)
+			iPos++;
+		m_lPending.insert(iPos, oProbe.inputFile());
+	}
+}
+
 // +-----------------------------------------------------------
 void fsdk::GaborApp::taskError(const QString &sInputFile, const ExtractionTask::ExtractionError eError)
 {
@@ -438,18 +1141,28 @@ void fsdk::GaborApp::taskError(const QString &sInputFile, const ExtractionTask::
 
 	GaborExtractionTask *pTask = static_cast<GaborExtractionTask*>(sender());
 	deleteTask(pTask);
+	m_oBatchProgress.finish(sInputFile);
+
+	// Start the next task waiting (if any) in the place of this one
+	startTasks();
 
 	if(m_lTasks.count() == 0)
 	{
 		QThreadPool::globalInstance()->waitForDone();
+		reportProfile();
 		exit(-2);
 	}
 }
 
 // +-----------------------------------------------------------
-void fsdk::GaborApp::taskProgress(const QString &sInputFile, int iProgress)
+void fsdk::GaborApp::taskProgress(const QString &sInputFile, const fsdk::TaskProgress &oProgress)
 {
-	qDebug().noquote() << tr("file %1 progress: %2%").arg(sInputFile).arg(iProgress);
+	m_oBatchProgress.update(sInputFile, oProgress);
+
+	qDebug().noquote() << tr("file %1 progress: %2% (%3 fps, ETA %4); batch: %5 of %6 files, %7% (%8 fps, ETA %9)")
+		.arg(sInputFile).arg(oProgress.percent()).arg(oProgress.frameRate(), 0, 'f', 1).arg(TaskProgress::formatTime(oProgress.remaining()))
+		.arg(m_oBatchProgress.finishedCount()).arg(m_oBatchProgress.tasksCount()).arg(m_oBatchProgress.percent())
+		.arg(m_oBatchProgress.frameRate(), 0, 'f', 1).arg(TaskProgress::formatTime(m_oBatchProgress.remaining()));
 }
 
 // +-----------------------------------------------------------
@@ -457,31 +1170,103 @@ void fsdk::GaborApp::taskFinished(const QString &sInputFile, const QVariant &vDa
 {
 	GaborExtractionTask *pTask = static_cast<GaborExtractionTask*>(sender());
 	deleteTask(pTask);
+	m_oBatchProgress.finish(sInputFile);
+
+	// Start the next task waiting (if any) in the place of this one
+	startTasks();
 
 	int iRet;
 	QString sCSVFile = m_mTaskFiles[sInputFile].second;
 
-	if(!vData.value<GaborData>().saveToCSV(sCSVFile))
+	bool bSaved;
+	{
+		ScopedStageTimer oTimer(m_oProfile, TaskProfile::SerializationStage);
+		bSaved = vData.value<GaborData>().saveToCSV(sCSVFile);
+	}
+
+	if(!bSaved)
 	{
 		qCritical().noquote() << tr("error writing to CSV file %1").arg(sCSVFile);
 		iRet = -3;
 	}
 	else
 	{
+		ExtractionTask::removeCheckpoint(ExtractionTask::checkpointFileName(sCSVFile));
 		qInfo().noquote() << tr("extraction of landmards from file %1 concluded.").arg(sInputFile);
 		iRet = 0;
+
+		// Add the results to the cache, with the summary pyramid (a failure
+		// only means they are not reused)
+		if(m_mCacheKeys.contains(sInputFile))
+		{
+			QStringList lFiles(sCSVFile);
+			if(QFile::exists(SignalPyramid::fileName(sCSVFile)))
+				lFiles.append(SignalPyramid::fileName(sCSVFile));
+			m_oCache.store(m_mCacheKeys[sInputFile], lFiles, sInputFile);
+		}
+
+		// List the images of a sequence next to the CSV file (their frames)
+		if(ImageSequence::isImageSequence(sInputFile))
+		{
+			ImageSequence oSequence(sInputFile);
+			if(!oSequence.open() || !oSequence.saveListing(ImageSequence::listingFileName(sCSVFile)))
+			{
+				qCritical().noquote() << tr("error writing the listing of images to file %1").arg(ImageSequence::listingFileName(sCSVFile));
+				iRet = -3;
+			}
+		}
 	}
 
 	if(m_lTasks.count() == 0)
 	{
 		QThreadPool::globalInstance()->waitForDone();
+		reportProfile();
 		exit(iRet);
 	}
 }
 
+// +-----------------------------------------------------------
+void fsdk::GaborApp::taskResult(const QString &sInputFile, const int iFrame, const QVariant &vData)
+{
+	Q_UNUSED(sInputFile);
+
+	QStringList lValues;
+	lValues.append(QString::number(iFrame));
+	foreach(float fEnergy, vData.value<GaborData>().energies(iFrame))
+		lValues.append(QString::number(fEnergy));
+
+	// Flush each line, so the results are available right away to a reader
+	std::cout << lValues.join(',').toStdString() << std::endl;
+}
+
+// +-----------------------------------------------------------
+void fsdk::GaborApp::taskProfiled(const QString &sInputFile, const fsdk::TaskProfile &oProfile)
+{
+	Q_UNUSED(sInputFile);
+	m_oProfile.merge(oProfile);
+}
+
+// +-----------------------------------------------------------
+void fsdk::GaborApp::reportProfile()
+{
+	if(m_bPrintProfile)
+		std::cout << m_oProfile.toText().toStdString() << std::endl;
+
+	if(!m_sProfileFile.isEmpty())
+	{
+		QFile oFile(m_sProfileFile);
+		QByteArray oJson = QJsonDocument(m_oProfile.toJson()).toJson(QJsonDocument::Indented);
+		if(!oFile.open(QIODevice::WriteOnly) || oFile.write(oJson) != oJson.size())
+			qCritical().noquote() << tr("error writing the profile to file %1").arg(m_sProfileFile);
+	}
+}
+
 // +-----------------------------------------------------------
 void fsdk::GaborApp::cancel()
 {
+	// The tasks still waiting are simply not started
+	m_lPending.clear();
+
 	foreach(ExtractionTask *pTask, m_lTasks)
 		pTask->cancel();
 }
\ No newline at end of file
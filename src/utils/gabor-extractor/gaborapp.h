@@ -22,6 +22,8 @@
 
 #include "application.h"
 #include "gaborextractiontask.h"
+#include "resultcache.h"
+#include "inputprobe.h"
 #include <QMap>
 #include <QList>
 #include <QPair>
@@ -102,11 +104,12 @@ namespace fsdk
 		void taskError(const QString &sInputFile, const ExtractionTask::ExtractionError eError);
 
 		/**
-		 * Captures the signal indicating the progress of one of the tasks.
+		 * Captures the signal indicating the progress of one of the tasks, and
+		 * displays it together with the progress of the whole batch of tasks.
 		 * @param sInputFile QString with the name of the image/video file of the task.
-		 * @param iProgress Integer value in range [0, 100] with the progress percent.
+		 * @param oProgress TaskProgress with the progress of the task.
 		 */
-		void taskProgress(const QString &sInputFile, int iProgress);
+		void taskProgress(const QString &sInputFile, const fsdk::TaskProgress &oProgress);
 
 		/**
 		 * Captures the signal indicating the conclusion of one of the tasks.
@@ -116,8 +119,41 @@ namespace fsdk
 		 */
 		void taskFinished(const QString &sInputFile, const QVariant &vData);
 
+		/**
+		 * Captures the signal with the Gabor responses of a single frame of one
+		 * of the tasks (only emitted if the streaming was requested), and prints
+		 * them to the standard output.
+		 * @param sInputFile QString with the name of the input of the task.
+		 * @param iFrame Integer with the index of the frame.
+		 * @param vData QVariant object with the GaborData of the frame.
+		 */
+		void taskResult(const QString &sInputFile, const int iFrame, const QVariant &vData);
+
+		/**
+		 * Captures the signal with the timing of the stages of one of the tasks
+		 * (only emitted if the profiling was requested).
+		 * @param sInputFile QString with the name of the image/video file of the task.
+		 * @param oProfile TaskProfile with the timing of the stages of the task.
+		 */
+		void taskProfiled(const QString &sInputFile, const fsdk::TaskProfile &oProfile);
+
+		/**
+		 * Captures the signal with the metadata of one of the input files probed
+		 * in background, to give its number of frames to the batch progress and
+		 * to start its task (if still waiting) before the ones of shorter files.
+		 * @param oProbe InputProbe with the metadata of the file.
+		 */
+		void inputProbed(const fsdk::InputProbe &oProbe);
+
 	protected:
 
+		/**
+		 * Prints and/or saves the timing of the stages of all tasks, if the
+		 * profiling was requested. It must be called before the application
+		 * terminates.
+		 */
+		void reportProfile();
+
 		/**
 		 * Checks if the CSV file exists and, in that case, confirm with the user
 		 * if she wants to have the file overwritten.
@@ -144,6 +180,20 @@ namespace fsdk
 		 */
 		bool confirmWritable(const QString sCSVFilename, bool &bAutoIgnore, bool &bCancel);
 
+		/**
+		 * Starts the tasks waiting, in their order, while there are threads
+		 * available in the pool to execute them.
+		 */
+		void startTasks();
+
+		/**
+		 * Creates the bank of Gabor filters used by the tasks, according to the
+		 * options of the command line (so the key of the results in the cache
+		 * is produced from the same bank that produces them).
+		 * @return GaborBank with the bank of filters.
+		 */
+		GaborBank createBank() const;
+
 		/**
 		 * Creates a new task to extracts the Gabor responses from the given input file.
 		 * The task created can then be initiated directly (by invoking task->run())
@@ -170,6 +220,96 @@ namespace fsdk
 
 		/** List of tasks in execution. */
 		QList<GaborExtractionTask*> m_lTasks;
+
+		/** Name of the face tracker backend. */
+		QString m_sTrackerBackend;
+
+		/** Indicates if the landmarks are temporally smoothed. */
+		bool m_bSmoothing;
+
+		/** Maximum number of consecutive frames filled by the smoothing. */
+		int m_iMaxGap;
+
+		/** Pooling of the Gabor responses over the regions of the face. */
+		RegionPooling m_oPooling;
+
+		/** Indicates if the Gabor responses are computed with the multi-scale (pyramid) filtering. */
+		bool m_bPyramid;
+
+		/** Indicates if the Gabor responses are computed with the fixed-point filtering. */
+		bool m_bFixedPoint;
+
+		/** Number of face crops filtered together in a batch. */
+		int m_iBatchSize;
+
+		/** Indicates if the filtering of the redundant frames is skipped. */
+		bool m_bGating;
+
+		/** Mean displacement of the landmarks below which a frame is redundant. */
+		double m_dGateThreshold;
+
+		/** Maximum number of consecutive frames skipped. */
+		int m_iGateMaxReused;
+
+		/** Indicates if the energies reused are validated against the filtering. */
+		bool m_bGateValidate;
+
+		/** Selection of the frames to process in the video files. */
+		FrameSelection m_oSelection;
+
+		/** Indicates if only the luma of the frames is decoded. */
+		bool m_bLumaDecode;
+
+		/** Indicates if the Gabor responses of each frame are printed as soon as they are extracted. */
+		bool m_bStreaming;
+
+		/** Maximum number of frames of a live input waiting to be processed. */
+		int m_iLiveQueueSize;
+
+		/** Maximum time that a frame of a live input may wait to be processed, in milliseconds. */
+		int m_iLiveMaxLatency;
+
+		/** Time after which the extraction of a live input ends, in seconds (0 for no limit). */
+		int m_iLiveDuration;
+
+		/** Key of the shared memory where the Gabor responses are published (empty if disabled). */
+		QString m_sPublishKey;
+
+		/** Number of frames kept in the ring buffer of the Gabor responses published. */
+		int m_iPublishCapacity;
+
+		/** Indicates if a previous execution should be resumed from the checkpoints. */
+		bool m_bResume;
+
+		/** Interval between the checkpoints of the tasks, in seconds (0 disables them). */
+		int m_iCheckpointInterval;
+
+		/** Cache of the results (only used if it is open). */
+		ResultCache m_oCache;
+
+		/** Keys of the results of the tasks in the cache (input file x key). */
+		QMap<QString, QString> m_mCacheKeys;
+
+		/** Progress of the whole batch of tasks. */
+		BatchProgress m_oBatchProgress;
+
+		/** Input files of the tasks not started yet, in the order they will be started. */
+		QStringList m_lPending;
+
+		/** Number of frames of the input files already probed (input file x frames). */
+		QMap<QString, int> m_mFrameCounts;
+
+		/** Prober of the input files of the tasks not started yet. */
+		InputProber m_oProber;
+
+		/** Timing of the stages of all tasks (enabled if the profiling was requested). */
+		TaskProfile m_oProfile;
+
+		/** Indicates if the timing of the stages should be printed at the end. */
+		bool m_bPrintProfile;
+
+		/** Name of the JSON file to save the timing of the stages (if requested). */
+		QString m_sProfileFile;
 	};
 }
 
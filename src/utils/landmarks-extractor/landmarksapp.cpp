@@ -26,7 +26,14 @@
 #include <QThreadPool>
 #include <QRegExp>
 #include "naming.h"
+#include "facetrackerregistry.h"
+#include "livesource.h"
+#include "imagesequence.h"
+#include "resultcache.h"
 #include <QRegularExpression>
+#include <QJsonDocument>
+#include <QFile>
+#include <QFileInfo>
 
 // To allow using _getch()/getch() for reading the overwrite confirmation answer
 #ifdef WIN32
@@ -39,11 +46,33 @@
 fsdk::LandmarksApp::LandmarksApp(int &argc, char **argv, const QString &sOrgName, const QString &sOrgDomain, const QString &sAppName, const QString &sAppVersion, const bool bUseSettings):
 	Application(argc, argv, sOrgName, sOrgDomain, sAppName, sAppVersion, bUseSettings)
 {
+	m_bPrintProfile = false;
+	m_bResume = false;
+	m_dTrackingScale = 1.0;
+	m_bTrackingROI = false;
+	m_bValidateTracking = false;
+	m_iCheckpointInterval = 60;
+	m_bSmoothing = false;
+	m_iMaxGap = 5;
+	m_iMaxFaces = 1;
+	m_bGating = false;
+	m_dGateThreshold = 2.0;
+	m_iGateMaxReused = 30;
+	m_bGateValidate = false;
+	m_bLumaDecode = false;
+	m_bStreaming = false;
+	m_iLiveQueueSize = 2;
+	m_iLiveMaxLatency = 200;
+	m_iLiveDuration = 0;
+	m_iPublishCapacity = 256;
+
 	// Replace the original message pattern from the parent class Application.
 	// i.e.: - remove the source and line number from trace even in debug;
 	//       - add the progress level instead of the log type;
 	qSetMessagePattern("%{time yyyy.MM.dd h:mm:ss.zzz} [%{if-critical}l1%{endif}%{if-warning}l2%{endif}%{if-info}l3%{endif}%{if-debug}l4%{endif}]: %{message}");
 	setLogLevel(Critical);
+
+	connect(&m_oProber, &InputProber::inputProbed, this, &LandmarksApp::inputProbed);
 }
 
 // +-----------------------------------------------------------
@@ -59,7 +88,14 @@ fsdk::LandmarksApp::CommandLineParseResult fsdk::LandmarksApp::parseCommandLine(
 
 	// Input image/video file option
 	oParser.addPositionalArgument("input file",
-		tr("Image or video file (wildcard masks can be used) to use for the landmark extraction."),
+		tr("Image or video file (wildcard masks can be used) to use for the landmark extraction, "
+		   "or a live input: camera:<index> for a camera device, or pipe:<width>x<height>[@<fps>]:<path> "
+		   "for a named pipe with raw BGR24 frames, or a sequence of images processed as the frames of a "
+		   "single input (with a single <csv file>): a directory, or images:<wildcard mask>. A ** directory "
+		   "in the wildcard masks lists the subdirectories recursively (e.g. videos/**/*.mp4 with the "
+		   "<csv file> csv/**/*.csv, whose subdirectories mirror the ones of the input files). A batch "
+		   "can also be given as @<manifest file>: a CSV file (without header) with an input file and its "
+		   "<csv file> in each line, case in which the argument <csv file> is omitted."),
 		tr("<input file>")
 	);
 
@@ -94,6 +130,204 @@ fsdk::LandmarksApp::CommandLineParseResult fsdk::LandmarksApp::parseCommandLine(
 	);
 	oParser.addOption(oAutoConfirmOpt);
 
+	// Tracking mode options
+	QCommandLineOption oTrackScaleOpt(QStringList({ "s", "track-scale" }),
+		tr("Scale factor, in range (0,1], applied to the frames before tracking the face "
+		   "(default is 1, i.e. full resolution). Lower values are much faster on high "
+		   "resolution videos; the landmarks are still given in full resolution."
+		), tr("factor"), "1"
+	);
+	oParser.addOption(oTrackScaleOpt);
+
+	QCommandLineOption oTrackROIOpt(QStringList({ "track-roi" }),
+		tr("Tracks the face only in a region around the face found in the previous frames.")
+	);
+	oParser.addOption(oTrackROIOpt);
+
+	QCommandLineOption oValidateOpt(QStringList({ "validate-tracking" }),
+		tr("Also tracks the face in full resolution (slower) and reports how much the "
+		   "landmarks obtained with --track-scale and/or --track-roi differ from it.")
+	);
+	oParser.addOption(oValidateOpt);
+
+	// Face tracker option
+	QCommandLineOption oTrackerOpt(QStringList({ "t", "tracker" }),
+		tr("%1, among: %2 (default is %3).").arg(tr("Face tracker used to extract the landmarks"))
+			.arg(FaceTrackerRegistry::backends().join(", ")).arg(FaceTrackerRegistry::defaultBackend()),
+		tr("name"), FaceTrackerRegistry::defaultBackend()
+	);
+	oParser.addOption(oTrackerOpt);
+
+	// Temporal smoothing options
+	QCommandLineOption oSmoothOpt(QStringList({ "smooth" }),
+		tr("Smooths the landmarks along the frames (reducing the jitter of the tracking), fills the short gaps where the face is lost and uses the predicted landmarks to help the tracker.")
+	);
+	oParser.addOption(oSmoothOpt);
+
+	QCommandLineOption oMaxGapOpt(QStringList({ "max-gap" }),
+		tr("Maximum number of consecutive frames without landmarks filled by --smooth (default is 5)."),
+		tr("frames"), "5"
+	);
+	oParser.addOption(oMaxGapOpt);
+
+	// Gating options
+	QCommandLineOption oGateOpt(QStringList({ "gate" }),
+		tr("Skips the tracking of the frames that barely changed since the last frame tracked, "
+		   "reusing its landmarks: a frame is skipped if the mean absolute difference of its "
+		   "downsampled gray levels is below the given threshold (e.g. 2). The frames skipped "
+		   "are marked in the column Reused of the <csv file>. Only used if --faces is 1."
+		), tr("threshold")
+	);
+	oParser.addOption(oGateOpt);
+
+	QCommandLineOption oGateMaxOpt(QStringList({ "gate-max" }),
+		tr("Maximum number of consecutive frames skipped by --gate (default is 30)."),
+		tr("frames"), "30"
+	);
+	oParser.addOption(oGateMaxOpt);
+
+	QCommandLineOption oGateValidateOpt(QStringList({ "gate-validate" }),
+		tr("Also tracks the frames skipped by --gate and reports the differences between "
+		   "the landmarks reused and the landmarks tracked at the end of each file."
+		)
+	);
+	oParser.addOption(oGateValidateOpt);
+
+	// Multiple faces options
+	QCommandLineOption oFacesOpt(QStringList({ "faces" }),
+		tr("Maximum number of faces tracked in each frame (default is 1). With more than "
+		   "one face, the landmarks of each face are saved to a <csv file> with the suffix "
+		   "-face<ID>, and the <csv file> lists the faces found."
+		), tr("number"), "1"
+	);
+	oParser.addOption(oFacesOpt);
+
+	QCommandLineOption oDetectorOpt(QStringList({ "face-detector" }),
+		tr("Haar cascade file used to detect the faces when --faces is greater than 1 "
+		   "(default is haarcascade_frontalface_alt2.xml in the application directory)."
+		), tr("file")
+	);
+	oParser.addOption(oDetectorOpt);
+
+	// Decoding option
+	QCommandLineOption oLumaOpt(QStringList({ "luma" }),
+		tr("Keeps only the luma (gray levels) of the frames as they are decoded, so the face trackers need no color conversion and the copies of the frames are a third of the size.")
+	);
+	oParser.addOption(oLumaOpt);
+
+	// Frame selection options
+	QCommandLineOption oStrideOpt(QStringList({ "stride" }),
+		tr("Processes only every Nth frame of the video files (default is 1, i.e. all frames)."),
+		tr("N"), "1"
+	);
+	oParser.addOption(oStrideOpt);
+
+	QCommandLineOption oFramesOpt(QStringList({ "frames" }),
+		tr("Processes only the given frames and ranges of frames of the video files "
+		   "(e.g. \"0-299,450,600-899\"). The stride, if given, applies to the ranges."
+		), tr("list")
+	);
+	oParser.addOption(oFramesOpt);
+
+	QCommandLineOption oTimesOpt(QStringList({ "times" }),
+		tr("Processes only the frames in the given time ranges of the video files, in "
+		   "seconds or [[hh:]mm:]ss (e.g. \"65.5-90,00:02:00-00:02:30\"). The stride, if "
+		   "given, applies to the ranges."
+		), tr("list")
+	);
+	oParser.addOption(oTimesOpt);
+
+	// Live input and streaming options
+	QCommandLineOption oStreamOpt(QStringList({ "stream" }),
+		tr("Prints the landmarks of each frame to the standard output as soon as it is "
+		   "processed, as CSV lines with the frame, the face (if --faces is greater than 1), "
+		   "the quality and the coordinates of the landmarks.")
+	);
+	oParser.addOption(oStreamOpt);
+
+	QCommandLineOption oLiveQueueOpt(QStringList({ "live-queue" }),
+		tr("Maximum number of frames of a live input waiting to be processed; the oldest "
+		   "ones are dropped when the extraction falls behind (default is 2)."
+		), tr("frames"), "2"
+	);
+	oParser.addOption(oLiveQueueOpt);
+
+	QCommandLineOption oLiveLatencyOpt(QStringList({ "live-latency" }),
+		tr("Maximum time in milliseconds that a frame of a live input may wait to be "
+		   "processed before being dropped (default is 200). Use 0 for no limit."
+		), tr("ms"), "200"
+	);
+	oParser.addOption(oLiveLatencyOpt);
+
+	QCommandLineOption oLiveDurationOpt(QStringList({ "live-duration" }),
+		tr("Time in seconds after which the extraction of a live input ends (default is 0, "
+		   "i.e. until the input ends or the application is interrupted)."
+		), tr("seconds"), "0"
+	);
+	oParser.addOption(oLiveDurationOpt);
+
+	QCommandLineOption oPublishOpt(QStringList({ "publish" }),
+		tr("Publishes the landmarks of each frame, as soon as it is processed, to a ring buffer "
+		   "in the shared memory with the given key, to be consumed by other processes "
+		   "(see the utility ffread). Only one input can be processed with this option."
+		), tr("key")
+	);
+	oParser.addOption(oPublishOpt);
+
+	QCommandLineOption oPublishCapacityOpt(QStringList({ "publish-capacity" }),
+		tr("Number of frames kept in the ring buffer of --publish (default is 256)."),
+		tr("frames"), "256"
+	);
+	oParser.addOption(oPublishCapacityOpt);
+
+	// Checkpointing options
+	QCommandLineOption oResumeOpt(QStringList({ "r", "resume" }),
+		tr("Resumes a previous execution that was interrupted: the input files whose "
+		   "CSV files were already concluded are skipped and the others continue "
+		   "from their last checkpoint (if any).")
+	);
+	oParser.addOption(oResumeOpt);
+
+	QCommandLineOption oCheckpointOpt(QStringList({ "c", "checkpoint" }),
+		tr("Interval in seconds between the checkpoints of the partial results of "
+		   "each input file (default is 60). Use 0 to disable the checkpoints."
+		), tr("seconds"), "60"
+	);
+	oParser.addOption(oCheckpointOpt);
+
+	// Result cache options
+	QCommandLineOption oCacheOpt(QStringList({ "cache" }),
+		tr("Directory of a cache of the results: the <csv file> of an input file (with the "
+		   "files of the faces and the summary pyramids saved along with it) that was "
+		   "already processed with the same options is taken from the cache (instead of "
+		   "processing the file again), and the new results are added to it. The input "
+		   "files are compared by a fast hash of their contents. Live inputs and image "
+		   "sequences are not cached."
+		), tr("directory")
+	);
+	oParser.addOption(oCacheOpt);
+
+	QCommandLineOption oCacheSizeOpt(QStringList({ "cache-size" }),
+		tr("Maximum size of the results kept in the cache of --cache, in megabytes "
+		   "(default is 1024). The results used less recently are evicted first."
+		), tr("MB"), "1024"
+	);
+	oParser.addOption(oCacheSizeOpt);
+
+	// Profiling options
+	QCommandLineOption oProfileOpt(QStringList({ "profile" }),
+		tr("Prints the timing of the stages of the extraction (throughput and latency "
+		   "percentiles of decoding, tracking, reset and serialization) at the end.")
+	);
+	oParser.addOption(oProfileOpt);
+
+	QCommandLineOption oProfileJsonOpt(QStringList({ "profile-json" }),
+		tr("Saves the timing of the stages of the extraction, including the latency "
+		   "histograms, to the given JSON file at the end."
+		), tr("file")
+	);
+	oParser.addOption(oProfileJsonOpt);
+
 	// Help and version options
 	QCommandLineOption oHelpOpt = oParser.addHelpOption();
 	QCommandLineOption oVersionOpt = oParser.addVersionOption();
@@ -135,6 +369,168 @@ fsdk::LandmarksApp::CommandLineParseResult fsdk::LandmarksApp::parseCommandLine(
 	int iLevel = oParser.value(oMsgLevelOpt).toInt();
 	setLogLevel(static_cast<LogLevel>(iLevel));
 
+	// Get the tracking mode options
+	m_dTrackingScale = oParser.value(oTrackScaleOpt).toDouble(&bValid);
+	if(!bValid || m_dTrackingScale <= 0 || m_dTrackingScale > 1)
+	{
+		qCritical().noquote() << tr("invalid tracking scale: %1").arg(oParser.value(oTrackScaleOpt)) << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+	m_bTrackingROI = oParser.isSet(oTrackROIOpt);
+	m_bValidateTracking = oParser.isSet(oValidateOpt);
+
+	// Get the face tracker option
+	m_sTrackerBackend = oParser.value(oTrackerOpt);
+	if(!FaceTrackerRegistry::backend(m_sTrackerBackend))
+	{
+		qCritical().noquote() << tr("unknown face tracker: %1").arg(m_sTrackerBackend) << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+
+	// Get the temporal smoothing options
+	m_bSmoothing = oParser.isSet(oSmoothOpt);
+	m_iMaxGap = oParser.value(oMaxGapOpt).toInt(&bValid);
+	if(!bValid || m_iMaxGap < 0)
+	{
+		qCritical().noquote() << tr("invalid maximum gap: %1").arg(oParser.value(oMaxGapOpt)) << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+
+	// Get the gating options
+	m_bGating = oParser.isSet(oGateOpt);
+	if(m_bGating)
+	{
+		m_dGateThreshold = oParser.value(oGateOpt).toDouble(&bValid);
+		if(!bValid || m_dGateThreshold <= 0)
+		{
+			qCritical().noquote() << tr("invalid gating threshold: %1").arg(oParser.value(oGateOpt)) << endl;
+			oParser.showHelp();
+			return CommandLineError;
+		}
+	}
+	m_iGateMaxReused = oParser.value(oGateMaxOpt).toInt(&bValid);
+	if(!bValid || m_iGateMaxReused < 1)
+	{
+		qCritical().noquote() << tr("invalid maximum number of frames skipped: %1").arg(oParser.value(oGateMaxOpt)) << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+	m_bGateValidate = oParser.isSet(oGateValidateOpt);
+
+	// Get the multiple faces options
+	m_iMaxFaces = oParser.value(oFacesOpt).toInt(&bValid);
+	if(!bValid || m_iMaxFaces < 1)
+	{
+		qCritical().noquote() << tr("invalid number of faces: %1").arg(oParser.value(oFacesOpt)) << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+	m_sDetectorFile = oParser.value(oDetectorOpt);
+	if(!m_sDetectorFile.isEmpty() && !QFile::exists(m_sDetectorFile))
+	{
+		qCritical().noquote() << tr("face detector file does not exist: %1").arg(m_sDetectorFile) << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+
+	// Get the decoding option
+	m_bLumaDecode = oParser.isSet(oLumaOpt);
+
+	// Get the frame selection options
+	int iStride = oParser.value(oStrideOpt).toInt(&bValid);
+	if(!bValid || iStride < 1)
+	{
+		qCritical().noquote() << tr("invalid stride: %1").arg(oParser.value(oStrideOpt)) << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+	m_oSelection.clear();
+	m_oSelection.setStride(iStride);
+
+	if(oParser.isSet(oFramesOpt) && !m_oSelection.parseFrames(oParser.value(oFramesOpt)))
+	{
+		qCritical().noquote() << tr("invalid list of frames: %1").arg(oParser.value(oFramesOpt)) << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+
+	if(oParser.isSet(oTimesOpt) && !m_oSelection.parseTimes(oParser.value(oTimesOpt)))
+	{
+		qCritical().noquote() << tr("invalid list of time ranges: %1").arg(oParser.value(oTimesOpt)) << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+
+	// Get the live input and streaming options
+	m_bStreaming = oParser.isSet(oStreamOpt);
+	m_iLiveQueueSize = oParser.value(oLiveQueueOpt).toInt(&bValid);
+	if(!bValid || m_iLiveQueueSize < 1)
+	{
+		qCritical().noquote() << tr("invalid live queue size: %1").arg(oParser.value(oLiveQueueOpt)) << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+	m_iLiveMaxLatency = oParser.value(oLiveLatencyOpt).toInt(&bValid);
+	if(!bValid || m_iLiveMaxLatency < 0)
+	{
+		qCritical().noquote() << tr("invalid live latency: %1").arg(oParser.value(oLiveLatencyOpt)) << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+	m_iLiveDuration = oParser.value(oLiveDurationOpt).toInt(&bValid);
+	if(!bValid || m_iLiveDuration < 0)
+	{
+		qCritical().noquote() << tr("invalid live duration: %1").arg(oParser.value(oLiveDurationOpt)) << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+
+	// Get the publishing options
+	m_sPublishKey = oParser.value(oPublishOpt);
+	m_iPublishCapacity = oParser.value(oPublishCapacityOpt).toInt(&bValid);
+	if(!bValid || m_iPublishCapacity < 1)
+	{
+		qCritical().noquote() << tr("invalid publishing capacity: %1").arg(oParser.value(oPublishCapacityOpt)) << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+
+	// Get the checkpointing options
+	m_bResume = oParser.isSet(oResumeOpt);
+	m_iCheckpointInterval = oParser.value(oCheckpointOpt).toInt(&bValid);
+	if(!bValid || m_iCheckpointInterval < 0)
+	{
+		qCritical().noquote() << tr("invalid checkpoint interval: %1").arg(oParser.value(oCheckpointOpt)) << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+
+	// Get the result cache options
+	if(oParser.isSet(oCacheOpt))
+	{
+		int iCacheSize = oParser.value(oCacheSizeOpt).toInt(&bValid);
+		if(!bValid || iCacheSize < 1)
+		{
+			qCritical().noquote() << tr("invalid cache size: %1").arg(oParser.value(oCacheSizeOpt)) << endl;
+			oParser.showHelp();
+			return CommandLineError;
+		}
+		if(!m_oCache.open(oParser.value(oCacheOpt), qint64(iCacheSize) * 1024 * 1024))
+		{
+			qCritical().noquote() << tr("invalid cache directory: %1").arg(oParser.value(oCacheOpt)) << endl;
+			oParser.showHelp();
+			return CommandLineError;
+		}
+	}
+
+	// Get the profiling options
+	m_bPrintProfile = oParser.isSet(oProfileOpt);
+	m_sProfileFile = oParser.value(oProfileJsonOpt);
+	m_oProfile.setEnabled(m_bPrintProfile || !m_sProfileFile.isEmpty());
+
 	// Get the quality level
 	QRegularExpression oREQuality("^0(\\.[0-9]+)?$|^1(\\.0)?$");
 	bValid = oREQuality.match(oParser.value(oQualityLevelOpt)).hasMatch();
@@ -155,6 +551,9 @@ fsdk::LandmarksApp::CommandLineParseResult fsdk::LandmarksApp::parseCommandLine(
 			return CommandLineError;
 
 		case 1:
+			// The manifests include the CSV files
+			if(Naming::isManifest(oParser.positionalArguments().at(0)))
+				break;
 			qCritical().noquote() << tr("the argument <csv file> is required") << endl;
 			oParser.showHelp();
 			return CommandLineError;
@@ -175,9 +574,61 @@ fsdk::LandmarksApp::CommandLineParseResult fsdk::LandmarksApp::parseCommandLine(
 
 	// Map the image/video/wildcard to the CSV file/wildcard
 	QString sInputFile = oParser.positionalArguments().at(0);;
-	QString sCSVFile = oParser.positionalArguments().at(1);
+	QString sCSVFile = oParser.positionalArguments().value(1);
 	m_mTaskFiles.clear();
-	Naming::WildcardListingReturn eRet = Naming::wildcardListing(sInputFile, sCSVFile, m_mTaskFiles);
+	Naming::WildcardListingReturn eRet;
+	if(Naming::isManifest(sInputFile))
+	{
+		if(!sCSVFile.isEmpty())
+		{
+			qCritical().noquote() << tr("unexpected arguments: %1").arg(sCSVFile) << endl;
+			oParser.showHelp();
+			return CommandLineError;
+		}
+
+		// The manifest is read one line at a time
+		QMap<QString, QStringList> mManifest;
+		int iLine;
+		switch(Naming::manifestListing(sInputFile, 1, mManifest, iLine))
+		{
+			case Naming::ManifestNotReadable:
+				qCritical().noquote() << tr("manifest file can not be read: %1").arg(sInputFile.mid(1)) << endl;
+				oParser.showHelp();
+				return CommandLineError;
+
+			case Naming::InvalidManifestLine:
+				qCritical().noquote() << tr("invalid line %1 in the manifest file %2 (expected an input file and a CSV file)").arg(iLine).arg(sInputFile.mid(1)) << endl;
+				oParser.showHelp();
+				return CommandLineError;
+
+			case Naming::DuplicateManifestInput:
+				qCritical().noquote() << tr("line %1 of the manifest file %2 lists an input already listed before").arg(iLine).arg(sInputFile.mid(1)) << endl;
+				oParser.showHelp();
+				return CommandLineError;
+
+			case Naming::EmptyManifest:
+				qCritical().noquote() << tr("manifest file did not list any file: %1").arg(sInputFile.mid(1)) << endl;
+				oParser.showHelp();
+				return CommandLineError;
+
+			case Naming::ManifestOk:
+				break;
+		}
+
+		QMap<QString, QStringList>::const_iterator itManifest;
+		for(itManifest = mManifest.cbegin(); itManifest != mManifest.cend(); ++itManifest)
+			m_mTaskFiles[itManifest.key()] = itManifest.value().first();
+		eRet = Naming::ListingOk;
+	}
+	else if(LiveSource::isLiveInput(sInputFile) || ImageSequence::isImageSequence(sInputFile))
+	{
+		// The live inputs are not files and the image sequences are a single
+		// input, so they are not listed
+		m_mTaskFiles[sInputFile] = sCSVFile;
+		eRet = Naming::ListingOk;
+	}
+	else
+		eRet = Naming::wildcardListing(sInputFile, sCSVFile, m_mTaskFiles);
 
 	switch(eRet)
 	{
@@ -210,15 +661,56 @@ fsdk::LandmarksApp::CommandLineParseResult fsdk::LandmarksApp::parseCommandLine(
 			break;
 	}
 
-	// Check if existing CSV files should be overwriting
+	// Create the directories of the CSV files mirrored from the input files
+	// (or given in a manifest), since they might not exist yet
+	if(Naming::isManifest(sInputFile) || Naming::isRecursiveWildcard(sInputFile))
+	{
+		QMap<QString, QString>::const_iterator itFile;
+		for(itFile = m_mTaskFiles.cbegin(); itFile != m_mTaskFiles.cend(); ++itFile)
+			QDir().mkpath(QFileInfo(itFile.value()).absolutePath());
+	}
+
+	// The ring buffer of the features published can only have one writer
+	if(!m_sPublishKey.isEmpty() && m_mTaskFiles.count() > 1)
+	{
+		qCritical().noquote() << tr("only one input file can be processed with --publish") << endl;
+		oParser.showHelp();
+		return CommandLineError;
+	}
+
+	// If resuming, skip the input files already concluded (i.e. whose CSV files
+	// exist with contents and have no checkpoint pending)
 	QStringList lIgnored;
-	bool bAutoConfirm = oParser.isSet(oAutoConfirmOpt);
 	QMap<QString, QString>::const_iterator it;
+	if(m_bResume)
+	{
+		for(it = m_mTaskFiles.cbegin(); it != m_mTaskFiles.cend(); ++it)
+		{
+			QString sInputFile = it.key();
+			QString sCSVFile = it.value();
+
+			if(!QFile::exists(ExtractionTask::checkpointFileName(sCSVFile)) && QFileInfo(sCSVFile).size() > 0)
+				lIgnored.append(sInputFile);
+		}
+		foreach(QString sIgnored, lIgnored)
+		{
+			qInfo().noquote() << tr("skipping input file %1 because it was already concluded").arg(sIgnored);
+			m_mTaskFiles.remove(sIgnored);
+		}
+	}
+
+	// Check if existing CSV files should be overwriting (the ones being resumed
+	// from a checkpoint are not really overwritten)
+	lIgnored.clear();
+	bool bAutoConfirm = oParser.isSet(oAutoConfirmOpt);
 	for(it = m_mTaskFiles.cbegin(); it != m_mTaskFiles.cend(); ++it)
 	{
 		QString sInputFile = it.key();
 		QString sCSVFile = it.value();
 
+		if(m_bResume && QFile::exists(ExtractionTask::checkpointFileName(sCSVFile)))
+			continue;
+
 		if(!confirmOverwrite(sCSVFile, bAutoConfirm))
 			lIgnored.append(sInputFile);
 	}
@@ -253,8 +745,65 @@ fsdk::LandmarksApp::CommandLineParseResult fsdk::LandmarksApp::parseCommandLine(
 		m_mTaskFiles.remove(sIgnored);
 	}
 
-	// If no tasks remain, terminate with error
-	if(m_mTaskFiles.count() == 0)
+	// Take the results of the input files already processed with the same
+	// options from the cache (the ones being resumed are processed anyway)
+	int iCached = 0;
+	m_mCacheKeys.clear();
+	if(m_oCache.isOpen())
+	{
+		// Options that change the landmarks extracted (and the tool version,
+		// since the trackers may change between versions)
+		QStringList lParameters;
+		lParameters.append(QString("tool=%1 %2").arg(applicationName(), applicationVersion()));
+		lParameters.append(QString("tracker=%1").arg(m_sTrackerBackend));
+		lParameters.append(QString("quality=%1").arg(m_fMinimumQuality));
+		lParameters.append(QString("track-scale=%1").arg(m_dTrackingScale));
+		lParameters.append(QString("track-roi=%1").arg(m_bTrackingROI));
+		lParameters.append(QString("smooth=%1").arg(m_bSmoothing ? QString::number(m_iMaxGap) : QString("off")));
+		lParameters.append(QString("faces=%1").arg(m_iMaxFaces));
+		lParameters.append(QString("face-detector=%1").arg(m_sDetectorFile.isEmpty() ? QString("default") : ResultCache::hashFile(m_sDetectorFile)));
+		lParameters.append(QString("gate=%1").arg(m_bGating ? QString("%1/%2").arg(m_dGateThreshold).arg(m_iGateMaxReused) : QString("off")));
+		lParameters.append(QString("luma=%1").arg(m_bLumaDecode));
+		lParameters.append(QString("stride=%1").arg(oParser.value(oStrideOpt)));
+		lParameters.append(QString("frames=%1").arg(oParser.value(oFramesOpt)));
+		lParameters.append(QString("times=%1").arg(oParser.value(oTimesOpt)));
+
+		lIgnored.clear();
+		for(it = m_mTaskFiles.cbegin(); it != m_mTaskFiles.cend(); ++it)
+		{
+			QString sInputFile = it.key();
+			QString sCSVFile = it.value();
+
+			if(LiveSource::isLiveInput(sInputFile) || ImageSequence::isImageSequence(sInputFile))
+				continue;
+
+			// The index of several faces lists the files of the faces by name, so
+			// it can only be reused with the same name
+			QStringList lKeyParameters = lParameters;
+			if(m_iMaxFaces > 1)
+				lKeyParameters.append(QString("output=%1").arg(QFileInfo(sCSVFile).fileName()));
+
+			QString sKey = ResultCache::key(QStringList(sInputFile), lKeyParameters);
+			if(sKey.isEmpty())
+				continue;
+			m_mCacheKeys[sInputFile] = sKey;
+
+			if(m_bResume && QFile::exists(ExtractionTask::checkpointFileName(sCSVFile)))
+				continue;
+
+			if(m_oCache.fetch(sKey, sCSVFile))
+				lIgnored.append(sInputFile);
+		}
+		foreach(QString sIgnored, lIgnored)
+		{
+			qInfo().noquote() << tr("taking the landmarks of input file %1 from the cache").arg(sIgnored);
+			m_mTaskFiles.remove(sIgnored);
+		}
+		iCached = lIgnored.count();
+	}
+
+	// If no tasks remain (and no results were taken from the cache), terminate with error
+	if(m_mTaskFiles.count() == 0 && iCached == 0)
 		return CommandLineError;
 
 	// Otherwise, go on! :)
@@ -365,11 +914,33 @@ fsdk::LandmarksExtractionTask* fsdk::LandmarksApp::createTask(const QString sInp
 {
 	LandmarksExtractionTask *pTask = new LandmarksExtractionTask(sInputFile, m_fMinimumQuality);
 	pTask->setAutoDelete(false);
+	pTask->setProfilingEnabled(m_oProfile.isEnabled());
+	pTask->setFrameSelection(m_oSelection);
+	pTask->setDecodeMode(m_bLumaDecode ? ExtractionTask::LumaDecode : ExtractionTask::ColorDecode);
+	pTask->setTrackerBackend(m_sTrackerBackend);
+	pTask->setSmoothing(m_bSmoothing, m_iMaxGap);
+	pTask->setMultiFace(m_iMaxFaces, m_sDetectorFile);
+	pTask->setGating(m_bGating, m_dGateThreshold, m_iGateMaxReused, m_bGateValidate);
+	pTask->setTrackingMode(m_dTrackingScale, m_bTrackingROI);
+	pTask->setValidationEnabled(m_bValidateTracking);
+	pTask->setLiveOptions(m_iLiveQueueSize, m_iLiveMaxLatency, m_iLiveDuration);
+	pTask->setStreaming(m_bStreaming);
+	pTask->setPublishing(m_sPublishKey, m_iPublishCapacity);
+
+	// Enable the checkpoints (discarding any previous one if not resuming)
+	QString sCheckpointFile = ExtractionTask::checkpointFileName(m_mTaskFiles[sInputFile]);
+	if(!m_bResume)
+		ExtractionTask::removeCheckpoint(sCheckpointFile);
+	if(m_iCheckpointInterval > 0)
+		pTask->setCheckpoint(sCheckpointFile, m_iCheckpointInterval);
+
 	m_lTasks.append(pTask);
 
 	connect(pTask, &LandmarksExtractionTask::taskError, this, &LandmarksApp::taskError);
 	connect(pTask, &LandmarksExtractionTask::taskProgress, this, &LandmarksApp::taskProgress);
 	connect(pTask, &LandmarksExtractionTask::taskFinished, this, &LandmarksApp::taskFinished);
+	connect(pTask, &LandmarksExtractionTask::taskResult, this, &LandmarksApp::taskResult);
+	connect(pTask, &LandmarksExtractionTask::taskProfiled, this, &LandmarksApp::taskProfiled);
 
 	return pTask;
 }
@@ -382,6 +953,8 @@ void fsdk::LandmarksApp::deleteTask(fsdk::LandmarksExtractionTask* pTask)
 	disconnect(pTask, &LandmarksExtractionTask::taskError, this, &LandmarksApp::taskError);
 	disconnect(pTask, &LandmarksExtractionTask::taskProgress, this, &LandmarksApp::taskProgress);
 	disconnect(pTask, &LandmarksExtractionTask::taskFinished, this, &LandmarksApp::taskFinished);
+	disconnect(pTask, &LandmarksExtractionTask::taskResult, this, &LandmarksApp::taskResult);
+	disconnect(pTask, &LandmarksExtractionTask::taskProfiled, this, &LandmarksApp::taskProfiled);
 
 	delete pTask;
 }
@@ -389,15 +962,79 @@ void fsdk::LandmarksApp::deleteTask(fsdk::LandmarksExtractionTask* pTask)
 // +-----------------------------------------------------------
 void fsdk::LandmarksApp::run()
 {
-	QMap<QString, QString>::const_iterator it;
-	for(it = m_mTaskFiles.cbegin(); it != m_mTaskFiles.cend(); ++it)
+	// All results might have been taken from the cache
+	if(m_mTaskFiles.count() == 0)
 	{
-		QString sInputFile = it.key();
+		reportProfile();
+		exit(0);
+		return;
+	}
+
+	m_oBatchProgress.setTasksCount(m_mTaskFiles.count());
+
+	// Only the files can be probed (the live inputs and the image sequences
+	// are started after them)
+	QStringList lFiles, lOthers;
+	foreach(QString sInputFile, m_mTaskFiles.keys())
+	{
+		if(LiveSource::isLiveInput(sInputFile) || ImageSequence::isImageSequence(sInputFile))
+			lOthers.append(sInputFile);
+		else
+			lFiles.append(sInputFile);
+	}
+	m_lPending = lFiles + lOthers;
+	startTasks();
+
+	// Probe the files of the tasks still waiting in background, so the batch
+	// progress knows their number of frames and the longest ones are started
+	// first (see inputProbed())
+	QStringList lProbed;
+	foreach(QString sInputFile, lFiles)
+	{
+		if(m_lPending.contains(sInputFile))
+			lProbed.append(sInputFile);
+	}
+	if(lProbed.count() > 0)
+		m_oProber.start(lProbed);
+}
+
+// +-----------------------------------------------------------
+void fsdk::LandmarksApp::startTasks()
+{
+	// Only as many tasks as the threads of the pool are started, so the ones
+	// waiting can still be reordered as their input files are probed
+	while(m_lPending.count() > 0 && m_lTasks.count() < QThreadPool::globalInstance()->maxThreadCount())
+	{
+		QString sInputFile = m_lPending.takeFirst();
 		LandmarksExtractionTask *pTask = createTask(sInputFile);
 		QThreadPool::globalInstance()->start(pTask);
 	}
 }
 
+// +-----------------------------------------------------------
+void fsdk::LandmarksApp::inputProbed(const fsdk::InputProbe &oProbe)
+{
+	if(oProbe.frameCount() <= 0)
+		return;
+
+	// Give the number of frames of the file to the batch progress, so it does
+	// not need to estimate it while the task is not started
+	double dFrameRate = oProbe.frameRate() > 0 ? oProbe.frameRate() : 30;
+	int iFrameCount = m_oSelection.isAll() ? oProbe.frameCount() : m_oSelection.count(oProbe.frameCount(), dFrameRate);
+	m_oBatchProgress.estimate(oProbe.inputFile(), iFrameCount);
+	m_mFrameCounts[oProbe.inputFile()] = iFrameCount;
+
+	// Move the task (if still waiting) ahead of the ones with fewer frames or
+	// not probed yet, so the longest files do not delay the end of the batch
+	if(m_lPending.removeOne(oProbe.inputFile()))
+	{
+		int iPos = 0;
+		while(iPos < m_lPending.count() && m_mFrameCounts.value(m_lPending[iPos]) >= iFrameCount)
+			iPos++;
+		m_lPending.insert(iPos, oProbe.inputFile());
+	}
+}
+
 // +-----------------------------------------------------------
 void fsdk::LandmarksApp::taskError(const QString &sInputFile, const ExtractionTask::ExtractionError eError)
 {
@@ -418,18 +1055,28 @@ void fsdk::LandmarksApp::taskError(const QString &sInputFile, const ExtractionTa
 
 	LandmarksExtractionTask *pTask = static_cast<LandmarksExtractionTask*>(sender());
 	deleteTask(pTask);
+	m_oBatchProgress.finish(sInputFile);
+
+	// Start the next task waiting (if any) in the place of this one
+	startTasks();
 
 	if(m_lTasks.count() == 0)
 	{
 		QThreadPool::globalInstance()->waitForDone();
+		reportProfile();
 		exit(-2);
 	}
 }
 
 // +-----------------------------------------------------------
-void fsdk::LandmarksApp::taskProgress(const QString &sInputFile, int iProgress)
+void fsdk::LandmarksApp::taskProgress(const QString &sInputFile, const fsdk::TaskProgress &oProgress)
 {
-	qDebug().noquote() << tr("file %1 progress: %2%").arg(sInputFile).arg(iProgress);
+	m_oBatchProgress.update(sInputFile, oProgress);
+
+	qDebug().noquote() << tr("file %1 progress: %2% (%3 fps, ETA %4); batch: %5 of %6 files, %7% (%8 fps, ETA %9)")
+		.arg(sInputFile).arg(oProgress.percent()).arg(oProgress.frameRate(), 0, 'f', 1).arg(TaskProgress::formatTime(oProgress.remaining()))
+		.arg(m_oBatchProgress.finishedCount()).arg(m_oBatchProgress.tasksCount()).arg(m_oBatchProgress.percent())
+		.arg(m_oBatchProgress.frameRate(), 0, 'f', 1).arg(TaskProgress::formatTime(m_oBatchProgress.remaining()));
 }
 
 // +-----------------------------------------------------------
@@ -437,31 +1084,132 @@ void fsdk::LandmarksApp::taskFinished(const QString &sInputFile, const QVariant
 {
 	LandmarksExtractionTask *pTask = static_cast<LandmarksExtractionTask*>(sender());
 	deleteTask(pTask);
+	m_oBatchProgress.finish(sInputFile);
+
+	// Start the next task waiting (if any) in the place of this one
+	startTasks();
 
 	int iRet;
 	QString sCSVFile = m_mTaskFiles[sInputFile];
 
-	if(!vData.value<LandmarksData>().saveToCSV(sCSVFile))
+	bool bSaved;
+	{
+		ScopedStageTimer oTimer(m_oProfile, TaskProfile::SerializationStage);
+		if(vData.userType() == qMetaTypeId<FaceTracksData>())
+			bSaved = vData.value<FaceTracksData>().saveToCSV(sCSVFile);
+		else
+			bSaved = vData.value<LandmarksData>().saveToCSV(sCSVFile);
+	}
+
+	if(!bSaved)
 	{
 		qCritical().noquote() << tr("error writing to CSV file %1").arg(sCSVFile);
 		iRet = -3;
 	}
 	else
 	{
+		ExtractionTask::removeCheckpoint(ExtractionTask::checkpointFileName(sCSVFile));
 		qInfo().noquote() << tr("extraction of landmards from file %1 concluded.").arg(sInputFile);
 		iRet = 0;
+
+		// Add the results to the cache, with the files of the faces and the
+		// summary pyramids (a failure only means they are not reused)
+		if(m_mCacheKeys.contains(sInputFile))
+		{
+			QStringList lResults(sCSVFile);
+			if(vData.userType() == qMetaTypeId<FaceTracksData>())
+				lResults.append(FaceTracksData::faceFiles(sCSVFile));
+
+			QStringList lFiles;
+			foreach(QString sFile, lResults)
+			{
+				lFiles.append(sFile);
+				if(QFile::exists(SignalPyramid::fileName(sFile)))
+					lFiles.append(SignalPyramid::fileName(sFile));
+			}
+			m_oCache.store(m_mCacheKeys[sInputFile], lFiles, sInputFile);
+		}
+
+		// List the images of a sequence next to the CSV file (their frames)
+		if(ImageSequence::isImageSequence(sInputFile))
+		{
+			ImageSequence oSequence(sInputFile);
+			if(!oSequence.open() || !oSequence.saveListing(ImageSequence::listingFileName(sCSVFile)))
+			{
+				qCritical().noquote() << tr("error writing the listing of images to file %1").arg(ImageSequence::listingFileName(sCSVFile));
+				iRet = -3;
+			}
+		}
 	}
 
 	if(m_lTasks.count() == 0)
 	{
 		QThreadPool::globalInstance()->waitForDone();
+		reportProfile();
 		exit(iRet);
 	}
 }
 
+// +-----------------------------------------------------------
+void fsdk::LandmarksApp::taskResult(const QString &sInputFile, const int iFrame, const QVariant &vData)
+{
+	Q_UNUSED(sInputFile);
+
+	// Print one line per face (with the face ID only if several faces are tracked)
+	QMap<int, LandmarksData> mFaces;
+	if(vData.userType() == qMetaTypeId<FaceTracksData>())
+	{
+		FaceTracksData oTracks = vData.value<FaceTracksData>();
+		foreach(int iFace, oTracks.faces())
+			mFaces.insert(iFace, oTracks.face(iFace));
+	}
+	else
+		mFaces.insert(-1, vData.value<LandmarksData>());
+
+	QMap<int, LandmarksData>::const_iterator it;
+	for(it = mFaces.cbegin(); it != mFaces.cend(); ++it)
+	{
+		QStringList lValues;
+		lValues.append(QString::number(iFrame));
+		if(it.key() >= 0)
+			lValues.append(QString::number(it.key()));
+		lValues.append(QString::number(it.value().quality(iFrame)));
+		foreach(QPoint oPoint, it.value().landmarks(iFrame))
+			lValues.append(QString("%1,%2").arg(oPoint.x()).arg(oPoint.y()));
+
+		// Flush each line, so the results are available right away to a reader
+		std::cout << lValues.join(',').toStdString() << std::endl;
+	}
+}
+
+// +-----------------------------------------------------------
+void fsdk::LandmarksApp::taskProfiled(const QString &sInputFile, const fsdk::TaskProfile &oProfile)
+{
+	Q_UNUSED(sInputFile);
+	m_oProfile.merge(oProfile);
+}
+
+// +-----------------------------------------------------------
+void fsdk::LandmarksApp::reportProfile()
+{
+	if(m_bPrintProfile)
+		std::cout << m_oProfile.toText().toStdString() << std::endl;
+
+	if(!m_sProfileFile.isEmpty())
+	{
+		QFile oFile(m_sProfileFile);
+		QByteArray oJson = QJsonDocument(m_oProfile.toJson()).toJson(QJsonDocument::Indented);
+		if(!oFile.open(QIODevice::WriteOnly) || oFile.write(oJson) != oJson.size())
+			qCritical().noquote() << tr("error writing the profile to file %1").arg(m_sProfileFile);
+	}
+}
+
 // +-----------------------------------------------------------
 void fsdk::LandmarksApp::cancel()
 {
+	// The tasks still waiting are simply not started
+	m_lPending.clear();
+
 	foreach(ExtractionTask *pTask, m_lTasks)
 		pTask->cancel();
 }
\ No newline at end of file